@@ -39,4 +39,8 @@ void _cally_actor_get_top_level_origin (ClutterActor *actor,
                                         gint         *x,
                                         gint         *y);
 
+void _cally_actor_queue_state_change (CallyActor *cally_actor,
+                                      AtkState    state,
+                                      gboolean    value);
+
 #endif /* __CALLY_ACTOR_PRIVATE_H__ */
@@ -134,6 +134,11 @@ static gint cally_actor_real_add_actor    (ClutterActor *container,
 static gint cally_actor_real_remove_actor (ClutterActor *container,
                                           ClutterActor *actor,
                                           gpointer      data);
+static gint cally_actor_get_child_index   (CallyActor   *cally_actor,
+                                          ClutterActor *container,
+                                          ClutterActor *child);
+static void cally_actor_queue_notify      (CallyActor   *cally_actor);
+static gboolean idle_notify               (gpointer      data);
 
 /* AtkComponent.h */
 static void     cally_actor_component_interface_init (AtkComponentIface *iface);
@@ -179,7 +184,26 @@ struct _CallyActorPrivate
   guint   action_idle_handler;
   GList  *action_list;
 
-  GList *children;
+  /* the children, as last notified through children_changed */
+  GPtrArray *children;
+
+  /* the children added and removed since the last notification; the
+   * removed ones map to a reference on their accessible, since the
+   * actor may be gone by the time we notify
+   */
+  GHashTable *added_children;
+  GHashTable *removed_children;
+
+  /* the ATK states changed since the last notification */
+  guint64 changed_states;
+  guint64 state_values;
+
+  guint notify_idle_handler;
+
+  /* maps each child to its index in the container; see
+   * cally_actor_get_child_index()
+   */
+  GHashTable *child_index;
 };
 
 G_DEFINE_TYPE_WITH_CODE (CallyActor,
@@ -224,6 +248,7 @@ cally_actor_initialize (AtkObject *obj,
   CallyActor        *self  = NULL;
   CallyActorPrivate *priv  = NULL;
   ClutterActor     *actor = NULL;
+  ClutterActor     *iter;
   guint             handler_id;
 
   ATK_OBJECT_CLASS (cally_actor_parent_class)->initialize (obj, data);
@@ -240,7 +265,11 @@ cally_actor_initialize (AtkObject *obj,
   g_object_set_data (G_OBJECT (obj), "atk-component-layer",
                      GINT_TO_POINTER (ATK_LAYER_MDI));
 
-  priv->children = clutter_actor_get_children (actor);
+  priv->children = g_ptr_array_sized_new (clutter_actor_get_n_children (actor));
+  for (iter = clutter_actor_get_first_child (actor);
+       iter != NULL;
+       iter = clutter_actor_get_next_sibling (iter))
+    g_ptr_array_add (priv->children, iter);
 
   /*
    * We store the handler ids for these signals in case some objects
@@ -299,6 +328,11 @@ cally_actor_init (CallyActor *cally_actor)
   priv->action_list = NULL;
 
   priv->children = NULL;
+  priv->added_children = NULL;
+  priv->removed_children = NULL;
+  priv->child_index = NULL;
+
+  priv->notify_idle_handler = 0;
 }
 
 static void
@@ -323,12 +357,22 @@ cally_actor_finalize (GObject *obj)
       g_queue_free (priv->action_queue);
     }
 
+  if (priv->notify_idle_handler)
+    {
+      g_source_remove (priv->notify_idle_handler);
+      priv->notify_idle_handler = 0;
+    }
+
   if (priv->children)
     {
-      g_list_free (priv->children);
+      g_ptr_array_free (priv->children, TRUE);
       priv->children = NULL;
     }
 
+  g_clear_pointer (&priv->added_children, g_hash_table_destroy);
+  g_clear_pointer (&priv->removed_children, g_hash_table_destroy);
+  g_clear_pointer (&priv->child_index, g_hash_table_destroy);
+
   G_OBJECT_CLASS (cally_actor_parent_class)->finalize (obj);
 }
 
@@ -374,6 +418,7 @@ cally_actor_get_index_in_parent (AtkObject *obj)
   ClutterActor *actor = NULL;
   ClutterActor *parent_actor = NULL;
   ClutterActor *iter;
+  AtkObject *parent;
   gint index = -1;
 
   g_return_val_if_fail (CALLY_IS_ACTOR (obj), -1);
@@ -409,6 +454,15 @@ cally_actor_get_index_in_parent (AtkObject *obj)
   if (parent_actor == NULL)
     return -1;
 
+  /* screen readers ask for the index of each child while walking
+   * a container, so we keep an index of the children around
+   */
+  parent = clutter_actor_get_accessible (parent_actor);
+  if (CALLY_IS_ACTOR (parent))
+    return cally_actor_get_child_index (CALLY_ACTOR (parent),
+                                        parent_actor,
+                                        actor);
+
   for (iter = clutter_actor_get_first_child (parent_actor);
        iter != NULL && iter != actor;
        iter = clutter_actor_get_next_sibling (iter))
@@ -573,20 +627,19 @@ cally_actor_real_add_actor (ClutterActor *container,
   AtkObject        *atk_child  = clutter_actor_get_accessible (actor);
   CallyActor        *cally_actor = CALLY_ACTOR (atk_parent);
   CallyActorPrivate *priv       = cally_actor->priv;
-  gint              index;
 
   g_return_val_if_fail (CLUTTER_IS_CONTAINER (container), 0);
   g_return_val_if_fail (CLUTTER_IS_ACTOR (actor), 0);
 
   g_object_notify (G_OBJECT (atk_child), "accessible_parent");
 
-  g_list_free (priv->children);
+  /* children_changed::add is emitted by idle_notify() */
+  if (priv->added_children == NULL)
+    priv->added_children = g_hash_table_new (NULL, NULL);
 
-  priv->children = clutter_actor_get_children (CLUTTER_ACTOR (container));
+  g_hash_table_add (priv->added_children, actor);
 
-  index = g_list_index (priv->children, actor);
-  g_signal_emit_by_name (atk_parent, "children_changed::add",
-                         index, atk_child, NULL);
+  cally_actor_queue_notify (cally_actor);
 
   return 1;
 }
@@ -600,7 +653,6 @@ cally_actor_real_remove_actor (ClutterActor *container,
   AtkObject*         atk_parent  = NULL;
   AtkObject         *atk_child   = NULL;
   CallyActorPrivate  *priv        = NULL;
-  gint               index;
 
   g_return_val_if_fail (CLUTTER_IS_CONTAINER (container), 0);
   g_return_val_if_fail (CLUTTER_IS_ACTOR (actor), 0);
@@ -622,18 +674,231 @@ cally_actor_real_remove_actor (ClutterActor *container,
     }
 
   priv = CALLY_ACTOR (atk_parent)->priv;
-  index = g_list_index (priv->children, actor);
-  g_list_free (priv->children);
 
-  priv->children = clutter_actor_get_children (CLUTTER_ACTOR (container));
+  /* children_changed::remove is emitted by idle_notify() */
+  if (atk_child != NULL)
+    {
+      if (priv->removed_children == NULL)
+        priv->removed_children = g_hash_table_new_full (NULL, NULL,
+                                                        NULL,
+                                                        g_object_unref);
+
+      if (!g_hash_table_contains (priv->removed_children, actor))
+        g_hash_table_insert (priv->removed_children,
+                             actor,
+                             g_object_ref (atk_child));
+    }
 
-  if (index >= 0 && index <= g_list_length (priv->children))
-    g_signal_emit_by_name (atk_parent, "children_changed::remove",
-                           index, atk_child, NULL);
+  cally_actor_queue_notify (CALLY_ACTOR (atk_parent));
 
   return 1;
 }
 
+static void
+cally_actor_rebuild_child_index (CallyActor   *cally_actor,
+                                 ClutterActor *container)
+{
+  CallyActorPrivate *priv = cally_actor->priv;
+  ClutterActor *iter;
+  gint i;
+
+  if (priv->child_index == NULL)
+    priv->child_index = g_hash_table_new (NULL, NULL);
+  else
+    g_hash_table_remove_all (priv->child_index);
+
+  for (iter = clutter_actor_get_first_child (container), i = 0;
+       iter != NULL;
+       iter = clutter_actor_get_next_sibling (iter), i++)
+    g_hash_table_insert (priv->child_index, iter, GINT_TO_POINTER (i));
+}
+
+/*
+ * Returns the index of @child inside @container; the index is cached
+ * until the children of @container change, and since children can be
+ * re-ordered without any notification the cached value is validated
+ * against clutter_actor_get_child_at_index(), which does not need to
+ * walk the children of large containers.
+ */
+static gint
+cally_actor_get_child_index (CallyActor   *cally_actor,
+                             ClutterActor *container,
+                             ClutterActor *child)
+{
+  CallyActorPrivate *priv = cally_actor->priv;
+  gpointer value;
+
+  if (priv->child_index != NULL &&
+      g_hash_table_lookup_extended (priv->child_index, child, NULL, &value) &&
+      clutter_actor_get_child_at_index (container, GPOINTER_TO_INT (value)) == child)
+    return GPOINTER_TO_INT (value);
+
+  cally_actor_rebuild_child_index (cally_actor, container);
+
+  if (g_hash_table_lookup_extended (priv->child_index, child, NULL, &value))
+    return GPOINTER_TO_INT (value);
+
+  return -1;
+}
+
+static void
+cally_actor_queue_notify (CallyActor *cally_actor)
+{
+  CallyActorPrivate *priv = cally_actor->priv;
+
+  if (priv->notify_idle_handler == 0)
+    priv->notify_idle_handler = clutter_threads_add_idle (idle_notify,
+                                                          cally_actor);
+}
+
+/*
+ * Emits the children_changed signals for all the changes since the
+ * last notification: first the removals, from the last to the first
+ * child, and then the additions, from the first to the last child, so
+ * that each index is valid at the time of the emission.
+ */
+static void
+cally_actor_notify_children_changed (CallyActor   *cally_actor,
+                                     ClutterActor *container)
+{
+  CallyActorPrivate *priv = cally_actor->priv;
+  AtkObject *atk_obj = ATK_OBJECT (cally_actor);
+  GHashTable *added, *removed;
+  GPtrArray *old_children;
+  ClutterActor *iter;
+  gint i;
+
+  /* batches with only state changes leave the children untouched */
+  if (priv->added_children == NULL && priv->removed_children == NULL)
+    return;
+
+  /* the handlers might change the children again, so we steal the
+   * current state before emitting anything
+   */
+  added = priv->added_children;
+  removed = priv->removed_children;
+  priv->added_children = NULL;
+  priv->removed_children = NULL;
+
+  old_children = priv->children;
+  priv->children = g_ptr_array_sized_new (clutter_actor_get_n_children (container));
+
+  for (iter = clutter_actor_get_first_child (container);
+       iter != NULL;
+       iter = clutter_actor_get_next_sibling (iter))
+    g_ptr_array_add (priv->children, iter);
+
+  if (removed != NULL)
+    {
+      for (i = (gint) old_children->len - 1; i >= 0; i--)
+        {
+          AtkObject *atk_child;
+
+          atk_child = g_hash_table_lookup (removed,
+                                           g_ptr_array_index (old_children, i));
+          if (atk_child != NULL)
+            g_signal_emit_by_name (atk_obj, "children_changed::remove",
+                                   i, atk_child, NULL);
+        }
+
+      g_hash_table_destroy (removed);
+    }
+
+  if (added != NULL)
+    {
+      for (i = 0; i < (gint) priv->children->len; i++)
+        {
+          ClutterActor *child = g_ptr_array_index (priv->children, i);
+
+          if (g_hash_table_contains (added, child))
+            g_signal_emit_by_name (atk_obj, "children_changed::add",
+                                   i, clutter_actor_get_accessible (child),
+                                   NULL);
+        }
+
+      g_hash_table_destroy (added);
+    }
+
+  g_ptr_array_free (old_children, TRUE);
+}
+
+static gboolean
+idle_notify (gpointer data)
+{
+  CallyActor        *cally_actor = CALLY_ACTOR (data);
+  CallyActorPrivate *priv        = cally_actor->priv;
+  ClutterActor      *actor       = NULL;
+  guint64            changed_states;
+  AtkState           state;
+
+  priv->notify_idle_handler = 0;
+
+  actor = CALLY_GET_CLUTTER_ACTOR (cally_actor);
+  if (actor == NULL) /* state is defunct */
+    return FALSE;
+
+  g_object_ref (cally_actor);
+
+  cally_actor_notify_children_changed (cally_actor, actor);
+
+  changed_states = priv->changed_states;
+  priv->changed_states = 0;
+
+  for (state = ATK_STATE_INVALID; changed_states != 0; state++)
+    {
+      guint64 mask = G_GUINT64_CONSTANT (1) << state;
+
+      if ((changed_states & mask) == 0)
+        continue;
+
+      changed_states &= ~mask;
+
+      atk_object_notify_state_change (ATK_OBJECT (cally_actor),
+                                      state,
+                                      (priv->state_values & mask) != 0);
+    }
+
+  g_object_unref (cally_actor);
+
+  return FALSE;
+}
+
+/*< private >
+ * _cally_actor_queue_state_change:
+ * @cally_actor: a #CallyActor
+ * @state: the #AtkState that changed
+ * @value: the new value of @state
+ *
+ * Queues the notification of a state change of @cally_actor; the
+ * state changes happening during a frame are coalesced, and only
+ * the last value of each state is notified.
+ */
+void
+_cally_actor_queue_state_change (CallyActor *cally_actor,
+                                 AtkState    state,
+                                 gboolean    value)
+{
+  CallyActorPrivate *priv = cally_actor->priv;
+  guint64 mask;
+
+  if (state >= 64)
+    {
+      atk_object_notify_state_change (ATK_OBJECT (cally_actor), state, value);
+      return;
+    }
+
+  mask = G_GUINT64_CONSTANT (1) << state;
+
+  priv->changed_states |= mask;
+
+  if (value)
+    priv->state_values |= mask;
+  else
+    priv->state_values &= ~mask;
+
+  cally_actor_queue_notify (cally_actor);
+}
+
 /* AtkComponent implementation */
 static void
 cally_actor_component_interface_init (AtkComponentIface *iface)
@@ -1035,7 +1300,10 @@ cally_actor_real_notify_clutter (GObject    *obj,
   else
     return;
 
-  atk_object_notify_state_change (atk_obj, state, value);
+  if (CALLY_IS_ACTOR (atk_obj))
+    _cally_actor_queue_state_change (CALLY_ACTOR (atk_obj), state, value);
+  else
+    atk_object_notify_state_change (atk_obj, state, value);
 }
 
 static void
@@ -1711,8 +1711,9 @@ cally_text_notify_clutter (GObject    *obj,
     }
   else if (g_strcmp0 (pspec->name, "editable") == 0)
     {
-      atk_object_notify_state_change (atk_obj, ATK_STATE_EDITABLE,
-                                      clutter_text_get_editable (clutter_text));
+      _cally_actor_queue_state_change (CALLY_ACTOR (atk_obj),
+                                       ATK_STATE_EDITABLE,
+                                       clutter_text_get_editable (clutter_text));
     }
   else if (g_strcmp0 (pspec->name, "activatable") == 0)
     {
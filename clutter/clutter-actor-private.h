@@ -295,6 +295,10 @@ gboolean                        _clutter_actor_set_default_paint_volume
 
 const gchar *                   _clutter_actor_get_debug_name                           (ClutterActor *self);
 
+void                            _clutter_actor_paint_children                           (ClutterActor *self);
+void                            _clutter_actor_paint_children_in_box                    (ClutterActor          *self,
+                                                                                         const ClutterActorBox *box);
+
 void                            _clutter_actor_push_clone_paint                         (void);
 void                            _clutter_actor_pop_clone_paint                          (void);
 
@@ -316,6 +320,7 @@ void                            _clutter_actor_detach_clone
 void                            _clutter_actor_queue_redraw_on_clones                   (ClutterActor *actor);
 void                            _clutter_actor_queue_relayout_on_clones                 (ClutterActor *actor);
 void                            _clutter_actor_queue_only_relayout                      (ClutterActor *actor);
+void                            _clutter_actor_allocate_boundary                        (ClutterActor *actor);
 
 CoglFramebuffer *               _clutter_actor_get_active_framebuffer                   (ClutterActor *actor);
 
@@ -621,8 +621,10 @@
 #include "clutter-action.h"
 #include "clutter-actor-meta-private.h"
 #include "clutter-animatable.h"
+#include "clutter-clone-private.h"
 #include "clutter-color-static.h"
 #include "clutter-color.h"
+#include "clutter-column-store.h"
 #include "clutter-constraint-private.h"
 #include "clutter-container.h"
 #include "clutter-content-private.h"
@@ -642,6 +644,7 @@
 #include "clutter-property-transition.h"
 #include "clutter-scriptable.h"
 #include "clutter-script-private.h"
+#include "clutter-spatial-index.h"
 #include "clutter-stage-private.h"
 #include "clutter-timeline.h"
 #include "clutter-transition.h"
@@ -672,18 +675,82 @@ typedef enum {
  * will ask for 3 different preferred size in each allocation cycle */
 #define N_CACHED_SIZE_REQUESTS 3
 
-struct _ClutterActorPrivate
+/* an axis aligned box in 3D */
+typedef struct _VolumeBox
 {
-  /* request mode */
-  ClutterRequestMode request_mode;
+  float x1, y1, z1;
+  float x2, y2, z2;
+} VolumeBox;
+
+typedef enum {
+  VOLUME_BOX_SKIP,      /* the actor does not contribute to the volume */
+  VOLUME_BOX_SET,       /* the box is set */
+  VOLUME_BOX_UNKNOWN    /* the actor does not have a paint volume */
+} VolumeBoxState;
+
+/* the union of the paint volumes of the children of an actor, in the
+ * coordinate space of the actor; see clutter_actor_update_children_volume()
+ */
+typedef struct _ClutterChildrenVolume
+{
+  VolumeBox box;
 
-  /* our cached size requests for different width / height */
+  /* the only child whose box changed since the union was computed */
+  ClutterActor *dirty_child;
+
+  guint is_valid : 1;
+  guint is_empty : 1;
+} ClutterChildrenVolume;
+
+/* the cached size requests of an actor; allocated the first time a
+ * size request is not satisfied by a fixed size
+ */
+typedef struct _ClutterSizeRequestCache
+{
   SizeRequest width_requests[N_CACHED_SIZE_REQUESTS];
   SizeRequest height_requests[N_CACHED_SIZE_REQUESTS];
 
   /* An age of 0 means the entry is not set */
   guint cached_height_age;
   guint cached_width_age;
+} ClutterSizeRequestCache;
+
+/* the paint volumes of an actor; allocated the first time the actor is
+ * painted, or its paint volume is queried
+ */
+typedef struct _ClutterActorVolumes
+{
+  ClutterPaintVolume paint_volume;
+
+  /* NB: This volume isn't relative to this actor, it is in eye
+   * coordinates so that it can remain valid after the actor changes.
+   */
+  ClutterPaintVolume last_paint_volume;
+} ClutterActorVolumes;
+
+/* the cached transformation from an actor to the coordinate space of
+ * its top-level actor, and its inverse; see clutter_actor_get_stage_transform()
+ */
+typedef struct _ClutterStageTransform
+{
+  CoglMatrix matrix;
+  CoglMatrix inverse;
+
+  ClutterActor *root;
+
+  guint inverse_valid : 1;
+  guint is_invertible : 1;
+} ClutterStageTransform;
+
+struct _ClutterActorPrivate
+{
+  /* request mode */
+  ClutterRequestMode request_mode;
+
+  /* our cached size requests for different width / height; see
+   * clutter_actor_get_size_request_cache()
+   */
+  ClutterSizeRequestCache *size_requests;
 
   /* the bounding box of the actor, relative to the parent's
    * allocation
@@ -694,8 +761,19 @@ struct _ClutterActorPrivate
   /* clip, in actor coordinates */
   ClutterRect clip;
 
-  /* the cached transformation matrix; see apply_transform() */
-  CoglMatrix transform;
+  /* the cached transformation matrix; see apply_transform(). It is
+   * not allocated for actors that are only translated by the origin
+   * of their allocation
+   */
+  CoglMatrix *transform;
+
+  /* the cached transformation from the actor to the coordinate space
+   * of its top-level actor, excluding the transformation of the top-level
+   * itself; allocated the first time it's needed, and only valid if
+   * stage_transform_valid is set, which implies that it is set on all
+   * the ancestors as well. See clutter_actor_get_stage_transform()
+   */
+  ClutterStageTransform *stage_transform;
 
   guint8 opacity;
   gint opacity_override;
@@ -715,6 +793,18 @@ struct _ClutterActorPrivate
 
   gint n_children;
 
+  /* a contiguous copy of the children list, in paint order; it is only
+   * allocated for actors with many children, and it is kept in sync by
+   * the functions that link and unlink children. See child_array_*()
+   */
+  GPtrArray *child_array;
+
+  /* a bounding volume hierarchy of the children, in the coordinate
+   * space of this actor; it has the same life time as child_array.
+   * See clutter_actor_paint_children()
+   */
+  ClutterSpatialIndex *spatial_index;
+
   /* tracks whenever the children of an actor are changed; the
    * age is incremented by 1 whenever an actor is added or
    * removed. the age is not incremented when the first or the
@@ -751,12 +841,6 @@ struct _ClutterActorPrivate
   /* delegate object used to paint the contents of this actor */
   ClutterContent *content;
 
-  ClutterActorBox content_box;
-  ClutterContentGravity content_gravity;
-  ClutterScalingFilter min_filter;
-  ClutterScalingFilter mag_filter;
-  ClutterContentRepeat content_repeat;
-
   /* used when painting, to update the paint volume */
   ClutterEffect *current_effect;
 
@@ -774,12 +858,14 @@ struct _ClutterActorPrivate
      the list of effects that is next in the chain */
   const GList *next_effect_to_paint;
 
-  ClutterPaintVolume paint_volume;
+  /* see clutter_actor_get_volumes() */
+  ClutterActorVolumes *volumes;
 
-  /* NB: This volume isn't relative to this actor, it is in eye
-   * coordinates so that it can remain valid after the actor changes.
+  /* the bounding box of the paint volume in the coordinate space of the
+   * parent, and the cached union of the boxes of the children
    */
-  ClutterPaintVolume last_paint_volume;
+  VolumeBox parent_volume_box;
+  ClutterChildrenVolume *children_volume;
 
   ClutterStageQueueRedrawEntry *queue_redraw_entry;
 
@@ -798,11 +884,6 @@ struct _ClutterActorPrivate
    */
   gulong in_cloned_branch;
 
-  GListModel *child_model;
-  ClutterActorCreateChildFunc create_child_func;
-  gpointer create_child_data;
-  GDestroyNotify create_child_notify;
-
   /* bitfields: KEEP AT THE END */
 
   /* fixed position and sizes */
@@ -825,23 +906,73 @@ struct _ClutterActorPrivate
   guint has_pointer                 : 1;
   guint propagated_one_redraw       : 1;
   guint paint_volume_valid          : 1;
+  /* paint_volume is up to date; see clutter_actor_invalidate_paint_volume() */
+  guint paint_volume_cached         : 1;
   guint last_paint_volume_valid     : 1;
+  guint parent_volume_box_valid     : 1;
+  guint parent_volume_box_state     : 2;
+  /* the ancestors already know that the volume of the actor changed;
+   * see clutter_actor_invalidate_parent_volume()
+   */
+  guint parent_volume_invalidated   : 1;
   guint in_clone_paint              : 1;
   guint transform_valid             : 1;
+  /* the cached transformation is only a translation by the origin
+   * of the allocation, and the transform field is unused
+   */
+  guint transform_is_translation    : 1;
+  guint stage_transform_valid       : 1;
+  /* the order of the children in spatial_index matches child_array */
+  guint spatial_index_order_valid   : 1;
+  /* the children are not known to be sorted by depth; see
+   * insert_child_at_depth()
+   */
+  guint children_depth_unsorted     : 1;
   /* This is TRUE if anything has queued a redraw since we were last
      painted. In this case effect_to_redraw will point to an effect
      the redraw was queued from or it will be NULL if the redraw was
      queued without an effect. */
   guint is_dirty                    : 1;
   guint bg_color_set                : 1;
-  guint content_box_valid           : 1;
   guint x_expand_set                : 1;
   guint y_expand_set                : 1;
   guint needs_compute_expand        : 1;
   guint needs_x_expand              : 1;
   guint needs_y_expand              : 1;
+  /* see clutter_actor_set_isolate_layout() */
+  guint isolate_layout              : 1;
 };
 
+/* state used only by actors with a ClutterContent, or that changed the
+ * content parameters; stored in a side structure to keep the size of
+ * ClutterActorPrivate small for the common case
+ */
+typedef struct _ClutterContentInfo
+{
+  ClutterActorBox content_box;
+  ClutterContentGravity content_gravity;
+  ClutterScalingFilter min_filter;
+  ClutterScalingFilter mag_filter;
+  ClutterContentRepeat content_repeat;
+
+  guint content_box_valid : 1;
+} ClutterContentInfo;
+
+/* creates the child for a row of the model without retrieving the item */
+typedef ClutterActor *(* ClutterActorCreateRowFunc) (GListModel *model,
+                                                     guint       position,
+                                                     gpointer    user_data);
+
+/* the state of clutter_actor_bind_model() */
+typedef struct _ClutterModelBinding
+{
+  GListModel *child_model;
+  ClutterActorCreateChildFunc create_child_func;
+  ClutterActorCreateRowFunc create_row_func;
+  gpointer create_child_data;
+  GDestroyNotify create_child_notify;
+} ClutterModelBinding;
+
 enum
 {
   PROP_0,
@@ -882,6 +1013,7 @@ enum
   PROP_NATURAL_HEIGHT_SET,
 
   PROP_REQUEST_MODE,
+  PROP_ISOLATE_LAYOUT,
 
   /* Allocation properties are read-only */
   PROP_ALLOCATION,
@@ -1066,6 +1198,10 @@ static gboolean clutter_anchor_coord_is_zero (const AnchorCoord *coord);
 static void _clutter_actor_get_relative_transformation_matrix (ClutterActor *self,
                                                                ClutterActor *ancestor,
                                                                CoglMatrix *matrix);
+static void clutter_actor_invalidate_transform (ClutterActor *self);
+static void clutter_actor_invalidate_stage_transform (ClutterActor *self);
+static gboolean clutter_transform_info_is_default (const ClutterTransformInfo *info);
+static void clutter_actor_check_child_depth_order (ClutterActor *child);
 
 static ClutterPaintVolume *_clutter_actor_get_paint_volume_mutable (ClutterActor *self);
 
@@ -1104,6 +1240,23 @@ static GQuark quark_shader_data = 0;
 static GQuark quark_actor_layout_info = 0;
 static GQuark quark_actor_transform_info = 0;
 static GQuark quark_actor_animation_info = 0;
+static GQuark quark_actor_content_info = 0;
+static GQuark quark_actor_model_binding = 0;
+
+static const ClutterContentInfo *       clutter_actor_get_content_info_or_defaults      (ClutterActor *self);
+static ClutterContentInfo *             clutter_actor_get_content_info                  (ClutterActor *self);
+static ClutterContentInfo *             clutter_actor_peek_content_info                 (ClutterActor *self);
+static void                             clutter_actor_unbind_model_internal             (ClutterActor *self);
+static void                             clutter_actor_bind_model_internal               (ClutterActor                *self,
+                                                                                         GListModel                  *model,
+                                                                                         ClutterActorCreateChildFunc  create_child_func,
+                                                                                         ClutterActorCreateRowFunc    create_row_func,
+                                                                                         gpointer                     user_data,
+                                                                                         GDestroyNotify               notify);
+static void                             clutter_actor_invalidate_paint_volume           (ClutterActor *self);
+static void                             clutter_actor_invalidate_parent_volume          (ClutterActor *self);
+static void                             clutter_actor_invalidate_children_volume        (ClutterActor *self);
+static void                             clutter_actor_ensure_spatial_index_order        (ClutterActor *self);
 
 G_DEFINE_TYPE_WITH_CODE (ClutterActor,
                          clutter_actor,
@@ -1503,6 +1656,9 @@ clutter_actor_real_map (ClutterActor *self)
 
   CLUTTER_ACTOR_SET_FLAGS (self, CLUTTER_ACTOR_MAPPED);
 
+  /* unmapped actors are not part of the volume of their parent */
+  clutter_actor_invalidate_parent_volume (self);
+
   stage = _clutter_actor_get_stage_internal (self);
   priv->pick_id = _clutter_stage_acquire_pick_id (CLUTTER_STAGE (stage), self);
 
@@ -1594,10 +1750,13 @@ clutter_actor_real_unmap (ClutterActor *self)
 
   CLUTTER_ACTOR_UNSET_FLAGS (self, CLUTTER_ACTOR_MAPPED);
 
+  clutter_actor_invalidate_parent_volume (self);
+
   /* clear the contents of the last paint volume, so that hiding + moving +
    * showing will not result in the wrong area being repainted
    */
-  _clutter_paint_volume_init_static (&priv->last_paint_volume, NULL);
+  if (priv->volumes != NULL)
+    _clutter_paint_volume_init_static (&priv->volumes->last_paint_volume, NULL);
   priv->last_paint_volume_valid = TRUE;
 
   /* notify on parent mapped after potentially unmapping
@@ -1668,6 +1827,9 @@ clutter_actor_real_show (ClutterActor *self)
 
   CLUTTER_ACTOR_SET_FLAGS (self, CLUTTER_ACTOR_VISIBLE);
 
+  /* hidden actors are not part of the spatial index of their parent */
+  clutter_actor_invalidate_parent_volume (self);
+
   /* we notify on the "visible" flag in the clutter_actor_show()
    * wrapper so the entire show signal emission completes first,
    * and the branch of the scene graph is in a stable state
@@ -1824,6 +1986,9 @@ clutter_actor_real_hide (ClutterActor *self)
 
   CLUTTER_ACTOR_UNSET_FLAGS (self, CLUTTER_ACTOR_VISIBLE);
 
+  /* hidden actors are not part of the spatial index of their parent */
+  clutter_actor_invalidate_parent_volume (self);
+
   /* we notify on the "visible" flag in the clutter_actor_hide()
    * wrapper so the entire hide signal emission completes first,
    * and the branch of the scene graph is in a stable state
@@ -2246,14 +2411,7 @@ clutter_actor_real_pick (ClutterActor       *self,
    * this has to go away for 2.0; hopefully along the pick() itself.
    */
   if (CLUTTER_ACTOR_GET_CLASS (self)->pick == clutter_actor_real_pick)
-    {
-      ClutterActor *iter;
-
-      for (iter = self->priv->first_child;
-           iter != NULL;
-           iter = iter->priv->next_sibling)
-        clutter_actor_paint (iter);
-    }
+    _clutter_actor_paint_children (self);
 }
 
 /**
@@ -2482,6 +2640,11 @@ clutter_actor_set_allocation_internal (ClutterActor           *self,
   priv->allocation = *box;
   priv->allocation_flags = flags;
 
+  /* the paint volume depends on the allocation, and on whether the
+   * actor has a valid allocation at all
+   */
+  clutter_actor_invalidate_paint_volume (self);
+
   /* allocation is authoritative */
   priv->needs_width_request = FALSE;
   priv->needs_height_request = FALSE;
@@ -2495,14 +2658,18 @@ clutter_actor_set_allocation_internal (ClutterActor           *self,
       CLUTTER_NOTE (LAYOUT, "Allocation for '%s' changed",
                     _clutter_actor_get_debug_name (self));
 
-      priv->transform_valid = FALSE;
+      clutter_actor_invalidate_transform (self);
 
       g_object_notify_by_pspec (obj, obj_props[PROP_ALLOCATION]);
 
       /* if the allocation changes, so does the content box */
       if (priv->content != NULL)
         {
-          priv->content_box_valid = FALSE;
+          ClutterContentInfo *cinfo = clutter_actor_peek_content_info (self);
+
+          if (cinfo != NULL)
+            cinfo->content_box_valid = FALSE;
+
           g_object_notify_by_pspec (obj, obj_props[PROP_CONTENT_BOX]);
         }
 
@@ -2716,6 +2883,58 @@ clutter_actor_real_queue_redraw (ClutterActor *self,
     }
 }
 
+/* an actor with a fixed size cannot change its preferred size in
+ * response to a change in its children, so a relayout queued by one
+ * of its children does not need to reach the parent; the expand flags
+ * are the only other piece of state that flows from the children to
+ * the parent's layout, so we let them go through the full relayout
+ */
+static inline gboolean
+clutter_actor_is_layout_boundary (ClutterActor *self)
+{
+  ClutterActorPrivate *priv = self->priv;
+
+  return priv->isolate_layout &&
+         priv->min_width_set && priv->natural_width_set &&
+         priv->min_height_set && priv->natural_height_set &&
+         !priv->needs_compute_expand &&
+         !CLUTTER_ACTOR_IS_TOPLEVEL (self);
+}
+
+static void
+clutter_actor_queue_boundary_relayout (ClutterActor *self)
+{
+  ClutterActorPrivate *priv = self->priv;
+  ClutterActor *stage;
+
+  if (CLUTTER_ACTOR_IN_DESTRUCTION (self))
+    return;
+
+  /* either we are already queued, or the parent will allocate us */
+  if (priv->needs_allocation)
+    return;
+
+  stage = _clutter_actor_get_stage_internal (self);
+  if (stage == NULL)
+    {
+      _clutter_actor_queue_only_relayout (self);
+      return;
+    }
+
+  CLUTTER_NOTE (LAYOUT, "Queueing a relayout of the children of '%s'",
+                _clutter_actor_get_debug_name (self));
+
+  /* the size requests of the boundary are still valid, so we only
+   * mark the allocation as dirty; this also means that a relayout
+   * queued on the boundary itself still reaches the parent
+   */
+  priv->needs_allocation = TRUE;
+
+  _clutter_actor_queue_relayout_on_clones (self);
+
+  _clutter_stage_queue_boundary_relayout (CLUTTER_STAGE (stage), self);
+}
+
 static void
 clutter_actor_real_queue_relayout (ClutterActor *self)
 {
@@ -2730,14 +2949,24 @@ clutter_actor_real_queue_relayout (ClutterActor *self)
   priv->needs_allocation     = TRUE;
 
   /* reset the cached size requests */
-  memset (priv->width_requests, 0,
-          N_CACHED_SIZE_REQUESTS * sizeof (SizeRequest));
-  memset (priv->height_requests, 0,
-          N_CACHED_SIZE_REQUESTS * sizeof (SizeRequest));
+  if (priv->size_requests != NULL)
+    {
+      memset (priv->size_requests->width_requests, 0,
+              N_CACHED_SIZE_REQUESTS * sizeof (SizeRequest));
+      memset (priv->size_requests->height_requests, 0,
+              N_CACHED_SIZE_REQUESTS * sizeof (SizeRequest));
+    }
 
-  /* We need to go all the way up the hierarchy */
+  /* We need to go all the way up the hierarchy, unless the parent
+   * isolates the layout of its children
+   */
   if (priv->parent != NULL)
-    _clutter_actor_queue_only_relayout (priv->parent);
+    {
+      if (clutter_actor_is_layout_boundary (priv->parent))
+        clutter_actor_queue_boundary_relayout (priv->parent);
+      else
+        _clutter_actor_queue_only_relayout (priv->parent);
+    }
 }
 
 /**
@@ -2881,8 +3110,6 @@ clutter_actor_apply_transform_to_point (ClutterActor        *self,
  * instead.
  *
  */
-/* XXX: We should consider caching the stage relative modelview along with
- * the actor itself */
 static void
 _clutter_actor_get_relative_transformation_matrix (ClutterActor *self,
                                                    ClutterActor *ancestor,
@@ -3067,8 +3294,8 @@ clutter_actor_real_apply_transform (ClutterActor  *self,
                                     ClutterMatrix *matrix)
 {
   ClutterActorPrivate *priv = self->priv;
-  CoglMatrix *transform = &priv->transform;
-  const ClutterTransformInfo *info;
+  const ClutterTransformInfo *info, *parent_info;
+  CoglMatrix *transform;
   float pivot_x = 0.f, pivot_y = 0.f;
 
   /* we already have a cached transformation */
@@ -3076,6 +3303,27 @@ clutter_actor_real_apply_transform (ClutterActor  *self,
     goto multiply_and_return;
 
   info = _clutter_actor_get_transform_info_or_defaults (self);
+  parent_info = priv->parent != NULL
+              ? _clutter_actor_get_transform_info_or_defaults (priv->parent)
+              : NULL;
+
+  /* most actors are only translated by the origin of their allocation,
+   * which we can apply directly without storing a matrix
+   */
+  priv->transform_is_translation =
+    clutter_transform_info_is_default (info) &&
+    (parent_info == NULL || clutter_transform_info_is_default (parent_info));
+
+  if (priv->transform_is_translation)
+    {
+      priv->transform_valid = TRUE;
+      goto multiply_and_return;
+    }
+
+  if (priv->transform == NULL)
+    priv->transform = g_slice_new (CoglMatrix);
+
+  transform = priv->transform;
 
   /* compute the pivot point given the allocated size */
   pivot_x = (priv->allocation.x2 - priv->allocation.x1)
@@ -3095,13 +3343,8 @@ clutter_actor_real_apply_transform (ClutterActor  *self,
                 priv->allocation.y1 + pivot_y + info->translation.y);
 
   /* we apply the :child-transform from the parent actor, if we have one */
-  if (priv->parent != NULL)
-    {
-      const ClutterTransformInfo *parent_info;
-
-      parent_info = _clutter_actor_get_transform_info_or_defaults (priv->parent);
-      clutter_matrix_init_from_matrix (transform, &(parent_info->child_transform));
-    }
+  if (parent_info != NULL)
+    clutter_matrix_init_from_matrix (transform, &(parent_info->child_transform));
   else
     clutter_matrix_init_identity (transform);
 
@@ -3199,7 +3442,142 @@ roll_back_pivot:
   priv->transform_valid = TRUE;
 
 multiply_and_return:
-  cogl_matrix_multiply (matrix, matrix, &priv->transform);
+  if (priv->transform_is_translation)
+    cogl_matrix_translate (matrix,
+                           priv->allocation.x1,
+                           priv->allocation.y1,
+                           0.f);
+  else
+    cogl_matrix_multiply (matrix, matrix, priv->transform);
+}
+
+/* Invalidates the cached transformation of the actor, and the cached
+ * stage transformation of the actor and its children
+ */
+static void
+clutter_actor_invalidate_transform (ClutterActor *self)
+{
+  self->priv->transform_valid = FALSE;
+
+  clutter_actor_invalidate_stage_transform (self);
+  clutter_actor_invalidate_parent_volume (self);
+}
+
+static void
+clutter_actor_invalidate_stage_transform (ClutterActor *self)
+{
+  ClutterActor *child;
+
+  /* if the stage transformation of an actor is not valid then the one
+   * of its children cannot be valid either, so we can stop here
+   */
+  if (!self->priv->stage_transform_valid)
+    return;
+
+  self->priv->stage_transform_valid = FALSE;
+  self->priv->stage_transform->root = NULL;
+
+  for (child = self->priv->first_child;
+       child != NULL;
+       child = child->priv->next_sibling)
+    clutter_actor_invalidate_stage_transform (child);
+}
+
+/*< private >
+ * clutter_actor_get_stage_transform:
+ * @self: a #ClutterActor
+ * @root_p: (out): return location for the top-level actor of @self
+ *
+ * Retrieves the transformation from the coordinate space of @self to
+ * the one of its top-level actor, excluding the transformation applied
+ * by the top-level actor itself, and caches it; repeated calls are
+ * a simple lookup until the transformation of @self, or of one of its
+ * ancestors, changes.
+ *
+ * The transformation can only be cached if @self and its ancestors,
+ * with the exception of the top-level, use the default implementation
+ * of #ClutterActorClass.apply_transform(), since we cannot know when
+ * the result of an overridden implementation changes.
+ *
+ * Return value: a pointer to the cached matrix, or %NULL if the
+ *   transformation could not be cached
+ */
+static const CoglMatrix *
+clutter_actor_get_stage_transform (ClutterActor  *self,
+                                   ClutterActor **root_p)
+{
+  ClutterActorPrivate *priv = self->priv;
+  const CoglMatrix *parent_transform;
+  ClutterStageTransform *info;
+
+  if (priv->stage_transform_valid)
+    {
+      *root_p = priv->stage_transform->root;
+      return &priv->stage_transform->matrix;
+    }
+
+  if (priv->parent != NULL &&
+      CLUTTER_ACTOR_GET_CLASS (self)->apply_transform != clutter_actor_real_apply_transform)
+    return NULL;
+
+  if (priv->stage_transform == NULL)
+    priv->stage_transform = g_slice_new0 (ClutterStageTransform);
+
+  info = priv->stage_transform;
+
+  if (priv->parent == NULL)
+    {
+      cogl_matrix_init_identity (&info->matrix);
+      *root_p = self;
+    }
+  else
+    {
+      parent_transform = clutter_actor_get_stage_transform (priv->parent, root_p);
+      if (parent_transform == NULL)
+        return NULL;
+
+      info->matrix = *parent_transform;
+      _clutter_actor_apply_modelview_transform (self, &info->matrix);
+    }
+
+  info->root = *root_p;
+  info->inverse_valid = FALSE;
+  priv->stage_transform_valid = TRUE;
+
+  return &info->matrix;
+}
+
+/*< private >
+ * clutter_actor_get_stage_transform_inverse:
+ * @self: a #ClutterActor
+ * @root_p: (out): return location for the top-level actor of @self
+ *
+ * Retrieves the inverse of the matrix returned by
+ * clutter_actor_get_stage_transform(); the inverse is computed the
+ * first time it's needed, and cached along with the transformation.
+ *
+ * Return value: a pointer to the cached inverse matrix, or %NULL if
+ *   the transformation could not be cached, or is not invertible
+ */
+static const CoglMatrix *
+clutter_actor_get_stage_transform_inverse (ClutterActor  *self,
+                                           ClutterActor **root_p)
+{
+  ClutterStageTransform *info;
+
+  if (clutter_actor_get_stage_transform (self, root_p) == NULL)
+    return NULL;
+
+  info = self->priv->stage_transform;
+
+  if (!info->inverse_valid)
+    {
+      info->is_invertible = cogl_matrix_get_inverse (&info->matrix,
+                                                     &info->inverse);
+      info->inverse_valid = TRUE;
+    }
+
+  return info->is_invertible ? &info->inverse : NULL;
 }
 
 /* Applies the transforms associated with this actor to the given
@@ -3252,6 +3630,26 @@ _clutter_actor_apply_relative_transformation_matrix (ClutterActor *self,
   if (self == ancestor)
     return;
 
+  /* the transformations to the top-level, or through it to the eye
+   * coordinates, are cached
+   */
+  if (ancestor == NULL || ancestor->priv->parent == NULL)
+    {
+      const CoglMatrix *stage_transform;
+      ClutterActor *root = NULL;
+
+      stage_transform = clutter_actor_get_stage_transform (self, &root);
+      if (stage_transform != NULL &&
+          (ancestor == NULL || ancestor == root))
+        {
+          if (ancestor == NULL)
+            _clutter_actor_apply_modelview_transform (root, matrix);
+
+          cogl_matrix_multiply (matrix, matrix, stage_transform);
+          return;
+        }
+    }
+
   parent = clutter_actor_get_parent (self);
 
   if (parent != NULL)
@@ -3427,6 +3825,23 @@ in_clone_paint (void)
 }
 
 /* Returns TRUE if the actor can be ignored */
+/* Retrieves the paint volumes of the actor, allocating them if needed;
+ * the last paint volume starts out empty
+ */
+static ClutterActorVolumes *
+clutter_actor_get_volumes (ClutterActor *self)
+{
+  ClutterActorPrivate *priv = self->priv;
+
+  if (priv->volumes == NULL)
+    {
+      priv->volumes = g_slice_new (ClutterActorVolumes);
+      _clutter_paint_volume_init_static (&priv->volumes->last_paint_volume, NULL);
+    }
+
+  return priv->volumes;
+}
+
 /* FIXME: we should return a ClutterCullResult, and
  * clutter_actor_paint should understand that a CLUTTER_CULL_RESULT_IN
  * means there's no point in trying to cull descendants of the current
@@ -3469,7 +3884,71 @@ cull_actor (ClutterActor      *self,
     }
 
   *result_out =
-    _clutter_paint_volume_cull (&priv->last_paint_volume, stage_clip);
+    _clutter_paint_volume_cull (&clutter_actor_get_volumes (self)->last_paint_volume,
+                                stage_clip);
+
+  return TRUE;
+}
+
+/* Returns TRUE if the actor can be ignored while picking
+ *
+ * We cannot use the last paint volume while picking, since the actor
+ * might have been moved after the last paint; instead, we transform the
+ * current paint volume using the modelview matrix of the pick, and test
+ * it against the stage clip, which _clutter_stage_do_pick() sets to the
+ * pick point
+ *
+ * The paint volume is not enough on its own: the default pick paints
+ * the whole allocation of the actor, which can be bigger than what the
+ * actor paints, e.g. a ClutterText only reports its ink rectangle; so
+ * we also add the allocation to the volume we cull
+ */
+static gboolean
+cull_actor_for_pick (ClutterActor      *self,
+                     ClutterCullResult *result_out)
+{
+  ClutterStage *stage;
+  const ClutterPlane *stage_clip;
+  const ClutterPaintVolume *pv;
+  ClutterPaintVolume eye_pv;
+  ClutterActorBox pick_box;
+  CoglMatrix modelview;
+
+  if (G_UNLIKELY (clutter_paint_debug_flags & CLUTTER_DEBUG_DISABLE_CULLING))
+    return FALSE;
+
+  stage = (ClutterStage *) _clutter_actor_get_stage_internal (self);
+  stage_clip = _clutter_stage_get_clip (stage);
+  if (G_UNLIKELY (!stage_clip))
+    return FALSE;
+
+  if (cogl_get_draw_framebuffer () != _clutter_stage_get_active_framebuffer (stage))
+    return FALSE;
+
+  pv = clutter_actor_get_paint_volume (self);
+  if (pv == NULL)
+    {
+      CLUTTER_NOTE (CLIPPING, "Bail from cull_actor_for_pick without "
+                    "culling (%s): Actor failed to report a paint volume",
+                    _clutter_actor_get_debug_name (self));
+      return FALSE;
+    }
+
+  _clutter_paint_volume_copy_static (pv, &eye_pv);
+
+  clutter_actor_box_init (&pick_box,
+                          0.f, 0.f,
+                          clutter_actor_box_get_width (&self->priv->allocation),
+                          clutter_actor_box_get_height (&self->priv->allocation));
+  clutter_paint_volume_union_box (&eye_pv, &pick_box);
+
+  cogl_get_modelview_matrix (&modelview);
+  _clutter_paint_volume_transform (&eye_pv, &modelview);
+  _clutter_paint_volume_set_reference_actor (&eye_pv, NULL);
+
+  *result_out = _clutter_paint_volume_cull (&eye_pv, stage_clip);
+
+  clutter_paint_volume_free (&eye_pv);
 
   return TRUE;
 }
@@ -3478,11 +3957,12 @@ static void
 _clutter_actor_update_last_paint_volume (ClutterActor *self)
 {
   ClutterActorPrivate *priv = self->priv;
+  ClutterActorVolumes *volumes = clutter_actor_get_volumes (self);
   const ClutterPaintVolume *pv;
 
   if (priv->last_paint_volume_valid)
     {
-      clutter_paint_volume_free (&priv->last_paint_volume);
+      clutter_paint_volume_free (&volumes->last_paint_volume);
       priv->last_paint_volume_valid = FALSE;
     }
 
@@ -3495,9 +3975,9 @@ _clutter_actor_update_last_paint_volume (ClutterActor *self)
       return;
     }
 
-  _clutter_paint_volume_copy_static (pv, &priv->last_paint_volume);
+  _clutter_paint_volume_copy_static (pv, &volumes->last_paint_volume);
 
-  _clutter_paint_volume_transform_relative (&priv->last_paint_volume,
+  _clutter_paint_volume_transform_relative (&volumes->last_paint_volume,
                                             NULL); /* eye coordinates */
 
   priv->last_paint_volume_valid = TRUE;
@@ -3615,19 +4095,109 @@ add_or_remove_flatten_effect (ClutterActor *self)
     }
 }
 
-static void
-clutter_actor_real_paint (ClutterActor *actor)
+/* queries the spatial index of @self for the children that may be
+ * inside the stage clip, given the current modelview; returns %NULL
+ * if the index cannot be used, in which case all children should be
+ * painted
+ */
+static GPtrArray *
+clutter_actor_get_visible_children (ClutterActor *self)
+{
+  ClutterActorPrivate *priv = self->priv;
+  const ClutterPlane *stage_clip;
+  ClutterStage *stage;
+  CoglMatrix mv;
+  float half_planes[4 * 3];
+  int i;
+
+  if (priv->spatial_index == NULL)
+    return NULL;
+
+  if (G_UNLIKELY (clutter_paint_debug_flags & CLUTTER_DEBUG_DISABLE_CULLING))
+    return NULL;
+
+  stage = (ClutterStage *) _clutter_actor_get_stage_internal (self);
+  if (stage == NULL)
+    return NULL;
+
+  stage_clip = _clutter_stage_get_clip (stage);
+  if (G_UNLIKELY (stage_clip == NULL))
+    return NULL;
+
+  /* the stage clip is only meaningful when painting on the stage */
+  if (cogl_get_draw_framebuffer () != _clutter_stage_get_active_framebuffer (stage))
+    return NULL;
+
+  cogl_get_modelview_matrix (&mv);
+
+  /* we expect an affine modelview; the perspective is in the projection */
+  if (mv.wx != 0.f || mv.wy != 0.f || mv.wz != 0.f || mv.ww != 1.f)
+    return NULL;
+
+  /* restricted to the z = 0 plane of the actor, each plane of the
+   * stage clip, which is in eye coordinates, becomes a half-plane;
+   * a point is inside the clip if dot (n, modelview * p - v0) >= 0
+   */
+  for (i = 0; i < 4; i++)
+    {
+      const ClutterPlane *plane = &stage_clip[i];
+      float *half_plane = half_planes + i * 3;
+
+      half_plane[0] = plane->n[0] * mv.xx + plane->n[1] * mv.yx + plane->n[2] * mv.zx;
+      half_plane[1] = plane->n[0] * mv.xy + plane->n[1] * mv.yy + plane->n[2] * mv.zy;
+      half_plane[2] = plane->n[0] * (mv.xw - plane->v0[0])
+                    + plane->n[1] * (mv.yw - plane->v0[1])
+                    + plane->n[2] * (mv.zw - plane->v0[2]);
+    }
+
+  clutter_actor_ensure_spatial_index_order (self);
+
+  return _clutter_spatial_index_query_half_planes (priv->spatial_index,
+                                                   half_planes,
+                                                   4);
+}
+
+/*< private >
+ * _clutter_actor_paint_children:
+ * @self: a #ClutterActor
+ *
+ * Paints, or picks, the children of @self in order.
+ *
+ * If @self has a spatial index of its children then only the children
+ * that may intersect the stage clip are visited; see the description
+ * of clutter_actor_get_children_in_rect().
+ */
+void
+_clutter_actor_paint_children (ClutterActor *self)
 {
-  ClutterActorPrivate *priv = actor->priv;
   ClutterActor *iter;
+  GPtrArray *visible;
+
+  visible = clutter_actor_get_visible_children (self);
+  if (visible != NULL)
+    {
+      guint i;
+
+      CLUTTER_NOTE (CLIPPING, "Painting %u out of %d children of '%s'",
+                    visible->len,
+                    self->priv->n_children,
+                    _clutter_actor_get_debug_name (self));
+
+      for (i = 0; i < visible->len; i++)
+        clutter_actor_paint (g_ptr_array_index (visible, i));
+
+      g_ptr_array_unref (visible);
 
-  for (iter = priv->first_child;
+      return;
+    }
+
+  for (iter = self->priv->first_child;
        iter != NULL;
        iter = iter->priv->next_sibling)
     {
       CLUTTER_NOTE (PAINT, "Painting %s, child of %s, at { %.2f, %.2f - %.2f x %.2f }",
                     _clutter_actor_get_debug_name (iter),
-                    _clutter_actor_get_debug_name (actor),
+                    _clutter_actor_get_debug_name (self),
                     iter->priv->allocation.x1,
                     iter->priv->allocation.y1,
                     iter->priv->allocation.x2 - iter->priv->allocation.x1,
@@ -3637,6 +4207,68 @@ clutter_actor_real_paint (ClutterActor *actor)
     }
 }
 
+/*< private >
+ * _clutter_actor_paint_children_in_box:
+ * @self: a #ClutterActor
+ * @box: a box, in the coordinate space of @self
+ *
+ * Paints the children of @self that may intersect @box, in order.
+ *
+ * Unlike _clutter_actor_paint_children(), this function does not depend
+ * on the stage clip, so it can be used to paint the children inside an
+ * offscreen framebuffer. Children without a bounded, flat volume are
+ * always painted, so the caller should clip the painting to @box.
+ */
+void
+_clutter_actor_paint_children_in_box (ClutterActor          *self,
+                                      const ClutterActorBox *box)
+{
+  ClutterActor *iter;
+  GPtrArray *children;
+  float half_planes[4 * 3] = {
+     1.f,  0.f, -box->x1,
+    -1.f,  0.f,  box->x2,
+     0.f,  1.f, -box->y1,
+     0.f, -1.f,  box->y2,
+  };
+  guint i;
+
+  if (self->priv->spatial_index == NULL ||
+      G_UNLIKELY (clutter_paint_debug_flags & CLUTTER_DEBUG_DISABLE_CULLING))
+    {
+      for (iter = self->priv->first_child;
+           iter != NULL;
+           iter = iter->priv->next_sibling)
+        clutter_actor_paint (iter);
+
+      return;
+    }
+
+  clutter_actor_ensure_spatial_index_order (self);
+
+  children = _clutter_spatial_index_query_half_planes (self->priv->spatial_index,
+                                                       half_planes,
+                                                       4);
+
+  CLUTTER_NOTE (CLIPPING, "Painting %u out of %d children of '%s' "
+                          "inside { %.2f, %.2f - %.2f, %.2f }",
+                children->len,
+                self->priv->n_children,
+                _clutter_actor_get_debug_name (self),
+                box->x1, box->y1, box->x2, box->y2);
+
+  for (i = 0; i < children->len; i++)
+    clutter_actor_paint (g_ptr_array_index (children, i));
+
+  g_ptr_array_unref (children);
+}
+
+static void
+clutter_actor_real_paint (ClutterActor *actor)
+{
+  _clutter_actor_paint_children (actor);
+}
+
 static gboolean
 clutter_actor_paint_node (ClutterActor     *actor,
                           ClutterPaintNode *root)
@@ -3886,8 +4518,9 @@ clutter_actor_paint (ClutterActor *self)
    * the CPU in a typical paint, so at some point we should
    * audit these and consider caching some things.
    *
-   * NB: We don't perform culling while picking at this point because
-   * clutter-stage.c doesn't setup the clipping planes appropriately.
+   * NB: While picking, the stage clip only covers the pick point, so
+   * we cull using the current paint volume instead; see the comment
+   * in cull_actor_for_pick().
    *
    * NB: We don't want to update the last-paint-volume during picking
    * because the last-paint-volume is used to determine the old screen
@@ -3918,6 +4551,18 @@ clutter_actor_paint (ClutterActor *self)
       else if (result == CLUTTER_CULL_RESULT_OUT && success)
         goto done;
     }
+  else if (!in_clone_paint ())
+    {
+      ClutterCullResult result = CLUTTER_CULL_RESULT_IN;
+
+      /* skipping an actor while picking also skips its children, so
+       * we only traverse the branches of the scene graph that lie
+       * under the pick point
+       */
+      if (cull_actor_for_pick (self, &result) &&
+          result == CLUTTER_CULL_RESULT_OUT)
+        goto done;
+    }
 
   if (priv->effects == NULL)
     {
@@ -4120,12 +4765,357 @@ invalidate_queue_redraw_entry (ClutterActor *self,
   return CLUTTER_ACTOR_TRAVERSE_VISIT_CONTINUE;
 }
 
+/* the number of children above which an actor keeps a child_array;
+ * the array is released once the number of children drops below half
+ * of this value, to avoid rebuilding it when the number of children
+ * oscillates around the threshold
+ */
+#define CHILD_ARRAY_THRESHOLD   64
+
+#ifdef __GNUC__
+#define CHILD_PREFETCH(a)       __builtin_prefetch ((a), 0, 1)
+#else
+#define CHILD_PREFETCH(a)       G_STMT_START { (void) (a); } G_STMT_END
+#endif
+
+/* the children are linked in a list, which means that iterating them
+ * stalls on each next_sibling pointer; when we have a child array we
+ * can ask the CPU to start loading the children we are going to visit
+ * next. The instance is fetched first, and its private data (which is
+ * allocated in a separate block) a couple of iterations later, once
+ * the priv pointer is in the cache
+ */
+static inline void
+child_array_prefetch (GPtrArray *array,
+                      gint       index_,
+                      gint       direction)
+{
+  gint instance_pos = index_ + 4 * direction;
+  gint priv_pos = index_ + 2 * direction;
+
+  if (instance_pos >= 0 && instance_pos < (gint) array->len)
+    CHILD_PREFETCH (g_ptr_array_index (array, instance_pos));
+
+  if (priv_pos >= 0 && priv_pos < (gint) array->len)
+    {
+      ClutterActor *actor = g_ptr_array_index (array, priv_pos);
+
+      CHILD_PREFETCH (actor->priv);
+    }
+}
+
+static inline gint
+child_array_find (GPtrArray    *array,
+                  ClutterActor *child)
+{
+  gint i;
+
+  /* children are mostly appended and removed at the top of the
+   * stack, so we look from the end
+   */
+  for (i = (gint) array->len - 1; i >= 0; i--)
+    {
+      if (g_ptr_array_index (array, i) == child)
+        return i;
+    }
+
+  return -1;
+}
+
+/* computes the 2D bounding box of a child in the coordinate space
+ * of its parent; see ClutterSpatialIndexBoxFunc
+ */
+static gboolean
+clutter_actor_get_child_box (gpointer         data,
+                             ClutterActorBox *box,
+                             gboolean        *is_flat,
+                             gpointer         user_data)
+{
+  ClutterActor *child = data;
+  ClutterActor *parent = user_data;
+  const ClutterPaintVolume *pv;
+  ClutterPaintVolume parent_pv;
+  ClutterActorBox alloc_box;
+  int i, count;
+
+  child->priv->parent_volume_invalidated = FALSE;
+
+  if (!CLUTTER_ACTOR_IS_VISIBLE (child))
+    return FALSE;
+
+  pv = clutter_actor_get_paint_volume (child);
+  if (pv == NULL)
+    return FALSE;
+
+  _clutter_paint_volume_copy_static (pv, &parent_pv);
+
+  /* the same index is used when picking, and actors are picked using
+   * their allocation, which can be larger than what they paint; for
+   * instance, a ClutterText only paints its ink rectangle
+   */
+  clutter_actor_box_init (&alloc_box,
+                          0.f, 0.f,
+                          clutter_actor_box_get_width (&child->priv->allocation),
+                          clutter_actor_box_get_height (&child->priv->allocation));
+  clutter_paint_volume_union_box (&parent_pv, &alloc_box);
+
+  _clutter_paint_volume_transform_relative (&parent_pv, parent);
+  _clutter_paint_volume_get_bounding_box (&parent_pv, box);
+
+  /* the bounding box is only meaningful for culling if the volume
+   * lies on the plane of the parent
+   */
+  *is_flat = TRUE;
+
+  count = parent_pv.is_2d ? 4 : 8;
+  for (i = 0; i < count; i++)
+    {
+      if (fabsf (parent_pv.vertices[i].z) > 1e-4f)
+        {
+          *is_flat = FALSE;
+          break;
+        }
+    }
+
+  clutter_paint_volume_free (&parent_pv);
+
+  return TRUE;
+}
+
+static void
+child_array_rebuild (ClutterActor *self)
+{
+  ClutterActorPrivate *priv = self->priv;
+  ClutterActor *iter;
+  guint i;
+
+  if (priv->child_array == NULL)
+    priv->child_array = g_ptr_array_sized_new (priv->n_children * 2);
+  else
+    g_ptr_array_set_size (priv->child_array, 0);
+
+  if (priv->spatial_index == NULL)
+    {
+      priv->spatial_index =
+        _clutter_spatial_index_new (clutter_actor_get_child_box, self);
+    }
+
+  for (iter = priv->first_child, i = 0;
+       iter != NULL;
+       iter = iter->priv->next_sibling, i++)
+    {
+      g_ptr_array_add (priv->child_array, iter);
+      _clutter_spatial_index_add (priv->spatial_index, iter, i);
+    }
+
+  priv->spatial_index_order_valid = TRUE;
+
+  CLUTTER_NOTE (ACTOR, "Created child array for actor '%s' (%d children)",
+                _clutter_actor_get_debug_name (self),
+                priv->n_children);
+}
+
+/* called after @child has been linked into the list of children
+ * of @self, and n_children has been updated
+ */
+static inline void
+child_array_add (ClutterActor *self,
+                 ClutterActor *child)
+{
+  ClutterActorPrivate *priv = self->priv;
+  ClutterActor *prev_sibling;
+  gint pos;
+
+  if (priv->child_array == NULL)
+    {
+      if (priv->n_children >= CHILD_ARRAY_THRESHOLD)
+        child_array_rebuild (self);
+
+      return;
+    }
+
+  prev_sibling = child->priv->prev_sibling;
+
+  if (child->priv->next_sibling == NULL)
+    pos = priv->child_array->len;
+  else if (prev_sibling == NULL)
+    pos = 0;
+  else
+    pos = child_array_find (priv->child_array, prev_sibling) + 1;
+
+  g_assert (pos > 0 || prev_sibling == NULL);
+
+  g_ptr_array_insert (priv->child_array, pos, child);
+
+  _clutter_spatial_index_add (priv->spatial_index, child, pos);
+
+  /* inserting a child anywhere but at the end shifts the order of
+   * the ones after it
+   */
+  if (pos != priv->child_array->len - 1)
+    priv->spatial_index_order_valid = FALSE;
+}
+
+static void
+child_array_clear (ClutterActor *self)
+{
+  ClutterActorPrivate *priv = self->priv;
+
+  g_clear_pointer (&priv->child_array, g_ptr_array_unref);
+
+  if (priv->spatial_index != NULL)
+    {
+      _clutter_spatial_index_free (priv->spatial_index);
+      priv->spatial_index = NULL;
+    }
+}
+
+/* called before @child is unlinked from the list of children of @self */
+static inline void
+child_array_remove (ClutterActor *self,
+                    ClutterActor *child)
+{
+  ClutterActorPrivate *priv = self->priv;
+  GPtrArray *array = priv->child_array;
+
+  if (array == NULL)
+    return;
+
+  if (priv->n_children - 1 < CHILD_ARRAY_THRESHOLD / 2)
+    {
+      child_array_clear (self);
+      return;
+    }
+
+  _clutter_spatial_index_remove (priv->spatial_index, child);
+
+  if (child == priv->last_child)
+    g_ptr_array_remove_index (array, array->len - 1);
+  else
+    {
+      if (child == priv->first_child)
+        g_ptr_array_remove_index (array, 0);
+      else
+        g_ptr_array_remove_index (array, child_array_find (array, child));
+
+      priv->spatial_index_order_valid = FALSE;
+    }
+}
+
+/*< private >
+ * clutter_actor_invalidate_parent_volume:
+ * @self: a #ClutterActor
+ *
+ * Marks the bounding box of @self in the coordinate space of its
+ * parent as changed, as well as the paint volumes of all the ancestors
+ * of @self and their bounding boxes in the spatial index and in the
+ * union of the children of their parent.
+ *
+ * This is called when the transformation of @self changes, or when
+ * @self is shown or hidden.
+ *
+ * The walk stops at the first actor whose ancestors were already
+ * notified, and that nothing has queried since: everything above it
+ * is already invalid. The flag is reset whenever the volume of the
+ * actor, or its box in the coordinate space of its parent, is
+ * computed again.
+ */
+static void
+clutter_actor_invalidate_parent_volume (ClutterActor *self)
+{
+  ClutterActor *iter;
+
+  for (iter = self; iter->priv->parent != NULL; iter = iter->priv->parent)
+    {
+      ClutterActorPrivate *parent_priv = iter->priv->parent->priv;
+      ClutterChildrenVolume *cv = parent_priv->children_volume;
+
+      if (iter->priv->parent_volume_invalidated)
+        break;
+
+      iter->priv->parent_volume_invalidated = TRUE;
+      iter->priv->parent_volume_box_valid = FALSE;
+
+      /* we can update the union incrementally if a single child
+       * changed since the last time it was computed
+       */
+      if (cv != NULL && cv->is_valid)
+        {
+          if (cv->dirty_child == NULL)
+            cv->dirty_child = iter;
+          else if (cv->dirty_child != iter)
+            cv->is_valid = FALSE;
+        }
+
+      if (parent_priv->spatial_index != NULL)
+        _clutter_spatial_index_invalidate (parent_priv->spatial_index, iter);
+
+      parent_priv->paint_volume_cached = FALSE;
+    }
+}
+
+/*< private >
+ * clutter_actor_invalidate_paint_volume:
+ * @self: a #ClutterActor
+ *
+ * Invalidates the cached paint volume of @self, and the ones of all
+ * its ancestors.
+ *
+ * We cannot know when the paint volume of an actor changes, but an
+ * actor is required to queue a redraw when its appearance changes,
+ * so this is called when a redraw is queued, as well as when the
+ * allocation changes.
+ */
+static void
+clutter_actor_invalidate_paint_volume (ClutterActor *self)
+{
+  self->priv->paint_volume_cached = FALSE;
+
+  clutter_actor_invalidate_parent_volume (self);
+}
+
+/* invalidates the union of the children of @self, when the list of
+ * children changes
+ */
+static void
+clutter_actor_invalidate_children_volume (ClutterActor *self)
+{
+  ClutterChildrenVolume *cv = self->priv->children_volume;
+
+  if (cv != NULL)
+    {
+      cv->is_valid = FALSE;
+      cv->dirty_child = NULL;
+    }
+
+  clutter_actor_invalidate_paint_volume (self);
+}
+
+static void
+clutter_actor_ensure_spatial_index_order (ClutterActor *self)
+{
+  ClutterActorPrivate *priv = self->priv;
+  guint i;
+
+  if (priv->spatial_index_order_valid)
+    return;
+
+  for (i = 0; i < priv->child_array->len; i++)
+    _clutter_spatial_index_set_order (priv->spatial_index,
+                                      g_ptr_array_index (priv->child_array, i),
+                                      i);
+
+  priv->spatial_index_order_valid = TRUE;
+}
+
 static inline void
 remove_child (ClutterActor *self,
               ClutterActor *child)
 {
   ClutterActor *prev_sibling, *next_sibling;
 
+  child_array_remove (self, child);
+
   prev_sibling = child->priv->prev_sibling;
   next_sibling = child->priv->next_sibling;
 
@@ -4141,6 +5131,8 @@ remove_child (ClutterActor *self,
   if (self->priv->last_child == child)
     self->priv->last_child = prev_sibling;
 
+  clutter_actor_invalidate_stage_transform (child);
+
   child->priv->parent = NULL;
   child->priv->prev_sibling = NULL;
   child->priv->next_sibling = NULL;
@@ -4262,6 +5254,14 @@ clutter_actor_remove_child_internal (ClutterActor                 *self,
 
   self->priv->n_children -= 1;
 
+  /* no children are always sorted */
+  if (self->priv->n_children == 0)
+    self->priv->children_depth_unsorted = FALSE;
+
+  child->priv->parent_volume_box_valid = FALSE;
+  child->priv->parent_volume_invalidated = FALSE;
+  clutter_actor_invalidate_children_volume (self);
+
   self->priv->age += 1;
 
   /* if the child that got removed was visible and set to
@@ -4328,6 +5328,15 @@ static const ClutterTransformInfo default_transform_info = {
   FALSE,                        /* child-transform */
 };
 
+/* whether @info is the structure used by actors that never had any
+ * of their transformation properties set
+ */
+static gboolean
+clutter_transform_info_is_default (const ClutterTransformInfo *info)
+{
+  return info == &default_transform_info;
+}
+
 /*< private >
  * _clutter_actor_get_transform_info_or_defaults:
  * @self: a #ClutterActor
@@ -4406,7 +5415,7 @@ clutter_actor_set_pivot_point_internal (ClutterActor       *self,
   info = _clutter_actor_get_transform_info (self);
   info->pivot = *pivot;
 
-  self->priv->transform_valid = FALSE;
+  clutter_actor_invalidate_transform (self);
 
   g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_PIVOT_POINT]);
 
@@ -4422,7 +5431,7 @@ clutter_actor_set_pivot_point_z_internal (ClutterActor *self,
   info = _clutter_actor_get_transform_info (self);
   info->pivot_z = pivot_z;
 
-  self->priv->transform_valid = FALSE;
+  clutter_actor_invalidate_transform (self);
 
   g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_PIVOT_POINT_Z]);
 
@@ -4456,7 +5465,7 @@ clutter_actor_set_translation_internal (ClutterActor *self,
   else
     g_assert_not_reached ();
 
-  self->priv->transform_valid = FALSE;
+  clutter_actor_invalidate_transform (self);
   clutter_actor_queue_redraw (self);
   g_object_notify_by_pspec (obj, pspec);
 }
@@ -4588,7 +5597,7 @@ clutter_actor_set_rotation_angle_internal (ClutterActor *self,
   else
     g_assert_not_reached ();
 
-  self->priv->transform_valid = FALSE;
+  clutter_actor_invalidate_transform (self);
 
   clutter_actor_queue_redraw (self);
 
@@ -4744,7 +5753,7 @@ clutter_actor_set_rotation_center_internal (ClutterActor        *self,
       break;
     }
 
-  self->priv->transform_valid = FALSE;
+  clutter_actor_invalidate_transform (self);
 
   g_object_thaw_notify (obj);
 
@@ -4770,7 +5779,7 @@ clutter_actor_set_scale_factor_internal (ClutterActor *self,
   else
     g_assert_not_reached ();
 
-  self->priv->transform_valid = FALSE;
+  clutter_actor_invalidate_transform (self);
   clutter_actor_queue_redraw (self);
   g_object_notify_by_pspec (obj, pspec);
 }
@@ -4851,7 +5860,7 @@ clutter_actor_set_scale_center (ClutterActor      *self,
       g_assert_not_reached ();
     }
 
-  self->priv->transform_valid = FALSE;
+  clutter_actor_invalidate_transform (self);
 
   clutter_actor_queue_redraw (self);
 
@@ -4873,7 +5882,7 @@ clutter_actor_set_scale_gravity (ClutterActor   *self,
   else
     clutter_anchor_coord_set_gravity (&info->scale_center, gravity);
 
-  self->priv->transform_valid = FALSE;
+  clutter_actor_invalidate_transform (self);
 
   g_object_notify_by_pspec (obj, obj_props[PROP_SCALE_CENTER_X]);
   g_object_notify_by_pspec (obj, obj_props[PROP_SCALE_CENTER_Y]);
@@ -4926,7 +5935,7 @@ clutter_actor_set_anchor_coord (ClutterActor      *self,
       g_assert_not_reached ();
     }
 
-  self->priv->transform_valid = FALSE;
+  clutter_actor_invalidate_transform (self);
 
   clutter_actor_queue_redraw (self);
 
@@ -5052,6 +6061,10 @@ clutter_actor_set_property (GObject      *object,
       clutter_actor_set_request_mode (actor, g_value_get_enum (value));
       break;
 
+    case PROP_ISOLATE_LAYOUT:
+      clutter_actor_set_isolate_layout (actor, g_value_get_boolean (value));
+      break;
+
     case PROP_DEPTH: /* XXX:2.0 - remove */
       clutter_actor_set_depth (actor, g_value_get_float (value));
       break;
@@ -5300,12 +6313,12 @@ clutter_actor_set_property (GObject      *object,
     case PROP_MINIFICATION_FILTER:
       clutter_actor_set_content_scaling_filters (actor,
                                                  g_value_get_enum (value),
-                                                 actor->priv->mag_filter);
+                                                 clutter_actor_get_content_info_or_defaults (actor)->mag_filter);
       break;
 
     case PROP_MAGNIFICATION_FILTER:
       clutter_actor_set_content_scaling_filters (actor,
-                                                 actor->priv->min_filter,
+                                                 clutter_actor_get_content_info_or_defaults (actor)->min_filter,
                                                  g_value_get_enum (value));
       break;
 
@@ -5446,6 +6459,10 @@ clutter_actor_get_property (GObject    *object,
       g_value_set_enum (value, priv->request_mode);
       break;
 
+    case PROP_ISOLATE_LAYOUT:
+      g_value_set_boolean (value, priv->isolate_layout);
+      break;
+
     case PROP_ALLOCATION:
       g_value_set_boxed (value, &priv->allocation);
       break;
@@ -5854,7 +6871,7 @@ clutter_actor_get_property (GObject    *object,
       break;
 
     case PROP_CONTENT_GRAVITY:
-      g_value_set_enum (value, priv->content_gravity);
+      g_value_set_enum (value, clutter_actor_get_content_gravity (actor));
       break;
 
     case PROP_CONTENT_BOX:
@@ -5867,15 +6884,15 @@ clutter_actor_get_property (GObject    *object,
       break;
 
     case PROP_MINIFICATION_FILTER:
-      g_value_set_enum (value, priv->min_filter);
+      g_value_set_enum (value, clutter_actor_get_content_info_or_defaults (actor)->min_filter);
       break;
 
     case PROP_MAGNIFICATION_FILTER:
-      g_value_set_enum (value, priv->mag_filter);
+      g_value_set_enum (value, clutter_actor_get_content_info_or_defaults (actor)->mag_filter);
       break;
 
     case PROP_CONTENT_REPEAT:
-      g_value_set_flags (value, priv->content_repeat);
+      g_value_set_flags (value, clutter_actor_get_content_repeat (actor));
       break;
 
     default:
@@ -5918,6 +6935,15 @@ clutter_actor_dispose (GObject *object)
   /* parent must be gone at this point */
   g_assert (priv->parent == NULL);
 
+  /* the stage does not hold a reference on the actors with a pending
+   * redraw, so we need to make sure that it won't find us later
+   */
+  if (priv->queue_redraw_entry != NULL)
+    {
+      _clutter_stage_queue_redraw_entry_invalidate (priv->queue_redraw_entry);
+      priv->queue_redraw_entry = NULL;
+    }
+
   if (!CLUTTER_ACTOR_IS_TOPLEVEL (self))
     {
       /* can't be mapped or realized with no parent */
@@ -5931,17 +6957,7 @@ clutter_actor_dispose (GObject *object)
   g_clear_object (&priv->effects);
   g_clear_object (&priv->flatten_effect);
 
-  if (priv->child_model != NULL)
-    {
-      if (priv->create_child_notify != NULL)
-        priv->create_child_notify (priv->create_child_data);
-
-      priv->create_child_func = NULL;
-      priv->create_child_data = NULL;
-      priv->create_child_notify = NULL;
-
-      g_clear_object (&priv->child_model);
-    }
+  clutter_actor_unbind_model_internal (self);
 
   if (priv->layout_manager != NULL)
     {
@@ -5975,6 +6991,23 @@ clutter_actor_finalize (GObject *object)
 
   g_free (priv->name);
 
+  child_array_clear (CLUTTER_ACTOR (object));
+
+  if (priv->children_volume != NULL)
+    g_slice_free (ClutterChildrenVolume, priv->children_volume);
+
+  if (priv->stage_transform != NULL)
+    g_slice_free (ClutterStageTransform, priv->stage_transform);
+
+  if (priv->transform != NULL)
+    g_slice_free (CoglMatrix, priv->transform);
+
+  if (priv->volumes != NULL)
+    g_slice_free (ClutterActorVolumes, priv->volumes);
+
+  if (priv->size_requests != NULL)
+    g_slice_free (ClutterSizeRequestCache, priv->size_requests);
+
 #ifdef CLUTTER_ENABLE_DEBUG
   g_free (priv->debug_name);
 #endif
@@ -6007,31 +7040,229 @@ clutter_actor_get_accessible (ClutterActor *self)
 {
   g_return_val_if_fail (CLUTTER_IS_ACTOR (self), NULL);
 
-  return CLUTTER_ACTOR_GET_CLASS (self)->get_accessible (self);
-}
+  return CLUTTER_ACTOR_GET_CLASS (self)->get_accessible (self);
+}
+
+static AtkObject *
+clutter_actor_real_get_accessible (ClutterActor *actor)
+{
+  return atk_gobject_accessible_for_object (G_OBJECT (actor));
+}
+
+static AtkObject *
+_clutter_actor_ref_accessible (AtkImplementor *implementor)
+{
+  AtkObject *accessible;
+
+  accessible = clutter_actor_get_accessible (CLUTTER_ACTOR (implementor));
+  if (accessible != NULL)
+    g_object_ref (accessible);
+
+  return accessible;
+}
+
+static void
+atk_implementor_iface_init (AtkImplementorIface *iface)
+{
+  iface->ref_accessible = _clutter_actor_ref_accessible;
+}
+
+static inline void
+volume_box_union (VolumeBox       *box,
+                  const VolumeBox *other)
+{
+  box->x1 = MIN (box->x1, other->x1);
+  box->y1 = MIN (box->y1, other->y1);
+  box->z1 = MIN (box->z1, other->z1);
+  box->x2 = MAX (box->x2, other->x2);
+  box->y2 = MAX (box->y2, other->y2);
+  box->z2 = MAX (box->z2, other->z2);
+}
+
+/* checks whether @inner touches the faces of @outer, i.e. whether the
+ * union could shrink without it; if @outer is flat then all the boxes
+ * inside it have the same depth, and we can ignore the z axis
+ */
+static inline gboolean
+volume_box_touches_faces (const VolumeBox *outer,
+                          const VolumeBox *inner)
+{
+  if (inner->x1 <= outer->x1 || inner->x2 >= outer->x2 ||
+      inner->y1 <= outer->y1 || inner->y2 >= outer->y2)
+    return TRUE;
+
+  if (outer->z1 < outer->z2 &&
+      (inner->z1 <= outer->z1 || inner->z2 >= outer->z2))
+    return TRUE;
+
+  return FALSE;
+}
+
+/* updates the bounding box of the paint volume of @child in the
+ * coordinate space of @parent, if needed
+ */
+static VolumeBoxState
+clutter_actor_update_parent_volume_box (ClutterActor *child,
+                                        ClutterActor *parent)
+{
+  ClutterActorPrivate *priv = child->priv;
+  const ClutterPaintVolume *child_volume;
+  ClutterPaintVolume pv;
+
+  if (priv->parent_volume_box_valid)
+    return priv->parent_volume_box_state;
+
+  priv->parent_volume_invalidated = FALSE;
+
+  /* the paint volume of an actor with handlers connected to the paint
+   * signal is unknown, and we cannot know when the handlers go away;
+   * we don't cache the box of such children, so that the union is not
+   * cached either
+   */
+  if (g_signal_has_handler_pending (child, actor_signals[PAINT], 0, TRUE))
+    {
+      priv->parent_volume_box_state = VOLUME_BOX_UNKNOWN;
+      return VOLUME_BOX_UNKNOWN;
+    }
+
+  priv->parent_volume_box_valid = TRUE;
+
+  /* we ignore unmapped children, since they won't be painted.
+   *
+   * XXX: we also have to ignore mapped children without a valid
+   * allocation, because apparently some code above Clutter allows
+   * them.
+   */
+  if (!CLUTTER_ACTOR_IS_MAPPED (child) || !clutter_actor_has_allocation (child))
+    {
+      priv->parent_volume_box_state = VOLUME_BOX_SKIP;
+      return VOLUME_BOX_SKIP;
+    }
+
+  child_volume = clutter_actor_get_paint_volume (child);
+  if (child_volume == NULL)
+    {
+      priv->parent_volume_box_state = VOLUME_BOX_UNKNOWN;
+      return VOLUME_BOX_UNKNOWN;
+    }
+
+  if (child_volume->is_empty)
+    {
+      priv->parent_volume_box_state = VOLUME_BOX_SKIP;
+      return VOLUME_BOX_SKIP;
+    }
+
+  _clutter_paint_volume_copy_static (child_volume, &pv);
+  _clutter_paint_volume_transform_relative (&pv, parent);
+  _clutter_paint_volume_axis_align (&pv);
+
+  priv->parent_volume_box.x1 = pv.vertices[0].x;
+  priv->parent_volume_box.y1 = pv.vertices[0].y;
+  priv->parent_volume_box.z1 = pv.vertices[0].z;
+  priv->parent_volume_box.x2 = pv.vertices[1].x;
+  priv->parent_volume_box.y2 = pv.vertices[3].y;
+  priv->parent_volume_box.z2 = pv.vertices[4].z;
+
+  clutter_paint_volume_free (&pv);
+
+  priv->parent_volume_box_state = VOLUME_BOX_SET;
+
+  return VOLUME_BOX_SET;
+}
+
+/*< private >
+ * clutter_actor_update_children_volume:
+ * @self: a #ClutterActor
+ *
+ * Updates the union of the bounding boxes of the children of @self,
+ * in the coordinate space of @self.
+ *
+ * Each child caches its own box, so the union only needs to query the
+ * paint volume of the children that changed. If a single child changed
+ * since the last update then the union is updated incrementally, unless
+ * the old box of the child was on the boundary of the union, in which
+ * case the union might shrink and it is recomputed from the cached
+ * boxes of the children.
+ *
+ * Return value: %FALSE if any of the children does not have a paint
+ *   volume
+ */
+static gboolean
+clutter_actor_update_children_volume (ClutterActor *self)
+{
+  ClutterActorPrivate *priv = self->priv;
+  ClutterChildrenVolume *cv;
+  ClutterActor *child;
+
+  if (priv->children_volume == NULL)
+    priv->children_volume = g_slice_new0 (ClutterChildrenVolume);
+
+  cv = priv->children_volume;
+
+  if (cv->is_valid && cv->dirty_child != NULL)
+    {
+      VolumeBoxState old_state, new_state;
+      VolumeBox old_box;
+
+      child = cv->dirty_child;
+      cv->dirty_child = NULL;
 
-static AtkObject *
-clutter_actor_real_get_accessible (ClutterActor *actor)
-{
-  return atk_gobject_accessible_for_object (G_OBJECT (actor));
-}
+      old_state = child->priv->parent_volume_box_state;
+      old_box = child->priv->parent_volume_box;
 
-static AtkObject *
-_clutter_actor_ref_accessible (AtkImplementor *implementor)
-{
-  AtkObject *accessible;
+      new_state = clutter_actor_update_parent_volume_box (child, self);
+      if (new_state == VOLUME_BOX_UNKNOWN)
+        {
+          cv->is_valid = FALSE;
+          return FALSE;
+        }
 
-  accessible = clutter_actor_get_accessible (CLUTTER_ACTOR (implementor));
-  if (accessible != NULL)
-    g_object_ref (accessible);
+      if (old_state == VOLUME_BOX_SET && !cv->is_empty &&
+          volume_box_touches_faces (&cv->box, &old_box))
+        {
+          cv->is_valid = FALSE;
+        }
+      else if (new_state == VOLUME_BOX_SET)
+        {
+          if (cv->is_empty)
+            cv->box = child->priv->parent_volume_box;
+          else
+            volume_box_union (&cv->box, &child->priv->parent_volume_box);
 
-  return accessible;
-}
+          cv->is_empty = FALSE;
+        }
+    }
 
-static void
-atk_implementor_iface_init (AtkImplementorIface *iface)
-{
-  iface->ref_accessible = _clutter_actor_ref_accessible;
+  if (cv->is_valid)
+    return TRUE;
+
+  cv->is_empty = TRUE;
+  cv->dirty_child = NULL;
+
+  for (child = priv->first_child;
+       child != NULL;
+       child = child->priv->next_sibling)
+    {
+      VolumeBoxState state;
+
+      state = clutter_actor_update_parent_volume_box (child, self);
+      if (state == VOLUME_BOX_UNKNOWN)
+        return FALSE;
+
+      if (state != VOLUME_BOX_SET)
+        continue;
+
+      if (cv->is_empty)
+        cv->box = child->priv->parent_volume_box;
+      else
+        volume_box_union (&cv->box, &child->priv->parent_volume_box);
+
+      cv->is_empty = FALSE;
+    }
+
+  cv->is_valid = TRUE;
+
+  return TRUE;
 }
 
 static gboolean
@@ -6066,7 +7297,7 @@ clutter_actor_update_default_paint_volume (ClutterActor       *self,
     }
   else
     {
-      ClutterActor *child;
+      ClutterChildrenVolume *cv;
 
       if (priv->has_clip &&
           priv->clip.size.width >= 0 &&
@@ -6089,35 +7320,35 @@ clutter_actor_update_default_paint_volume (ClutterActor       *self,
       if (priv->n_children == 0)
         return res;
 
-      /* ...but if we have children then we ask for their paint volume in
-       * our coordinates. if any of our children replies that it doesn't
-       * have a paint volume, we bail out
+      /* ...but if we have children then we need the union of their
+       * paint volumes in our coordinates. if any of our children replies
+       * that it doesn't have a paint volume, we bail out
        */
-      for (child = priv->first_child;
-           child != NULL;
-           child = child->priv->next_sibling)
+      if (!clutter_actor_update_children_volume (self))
+        return FALSE;
+
+      cv = priv->children_volume;
+      if (!cv->is_empty)
         {
-          const ClutterPaintVolume *child_volume;
+          ClutterPaintVolume children_volume;
+          ClutterVertex origin;
 
-          /* we ignore unmapped children, since they won't be painted.
-           *
-           * XXX: we also have to ignore mapped children without a valid
-           * allocation, because apparently some code above Clutter allows
-           * them.
-           */
-          if (!CLUTTER_ACTOR_IS_MAPPED (child) || !clutter_actor_has_allocation (child))
-            continue;
+          _clutter_paint_volume_init_static (&children_volume, self);
 
-          child_volume = clutter_actor_get_transformed_paint_volume (child, self);
-          if (child_volume == NULL)
-            {
-              res = FALSE;
-              break;
-            }
+          origin.x = cv->box.x1;
+          origin.y = cv->box.y1;
+          origin.z = cv->box.z1;
+          clutter_paint_volume_set_origin (&children_volume, &origin);
+          clutter_paint_volume_set_width (&children_volume, cv->box.x2 - cv->box.x1);
+          clutter_paint_volume_set_height (&children_volume, cv->box.y2 - cv->box.y1);
+          clutter_paint_volume_set_depth (&children_volume, cv->box.z2 - cv->box.z1);
 
-          clutter_paint_volume_union (volume, child_volume);
-          res = TRUE;
+          clutter_paint_volume_union (volume, &children_volume);
+
+          clutter_paint_volume_free (&children_volume);
         }
+
+      res = TRUE;
     }
 
   return res;
@@ -6267,6 +7498,8 @@ clutter_actor_class_init (ClutterActorClass *klass)
   quark_actor_layout_info = g_quark_from_static_string ("-clutter-actor-layout-info");
   quark_actor_transform_info = g_quark_from_static_string ("-clutter-actor-transform-info");
   quark_actor_animation_info = g_quark_from_static_string ("-clutter-actor-animation-info");
+  quark_actor_content_info = g_quark_from_static_string ("-clutter-actor-content-info");
+  quark_actor_model_binding = g_quark_from_static_string ("-clutter-actor-model-binding");
 
   object_class->constructor = clutter_actor_constructor;
   object_class->set_property = clutter_actor_set_property;
@@ -6687,6 +7920,23 @@ clutter_actor_class_init (ClutterActorClass *klass)
                        CLUTTER_REQUEST_HEIGHT_FOR_WIDTH,
                        CLUTTER_PARAM_READWRITE);
 
+  /**
+   * ClutterActor:isolate-layout:
+   *
+   * Whether the layout of the children of the actor is isolated from
+   * the rest of the scene graph.
+   *
+   * See clutter_actor_set_isolate_layout().
+   *
+   * Since: 1.28
+   */
+  obj_props[PROP_ISOLATE_LAYOUT] =
+    g_param_spec_boolean ("isolate-layout",
+                          P_("Isolate Layout"),
+                          P_("Whether changes in the layout of the children are kept inside the actor"),
+                          FALSE,
+                          CLUTTER_PARAM_READWRITE);
+
   /**
    * ClutterActor:depth:
    *
@@ -8498,26 +9748,14 @@ clutter_actor_init (ClutterActor *self)
   priv->needs_height_request = TRUE;
   priv->needs_allocation = TRUE;
 
-  priv->cached_width_age = 1;
-  priv->cached_height_age = 1;
-
   priv->opacity_override = -1;
   priv->enable_model_view_transform = TRUE;
 
-  /* Initialize an empty paint volume to start with */
-  _clutter_paint_volume_init_static (&priv->last_paint_volume, NULL);
+  /* Start with an empty paint volume; see clutter_actor_get_volumes() */
   priv->last_paint_volume_valid = TRUE;
 
   priv->transform_valid = FALSE;
 
-  /* the default is to stretch the content, to match the
-   * current behaviour of basically all actors. also, it's
-   * the easiest thing to compute.
-   */
-  priv->content_gravity = CLUTTER_CONTENT_GRAVITY_RESIZE_FILL;
-  priv->min_filter = CLUTTER_SCALING_FILTER_LINEAR;
-  priv->mag_filter = CLUTTER_SCALING_FILTER_LINEAR;
-
   /* this flag will be set to TRUE if the actor gets a child
    * or if the [xy]-expand flags are explicitly set; until
    * then, the actor does not need to expand.
@@ -8630,7 +9868,7 @@ _clutter_actor_finish_queue_redraw (ClutterActor *self,
 
           /* make sure we redraw the actors old position... */
           _clutter_actor_set_queue_redraw_clip (stage,
-                                                &priv->last_paint_volume);
+                                                &clutter_actor_get_volumes (self)->last_paint_volume);
           _clutter_actor_signal_queue_redraw (stage, stage);
           _clutter_actor_set_queue_redraw_clip (stage, NULL);
 
@@ -8774,6 +10012,19 @@ _clutter_actor_queue_redraw_full (ClutterActor       *self,
   if (CLUTTER_ACTOR_IN_DESTRUCTION (self))
     return;
 
+  /* the paint volume of the actor, and of its parents, may have
+   * changed; we need to do this before the checks below, as the
+   * actor may be hidden, but still indexed
+   */
+  clutter_actor_invalidate_paint_volume (self);
+
+  /* if the stage has an update in progress, the redraw is queued when
+   * the update ends; the clip and the effect are not kept, so the whole
+   * actor is redrawn then
+   */
+  if (_clutter_stage_defer_actor_update (self, CLUTTER_STAGE_UPDATE_REDRAW))
+    return;
+
   /* we can ignore unmapped actors, unless they have at least one
    * mapped clone or they are inside a cloned branch of the scene
    * graph, as unmapped actors will simply be left unpainted.
@@ -8913,6 +10164,9 @@ _clutter_actor_queue_redraw_full (ClutterActor       *self,
  * Also be aware that painting is a NOP for actors with an opacity of
  * 0
  *
+ * If the stage of @self has an update in progress, the redraw is
+ * deferred until the update ends; see clutter_stage_begin_update().
+ *
  * When you are implementing a custom actor you must queue a redraw
  * whenever some private state changes that will affect painting or
  * picking of your actor.
@@ -9057,6 +10311,9 @@ clutter_actor_queue_redraw_with_clip (ClutterActor                *self,
  *
  * Queueing a new layout automatically queues a redraw as well.
  *
+ * If the stage of @self has an update in progress, the relayout is
+ * deferred until the update ends; see clutter_stage_begin_update().
+ *
  * Since: 0.8
  */
 void
@@ -9064,6 +10321,9 @@ clutter_actor_queue_relayout (ClutterActor *self)
 {
   g_return_if_fail (CLUTTER_IS_ACTOR (self));
 
+  if (_clutter_stage_defer_actor_update (self, CLUTTER_STAGE_UPDATE_RELAYOUT))
+    return;
+
   _clutter_actor_queue_only_relayout (self);
   clutter_actor_queue_redraw (self);
 }
@@ -9438,6 +10698,24 @@ clutter_actor_update_preferred_size_for_constraints (ClutterActor *self,
     }
 }
 
+/* Retrieves the cache of the size requests of the actor, allocating
+ * it if needed; actors with a fixed size never need it
+ */
+static ClutterSizeRequestCache *
+clutter_actor_get_size_request_cache (ClutterActor *self)
+{
+  ClutterActorPrivate *priv = self->priv;
+
+  if (priv->size_requests == NULL)
+    {
+      priv->size_requests = g_slice_new0 (ClutterSizeRequestCache);
+      priv->size_requests->cached_width_age = 1;
+      priv->size_requests->cached_height_age = 1;
+    }
+
+  return priv->size_requests;
+}
+
 /**
  * clutter_actor_get_preferred_width:
  * @self: A #ClutterActor
@@ -9467,6 +10745,7 @@ clutter_actor_get_preferred_width (ClutterActor *self,
                                    gfloat       *natural_width_p)
 {
   float request_min_width, request_natural_width;
+  ClutterSizeRequestCache *cache;
   SizeRequest *cached_size_request;
   const ClutterLayoutInfo *info;
   ClutterActorPrivate *priv;
@@ -9500,18 +10779,20 @@ clutter_actor_get_preferred_width (ClutterActor *self,
    * the *_set flags.
    */
 
+  cache = clutter_actor_get_size_request_cache (self);
+
   if (!priv->needs_width_request)
     {
       found_in_cache =
         _clutter_actor_get_cached_size_request (for_height,
-                                                priv->width_requests,
+                                                cache->width_requests,
                                                 &cached_size_request);
     }
   else
     {
       /* if the actor needs a width request we use the first slot */
       found_in_cache = FALSE;
-      cached_size_request = &priv->width_requests[0];
+      cached_size_request = &cache->width_requests[0];
     }
 
   if (!found_in_cache)
@@ -9556,9 +10837,9 @@ clutter_actor_get_preferred_width (ClutterActor *self,
       cached_size_request->min_size = minimum_width;
       cached_size_request->natural_size = natural_width;
       cached_size_request->for_size = for_height;
-      cached_size_request->age = priv->cached_width_age;
+      cached_size_request->age = cache->cached_width_age;
 
-      priv->cached_width_age += 1;
+      cache->cached_width_age += 1;
       priv->needs_width_request = FALSE;
     }
 
@@ -9611,6 +10892,7 @@ clutter_actor_get_preferred_height (ClutterActor *self,
                                     gfloat       *natural_height_p)
 {
   float request_min_height, request_natural_height;
+  ClutterSizeRequestCache *cache;
   SizeRequest *cached_size_request;
   const ClutterLayoutInfo *info;
   ClutterActorPrivate *priv;
@@ -9644,17 +10926,19 @@ clutter_actor_get_preferred_height (ClutterActor *self,
    * the *_set flags.
    */
 
+  cache = clutter_actor_get_size_request_cache (self);
+
   if (!priv->needs_height_request)
     {
       found_in_cache =
         _clutter_actor_get_cached_size_request (for_width,
-                                                priv->height_requests,
+                                                cache->height_requests,
                                                 &cached_size_request);
     }
   else
     {
       found_in_cache = FALSE;
-      cached_size_request = &priv->height_requests[0];
+      cached_size_request = &cache->height_requests[0];
     }
 
   if (!found_in_cache)
@@ -9699,9 +10983,9 @@ clutter_actor_get_preferred_height (ClutterActor *self,
       cached_size_request->min_size = minimum_height;
       cached_size_request->natural_size = natural_height;
       cached_size_request->for_size = for_width;
-      cached_size_request->age = priv->cached_height_age;
+      cached_size_request->age = cache->cached_height_age;
 
-      priv->cached_height_age += 1;
+      cache->cached_height_age += 1;
       priv->needs_height_request = FALSE;
     }
 
@@ -10090,6 +11374,48 @@ clutter_actor_allocate (ClutterActor           *self,
                                     &real_allocation);
 }
 
+/*< private >
+ * _clutter_actor_allocate_boundary:
+ * @self: a #ClutterActor
+ *
+ * Allocates the children of @self using its current allocation; this
+ * is used by the stage to process the relayouts queued inside an actor
+ * with the #ClutterActor:isolate-layout property set.
+ *
+ * This function does nothing if the allocation of @self is not dirty,
+ * e.g. because the parent of @self has already allocated it.
+ */
+void
+_clutter_actor_allocate_boundary (ClutterActor *self)
+{
+  ClutterActorPrivate *priv = self->priv;
+  ClutterActorBox box;
+
+  if (!priv->needs_allocation)
+    return;
+
+  if (CLUTTER_ACTOR_IN_DESTRUCTION (self))
+    return;
+
+  /* hidden actors are not allocated by their parent either; showing
+   * the actor will queue a relayout anyway
+   */
+  if (!CLUTTER_ACTOR_IS_VISIBLE (self))
+    return;
+
+  if (_clutter_actor_get_stage_internal (self) == NULL)
+    return;
+
+  CLUTTER_NOTE (LAYOUT, "Allocating the children of '%s'",
+                _clutter_actor_get_debug_name (self));
+
+  /* the allocation has already been adjusted for the constraints, the
+   * alignment and the margins, so we bypass clutter_actor_allocate()
+   */
+  box = priv->allocation;
+  clutter_actor_allocate_internal (self, &box, CLUTTER_ALLOCATION_NONE);
+}
+
 /**
  * clutter_actor_set_allocation:
  * @self: a #ClutterActor
@@ -10622,6 +11948,68 @@ clutter_actor_get_request_mode (ClutterActor *self)
   return self->priv->request_mode;
 }
 
+/**
+ * clutter_actor_set_isolate_layout:
+ * @self: a #ClutterActor
+ * @isolate: %TRUE to isolate the layout of the children of @self
+ *
+ * Sets whether the layout of the children of @self should be isolated
+ * from the rest of the scene graph.
+ *
+ * By default, a relayout queued by an actor goes all the way up to the
+ * stage, and the whole scene graph is allocated again from the top. If
+ * the layout is isolated, and @self has a fixed size set using
+ * clutter_actor_set_size() or equivalent functions, a relayout queued
+ * by one of the children of @self stops at @self, and only the children
+ * of @self are allocated again, using the current allocation of @self.
+ *
+ * This is useful for containers whose size does not depend on their
+ * children, like the panels of a dashboard, as changing the contents of
+ * one of them will not cause the other ones to be allocated.
+ *
+ * The layout is not isolated while @self does not have a fixed size,
+ * or while the expand flags of @self need to be computed again.
+ *
+ * Since: 1.28
+ */
+void
+clutter_actor_set_isolate_layout (ClutterActor *self,
+                                  gboolean      isolate)
+{
+  ClutterActorPrivate *priv;
+
+  g_return_if_fail (CLUTTER_IS_ACTOR (self));
+
+  priv = self->priv;
+
+  isolate = !!isolate;
+
+  if (priv->isolate_layout == isolate)
+    return;
+
+  priv->isolate_layout = isolate;
+
+  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_ISOLATE_LAYOUT]);
+}
+
+/**
+ * clutter_actor_get_isolate_layout:
+ * @self: a #ClutterActor
+ *
+ * Retrieves the value set using clutter_actor_set_isolate_layout().
+ *
+ * Return value: %TRUE if the layout of the children of @self is isolated
+ *
+ * Since: 1.28
+ */
+gboolean
+clutter_actor_get_isolate_layout (ClutterActor *self)
+{
+  g_return_val_if_fail (CLUTTER_IS_ACTOR (self), FALSE);
+
+  return self->priv->isolate_layout;
+}
+
 /* variant of set_width() without checks and without notification
  * freeze+thaw, for internal usage only
  */
@@ -10749,6 +12137,70 @@ clutter_actor_set_size (ClutterActor *self,
     }
 }
 
+/**
+ * clutter_actor_set_geometry_bulk:
+ * @actors: (array length=n_actors): an array of #ClutterActor<!-- -->s
+ * @geometries: (array length=n_actors): an array of #ClutterRect<!-- -->s,
+ *   with the position and size of each actor in @actors
+ * @n_actors: the number of actors
+ *
+ * Sets the position and the size of multiple actors at once.
+ *
+ * This function is the equivalent of calling clutter_actor_set_position()
+ * and clutter_actor_set_size() on each actor in @actors, but the changes
+ * are applied inside an update of the stage of each actor, so that the
+ * notifications, relayouts and redraws are coalesced; see
+ * clutter_stage_begin_update().
+ *
+ * Since: 1.28
+ */
+void
+clutter_actor_set_geometry_bulk (ClutterActor * const *actors,
+                                 const ClutterRect    *geometries,
+                                 guint                 n_actors)
+{
+  ClutterActor *stage = NULL;
+  guint i;
+
+  g_return_if_fail (n_actors == 0 || actors != NULL);
+  g_return_if_fail (n_actors == 0 || geometries != NULL);
+
+  for (i = 0; i < n_actors; i++)
+    g_return_if_fail (CLUTTER_IS_ACTOR (actors[i]));
+
+  for (i = 0; i < n_actors; i++)
+    {
+      ClutterActor *actor = actors[i];
+      const ClutterRect *geometry = &geometries[i];
+      ClutterActor *actor_stage;
+
+      /* actors are usually siblings, so we only switch updates when
+       * the stage changes
+       */
+      actor_stage = _clutter_actor_get_stage_internal (actor);
+      if (actor_stage != stage)
+        {
+          if (stage != NULL)
+            clutter_stage_end_update (CLUTTER_STAGE (stage));
+
+          stage = actor_stage;
+
+          if (stage != NULL)
+            clutter_stage_begin_update (CLUTTER_STAGE (stage));
+        }
+
+      g_object_freeze_notify (G_OBJECT (actor));
+
+      clutter_actor_set_position (actor, geometry->origin.x, geometry->origin.y);
+      clutter_actor_set_size (actor, geometry->size.width, geometry->size.height);
+
+      g_object_thaw_notify (G_OBJECT (actor));
+    }
+
+  if (stage != NULL)
+    clutter_stage_end_update (CLUTTER_STAGE (stage));
+}
+
 /**
  * clutter_actor_get_size:
  * @self: A #ClutterActor
@@ -11927,7 +13379,8 @@ clutter_actor_set_depth_internal (ClutterActor *self,
       /* Sets Z value - XXX 2.0: should we invert? */
       info->z_position = depth;
 
-      self->priv->transform_valid = FALSE;
+      clutter_actor_invalidate_transform (self);
+      clutter_actor_check_child_depth_order (self);
 
       /* FIXME - remove this crap; sadly, there are still containers
        * in Clutter that depend on this utter brain damage
@@ -11952,7 +13405,8 @@ clutter_actor_set_z_position_internal (ClutterActor *self,
     {
       info->z_position = z_position;
 
-      self->priv->transform_valid = FALSE;
+      clutter_actor_invalidate_transform (self);
+      clutter_actor_check_child_depth_order (self);
 
       clutter_actor_queue_redraw (self);
 
@@ -12504,6 +13958,89 @@ clutter_actor_get_children (ClutterActor *self)
   return res;
 }
 
+/**
+ * clutter_actor_get_children_in_rect:
+ * @self: a #ClutterActor
+ * @rect: a #ClutterRect, in the coordinate space of @self
+ *
+ * Retrieves the children of @self whose paint volume or allocation,
+ * transformed in the coordinate space of @self, intersects @rect.
+ *
+ * Hidden children, and children that do not have a paint volume, are
+ * never returned.
+ *
+ * For actors with a large number of children this function uses the
+ * same spatial index that is used to avoid painting and picking the
+ * children that are outside of the visible area of the stage, and it
+ * is faster than iterating over all the children.
+ *
+ * Return value: (transfer container) (element-type ClutterActor): A newly
+ *   allocated #GList of #ClutterActor<!-- -->s, in paint order. Use
+ *   g_list_free() when done.
+ *
+ * Since: 1.28
+ */
+GList *
+clutter_actor_get_children_in_rect (ClutterActor      *self,
+                                    const ClutterRect *rect)
+{
+  ClutterActorPrivate *priv;
+  ClutterActorBox query;
+  ClutterRect r;
+  GList *res = NULL;
+
+  g_return_val_if_fail (CLUTTER_IS_ACTOR (self), NULL);
+  g_return_val_if_fail (rect != NULL, NULL);
+
+  priv = self->priv;
+
+  r = *rect;
+  clutter_rect_normalize (&r);
+
+  query.x1 = r.origin.x;
+  query.y1 = r.origin.y;
+  query.x2 = r.origin.x + r.size.width;
+  query.y2 = r.origin.y + r.size.height;
+
+  if (priv->spatial_index != NULL)
+    {
+      GPtrArray *children;
+      guint i;
+
+      clutter_actor_ensure_spatial_index_order (self);
+
+      children = _clutter_spatial_index_query_box (priv->spatial_index, &query);
+
+      for (i = children->len; i > 0; i--)
+        res = g_list_prepend (res, g_ptr_array_index (children, i - 1));
+
+      g_ptr_array_unref (children);
+    }
+  else
+    {
+      ClutterActor *iter;
+
+      for (iter = priv->last_child;
+           iter != NULL;
+           iter = iter->priv->prev_sibling)
+        {
+          ClutterActorBox box;
+          gboolean is_flat;
+
+          if (!clutter_actor_get_child_box (iter, &box, &is_flat, self))
+            continue;
+
+          if (box.x2 < query.x1 || box.x1 > query.x2 ||
+              box.y2 < query.y1 || box.y1 > query.y2)
+            continue;
+
+          res = g_list_prepend (res, iter);
+        }
+    }
+
+  return res;
+}
+
 /*< private >
  * insert_child_at_depth:
  * @self: a #ClutterActor
@@ -12516,6 +14053,51 @@ clutter_actor_get_children (ClutterActor *self)
  * list sorted so that the painters algorithm we use for painting
  * the children will work correctly.
  */
+/* Checks whether @child is still in depth order with its siblings,
+ * after being added to its parent or after its depth changed; we only
+ * need to look at the siblings, since the rest of the children were
+ * already sorted
+ */
+static void
+clutter_actor_check_child_depth_order (ClutterActor *child)
+{
+  ClutterActorPrivate *priv = child->priv;
+  float depth;
+
+  if (priv->parent == NULL || priv->parent->priv->children_depth_unsorted)
+    return;
+
+  depth = _clutter_actor_get_transform_info_or_defaults (child)->z_position;
+
+  if ((priv->prev_sibling != NULL &&
+       _clutter_actor_get_transform_info_or_defaults (priv->prev_sibling)->z_position > depth) ||
+      (priv->next_sibling != NULL &&
+       _clutter_actor_get_transform_info_or_defaults (priv->next_sibling)->z_position < depth))
+    priv->parent->priv->children_depth_unsorted = TRUE;
+}
+
+static gboolean
+clutter_actor_children_are_depth_sorted (ClutterActor *self)
+{
+  ClutterActor *iter;
+  float last_depth = -G_MAXFLOAT;
+
+  for (iter = self->priv->first_child;
+       iter != NULL;
+       iter = iter->priv->next_sibling)
+    {
+      float depth;
+
+      depth = _clutter_actor_get_transform_info_or_defaults (iter)->z_position;
+      if (depth < last_depth)
+        return FALSE;
+
+      last_depth = depth;
+    }
+
+  return TRUE;
+}
+
 static void
 insert_child_at_depth (ClutterActor *self,
                        ClutterActor *child,
@@ -12544,17 +14126,53 @@ insert_child_at_depth (ClutterActor *self,
   /* Find the right place to insert the child so that it will still be
      sorted and the child will be after all of the actors at the same
      dept */
-  for (iter = self->priv->first_child;
-       iter != NULL;
-       iter = iter->priv->next_sibling)
+  if (self->priv->child_array != NULL &&
+      !self->priv->children_depth_unsorted)
+    {
+      GPtrArray *array = self->priv->child_array;
+      guint lo = 0, hi = array->len;
+
+      /* the children are sorted by depth, so we can bisect the array
+       * to find the first child with a bigger depth
+       */
+      while (lo < hi)
+        {
+          guint mid = lo + (hi - lo) / 2;
+          float iter_depth;
+
+          iter = g_ptr_array_index (array, mid);
+          iter_depth =
+            _clutter_actor_get_transform_info_or_defaults (iter)->z_position;
+
+          if (iter_depth > child_depth)
+            hi = mid;
+          else
+            lo = mid + 1;
+        }
+
+      iter = lo < array->len ? g_ptr_array_index (array, lo) : NULL;
+    }
+  else
     {
-      float iter_depth;
+      for (iter = self->priv->first_child;
+           iter != NULL;
+           iter = iter->priv->next_sibling)
+        {
+          float iter_depth;
 
-      iter_depth =
-        _clutter_actor_get_transform_info_or_defaults (iter)->z_position;
+          iter_depth =
+            _clutter_actor_get_transform_info_or_defaults (iter)->z_position;
 
-      if (iter_depth > child_depth)
-        break;
+          if (iter_depth > child_depth)
+            break;
+        }
+
+      /* if we have to scan, check whether the order has been restored
+       * so that the next insertion can bisect the array again
+       */
+      if (self->priv->child_array != NULL)
+        self->priv->children_depth_unsorted =
+          !clutter_actor_children_are_depth_sorted (self);
     }
 
   if (iter != NULL)
@@ -12619,28 +14237,28 @@ insert_child_at_index (ClutterActor *self,
     }
   else
     {
-      ClutterActor *iter;
+      ClutterActor *iter, *tmp;
       int i;
 
-      for (iter = self->priv->first_child, i = 0;
-           iter != NULL;
-           iter = iter->priv->next_sibling, i += 1)
+      if (self->priv->child_array != NULL)
+        iter = g_ptr_array_index (self->priv->child_array, index_);
+      else
         {
-          if (index_ == i)
-            {
-              ClutterActor *tmp = iter->priv->prev_sibling;
+          for (iter = self->priv->first_child, i = 0;
+               iter != NULL && i < index_;
+               iter = iter->priv->next_sibling, i += 1)
+            ;
+        }
 
-              child->priv->prev_sibling = tmp;
-              child->priv->next_sibling = iter;
+      tmp = iter->priv->prev_sibling;
 
-              iter->priv->prev_sibling = child;
+      child->priv->prev_sibling = tmp;
+      child->priv->next_sibling = iter;
 
-              if (tmp != NULL)
-                tmp->priv->next_sibling = child;
+      iter->priv->prev_sibling = child;
 
-              break;
-            }
-        }
+      if (tmp != NULL)
+        tmp->priv->next_sibling = child;
     }
 
   if (child->priv->prev_sibling == NULL)
@@ -12868,6 +14486,7 @@ clutter_actor_add_child_internal (ClutterActor              *self,
     clutter_container_create_child_meta (CLUTTER_CONTAINER (self), child);
 
   g_object_ref_sink (child);
+  clutter_actor_invalidate_stage_transform (child);
   child->priv->parent = NULL;
   child->priv->next_sibling = NULL;
   child->priv->prev_sibling = NULL;
@@ -12877,8 +14496,17 @@ clutter_actor_add_child_internal (ClutterActor              *self,
 
   g_assert (child->priv->parent == self);
 
+  clutter_actor_check_child_depth_order (child);
+
   self->priv->n_children += 1;
 
+  child_array_add (self, child);
+
+  /* the paint volume of the parents has changed */
+  child->priv->parent_volume_box_valid = FALSE;
+  child->priv->parent_volume_invalidated = FALSE;
+  clutter_actor_invalidate_children_volume (self);
+
   self->priv->age += 1;
 
   /* if push_internal() has been called then we automatically set
@@ -13258,6 +14886,9 @@ clutter_actor_remove_all_children (ClutterActor *self)
 
   g_object_freeze_notify (G_OBJECT (self));
 
+  /* no point in keeping the child array up to date */
+  child_array_clear (self);
+
   clutter_actor_iter_init (&iter, self);
   while (clutter_actor_iter_next (&iter, NULL))
     clutter_actor_iter_remove (&iter);
@@ -13309,6 +14940,9 @@ clutter_actor_destroy_all_children (ClutterActor *self)
 
   g_object_freeze_notify (G_OBJECT (self));
 
+  /* no point in keeping the child array up to date */
+  child_array_clear (self);
+
   clutter_actor_iter_init (&iter, self);
   while (clutter_actor_iter_next (&iter, NULL))
     clutter_actor_iter_destroy (&iter);
@@ -14042,7 +15676,7 @@ clutter_actor_set_anchor_point (ClutterActor *self,
 
   if (changed)
     {
-      priv->transform_valid = FALSE;
+      clutter_actor_invalidate_transform (self);
       clutter_actor_queue_redraw (self);
     }
 
@@ -14212,7 +15846,7 @@ clutter_actor_set_anchor_point_from_gravity (ClutterActor   *self,
       g_object_notify_by_pspec (obj, obj_props[PROP_ANCHOR_X]);
       g_object_notify_by_pspec (obj, obj_props[PROP_ANCHOR_Y]);
 
-      self->priv->transform_valid = FALSE;
+      clutter_actor_invalidate_transform (self);
 
       clutter_actor_queue_redraw (self);
 
@@ -14224,13 +15858,20 @@ static void
 clutter_actor_store_content_box (ClutterActor *self,
                                  const ClutterActorBox *box)
 {
+  ClutterContentInfo *info;
+
   if (box != NULL)
     {
-      self->priv->content_box = *box;
-      self->priv->content_box_valid = TRUE;
+      info = clutter_actor_get_content_info (self);
+      info->content_box = *box;
+      info->content_box_valid = TRUE;
     }
   else
-    self->priv->content_box_valid = FALSE;
+    {
+      info = clutter_actor_peek_content_info (self);
+      if (info != NULL)
+        info->content_box_valid = FALSE;
+    }
 
   clutter_actor_queue_redraw (self);
 
@@ -15088,6 +16729,55 @@ clutter_animatable_iface_init (ClutterAnimatableIface *iface)
   iface->set_final_state = clutter_actor_set_final_state;
 }
 
+/* The z=0 plane of the stage is mapped 1:1 on the screen, so if the
+ * transformation of an actor keeps it on that plane, without a
+ * perspective component, the inverse of its stage transformation maps
+ * stage coordinates directly to the actor, and we can avoid going
+ * through the projected vertices of its allocation
+ */
+static gboolean
+clutter_actor_transform_stage_point_2d (ClutterActor *self,
+                                        gfloat        x,
+                                        gfloat        y,
+                                        gfloat       *x_out,
+                                        gfloat       *y_out)
+{
+  ClutterActorPrivate *priv = self->priv;
+  const CoglMatrix *matrix, *inverse;
+  ClutterActor *root = NULL;
+  gfloat z = 0.f, w = 1.f;
+
+  /* the slow path takes care of updating the allocation, and of
+   * rejecting empty ones
+   */
+  if (priv->needs_allocation ||
+      ceilf (priv->allocation.x2 - priv->allocation.x1) == 0 ||
+      ceilf (priv->allocation.y2 - priv->allocation.y1) == 0)
+    return FALSE;
+
+  matrix = clutter_actor_get_stage_transform (self, &root);
+  if (matrix == NULL || !CLUTTER_IS_STAGE (root))
+    return FALSE;
+
+  if (matrix->zx != 0.f || matrix->zy != 0.f || matrix->zw != 0.f ||
+      matrix->wx != 0.f || matrix->wy != 0.f || matrix->ww != 1.f)
+    return FALSE;
+
+  inverse = clutter_actor_get_stage_transform_inverse (self, &root);
+  if (inverse == NULL)
+    return FALSE;
+
+  cogl_matrix_transform_point (inverse, &x, &y, &z, &w);
+
+  if (x_out)
+    *x_out = x;
+
+  if (y_out)
+    *y_out = y;
+
+  return TRUE;
+}
+
 /**
  * clutter_actor_transform_stage_point:
  * @self: A #ClutterActor
@@ -15136,6 +16826,9 @@ clutter_actor_transform_stage_point (ClutterActor *self,
 
   priv = self->priv;
 
+  if (clutter_actor_transform_stage_point_2d (self, x, y, x_out, y_out))
+    return TRUE;
+
   /* This implementation is based on the quad -> quad projection algorithm
    * described by Paul Heckbert in:
    *
@@ -16292,7 +17985,7 @@ clutter_actor_set_transform_internal (ClutterActor        *self,
   info->transform = *transform;
   info->transform_set = !cogl_matrix_is_identity (&info->transform);
 
-  self->priv->transform_valid = FALSE;
+  clutter_actor_invalidate_transform (self);
 
   clutter_actor_queue_redraw (self);
 
@@ -17496,16 +19189,54 @@ static ClutterPaintVolume *
 _clutter_actor_get_paint_volume_mutable (ClutterActor *self)
 {
   ClutterActorPrivate *priv;
+  ClutterActorVolumes *volumes;
+  gboolean has_paint_handlers;
+  gboolean can_cache;
 
   priv = self->priv;
+  volumes = clutter_actor_get_volumes (self);
+
+  has_paint_handlers = g_signal_has_handler_pending (self,
+                                                     actor_signals[PAINT],
+                                                     0,
+                                                     TRUE);
+
+  /* there is no notification when a handler is connected to the paint
+   * signal, so if the parent cached our box before that happened we
+   * need to invalidate it the first time we notice
+   */
+  if (has_paint_handlers &&
+      priv->parent_volume_box_valid &&
+      priv->parent_volume_box_state != VOLUME_BOX_UNKNOWN)
+    {
+      priv->parent_volume_invalidated = FALSE;
+      clutter_actor_invalidate_parent_volume (self);
+    }
+
+  priv->parent_volume_invalidated = FALSE;
+
+  /* the paint volume is cached until the actor queues a redraw or
+   * changes its allocation; while painting an effect the volume
+   * depends on the current effect, and if the actor does not have a
+   * valid allocation or has handlers connected to the paint signal
+   * we cannot report a paint volume anyway
+   */
+  can_cache = priv->current_effect == NULL &&
+              !priv->needs_allocation &&
+              !has_paint_handlers;
+
+  if (can_cache && priv->paint_volume_cached)
+    return priv->paint_volume_valid ? &volumes->paint_volume : NULL;
 
   if (priv->paint_volume_valid)
-    clutter_paint_volume_free (&priv->paint_volume);
+    clutter_paint_volume_free (&volumes->paint_volume);
+
+  priv->paint_volume_cached = can_cache;
 
-  if (_clutter_actor_get_paint_volume_real (self, &priv->paint_volume))
+  if (_clutter_actor_get_paint_volume_real (self, &volumes->paint_volume))
     {
       priv->paint_volume_valid = TRUE;
-      return &priv->paint_volume;
+      return &volumes->paint_volume;
     }
   else
     {
@@ -17785,6 +19516,14 @@ clutter_actor_get_child_at_index (ClutterActor *self,
   g_return_val_if_fail (CLUTTER_IS_ACTOR (self), NULL);
   g_return_val_if_fail (index_ <= self->priv->n_children, NULL);
 
+  if (self->priv->child_array != NULL)
+    {
+      if (index_ < 0 || index_ >= self->priv->n_children)
+        return NULL;
+
+      return g_ptr_array_index (self->priv->child_array, index_);
+    }
+
   for (iter = self->priv->first_child, i = 0;
        iter != NULL && i < index_;
        iter = iter->priv->next_sibling, i += 1)
@@ -17812,6 +19551,7 @@ _clutter_actor_foreach_child (ClutterActor           *self,
 {
   ClutterActor *iter;
   gboolean cont;
+  gint i = 0;
 
   if (self->priv->first_child == NULL)
     return TRUE;
@@ -17826,9 +19566,16 @@ _clutter_actor_foreach_child (ClutterActor           *self,
     {
       ClutterActor *next = iter->priv->next_sibling;
 
+      /* the callback may change the children, so the index is
+       * just a hint
+       */
+      if (self->priv->child_array != NULL)
+        child_array_prefetch (self->priv->child_array, i, 1);
+
       cont = callback (iter, user_data);
 
       iter = next;
+      i += 1;
     }
 
   return cont;
@@ -18687,7 +20434,7 @@ typedef struct _RealActorIter
 {
   ClutterActor *root;           /* dummy1 */
   ClutterActor *current;        /* dummy2 */
-  gpointer padding_1;           /* dummy3 */
+  gintptr index;                /* dummy3 */
   gint age;                     /* dummy4 */
   gpointer padding_2;           /* dummy5 */
 } RealActorIter;
@@ -18728,6 +20475,7 @@ clutter_actor_iter_init (ClutterActorIter *iter,
 
   ri->root = root;
   ri->current = NULL;
+  ri->index = -1;
   ri->age = root->priv->age;
 }
 
@@ -18789,9 +20537,18 @@ clutter_actor_iter_next (ClutterActorIter  *iter,
 #endif
 
   if (ri->current == NULL)
-    ri->current = ri->root->priv->first_child;
+    {
+      ri->current = ri->root->priv->first_child;
+      ri->index = 0;
+    }
   else
-    ri->current = ri->current->priv->next_sibling;
+    {
+      ri->current = ri->current->priv->next_sibling;
+      ri->index += 1;
+    }
+
+  if (ri->root->priv->child_array != NULL)
+    child_array_prefetch (ri->root->priv->child_array, ri->index, 1);
 
   if (child != NULL)
     *child = ri->current;
@@ -18830,9 +20587,18 @@ clutter_actor_iter_prev (ClutterActorIter  *iter,
 #endif
 
   if (ri->current == NULL)
-    ri->current = ri->root->priv->last_child;
+    {
+      ri->current = ri->root->priv->last_child;
+      ri->index = ri->root->priv->n_children - 1;
+    }
   else
-    ri->current = ri->current->priv->prev_sibling;
+    {
+      ri->current = ri->current->priv->prev_sibling;
+      ri->index -= 1;
+    }
+
+  if (ri->root->priv->child_array != NULL)
+    child_array_prefetch (ri->root->priv->child_array, ri->index, -1);
 
   if (child != NULL)
     *child = ri->current;
@@ -18873,6 +20639,7 @@ clutter_actor_iter_remove (ClutterActorIter *iter)
   if (cur != NULL)
     {
       ri->current = cur->priv->prev_sibling;
+      ri->index -= 1;
 
       clutter_actor_remove_child_internal (ri->root, cur,
                                            REMOVE_CHILD_DEFAULT_FLAGS);
@@ -18914,6 +20681,7 @@ clutter_actor_iter_destroy (ClutterActorIter *iter)
   if (cur != NULL)
     {
       ri->current = cur->priv->prev_sibling;
+      ri->index -= 1;
 
       clutter_actor_destroy (cur);
 
@@ -19771,6 +21539,90 @@ clutter_actor_restore_easing_state (ClutterActor *self)
     }
 }
 
+/* the default is to stretch the content, to match the
+ * current behaviour of basically all actors. also, it's
+ * the easiest thing to compute.
+ */
+static const ClutterContentInfo default_content_info = {
+  { 0, 0, 0, 0 },                       /* content-box */
+  CLUTTER_CONTENT_GRAVITY_RESIZE_FILL,  /* content-gravity */
+  CLUTTER_SCALING_FILTER_LINEAR,        /* min-filter */
+  CLUTTER_SCALING_FILTER_LINEAR,        /* mag-filter */
+  CLUTTER_REPEAT_NONE,                  /* content-repeat */
+  FALSE,                                /* content-box-valid */
+};
+
+static void
+content_info_free (gpointer data)
+{
+  if (G_LIKELY (data != NULL))
+    g_slice_free (ClutterContentInfo, data);
+}
+
+/*< private >
+ * clutter_actor_peek_content_info:
+ * @self: a #ClutterActor
+ *
+ * Retrieves a pointer to the ClutterContentInfo structure, or %NULL
+ * if the actor does not have one.
+ */
+static ClutterContentInfo *
+clutter_actor_peek_content_info (ClutterActor *self)
+{
+  return g_object_get_qdata (G_OBJECT (self), quark_actor_content_info);
+}
+
+/*< private >
+ * clutter_actor_get_content_info:
+ * @self: a #ClutterActor
+ *
+ * Retrieves a pointer to the ClutterContentInfo structure, creating
+ * it with the default values if needed.
+ *
+ * This function should be used for setters; getters should use
+ * clutter_actor_get_content_info_or_defaults() instead.
+ */
+static ClutterContentInfo *
+clutter_actor_get_content_info (ClutterActor *self)
+{
+  ClutterContentInfo *retval;
+
+  retval = clutter_actor_peek_content_info (self);
+  if (retval == NULL)
+    {
+      retval = g_slice_new (ClutterContentInfo);
+
+      *retval = default_content_info;
+
+      g_object_set_qdata_full (G_OBJECT (self), quark_actor_content_info,
+                               retval,
+                               content_info_free);
+    }
+
+  return retval;
+}
+
+/*< private >
+ * clutter_actor_get_content_info_or_defaults:
+ * @self: a #ClutterActor
+ *
+ * Retrieves the ClutterContentInfo structure associated to an actor,
+ * or the default structure if the actor does not have one.
+ *
+ * This function should only be used for getters.
+ */
+static const ClutterContentInfo *
+clutter_actor_get_content_info_or_defaults (ClutterActor *self)
+{
+  const ClutterContentInfo *info;
+
+  info = clutter_actor_peek_content_info (self);
+  if (info == NULL)
+    return &default_content_info;
+
+  return info;
+}
+
 /**
  * clutter_actor_set_content:
  * @self: a #ClutterActor
@@ -19785,6 +21637,7 @@ clutter_actor_set_content (ClutterActor   *self,
                            ClutterContent *content)
 {
   ClutterActorPrivate *priv;
+  ClutterContentInfo *cinfo;
 
   g_return_if_fail (CLUTTER_IS_ACTOR (self));
   g_return_if_fail (content == NULL || CLUTTER_IS_CONTENT (content));
@@ -19824,16 +21677,18 @@ clutter_actor_set_content (ClutterActor   *self,
    * here, and let whomever watches :content-box do whatever they need to
    * do.
    */
-  if (priv->content_gravity != CLUTTER_CONTENT_GRAVITY_RESIZE_FILL)
+  cinfo = clutter_actor_peek_content_info (self);
+  if (cinfo != NULL &&
+      cinfo->content_gravity != CLUTTER_CONTENT_GRAVITY_RESIZE_FILL)
     {
-      if (priv->content_box_valid)
+      if (cinfo->content_box_valid)
         {
           ClutterActorBox from_box, to_box;
 
           clutter_actor_get_content_box (self, &from_box);
 
           /* invalidate the cached content box */
-          priv->content_box_valid = FALSE;
+          cinfo->content_box_valid = FALSE;
           clutter_actor_get_content_box (self, &to_box);
 
           if (!clutter_actor_box_equal (&from_box, &to_box))
@@ -19883,21 +21738,20 @@ void
 clutter_actor_set_content_gravity (ClutterActor *self,
                                    ClutterContentGravity  gravity)
 {
-  ClutterActorPrivate *priv;
+  ClutterContentInfo *info;
   ClutterActorBox from_box, to_box;
 
   g_return_if_fail (CLUTTER_IS_ACTOR (self));
 
-  priv = self->priv;
-
-  if (priv->content_gravity == gravity)
+  if (clutter_actor_get_content_info_or_defaults (self)->content_gravity == gravity)
     return;
 
-  priv->content_box_valid = FALSE;
+  info = clutter_actor_get_content_info (self);
+  info->content_box_valid = FALSE;
 
   clutter_actor_get_content_box (self, &from_box);
 
-  priv->content_gravity = gravity;
+  info->content_gravity = gravity;
 
   clutter_actor_get_content_box (self, &to_box);
 
@@ -19925,7 +21779,7 @@ clutter_actor_get_content_gravity (ClutterActor *self)
   g_return_val_if_fail (CLUTTER_IS_ACTOR (self),
                         CLUTTER_CONTENT_GRAVITY_RESIZE_FILL);
 
-  return self->priv->content_gravity;
+  return clutter_actor_get_content_info_or_defaults (self)->content_gravity;
 }
 
 /**
@@ -19955,6 +21809,7 @@ clutter_actor_get_content_box (ClutterActor    *self,
                                ClutterActorBox *box)
 {
   ClutterActorPrivate *priv;
+  const ClutterContentInfo *info;
   gfloat content_w, content_h;
   gfloat alloc_w, alloc_h;
 
@@ -19962,20 +21817,21 @@ clutter_actor_get_content_box (ClutterActor    *self,
   g_return_if_fail (box != NULL);
 
   priv = self->priv;
+  info = clutter_actor_get_content_info_or_defaults (self);
 
   box->x1 = 0.f;
   box->y1 = 0.f;
   box->x2 = priv->allocation.x2 - priv->allocation.x1;
   box->y2 = priv->allocation.y2 - priv->allocation.y1;
 
-  if (priv->content_box_valid)
+  if (info->content_box_valid)
     {
-      *box = priv->content_box;
+      *box = info->content_box;
       return;
     }
 
   /* no need to do any more work */
-  if (priv->content_gravity == CLUTTER_CONTENT_GRAVITY_RESIZE_FILL)
+  if (info->content_gravity == CLUTTER_CONTENT_GRAVITY_RESIZE_FILL)
     return;
 
   if (priv->content == NULL)
@@ -19992,7 +21848,7 @@ clutter_actor_get_content_box (ClutterActor    *self,
   alloc_w = box->x2;
   alloc_h = box->y2;
 
-  switch (priv->content_gravity)
+  switch (info->content_gravity)
     {
     case CLUTTER_CONTENT_GRAVITY_TOP_LEFT:
       box->x2 = box->x1 + MIN (content_w, alloc_w);
@@ -20145,30 +22001,36 @@ clutter_actor_set_content_scaling_filters (ClutterActor         *self,
                                            ClutterScalingFilter  min_filter,
                                            ClutterScalingFilter  mag_filter)
 {
-  ClutterActorPrivate *priv;
+  const ClutterContentInfo *old_info;
+  ClutterContentInfo *info;
   gboolean changed;
   GObject *obj;
 
   g_return_if_fail (CLUTTER_IS_ACTOR (self));
 
-  priv = self->priv;
+  old_info = clutter_actor_get_content_info_or_defaults (self);
+  if (old_info->min_filter == min_filter &&
+      old_info->mag_filter == mag_filter)
+    return;
+
+  info = clutter_actor_get_content_info (self);
   obj = G_OBJECT (self);
 
   g_object_freeze_notify (obj);
 
   changed = FALSE;
 
-  if (priv->min_filter != min_filter)
+  if (info->min_filter != min_filter)
     {
-      priv->min_filter = min_filter;
+      info->min_filter = min_filter;
       changed = TRUE;
 
       g_object_notify_by_pspec (obj, obj_props[PROP_MINIFICATION_FILTER]);
     }
 
-  if (priv->mag_filter != mag_filter)
+  if (info->mag_filter != mag_filter)
     {
-      priv->mag_filter = mag_filter;
+      info->mag_filter = mag_filter;
       changed = TRUE;
 
       g_object_notify_by_pspec (obj, obj_props[PROP_MAGNIFICATION_FILTER]);
@@ -20197,13 +22059,17 @@ clutter_actor_get_content_scaling_filters (ClutterActor         *self,
                                            ClutterScalingFilter *min_filter,
                                            ClutterScalingFilter *mag_filter)
 {
+  const ClutterContentInfo *info;
+
   g_return_if_fail (CLUTTER_IS_ACTOR (self));
 
+  info = clutter_actor_get_content_info_or_defaults (self);
+
   if (min_filter != NULL)
-    *min_filter = self->priv->min_filter;
+    *min_filter = info->min_filter;
 
   if (mag_filter != NULL)
-    *mag_filter = self->priv->mag_filter;
+    *mag_filter = info->mag_filter;
 }
 
 /*
@@ -20494,10 +22360,10 @@ clutter_actor_set_content_repeat (ClutterActor         *self,
 {
   g_return_if_fail (CLUTTER_IS_ACTOR (self));
 
-  if (self->priv->content_repeat == repeat)
+  if (clutter_actor_get_content_info_or_defaults (self)->content_repeat == repeat)
     return;
 
-  self->priv->content_repeat = repeat;
+  clutter_actor_get_content_info (self)->content_repeat = repeat;
 
   clutter_actor_queue_redraw (self);
 }
@@ -20518,7 +22384,7 @@ clutter_actor_get_content_repeat (ClutterActor *self)
 {
   g_return_val_if_fail (CLUTTER_IS_ACTOR (self), CLUTTER_REPEAT_NONE);
 
-  return self->priv->content_repeat;
+  return clutter_actor_get_content_info_or_defaults (self)->content_repeat;
 }
 
 void
@@ -20591,7 +22457,7 @@ clutter_actor_set_child_transform_internal (ClutterActor        *self,
   /* we need to reset the transform_valid flag on each child */
   clutter_actor_iter_init (&iter, self);
   while (clutter_actor_iter_next (&iter, &child))
-    child->priv->transform_valid = FALSE;
+    clutter_actor_invalidate_transform (child);
 
   clutter_actor_queue_redraw (self);
 
@@ -20741,6 +22607,8 @@ _clutter_actor_queue_redraw_on_clones (ClutterActor *self)
   if (priv->clones == NULL)
     return;
 
+  _clutter_clone_invalidate_paint_cache (self);
+
   g_hash_table_iter_init (&iter, priv->clones);
   while (g_hash_table_iter_next (&iter, &key, NULL))
     clutter_actor_queue_redraw (key);
@@ -20821,6 +22689,19 @@ _clutter_actor_get_active_framebuffer (ClutterActor *self)
   return _clutter_stage_get_active_framebuffer (stage);
 }
 
+static void
+model_binding_free (gpointer data)
+{
+  ClutterModelBinding *binding = data;
+
+  if (binding->create_child_notify != NULL)
+    binding->create_child_notify (binding->create_child_data);
+
+  g_object_unref (binding->child_model);
+
+  g_slice_free (ClutterModelBinding, binding);
+}
+
 static void
 clutter_actor_child_model__items_changed (GListModel *model,
                                           guint       position,
@@ -20829,9 +22710,11 @@ clutter_actor_child_model__items_changed (GListModel *model,
                                           gpointer    user_data)
 {
   ClutterActor *parent = user_data;
-  ClutterActorPrivate *priv = parent->priv;
+  ClutterModelBinding *binding;
   guint i;
 
+  binding = g_object_get_qdata (G_OBJECT (parent), quark_actor_model_binding);
+
   while (removed--)
     {
       ClutterActor *child = clutter_actor_get_child_at_index (parent, position);
@@ -20840,8 +22723,18 @@ clutter_actor_child_model__items_changed (GListModel *model,
 
   for (i = 0; i < added; i++)
     {
-      GObject *item = g_list_model_get_item (model, position + i);
-      ClutterActor *child = priv->create_child_func (item, priv->create_child_data);
+      ClutterActor *child;
+
+      if (binding->create_row_func != NULL)
+        child = binding->create_row_func (model, position + i, binding->create_child_data);
+      else
+        {
+          GObject *item = g_list_model_get_item (model, position + i);
+
+          child = binding->create_child_func (item, binding->create_child_data);
+
+          g_object_unref (item);
+        }
 
       /* The actor returned by the function can have a floating reference,
        * if the implementation is in pure C, or have a full reference, usually
@@ -20856,10 +22749,36 @@ clutter_actor_child_model__items_changed (GListModel *model,
       clutter_actor_insert_child_at_index (parent, child, position + i);
 
       g_object_unref (child);
-      g_object_unref (item);
     }
 }
 
+static void clutter_actor_column_store__values_changed (ClutterColumnStore *store,
+                                                        guint               position,
+                                                        guint               n_rows,
+                                                        gpointer            user_data);
+
+static void
+clutter_actor_unbind_model_internal (ClutterActor *self)
+{
+  ClutterModelBinding *binding;
+
+  binding = g_object_get_qdata (G_OBJECT (self), quark_actor_model_binding);
+  if (binding == NULL)
+    return;
+
+  g_signal_handlers_disconnect_by_func (binding->child_model,
+                                        clutter_actor_child_model__items_changed,
+                                        self);
+
+  if (binding->create_row_func != NULL)
+    g_signal_handlers_disconnect_by_func (binding->child_model,
+                                          clutter_actor_column_store__values_changed,
+                                          self);
+
+  /* this will call model_binding_free() */
+  g_object_set_qdata (G_OBJECT (self), quark_actor_model_binding, NULL);
+}
+
 /**
  * clutter_actor_bind_model:
  * @self: a #ClutterActor
@@ -20891,44 +22810,58 @@ clutter_actor_bind_model (ClutterActor                *self,
                           gpointer                     user_data,
                           GDestroyNotify               notify)
 {
-  ClutterActorPrivate *priv = clutter_actor_get_instance_private (self);
-
   g_return_if_fail (CLUTTER_IS_ACTOR (self));
   g_return_if_fail (model == NULL || G_IS_LIST_MODEL (model));
   g_return_if_fail (model == NULL || create_child_func != NULL);
 
-  if (priv->child_model != NULL)
-    {
-      if (priv->create_child_notify != NULL)
-        priv->create_child_notify (priv->create_child_data);
+  clutter_actor_bind_model_internal (self, model,
+                                     create_child_func,
+                                     NULL,
+                                     user_data,
+                                     notify);
+}
 
-      g_signal_handlers_disconnect_by_func (priv->child_model,
-                                            clutter_actor_child_model__items_changed,
-                                            self);
-      g_clear_object (&priv->child_model);
-      priv->create_child_func = NULL;
-      priv->create_child_data = NULL;
-      priv->create_child_notify = NULL;
-    }
+static void
+clutter_actor_bind_model_internal (ClutterActor                *self,
+                                   GListModel                  *model,
+                                   ClutterActorCreateChildFunc  create_child_func,
+                                   ClutterActorCreateRowFunc    create_row_func,
+                                   gpointer                     user_data,
+                                   GDestroyNotify               notify)
+{
+  ClutterModelBinding *binding;
+
+  clutter_actor_unbind_model_internal (self);
 
   clutter_actor_destroy_all_children (self);
 
   if (model == NULL)
     return;
 
-  priv->child_model = g_object_ref (model);
-  priv->create_child_func = create_child_func;
-  priv->create_child_data = user_data;
-  priv->create_child_notify = notify;
+  binding = g_slice_new (ClutterModelBinding);
+  binding->child_model = g_object_ref (model);
+  binding->create_child_func = create_child_func;
+  binding->create_row_func = create_row_func;
+  binding->create_child_data = user_data;
+  binding->create_child_notify = notify;
+
+  g_object_set_qdata_full (G_OBJECT (self), quark_actor_model_binding,
+                           binding,
+                           model_binding_free);
 
-  g_signal_connect (priv->child_model, "items-changed",
+  g_signal_connect (binding->child_model, "items-changed",
                     G_CALLBACK (clutter_actor_child_model__items_changed),
                     self);
 
-  clutter_actor_child_model__items_changed (priv->child_model,
+  if (create_row_func != NULL)
+    g_signal_connect (binding->child_model, "values-changed",
+                      G_CALLBACK (clutter_actor_column_store__values_changed),
+                      self);
+
+  clutter_actor_child_model__items_changed (binding->child_model,
                                             0,
                                             0,
-                                            g_list_model_get_n_items (priv->child_model),
+                                            g_list_model_get_n_items (binding->child_model),
                                             self);
 }
 
@@ -20977,6 +22910,163 @@ bind_child_with_properties (gpointer item,
   return res;
 }
 
+typedef struct {
+  guint column;
+  GParamSpec *pspec;
+} BindColumn;
+
+typedef struct {
+  GType child_type;
+
+  /* keeps the GParamSpecs of the columns alive */
+  GObjectClass *child_class;
+
+  GArray *columns;
+} BindColumnClosure;
+
+static void
+bind_column_closure_free (gpointer data_)
+{
+  BindColumnClosure *data = data_;
+
+  if (data == NULL)
+    return;
+
+  g_array_unref (data->columns);
+  g_type_class_unref (data->child_class);
+  g_slice_free (BindColumnClosure, data);
+}
+
+static void
+bind_column_sync_child (BindColumnClosure  *data,
+                        ClutterColumnStore *store,
+                        guint               row,
+                        ClutterActor       *child)
+{
+  guint i;
+
+  g_object_freeze_notify (G_OBJECT (child));
+
+  for (i = 0; i < data->columns->len; i++)
+    {
+      const BindColumn *column = &g_array_index (data->columns, BindColumn, i);
+      GType pspec_type = G_PARAM_SPEC_VALUE_TYPE (column->pspec);
+      GValue value = G_VALUE_INIT;
+
+      clutter_column_store_get_value (store, column->column, row, &value);
+
+      if (G_VALUE_TYPE (&value) == pspec_type)
+        g_object_set_property (G_OBJECT (child), column->pspec->name, &value);
+      else
+        {
+          GValue transformed = G_VALUE_INIT;
+
+          g_value_init (&transformed, pspec_type);
+
+          if (g_value_transform (&value, &transformed))
+            g_object_set_property (G_OBJECT (child), column->pspec->name, &transformed);
+
+          g_value_unset (&transformed);
+        }
+
+      g_value_unset (&value);
+    }
+
+  g_object_thaw_notify (G_OBJECT (child));
+}
+
+static ClutterActor *
+bind_row_with_columns (GListModel *model,
+                       guint       position,
+                       gpointer    data_)
+{
+  BindColumnClosure *data = data_;
+  ClutterActor *res;
+
+  res = g_object_new (data->child_type, NULL);
+
+  bind_column_sync_child (data, CLUTTER_COLUMN_STORE (model), position, res);
+
+  return res;
+}
+
+static void
+clutter_actor_column_store__values_changed (ClutterColumnStore *store,
+                                            guint               position,
+                                            guint               n_rows,
+                                            gpointer            user_data)
+{
+  ClutterActor *parent = user_data;
+  ClutterModelBinding *binding;
+  ClutterActor *child;
+  guint i;
+
+  binding = g_object_get_qdata (G_OBJECT (parent), quark_actor_model_binding);
+  if (binding == NULL || n_rows == 0)
+    return;
+
+  child = clutter_actor_get_child_at_index (parent, position);
+  for (i = 0; i < n_rows && child != NULL; i++)
+    {
+      bind_column_sync_child (binding->create_child_data, store, position + i, child);
+
+      child = child->priv->next_sibling;
+    }
+}
+
+/* binds the columns of a ClutterColumnStore to the properties of the
+ * children, without creating the row items or any GBinding
+ */
+static void
+clutter_actor_bind_column_store (ClutterActor       *self,
+                                 ClutterColumnStore *store,
+                                 GType               child_type,
+                                 GArray             *props)
+{
+  BindColumnClosure *clos;
+  guint i;
+
+  clos = g_slice_new0 (BindColumnClosure);
+  clos->child_type = child_type;
+  clos->child_class = g_type_class_ref (child_type);
+  clos->columns = g_array_sized_new (FALSE, FALSE, sizeof (BindColumn), props->len);
+
+  for (i = 0; i < props->len; i++)
+    {
+      const BindProperty *prop = &g_array_index (props, BindProperty, i);
+      BindColumn column;
+      gint index_;
+
+      index_ = clutter_column_store_find_column (store, prop->model_property);
+      if (index_ < 0)
+        {
+          g_warning ("%s: the model has no column named '%s'",
+                     G_STRLOC,
+                     prop->model_property);
+          continue;
+        }
+
+      column.column = index_;
+      column.pspec = g_object_class_find_property (clos->child_class, prop->child_property);
+      if (column.pspec == NULL)
+        {
+          g_warning ("%s: the type '%s' has no property named '%s'",
+                     G_STRLOC,
+                     g_type_name (child_type),
+                     prop->child_property);
+          continue;
+        }
+
+      g_array_append_val (clos->columns, column);
+    }
+
+  clutter_actor_bind_model_internal (self, G_LIST_MODEL (store),
+                                     NULL,
+                                     bind_row_with_columns,
+                                     clos,
+                                     bind_column_closure_free);
+}
+
 /**
  * clutter_actor_bind_model_with_properties:
  * @self: a #ClutterActor
@@ -21024,6 +23114,13 @@ bind_child_with_properties (gpointer item,
  * When a #ClutterActor is bound to a model, adding and removing children
  * directly is undefined behaviour.
  *
+ * If @model is a #ClutterColumnStore, the model properties are the names
+ * of its columns, and the properties of the children are set directly
+ * from the values of the columns whenever they change, without creating
+ * an item for each row or a #GBinding for each property; in that case,
+ * the #GBindingFlags are ignored, and changes to the properties of the
+ * children are not propagated to the model.
+ *
  * See also: clutter_actor_bind_model()
  *
  * Since: 1.24
@@ -21064,6 +23161,17 @@ clutter_actor_bind_model_with_properties (ClutterActor *self,
       model_property = va_arg (args, char *);
     }
 
+  va_end (args);
+
+  if (CLUTTER_IS_COLUMN_STORE (model))
+    {
+      clutter_actor_bind_column_store (self, CLUTTER_COLUMN_STORE (model),
+                                       child_type,
+                                       clos->props);
+      bind_closure_free (clos);
+      return;
+    }
+
   clutter_actor_bind_model (self, model, bind_child_with_properties, clos, bind_closure_free);
 }
 
@@ -21089,7 +23197,7 @@ ClutterPaintNode *
 clutter_actor_create_texture_paint_node (ClutterActor *self,
                                          CoglTexture  *texture)
 {
-  ClutterActorPrivate *priv = clutter_actor_get_instance_private (self);
+  const ClutterContentInfo *info;
   ClutterPaintNode *node;
   ClutterActorBox box;
   ClutterColor color;
@@ -21107,19 +23215,21 @@ clutter_actor_create_texture_paint_node (ClutterActor *self,
   color.blue = 255;
   color.alpha = clutter_actor_get_paint_opacity_internal (self);
 
-  node = clutter_texture_node_new (texture, &color, priv->min_filter, priv->mag_filter);
+  info = clutter_actor_get_content_info_or_defaults (self);
+
+  node = clutter_texture_node_new (texture, &color, info->min_filter, info->mag_filter);
   clutter_paint_node_set_name (node, "Texture");
 
-  if (priv->content_repeat == CLUTTER_REPEAT_NONE)
+  if (info->content_repeat == CLUTTER_REPEAT_NONE)
     clutter_paint_node_add_rectangle (node, &box);
   else
     {
       float t_w = 1.f, t_h = 1.f;
 
-      if ((priv->content_repeat & CLUTTER_REPEAT_X_AXIS) != FALSE)
+      if ((info->content_repeat & CLUTTER_REPEAT_X_AXIS) != FALSE)
         t_w = (box.x2 - box.x1) / cogl_texture_get_width (texture);
 
-      if ((priv->content_repeat & CLUTTER_REPEAT_Y_AXIS) != FALSE)
+      if ((info->content_repeat & CLUTTER_REPEAT_Y_AXIS) != FALSE)
         t_h = (box.y2 - box.y1) / cogl_texture_get_height (texture);
 
       clutter_paint_node_add_texture_rectangle (node, &box,
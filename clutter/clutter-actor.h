@@ -382,6 +382,11 @@ void                            clutter_actor_set_request_mode
                                                                                  ClutterRequestMode           mode);
 CLUTTER_AVAILABLE_IN_ALL
 ClutterRequestMode              clutter_actor_get_request_mode                  (ClutterActor                *self);
+CLUTTER_AVAILABLE_IN_1_28
+void                            clutter_actor_set_isolate_layout                (ClutterActor                *self,
+                                                                                 gboolean                     isolate);
+CLUTTER_AVAILABLE_IN_1_28
+gboolean                        clutter_actor_get_isolate_layout                (ClutterActor                *self);
 CLUTTER_AVAILABLE_IN_ALL
 void                            clutter_actor_get_preferred_width               (ClutterActor                *self,
                                                                                  gfloat                       for_height,
@@ -437,6 +442,10 @@ CLUTTER_AVAILABLE_IN_ALL
 void                            clutter_actor_set_size                          (ClutterActor                *self,
                                                                                  gfloat                       width,
                                                                                  gfloat                       height);
+CLUTTER_AVAILABLE_IN_1_28
+void                            clutter_actor_set_geometry_bulk                 (ClutterActor * const        *actors,
+                                                                                 const ClutterRect           *geometries,
+                                                                                 guint                        n_actors);
 CLUTTER_AVAILABLE_IN_ALL
 void                            clutter_actor_get_size                          (ClutterActor                *self,
                                                                                  gfloat                      *width,
@@ -687,6 +696,9 @@ CLUTTER_AVAILABLE_IN_1_10
 void                            clutter_actor_destroy_all_children              (ClutterActor               *self);
 CLUTTER_AVAILABLE_IN_1_10
 GList *                         clutter_actor_get_children                      (ClutterActor               *self);
+CLUTTER_AVAILABLE_IN_1_28
+GList *                         clutter_actor_get_children_in_rect              (ClutterActor               *self,
+                                                                                 const ClutterRect          *rect);
 CLUTTER_AVAILABLE_IN_1_10
 gint                            clutter_actor_get_n_children                    (ClutterActor               *self);
 CLUTTER_AVAILABLE_IN_1_10
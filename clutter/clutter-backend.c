@@ -92,6 +92,9 @@
 #ifdef CLUTTER_WINDOWING_MIR
 #include "mir/clutter-backend-mir.h"
 #endif
+#ifdef CLUTTER_WINDOWING_HEADLESS
+#include "headless/clutter-backend-headless.h"
+#endif
 #ifdef CLUTTER_INPUT_MIR
 #include "mir/clutter-device-manager-mir.h"
 #endif
@@ -556,6 +559,10 @@ static const struct {
 #endif
 #ifdef CLUTTER_WINDOWING_MIR
   { CLUTTER_WINDOWING_MIR, clutter_backend_mir_new },
+#endif
+#ifdef CLUTTER_WINDOWING_HEADLESS
+  /* the headless backend is the last resort */
+  { CLUTTER_WINDOWING_HEADLESS, clutter_backend_headless_new },
 #endif
   { NULL, NULL },
 };
@@ -0,0 +1,12 @@
+#ifndef __CLUTTER_CLONE_PRIVATE_H__
+#define __CLUTTER_CLONE_PRIVATE_H__
+
+#include <clutter/clutter-clone.h>
+
+G_BEGIN_DECLS
+
+void    _clutter_clone_invalidate_paint_cache   (ClutterActor *source);
+
+G_END_DECLS
+
+#endif /* __CLUTTER_CLONE_PRIVATE_H__ */
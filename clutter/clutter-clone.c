@@ -34,6 +34,16 @@
  * the presence of support for FBOs in the underlying GL or GLES
  * implementation.
  *
+ * By default each #ClutterClone paints its source again, which means
+ * that the whole scene graph of the source is traversed once for every
+ * clone. If many clones are showing the same complex source, setting
+ * the #ClutterClone:cache-paint property will render the source into
+ * an offscreen texture at most once per frame, shared by all the clones
+ * of the same source that have the property set. A clone will fall back
+ * to painting its source directly if it is scaled up to the point where
+ * the cached texture would look blurry, or if the paint volume of the
+ * source cannot be determined.
+ *
  * #ClutterClone is available since Clutter 1.0
  */
 
@@ -41,19 +51,55 @@
 #include "config.h"
 #endif
 
+#include <math.h>
+
 #define CLUTTER_ENABLE_EXPERIMENTAL_API
 #include "clutter-actor-private.h"
-#include "clutter-clone.h"
+#include "clutter-backend.h"
+#include "clutter-clone-private.h"
 #include "clutter-debug.h"
 #include "clutter-main.h"
 #include "clutter-paint-volume-private.h"
 #include "clutter-private.h"
+#include "clutter-stage-private.h"
+#include "clutter-stage-window.h"
 
 #include "cogl/cogl.h"
 
+/* how much a clone can scale up its cached source before we consider
+ * the result too blurry and paint the source directly
+ */
+#define PAINT_CACHE_SCALE_THRESHOLD     1.01f
+
+/* The rendered contents of a clone source; the cache is attached to the
+ * source, and it's shared by all the clones that have :cache-paint set
+ */
+typedef struct _PaintCache
+{
+  CoglTexture *texture;
+  CoglFramebuffer *offscreen;
+  CoglPipeline *pipeline;
+
+  /* the area of the source covered by the texture, in the coordinate
+   * space of the source
+   */
+  gfloat x1, y1;
+  gfloat x2, y2;
+
+  /* the number of texels for each unit of the source */
+  gint scale;
+
+  /* the number of clones using the cache */
+  guint n_users;
+
+  guint is_dirty : 1;
+} PaintCache;
+
 struct _ClutterClonePrivate
 {
   ClutterActor *clone_source;
+
+  guint cache_paint : 1;
 };
 
 G_DEFINE_TYPE_WITH_PRIVATE (ClutterClone, clutter_clone, CLUTTER_TYPE_ACTOR)
@@ -63,12 +109,15 @@ enum
   PROP_0,
 
   PROP_SOURCE,
+  PROP_CACHE_PAINT,
 
   PROP_LAST
 };
 
 static GParamSpec *obj_props[PROP_LAST];
 
+static GQuark quark_paint_cache = 0;
+
 static void clutter_clone_set_source_internal (ClutterClone *clone,
 					       ClutterActor *source);
 static void
@@ -153,17 +202,81 @@ clutter_clone_apply_transform (ClutterActor *self, CoglMatrix *matrix)
 }
 
 static void
-clutter_clone_paint (ClutterActor *actor)
+paint_cache_free (gpointer data)
 {
-  ClutterClone *self = CLUTTER_CLONE (actor);
-  ClutterClonePrivate *priv = self->priv;
-  gboolean was_unmapped = FALSE;
+  PaintCache *cache = data;
 
-  if (priv->clone_source == NULL)
+  if (cache->offscreen != NULL)
+    cogl_object_unref (cache->offscreen);
+
+  if (cache->texture != NULL)
+    cogl_object_unref (cache->texture);
+
+  if (cache->pipeline != NULL)
+    cogl_object_unref (cache->pipeline);
+
+  g_slice_free (PaintCache, cache);
+}
+
+static void
+paint_cache_ref (ClutterActor *source)
+{
+  PaintCache *cache;
+
+  cache = g_object_get_qdata (G_OBJECT (source), quark_paint_cache);
+  if (cache == NULL)
+    {
+      cache = g_slice_new0 (PaintCache);
+      cache->is_dirty = TRUE;
+
+      g_object_set_qdata_full (G_OBJECT (source), quark_paint_cache,
+                               cache,
+                               paint_cache_free);
+    }
+
+  cache->n_users += 1;
+}
+
+static void
+paint_cache_unref (ClutterActor *source)
+{
+  PaintCache *cache;
+
+  cache = g_object_get_qdata (G_OBJECT (source), quark_paint_cache);
+  if (cache == NULL)
     return;
 
-  CLUTTER_NOTE (PAINT, "painting clone actor '%s'",
-                _clutter_actor_get_debug_name (actor));
+  cache->n_users -= 1;
+  if (cache->n_users == 0)
+    g_object_set_qdata (G_OBJECT (source), quark_paint_cache, NULL);
+}
+
+/*< private >
+ * _clutter_clone_invalidate_paint_cache:
+ * @source: a #ClutterActor
+ *
+ * Marks the cached contents of @source as out of date; this is called
+ * every time a redraw is queued on @source, or on any of its children.
+ */
+void
+_clutter_clone_invalidate_paint_cache (ClutterActor *source)
+{
+  PaintCache *cache;
+
+  if (quark_paint_cache == 0)
+    return;
+
+  cache = g_object_get_qdata (G_OBJECT (source), quark_paint_cache);
+  if (cache != NULL)
+    cache->is_dirty = TRUE;
+}
+
+static void
+clutter_clone_paint_source (ClutterClone *self,
+                            guint8        paint_opacity)
+{
+  ClutterClonePrivate *priv = self->priv;
+  gboolean was_unmapped = FALSE;
 
   /* The final bits of magic:
    * - We need to override the paint opacity of the actor with our own
@@ -174,8 +287,7 @@ clutter_clone_paint (ClutterActor *actor)
    *   the clone source actor.
    */
   _clutter_actor_set_in_clone_paint (priv->clone_source, TRUE);
-  clutter_actor_set_opacity_override (priv->clone_source,
-                                       clutter_actor_get_paint_opacity (actor));
+  clutter_actor_set_opacity_override (priv->clone_source, paint_opacity);
   _clutter_actor_set_enable_model_view_transform (priv->clone_source, FALSE);
 
   if (!clutter_actor_is_mapped (priv->clone_source))
@@ -202,6 +314,235 @@ clutter_clone_paint (ClutterActor *actor)
   _clutter_actor_set_in_clone_paint (priv->clone_source, FALSE);
 }
 
+static gboolean
+clutter_clone_update_paint_cache (ClutterClone *self,
+                                  PaintCache   *cache,
+                                  gint          scale)
+{
+  ClutterClonePrivate *priv = self->priv;
+  const ClutterPaintVolume *volume;
+  ClutterVertex origin;
+  CoglMatrix modelview;
+  gfloat x1, y1, x2, y2, z1, z2;
+  gint width, height;
+
+  /* the paint volume of the source, in the coordinate space of the
+   * source, is the area that we need to cache
+   */
+  volume = clutter_actor_get_paint_volume (priv->clone_source);
+  if (volume == NULL)
+    return FALSE;
+
+  clutter_paint_volume_get_origin (volume, &origin);
+
+  x1 = floorf (origin.x);
+  y1 = floorf (origin.y);
+  x2 = ceilf (origin.x + clutter_paint_volume_get_width (volume));
+  y2 = ceilf (origin.y + clutter_paint_volume_get_height (volume));
+  z1 = origin.z;
+  z2 = origin.z + clutter_paint_volume_get_depth (volume);
+
+  if (x2 <= x1 || y2 <= y1)
+    return FALSE;
+
+  if (!cache->is_dirty &&
+      cache->scale == scale &&
+      cache->x1 == x1 && cache->y1 == y1 &&
+      cache->x2 == x2 && cache->y2 == y2)
+    return TRUE;
+
+  width = (x2 - x1) * scale;
+  height = (y2 - y1) * scale;
+
+  if (cache->texture == NULL ||
+      cogl_texture_get_width (cache->texture) != width ||
+      cogl_texture_get_height (cache->texture) != height)
+    {
+      CoglContext *ctx =
+        clutter_backend_get_cogl_context (clutter_get_default_backend ());
+      GError *error = NULL;
+
+      if (cache->offscreen != NULL)
+        {
+          cogl_object_unref (cache->offscreen);
+          cache->offscreen = NULL;
+        }
+
+      if (cache->texture != NULL)
+        {
+          cogl_object_unref (cache->texture);
+          cache->texture = NULL;
+        }
+
+      cache->texture = cogl_texture_2d_new_with_size (ctx, width, height);
+      cache->offscreen =
+        COGL_FRAMEBUFFER (cogl_offscreen_new_with_texture (cache->texture));
+      if (!cogl_framebuffer_allocate (cache->offscreen, &error))
+        {
+          CLUTTER_NOTE (PAINT, "Unable to create an offscreen buffer "
+                               "of %dx%d for the source of clone '%s': %s",
+                        width, height,
+                        _clutter_actor_get_debug_name (CLUTTER_ACTOR (self)),
+                        error->message);
+
+          g_error_free (error);
+
+          cogl_object_unref (cache->offscreen);
+          cache->offscreen = NULL;
+          cogl_object_unref (cache->texture);
+          cache->texture = NULL;
+
+          return FALSE;
+        }
+
+      if (cache->pipeline == NULL)
+        cache->pipeline = cogl_pipeline_new (ctx);
+
+      cogl_pipeline_set_layer_texture (cache->pipeline, 0, cache->texture);
+    }
+
+  CLUTTER_NOTE (PAINT, "Updating the paint cache of '%s' (%dx%d)",
+                _clutter_actor_get_debug_name (priv->clone_source),
+                width, height);
+
+  cache->x1 = x1;
+  cache->y1 = y1;
+  cache->x2 = x2;
+  cache->y2 = y2;
+  cache->scale = scale;
+
+  /* the source is painted without its own transformation, so we
+   * only need to map its paint volume on the whole framebuffer
+   */
+  cogl_framebuffer_orthographic (cache->offscreen,
+                                 x1, y1, x2, y2,
+                                 -z2 - 1.f, -z1 + 1.f);
+
+  cogl_matrix_init_identity (&modelview);
+  cogl_framebuffer_set_modelview_matrix (cache->offscreen, &modelview);
+
+  cogl_framebuffer_clear4f (cache->offscreen,
+                            COGL_BUFFER_BIT_COLOR | COGL_BUFFER_BIT_DEPTH,
+                            0.f, 0.f, 0.f, 0.f);
+
+  /* actors paint on the current draw framebuffer */
+  cogl_push_framebuffer (cache->offscreen);
+
+  /* the paint opacity of the clone is applied when painting the
+   * cached texture
+   */
+  clutter_clone_paint_source (self, 0xff);
+
+  cogl_pop_framebuffer ();
+
+  cache->is_dirty = FALSE;
+
+  return TRUE;
+}
+
+static gfloat
+matrix_get_axis_scale (const CoglMatrix *matrix,
+                       gint              axis)
+{
+  const float *m = cogl_matrix_get_array (matrix);
+  const float *column = m + (axis * 4);
+
+  return sqrtf (column[0] * column[0]
+              + column[1] * column[1]
+              + column[2] * column[2]);
+}
+
+static gboolean
+clutter_clone_paint_cached (ClutterClone *self)
+{
+  ClutterActor *actor = CLUTTER_ACTOR (self);
+  ClutterClonePrivate *priv = self->priv;
+  ClutterStageWindow *stage_window;
+  ClutterActor *stage;
+  PaintCache *cache;
+  CoglFramebuffer *framebuffer;
+  CoglMatrix modelview, view;
+  gfloat unit_scale, x_scale, y_scale;
+  guint8 paint_opacity;
+  gint scale;
+
+  cache = g_object_get_qdata (G_OBJECT (priv->clone_source),
+                              quark_paint_cache);
+  if (cache == NULL)
+    return FALSE;
+
+  /* unrealized sources cannot be painted at all */
+  if (!clutter_actor_is_realized (priv->clone_source))
+    return TRUE;
+
+  stage = _clutter_actor_get_stage_internal (actor);
+  if (stage == NULL)
+    return FALSE;
+
+  stage_window = _clutter_stage_get_window (CLUTTER_STAGE (stage));
+  scale = stage_window != NULL
+        ? _clutter_stage_window_get_scale_factor (stage_window)
+        : 1;
+
+  /* compare the scale of the current modelview with the scale of the
+   * stage, to know how many device pixels a unit of the source will
+   * cover once the clone is painted
+   */
+  cogl_matrix_init_identity (&view);
+  _clutter_actor_apply_modelview_transform (stage, &view);
+  unit_scale = matrix_get_axis_scale (&view, 0) / scale;
+  if (unit_scale <= 0.f)
+    return FALSE;
+
+  framebuffer = cogl_get_draw_framebuffer ();
+  cogl_framebuffer_get_modelview_matrix (framebuffer, &modelview);
+  x_scale = matrix_get_axis_scale (&modelview, 0) / unit_scale;
+  y_scale = matrix_get_axis_scale (&modelview, 1) / unit_scale;
+
+  if (x_scale > scale * PAINT_CACHE_SCALE_THRESHOLD ||
+      y_scale > scale * PAINT_CACHE_SCALE_THRESHOLD)
+    {
+      CLUTTER_NOTE (PAINT, "Clone '%s' is scaled by %.2fx%.2f, "
+                           "painting its source directly",
+                    _clutter_actor_get_debug_name (actor),
+                    x_scale, y_scale);
+      return FALSE;
+    }
+
+  if (!clutter_clone_update_paint_cache (self, cache, scale))
+    return FALSE;
+
+  paint_opacity = clutter_actor_get_paint_opacity (actor);
+  cogl_pipeline_set_color4ub (cache->pipeline,
+                              paint_opacity,
+                              paint_opacity,
+                              paint_opacity,
+                              paint_opacity);
+  cogl_framebuffer_draw_rectangle (framebuffer, cache->pipeline,
+                                   cache->x1, cache->y1,
+                                   cache->x2, cache->y2);
+
+  return TRUE;
+}
+
+static void
+clutter_clone_paint (ClutterActor *actor)
+{
+  ClutterClone *self = CLUTTER_CLONE (actor);
+  ClutterClonePrivate *priv = self->priv;
+
+  if (priv->clone_source == NULL)
+    return;
+
+  CLUTTER_NOTE (PAINT, "painting clone actor '%s'",
+                _clutter_actor_get_debug_name (actor));
+
+  if (priv->cache_paint && clutter_clone_paint_cached (self))
+    return;
+
+  clutter_clone_paint_source (self, clutter_actor_get_paint_opacity (actor));
+}
+
 static gboolean
 clutter_clone_get_paint_volume (ClutterActor       *actor,
                                 ClutterPaintVolume *volume)
@@ -284,6 +625,10 @@ clutter_clone_set_property (GObject      *gobject,
       clutter_clone_set_source (self, g_value_get_object (value));
       break;
 
+    case PROP_CACHE_PAINT:
+      clutter_clone_set_cache_paint (self, g_value_get_boolean (value));
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id, pspec);
       break;
@@ -304,6 +649,10 @@ clutter_clone_get_property (GObject    *gobject,
       g_value_set_object (value, priv->clone_source);
       break;
 
+    case PROP_CACHE_PAINT:
+      g_value_set_boolean (value, priv->cache_paint);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id, pspec);
       break;
@@ -351,6 +700,30 @@ clutter_clone_class_init (ClutterCloneClass *klass)
                          G_PARAM_CONSTRUCT |
                          CLUTTER_PARAM_READWRITE);
 
+  /**
+   * ClutterClone:cache-paint:
+   *
+   * Whether the clone should paint a cached copy of its source,
+   * instead of painting the source again.
+   *
+   * The cache is rendered at most once per frame, and it is shared
+   * by all the clones of the same source that have this property
+   * set. The source is rendered into the cache using an orthographic
+   * projection, so this property should not be used if the children
+   * of the source rely on the perspective of the stage, or use an
+   * offscreen #ClutterEffect.
+   *
+   * Since: 1.28
+   */
+  obj_props[PROP_CACHE_PAINT] =
+    g_param_spec_boolean ("cache-paint",
+                          P_("Cache Paint"),
+                          P_("Whether to paint a cached copy of the source"),
+                          FALSE,
+                          CLUTTER_PARAM_READWRITE);
+
+  quark_paint_cache = g_quark_from_static_string ("-clutter-clone-paint-cache");
+
   g_object_class_install_properties (gobject_class, PROP_LAST, obj_props);
 }
 
@@ -387,6 +760,9 @@ clutter_clone_set_source_internal (ClutterClone *self,
 
   if (priv->clone_source != NULL)
     {
+      if (priv->cache_paint)
+        paint_cache_unref (priv->clone_source);
+
       _clutter_actor_detach_clone (priv->clone_source, CLUTTER_ACTOR (self));
       g_object_unref (priv->clone_source);
       priv->clone_source = NULL;
@@ -396,6 +772,9 @@ clutter_clone_set_source_internal (ClutterClone *self,
     {
       priv->clone_source = g_object_ref (source);
       _clutter_actor_attach_clone (priv->clone_source, CLUTTER_ACTOR (self));
+
+      if (priv->cache_paint)
+        paint_cache_ref (priv->clone_source);
     }
 
   g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_SOURCE]);
@@ -440,3 +819,64 @@ clutter_clone_get_source (ClutterClone *self)
 
   return self->priv->clone_source;
 }
+
+/**
+ * clutter_clone_set_cache_paint:
+ * @self: a #ClutterClone
+ * @cache_paint: whether @self should paint a cached copy of its source
+ *
+ * Sets whether @self should paint a copy of its source that is cached
+ * in a texture, and shared with the other clones of the same source,
+ * instead of painting the source directly.
+ *
+ * See #ClutterClone:cache-paint for the limitations of this mode.
+ *
+ * Since: 1.28
+ */
+void
+clutter_clone_set_cache_paint (ClutterClone *self,
+                               gboolean      cache_paint)
+{
+  ClutterClonePrivate *priv;
+
+  g_return_if_fail (CLUTTER_IS_CLONE (self));
+
+  priv = self->priv;
+
+  cache_paint = !!cache_paint;
+
+  if (priv->cache_paint == cache_paint)
+    return;
+
+  priv->cache_paint = cache_paint;
+
+  if (priv->clone_source != NULL)
+    {
+      if (priv->cache_paint)
+        paint_cache_ref (priv->clone_source);
+      else
+        paint_cache_unref (priv->clone_source);
+    }
+
+  clutter_actor_queue_redraw (CLUTTER_ACTOR (self));
+
+  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_CACHE_PAINT]);
+}
+
+/**
+ * clutter_clone_get_cache_paint:
+ * @self: a #ClutterClone
+ *
+ * Retrieves the value set using clutter_clone_set_cache_paint().
+ *
+ * Return value: %TRUE if the clone paints a cached copy of its source
+ *
+ * Since: 1.28
+ */
+gboolean
+clutter_clone_get_cache_paint (ClutterClone *self)
+{
+  g_return_val_if_fail (CLUTTER_IS_CLONE (self), FALSE);
+
+  return self->priv->cache_paint;
+}
@@ -89,6 +89,12 @@ void            clutter_clone_set_source        (ClutterClone *self,
 CLUTTER_AVAILABLE_IN_1_0
 ClutterActor *  clutter_clone_get_source        (ClutterClone *self);
 
+CLUTTER_AVAILABLE_IN_1_28
+void            clutter_clone_set_cache_paint   (ClutterClone *self,
+                                                 gboolean      cache_paint);
+CLUTTER_AVAILABLE_IN_1_28
+gboolean        clutter_clone_get_cache_paint   (ClutterClone *self);
+
 G_END_DECLS
 
 #endif /* __CLUTTER_CLONE_H__ */
@@ -0,0 +1,1052 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * SECTION:clutter-column-store
+ * @Title: ClutterColumnStore
+ * @Short_Description: A column-oriented list model
+ *
+ * #ClutterColumnStore is a #GListModel implementation that stores its
+ * data by column instead of by row: each column holds the values of
+ * a single type for every row in a contiguous array. The supported
+ * column types are %G_TYPE_FLOAT, %G_TYPE_INT, %G_TYPE_STRING and
+ * %CLUTTER_TYPE_COLOR.
+ *
+ * Rows are inserted and removed in ranges, and each change emits a
+ * single #GListModel::items-changed signal; the values are set one
+ * column slice at a time, and each change emits a single
+ * #ClutterColumnStore::values-changed signal for the range of rows
+ * that changed.
+ *
+ * The items of the model are #ClutterColumnStoreRow instances, which
+ * are created only when g_list_model_get_item() is called, and only
+ * reference a row of the store.
+ *
+ * When a #ClutterColumnStore is bound to an actor using
+ * clutter_actor_bind_model_with_properties(), the properties of the
+ * children are set directly from the columns, without creating the
+ * row instances or any #GBinding, which makes it possible to bind
+ * models with a very large number of rows.
+ *
+ * #ClutterColumnStore is available since Clutter 1.28
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+
+#include "clutter-column-store.h"
+
+#include "clutter-color.h"
+#include "clutter-debug.h"
+#include "clutter-marshal.h"
+#include "clutter-private.h"
+
+typedef struct {
+  gchar *name;
+  GType type;
+
+  /* one element per row; the element size depends on the type */
+  GArray *data;
+} Column;
+
+struct _ClutterColumnStorePrivate
+{
+  Column *columns;
+  guint n_columns;
+
+  guint n_rows;
+
+  /* the row instances that are alive, by index; they are not
+   * referenced, as they remove themselves when finalized
+   */
+  GHashTable *rows;
+};
+
+struct _ClutterColumnStoreRow
+{
+  GObject parent_instance;
+
+  ClutterColumnStore *store;
+
+  /* G_MAXUINT if the row was removed from the store */
+  guint index;
+};
+
+struct _ClutterColumnStoreRowClass
+{
+  GObjectClass parent_class;
+};
+
+enum
+{
+  VALUES_CHANGED,
+
+  LAST_SIGNAL
+};
+
+static guint column_store_signals[LAST_SIGNAL] = { 0, };
+
+static void g_list_model_iface_init (GListModelInterface *iface);
+
+G_DEFINE_TYPE_WITH_CODE (ClutterColumnStore, clutter_column_store, G_TYPE_OBJECT,
+                         G_ADD_PRIVATE (ClutterColumnStore)
+                         G_IMPLEMENT_INTERFACE (G_TYPE_LIST_MODEL,
+                                                g_list_model_iface_init))
+
+G_DEFINE_TYPE (ClutterColumnStoreRow, clutter_column_store_row, G_TYPE_OBJECT)
+
+#define INVALID_ROW     G_MAXUINT
+
+static gboolean
+column_type_is_supported (GType gtype)
+{
+  return gtype == G_TYPE_FLOAT ||
+         gtype == G_TYPE_INT ||
+         gtype == G_TYPE_STRING ||
+         gtype == CLUTTER_TYPE_COLOR;
+}
+
+static guint
+column_type_get_size (GType gtype)
+{
+  if (gtype == G_TYPE_FLOAT)
+    return sizeof (gfloat);
+
+  if (gtype == G_TYPE_INT)
+    return sizeof (gint);
+
+  if (gtype == G_TYPE_STRING)
+    return sizeof (gchar *);
+
+  if (gtype == CLUTTER_TYPE_COLOR)
+    return sizeof (ClutterColor);
+
+  g_assert_not_reached ();
+
+  return 0;
+}
+
+static void
+clear_string (gpointer data)
+{
+  gchar **str = data;
+
+  g_free (*str);
+  *str = NULL;
+}
+
+static inline Column *
+get_column (ClutterColumnStore *store,
+            guint               column,
+            GType               gtype)
+{
+  ClutterColumnStorePrivate *priv = store->priv;
+
+  if (column >= priv->n_columns)
+    {
+      g_critical ("Invalid column %u for a ClutterColumnStore with "
+                  "%u columns",
+                  column,
+                  priv->n_columns);
+      return NULL;
+    }
+
+  if (gtype != G_TYPE_INVALID && priv->columns[column].type != gtype)
+    {
+      g_critical ("The column %u of the ClutterColumnStore holds values "
+                  "of type '%s', not '%s'",
+                  column,
+                  g_type_name (priv->columns[column].type),
+                  g_type_name (gtype));
+      return NULL;
+    }
+
+  return &priv->columns[column];
+}
+
+/* updates the indices of the live rows after @removed rows have been
+ * replaced by @added rows at @position
+ */
+static void
+clutter_column_store_update_rows (ClutterColumnStore *store,
+                                  guint               position,
+                                  guint               removed,
+                                  guint               added)
+{
+  ClutterColumnStorePrivate *priv = store->priv;
+  GList *rows, *l;
+
+  if (g_hash_table_size (priv->rows) == 0)
+    return;
+
+  rows = g_hash_table_get_values (priv->rows);
+  g_hash_table_remove_all (priv->rows);
+
+  for (l = rows; l != NULL; l = l->next)
+    {
+      ClutterColumnStoreRow *row = l->data;
+
+      if (row->index >= position + removed)
+        row->index = row->index - removed + added;
+      else if (row->index >= position)
+        row->index = INVALID_ROW;
+
+      if (row->index != INVALID_ROW)
+        g_hash_table_insert (priv->rows, GUINT_TO_POINTER (row->index), row);
+    }
+
+  g_list_free (rows);
+}
+
+static GType
+clutter_column_store_get_item_type (GListModel *model)
+{
+  return CLUTTER_TYPE_COLUMN_STORE_ROW;
+}
+
+static guint
+clutter_column_store_get_n_items (GListModel *model)
+{
+  return CLUTTER_COLUMN_STORE (model)->priv->n_rows;
+}
+
+static gpointer
+clutter_column_store_get_item (GListModel *model,
+                               guint       position)
+{
+  ClutterColumnStore *store = CLUTTER_COLUMN_STORE (model);
+  ClutterColumnStorePrivate *priv = store->priv;
+  ClutterColumnStoreRow *row;
+
+  if (position >= priv->n_rows)
+    return NULL;
+
+  row = g_hash_table_lookup (priv->rows, GUINT_TO_POINTER (position));
+  if (row != NULL)
+    return g_object_ref (row);
+
+  row = g_object_new (CLUTTER_TYPE_COLUMN_STORE_ROW, NULL);
+  row->store = g_object_ref (store);
+  row->index = position;
+
+  g_hash_table_insert (priv->rows, GUINT_TO_POINTER (position), row);
+
+  return row;
+}
+
+static void
+g_list_model_iface_init (GListModelInterface *iface)
+{
+  iface->get_item_type = clutter_column_store_get_item_type;
+  iface->get_n_items = clutter_column_store_get_n_items;
+  iface->get_item = clutter_column_store_get_item;
+}
+
+static void
+clutter_column_store_finalize (GObject *gobject)
+{
+  ClutterColumnStorePrivate *priv = CLUTTER_COLUMN_STORE (gobject)->priv;
+  guint i;
+
+  /* every row holds a reference on the store */
+  g_assert (g_hash_table_size (priv->rows) == 0);
+  g_hash_table_unref (priv->rows);
+
+  for (i = 0; i < priv->n_columns; i++)
+    {
+      g_free (priv->columns[i].name);
+      g_array_unref (priv->columns[i].data);
+    }
+
+  g_free (priv->columns);
+
+  G_OBJECT_CLASS (clutter_column_store_parent_class)->finalize (gobject);
+}
+
+static void
+clutter_column_store_class_init (ClutterColumnStoreClass *klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+  gobject_class->finalize = clutter_column_store_finalize;
+
+  /**
+   * ClutterColumnStore::values-changed:
+   * @store: the #ClutterColumnStore that emitted the signal
+   * @position: the index of the first row that changed
+   * @n_rows: the number of rows that changed
+   *
+   * The ::values-changed signal is emitted each time the values of
+   * a range of rows are changed.
+   *
+   * Since: 1.28
+   */
+  column_store_signals[VALUES_CHANGED] =
+    g_signal_new (I_("values-changed"),
+                  G_TYPE_FROM_CLASS (klass),
+                  G_SIGNAL_RUN_LAST,
+                  G_STRUCT_OFFSET (ClutterColumnStoreClass, values_changed),
+                  NULL, NULL,
+                  _clutter_marshal_VOID__UINT_UINT,
+                  G_TYPE_NONE, 2,
+                  G_TYPE_UINT,
+                  G_TYPE_UINT);
+}
+
+static void
+clutter_column_store_init (ClutterColumnStore *self)
+{
+  self->priv = clutter_column_store_get_instance_private (self);
+
+  self->priv->rows = g_hash_table_new (NULL, NULL);
+}
+
+static void
+clutter_column_store_row_finalize (GObject *gobject)
+{
+  ClutterColumnStoreRow *row = CLUTTER_COLUMN_STORE_ROW (gobject);
+
+  if (row->store != NULL)
+    {
+      if (row->index != INVALID_ROW)
+        g_hash_table_remove (row->store->priv->rows, GUINT_TO_POINTER (row->index));
+
+      g_object_unref (row->store);
+    }
+
+  G_OBJECT_CLASS (clutter_column_store_row_parent_class)->finalize (gobject);
+}
+
+static void
+clutter_column_store_row_class_init (ClutterColumnStoreRowClass *klass)
+{
+  G_OBJECT_CLASS (klass)->finalize = clutter_column_store_row_finalize;
+}
+
+static void
+clutter_column_store_row_init (ClutterColumnStoreRow *self)
+{
+  self->index = INVALID_ROW;
+}
+
+/**
+ * clutter_column_store_newv: (rename-to clutter_column_store_new)
+ * @n_columns: the number of columns
+ * @types: (array length=n_columns): the types of the columns
+ * @names: (array length=n_columns): the names of the columns
+ *
+ * Creates a new #ClutterColumnStore with @n_columns columns, of the
+ * given @types and @names.
+ *
+ * This function is meant for language bindings; see
+ * clutter_column_store_new().
+ *
+ * Return value: (transfer full): the newly created #ClutterColumnStore
+ *
+ * Since: 1.28
+ */
+ClutterColumnStore *
+clutter_column_store_newv (guint               n_columns,
+                           const GType        *types,
+                           const gchar * const names[])
+{
+  ClutterColumnStorePrivate *priv;
+  ClutterColumnStore *store;
+  guint i;
+
+  g_return_val_if_fail (n_columns > 0, NULL);
+  g_return_val_if_fail (types != NULL, NULL);
+
+  for (i = 0; i < n_columns; i++)
+    {
+      if (!column_type_is_supported (types[i]))
+        {
+          g_critical ("%s: type '%s' of column %u is not supported",
+                      G_STRLOC,
+                      g_type_name (types[i]),
+                      i);
+          return NULL;
+        }
+    }
+
+  store = g_object_new (CLUTTER_TYPE_COLUMN_STORE, NULL);
+  priv = store->priv;
+
+  priv->n_columns = n_columns;
+  priv->columns = g_new0 (Column, n_columns);
+
+  for (i = 0; i < n_columns; i++)
+    {
+      Column *column = &priv->columns[i];
+
+      column->type = types[i];
+
+      /* like ClutterModel, we use the type name if unnamed */
+      if (names != NULL && names[i] != NULL)
+        column->name = g_strdup (names[i]);
+      else
+        column->name = g_strdup (g_type_name (types[i]));
+
+      column->data = g_array_new (FALSE, TRUE, column_type_get_size (types[i]));
+
+      if (types[i] == G_TYPE_STRING)
+        g_array_set_clear_func (column->data, clear_string);
+    }
+
+  return store;
+}
+
+/**
+ * clutter_column_store_new: (skip)
+ * @n_columns: the number of columns
+ * @...: @n_columns pairs of #GType and column name
+ *
+ * Creates a new #ClutterColumnStore with @n_columns columns of the
+ * given types and names, for instance:
+ *
+ * |[<!-- language="C" -->
+ *   store = clutter_column_store_new (3,
+ *                                     G_TYPE_STRING, "label",
+ *                                     G_TYPE_FLOAT, "opacity",
+ *                                     CLUTTER_TYPE_COLOR, "color");
+ * ]|
+ *
+ * Return value: (transfer full): the newly created #ClutterColumnStore
+ *
+ * Since: 1.28
+ */
+ClutterColumnStore *
+clutter_column_store_new (guint n_columns,
+                          ...)
+{
+  ClutterColumnStore *store;
+  const gchar **names;
+  GType *types;
+  va_list args;
+  guint i;
+
+  g_return_val_if_fail (n_columns > 0, NULL);
+
+  types = g_new (GType, n_columns);
+  names = g_new (const gchar *, n_columns);
+
+  va_start (args, n_columns);
+
+  for (i = 0; i < n_columns; i++)
+    {
+      types[i] = va_arg (args, GType);
+      names[i] = va_arg (args, const gchar *);
+    }
+
+  va_end (args);
+
+  store = clutter_column_store_newv (n_columns, types, names);
+
+  g_free (types);
+  g_free (names);
+
+  return store;
+}
+
+/**
+ * clutter_column_store_get_n_columns:
+ * @store: a #ClutterColumnStore
+ *
+ * Retrieves the number of columns of @store.
+ *
+ * Return value: the number of columns
+ *
+ * Since: 1.28
+ */
+guint
+clutter_column_store_get_n_columns (ClutterColumnStore *store)
+{
+  g_return_val_if_fail (CLUTTER_IS_COLUMN_STORE (store), 0);
+
+  return store->priv->n_columns;
+}
+
+/**
+ * clutter_column_store_get_column_type:
+ * @store: a #ClutterColumnStore
+ * @column: the index of a column
+ *
+ * Retrieves the type of the values of @column.
+ *
+ * Return value: a #GType
+ *
+ * Since: 1.28
+ */
+GType
+clutter_column_store_get_column_type (ClutterColumnStore *store,
+                                      guint               column)
+{
+  g_return_val_if_fail (CLUTTER_IS_COLUMN_STORE (store), G_TYPE_INVALID);
+  g_return_val_if_fail (column < store->priv->n_columns, G_TYPE_INVALID);
+
+  return store->priv->columns[column].type;
+}
+
+/**
+ * clutter_column_store_get_column_name:
+ * @store: a #ClutterColumnStore
+ * @column: the index of a column
+ *
+ * Retrieves the name of @column.
+ *
+ * Return value: the name of the column
+ *
+ * Since: 1.28
+ */
+const gchar *
+clutter_column_store_get_column_name (ClutterColumnStore *store,
+                                      guint               column)
+{
+  g_return_val_if_fail (CLUTTER_IS_COLUMN_STORE (store), NULL);
+  g_return_val_if_fail (column < store->priv->n_columns, NULL);
+
+  return store->priv->columns[column].name;
+}
+
+/**
+ * clutter_column_store_find_column:
+ * @store: a #ClutterColumnStore
+ * @name: the name of a column
+ *
+ * Retrieves the index of the first column named @name.
+ *
+ * Return value: the index of the column, or -1 if no column
+ *   is named @name
+ *
+ * Since: 1.28
+ */
+gint
+clutter_column_store_find_column (ClutterColumnStore *store,
+                                  const gchar        *name)
+{
+  ClutterColumnStorePrivate *priv;
+  guint i;
+
+  g_return_val_if_fail (CLUTTER_IS_COLUMN_STORE (store), -1);
+  g_return_val_if_fail (name != NULL, -1);
+
+  priv = store->priv;
+
+  for (i = 0; i < priv->n_columns; i++)
+    {
+      if (strcmp (priv->columns[i].name, name) == 0)
+        return i;
+    }
+
+  return -1;
+}
+
+/**
+ * clutter_column_store_insert_rows:
+ * @store: a #ClutterColumnStore
+ * @position: the index at which the rows should be inserted
+ * @n_rows: the number of rows to insert
+ *
+ * Inserts @n_rows rows at @position. The values of the new rows are
+ * zero, %NULL or transparent, depending on the type of the column.
+ *
+ * Since: 1.28
+ */
+void
+clutter_column_store_insert_rows (ClutterColumnStore *store,
+                                  guint               position,
+                                  guint               n_rows)
+{
+  ClutterColumnStorePrivate *priv;
+  guint i;
+
+  g_return_if_fail (CLUTTER_IS_COLUMN_STORE (store));
+  g_return_if_fail (position <= store->priv->n_rows);
+
+  if (n_rows == 0)
+    return;
+
+  priv = store->priv;
+
+  for (i = 0; i < priv->n_columns; i++)
+    {
+      GArray *data = priv->columns[i].data;
+      guint elt_size = g_array_get_element_size (data);
+      guint8 *base;
+
+      /* the array clears the new elements, so we only need to move
+       * the tail and clear the gap
+       */
+      g_array_set_size (data, priv->n_rows + n_rows);
+
+      base = (guint8 *) data->data;
+      memmove (base + (position + n_rows) * elt_size,
+               base + position * elt_size,
+               (priv->n_rows - position) * elt_size);
+      memset (base + position * elt_size, 0, n_rows * elt_size);
+    }
+
+  priv->n_rows += n_rows;
+
+  clutter_column_store_update_rows (store, position, 0, n_rows);
+
+  g_list_model_items_changed (G_LIST_MODEL (store), position, 0, n_rows);
+}
+
+/**
+ * clutter_column_store_remove_rows:
+ * @store: a #ClutterColumnStore
+ * @position: the index of the first row to remove
+ * @n_rows: the number of rows to remove
+ *
+ * Removes @n_rows rows, starting from @position.
+ *
+ * Since: 1.28
+ */
+void
+clutter_column_store_remove_rows (ClutterColumnStore *store,
+                                  guint               position,
+                                  guint               n_rows)
+{
+  ClutterColumnStorePrivate *priv;
+  guint i;
+
+  g_return_if_fail (CLUTTER_IS_COLUMN_STORE (store));
+  g_return_if_fail (position <= store->priv->n_rows);
+  g_return_if_fail (n_rows <= store->priv->n_rows - position);
+
+  if (n_rows == 0)
+    return;
+
+  priv = store->priv;
+
+  for (i = 0; i < priv->n_columns; i++)
+    g_array_remove_range (priv->columns[i].data, position, n_rows);
+
+  priv->n_rows -= n_rows;
+
+  clutter_column_store_update_rows (store, position, n_rows, 0);
+
+  g_list_model_items_changed (G_LIST_MODEL (store), position, n_rows, 0);
+}
+
+static gpointer
+clutter_column_store_get_slice (ClutterColumnStore *store,
+                                guint               column,
+                                GType               gtype,
+                                guint               position,
+                                guint               n_values)
+{
+  Column *c = get_column (store, column, gtype);
+
+  if (c == NULL)
+    return NULL;
+
+  if (position > store->priv->n_rows ||
+      n_values > store->priv->n_rows - position)
+    {
+      g_critical ("Invalid range [%u, %u) for a ClutterColumnStore with "
+                  "%u rows",
+                  position, position + n_values,
+                  store->priv->n_rows);
+      return NULL;
+    }
+
+  return c->data->data + position * g_array_get_element_size (c->data);
+}
+
+/**
+ * clutter_column_store_set_floats:
+ * @store: a #ClutterColumnStore
+ * @column: the index of a column of type %G_TYPE_FLOAT
+ * @position: the index of the first row to set
+ * @values: (array length=n_values): the values to set
+ * @n_values: the number of values
+ *
+ * Sets the values of @column for @n_values rows, starting from
+ * @position.
+ *
+ * Since: 1.28
+ */
+void
+clutter_column_store_set_floats (ClutterColumnStore *store,
+                                 guint               column,
+                                 guint               position,
+                                 const gfloat       *values,
+                                 guint               n_values)
+{
+  gfloat *slice;
+
+  g_return_if_fail (CLUTTER_IS_COLUMN_STORE (store));
+  g_return_if_fail (values != NULL || n_values == 0);
+
+  slice = clutter_column_store_get_slice (store, column, G_TYPE_FLOAT,
+                                          position,
+                                          n_values);
+  if (slice == NULL || n_values == 0)
+    return;
+
+  memcpy (slice, values, n_values * sizeof (gfloat));
+
+  g_signal_emit (store, column_store_signals[VALUES_CHANGED], 0,
+                 position,
+                 n_values);
+}
+
+/**
+ * clutter_column_store_set_ints:
+ * @store: a #ClutterColumnStore
+ * @column: the index of a column of type %G_TYPE_INT
+ * @position: the index of the first row to set
+ * @values: (array length=n_values): the values to set
+ * @n_values: the number of values
+ *
+ * Sets the values of @column for @n_values rows, starting from
+ * @position.
+ *
+ * Since: 1.28
+ */
+void
+clutter_column_store_set_ints (ClutterColumnStore *store,
+                               guint               column,
+                               guint               position,
+                               const gint         *values,
+                               guint               n_values)
+{
+  gint *slice;
+
+  g_return_if_fail (CLUTTER_IS_COLUMN_STORE (store));
+  g_return_if_fail (values != NULL || n_values == 0);
+
+  slice = clutter_column_store_get_slice (store, column, G_TYPE_INT,
+                                          position,
+                                          n_values);
+  if (slice == NULL || n_values == 0)
+    return;
+
+  memcpy (slice, values, n_values * sizeof (gint));
+
+  g_signal_emit (store, column_store_signals[VALUES_CHANGED], 0,
+                 position,
+                 n_values);
+}
+
+/**
+ * clutter_column_store_set_strings:
+ * @store: a #ClutterColumnStore
+ * @column: the index of a column of type %G_TYPE_STRING
+ * @position: the index of the first row to set
+ * @values: (array length=n_values): the values to set
+ * @n_values: the number of values
+ *
+ * Sets the values of @column for @n_values rows, starting from
+ * @position. The strings are copied.
+ *
+ * Since: 1.28
+ */
+void
+clutter_column_store_set_strings (ClutterColumnStore  *store,
+                                  guint                column,
+                                  guint                position,
+                                  const gchar * const *values,
+                                  guint                n_values)
+{
+  gchar **slice;
+  guint i;
+
+  g_return_if_fail (CLUTTER_IS_COLUMN_STORE (store));
+  g_return_if_fail (values != NULL || n_values == 0);
+
+  slice = clutter_column_store_get_slice (store, column, G_TYPE_STRING,
+                                          position,
+                                          n_values);
+  if (slice == NULL || n_values == 0)
+    return;
+
+  for (i = 0; i < n_values; i++)
+    {
+      gchar *str = g_strdup (values[i]);
+
+      g_free (slice[i]);
+      slice[i] = str;
+    }
+
+  g_signal_emit (store, column_store_signals[VALUES_CHANGED], 0,
+                 position,
+                 n_values);
+}
+
+/**
+ * clutter_column_store_set_colors:
+ * @store: a #ClutterColumnStore
+ * @column: the index of a column of type %CLUTTER_TYPE_COLOR
+ * @position: the index of the first row to set
+ * @values: (array length=n_values): the values to set
+ * @n_values: the number of values
+ *
+ * Sets the values of @column for @n_values rows, starting from
+ * @position.
+ *
+ * Since: 1.28
+ */
+void
+clutter_column_store_set_colors (ClutterColumnStore *store,
+                                 guint               column,
+                                 guint               position,
+                                 const ClutterColor *values,
+                                 guint               n_values)
+{
+  ClutterColor *slice;
+
+  g_return_if_fail (CLUTTER_IS_COLUMN_STORE (store));
+  g_return_if_fail (values != NULL || n_values == 0);
+
+  slice = clutter_column_store_get_slice (store, column, CLUTTER_TYPE_COLOR,
+                                          position,
+                                          n_values);
+  if (slice == NULL || n_values == 0)
+    return;
+
+  memcpy (slice, values, n_values * sizeof (ClutterColor));
+
+  g_signal_emit (store, column_store_signals[VALUES_CHANGED], 0,
+                 position,
+                 n_values);
+}
+
+/**
+ * clutter_column_store_get_float:
+ * @store: a #ClutterColumnStore
+ * @column: the index of a column of type %G_TYPE_FLOAT
+ * @row: the index of a row
+ *
+ * Retrieves the value of @column for @row.
+ *
+ * Return value: the value
+ *
+ * Since: 1.28
+ */
+gfloat
+clutter_column_store_get_float (ClutterColumnStore *store,
+                                guint               column,
+                                guint               row)
+{
+  gfloat *slice;
+
+  g_return_val_if_fail (CLUTTER_IS_COLUMN_STORE (store), 0.f);
+
+  slice = clutter_column_store_get_slice (store, column, G_TYPE_FLOAT, row, 1);
+  if (slice == NULL)
+    return 0.f;
+
+  return *slice;
+}
+
+/**
+ * clutter_column_store_get_int:
+ * @store: a #ClutterColumnStore
+ * @column: the index of a column of type %G_TYPE_INT
+ * @row: the index of a row
+ *
+ * Retrieves the value of @column for @row.
+ *
+ * Return value: the value
+ *
+ * Since: 1.28
+ */
+gint
+clutter_column_store_get_int (ClutterColumnStore *store,
+                              guint               column,
+                              guint               row)
+{
+  gint *slice;
+
+  g_return_val_if_fail (CLUTTER_IS_COLUMN_STORE (store), 0);
+
+  slice = clutter_column_store_get_slice (store, column, G_TYPE_INT, row, 1);
+  if (slice == NULL)
+    return 0;
+
+  return *slice;
+}
+
+/**
+ * clutter_column_store_get_string:
+ * @store: a #ClutterColumnStore
+ * @column: the index of a column of type %G_TYPE_STRING
+ * @row: the index of a row
+ *
+ * Retrieves the value of @column for @row.
+ *
+ * Return value: (nullable): the value; the string is owned by the
+ *   #ClutterColumnStore and should not be modified or freed
+ *
+ * Since: 1.28
+ */
+const gchar *
+clutter_column_store_get_string (ClutterColumnStore *store,
+                                 guint               column,
+                                 guint               row)
+{
+  gchar **slice;
+
+  g_return_val_if_fail (CLUTTER_IS_COLUMN_STORE (store), NULL);
+
+  slice = clutter_column_store_get_slice (store, column, G_TYPE_STRING, row, 1);
+  if (slice == NULL)
+    return NULL;
+
+  return *slice;
+}
+
+/**
+ * clutter_column_store_get_color:
+ * @store: a #ClutterColumnStore
+ * @column: the index of a column of type %CLUTTER_TYPE_COLOR
+ * @row: the index of a row
+ * @color: (out caller-allocates): return location for the value
+ *
+ * Retrieves the value of @column for @row.
+ *
+ * Since: 1.28
+ */
+void
+clutter_column_store_get_color (ClutterColumnStore *store,
+                                guint               column,
+                                guint               row,
+                                ClutterColor       *color)
+{
+  ClutterColor *slice;
+
+  g_return_if_fail (CLUTTER_IS_COLUMN_STORE (store));
+  g_return_if_fail (color != NULL);
+
+  slice = clutter_column_store_get_slice (store, column, CLUTTER_TYPE_COLOR, row, 1);
+  if (slice == NULL)
+    return;
+
+  *color = *slice;
+}
+
+/**
+ * clutter_column_store_get_value:
+ * @store: a #ClutterColumnStore
+ * @column: the index of a column
+ * @row: the index of a row
+ * @value: (out caller-allocates): an uninitialized #GValue
+ *
+ * Initializes @value with the type of @column, and sets it to the
+ * value of @column for @row.
+ *
+ * Since: 1.28
+ */
+void
+clutter_column_store_get_value (ClutterColumnStore *store,
+                                guint               column,
+                                guint               row,
+                                GValue             *value)
+{
+  Column *c;
+  gpointer slice;
+
+  g_return_if_fail (CLUTTER_IS_COLUMN_STORE (store));
+  g_return_if_fail (value != NULL);
+
+  c = get_column (store, column, G_TYPE_INVALID);
+  if (c == NULL)
+    return;
+
+  slice = clutter_column_store_get_slice (store, column, c->type, row, 1);
+  if (slice == NULL)
+    return;
+
+  g_value_init (value, c->type);
+
+  if (c->type == G_TYPE_FLOAT)
+    g_value_set_float (value, *(gfloat *) slice);
+  else if (c->type == G_TYPE_INT)
+    g_value_set_int (value, *(gint *) slice);
+  else if (c->type == G_TYPE_STRING)
+    g_value_set_string (value, *(gchar **) slice);
+  else if (c->type == CLUTTER_TYPE_COLOR)
+    g_value_set_boxed (value, slice);
+}
+
+/**
+ * clutter_column_store_row_get_store:
+ * @row: a #ClutterColumnStoreRow
+ *
+ * Retrieves the #ClutterColumnStore that created @row.
+ *
+ * Return value: (transfer none): a #ClutterColumnStore
+ *
+ * Since: 1.28
+ */
+ClutterColumnStore *
+clutter_column_store_row_get_store (ClutterColumnStoreRow *row)
+{
+  g_return_val_if_fail (CLUTTER_IS_COLUMN_STORE_ROW (row), NULL);
+
+  return row->store;
+}
+
+/**
+ * clutter_column_store_row_get_index:
+ * @row: a #ClutterColumnStoreRow
+ *
+ * Retrieves the index of @row inside its #ClutterColumnStore. The index
+ * is updated when rows are inserted or removed before @row.
+ *
+ * Return value: the index of the row, or %G_MAXUINT if the row was
+ *   removed from the store
+ *
+ * Since: 1.28
+ */
+guint
+clutter_column_store_row_get_index (ClutterColumnStoreRow *row)
+{
+  g_return_val_if_fail (CLUTTER_IS_COLUMN_STORE_ROW (row), INVALID_ROW);
+
+  return row->index;
+}
+
+/**
+ * clutter_column_store_row_get_value:
+ * @row: a #ClutterColumnStoreRow
+ * @column: the index of a column
+ * @value: (out caller-allocates): an uninitialized #GValue
+ *
+ * Retrieves the value of @column for @row; see
+ * clutter_column_store_get_value().
+ *
+ * Since: 1.28
+ */
+void
+clutter_column_store_row_get_value (ClutterColumnStoreRow *row,
+                                    guint                  column,
+                                    GValue                *value)
+{
+  g_return_if_fail (CLUTTER_IS_COLUMN_STORE_ROW (row));
+  g_return_if_fail (row->index != INVALID_ROW);
+
+  clutter_column_store_get_value (row->store, column, row->index, value);
+}
@@ -0,0 +1,182 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __CLUTTER_COLUMN_STORE_H__
+#define __CLUTTER_COLUMN_STORE_H__
+
+#if !defined(__CLUTTER_H_INSIDE__) && !defined(CLUTTER_COMPILATION)
+#error "Only <clutter/clutter.h> can be included directly."
+#endif
+
+#include <gio/gio.h>
+#include <clutter/clutter-types.h>
+
+G_BEGIN_DECLS
+
+#define CLUTTER_TYPE_COLUMN_STORE               (clutter_column_store_get_type ())
+#define CLUTTER_COLUMN_STORE(obj)               (G_TYPE_CHECK_INSTANCE_CAST ((obj), CLUTTER_TYPE_COLUMN_STORE, ClutterColumnStore))
+#define CLUTTER_IS_COLUMN_STORE(obj)            (G_TYPE_CHECK_INSTANCE_TYPE ((obj), CLUTTER_TYPE_COLUMN_STORE))
+#define CLUTTER_COLUMN_STORE_CLASS(klass)       (G_TYPE_CHECK_CLASS_CAST ((klass), CLUTTER_TYPE_COLUMN_STORE, ClutterColumnStoreClass))
+#define CLUTTER_IS_COLUMN_STORE_CLASS(klass)    (G_TYPE_CHECK_CLASS_TYPE ((klass), CLUTTER_TYPE_COLUMN_STORE))
+#define CLUTTER_COLUMN_STORE_GET_CLASS(obj)     (G_TYPE_INSTANCE_GET_CLASS ((obj), CLUTTER_TYPE_COLUMN_STORE, ClutterColumnStoreClass))
+
+#define CLUTTER_TYPE_COLUMN_STORE_ROW           (clutter_column_store_row_get_type ())
+#define CLUTTER_COLUMN_STORE_ROW(obj)           (G_TYPE_CHECK_INSTANCE_CAST ((obj), CLUTTER_TYPE_COLUMN_STORE_ROW, ClutterColumnStoreRow))
+#define CLUTTER_IS_COLUMN_STORE_ROW(obj)        (G_TYPE_CHECK_INSTANCE_TYPE ((obj), CLUTTER_TYPE_COLUMN_STORE_ROW))
+
+typedef struct _ClutterColumnStore              ClutterColumnStore;
+typedef struct _ClutterColumnStorePrivate       ClutterColumnStorePrivate;
+typedef struct _ClutterColumnStoreClass         ClutterColumnStoreClass;
+
+typedef struct _ClutterColumnStoreRow           ClutterColumnStoreRow;
+typedef struct _ClutterColumnStoreRowClass      ClutterColumnStoreRowClass;
+
+/**
+ * ClutterColumnStore:
+ *
+ * The #ClutterColumnStore structure contains only private data
+ * and should be accessed using the provided API.
+ *
+ * Since: 1.28
+ */
+struct _ClutterColumnStore
+{
+  /*< private >*/
+  GObject parent_instance;
+
+  ClutterColumnStorePrivate *priv;
+};
+
+/**
+ * ClutterColumnStoreClass:
+ * @values_changed: class handler for the #ClutterColumnStore::values-changed
+ *   signal
+ *
+ * The #ClutterColumnStoreClass structure contains only private data.
+ *
+ * Since: 1.28
+ */
+struct _ClutterColumnStoreClass
+{
+  /*< private >*/
+  GObjectClass parent_class;
+
+  /*< public >*/
+  void (* values_changed) (ClutterColumnStore *store,
+                           guint               position,
+                           guint               n_rows);
+
+  /*< private >*/
+  gpointer _padding[8];
+};
+
+CLUTTER_AVAILABLE_IN_1_28
+GType clutter_column_store_get_type (void) G_GNUC_CONST;
+CLUTTER_AVAILABLE_IN_1_28
+GType clutter_column_store_row_get_type (void) G_GNUC_CONST;
+
+CLUTTER_AVAILABLE_IN_1_28
+ClutterColumnStore *    clutter_column_store_new                (guint                n_columns,
+                                                                 ...);
+CLUTTER_AVAILABLE_IN_1_28
+ClutterColumnStore *    clutter_column_store_newv               (guint                n_columns,
+                                                                 const GType         *types,
+                                                                 const gchar * const  names[]);
+
+CLUTTER_AVAILABLE_IN_1_28
+guint                   clutter_column_store_get_n_columns      (ClutterColumnStore  *store);
+CLUTTER_AVAILABLE_IN_1_28
+GType                   clutter_column_store_get_column_type    (ClutterColumnStore  *store,
+                                                                 guint                column);
+CLUTTER_AVAILABLE_IN_1_28
+const gchar *           clutter_column_store_get_column_name    (ClutterColumnStore  *store,
+                                                                 guint                column);
+CLUTTER_AVAILABLE_IN_1_28
+gint                    clutter_column_store_find_column        (ClutterColumnStore  *store,
+                                                                 const gchar         *name);
+
+CLUTTER_AVAILABLE_IN_1_28
+void                    clutter_column_store_insert_rows        (ClutterColumnStore  *store,
+                                                                 guint                position,
+                                                                 guint                n_rows);
+CLUTTER_AVAILABLE_IN_1_28
+void                    clutter_column_store_remove_rows        (ClutterColumnStore  *store,
+                                                                 guint                position,
+                                                                 guint                n_rows);
+
+CLUTTER_AVAILABLE_IN_1_28
+void                    clutter_column_store_set_floats         (ClutterColumnStore  *store,
+                                                                 guint                column,
+                                                                 guint                position,
+                                                                 const gfloat        *values,
+                                                                 guint                n_values);
+CLUTTER_AVAILABLE_IN_1_28
+void                    clutter_column_store_set_ints           (ClutterColumnStore  *store,
+                                                                 guint                column,
+                                                                 guint                position,
+                                                                 const gint          *values,
+                                                                 guint                n_values);
+CLUTTER_AVAILABLE_IN_1_28
+void                    clutter_column_store_set_strings        (ClutterColumnStore  *store,
+                                                                 guint                column,
+                                                                 guint                position,
+                                                                 const gchar * const *values,
+                                                                 guint                n_values);
+CLUTTER_AVAILABLE_IN_1_28
+void                    clutter_column_store_set_colors         (ClutterColumnStore  *store,
+                                                                 guint                column,
+                                                                 guint                position,
+                                                                 const ClutterColor  *values,
+                                                                 guint                n_values);
+
+CLUTTER_AVAILABLE_IN_1_28
+gfloat                  clutter_column_store_get_float          (ClutterColumnStore  *store,
+                                                                 guint                column,
+                                                                 guint                row);
+CLUTTER_AVAILABLE_IN_1_28
+gint                    clutter_column_store_get_int            (ClutterColumnStore  *store,
+                                                                 guint                column,
+                                                                 guint                row);
+CLUTTER_AVAILABLE_IN_1_28
+const gchar *           clutter_column_store_get_string         (ClutterColumnStore  *store,
+                                                                 guint                column,
+                                                                 guint                row);
+CLUTTER_AVAILABLE_IN_1_28
+void                    clutter_column_store_get_color          (ClutterColumnStore  *store,
+                                                                 guint                column,
+                                                                 guint                row,
+                                                                 ClutterColor        *color);
+CLUTTER_AVAILABLE_IN_1_28
+void                    clutter_column_store_get_value          (ClutterColumnStore  *store,
+                                                                 guint                column,
+                                                                 guint                row,
+                                                                 GValue              *value);
+
+CLUTTER_AVAILABLE_IN_1_28
+ClutterColumnStore *    clutter_column_store_row_get_store      (ClutterColumnStoreRow *row);
+CLUTTER_AVAILABLE_IN_1_28
+guint                   clutter_column_store_row_get_index      (ClutterColumnStoreRow *row);
+CLUTTER_AVAILABLE_IN_1_28
+void                    clutter_column_store_row_get_value      (ClutterColumnStoreRow *row,
+                                                                 guint                  column,
+                                                                 GValue                *value);
+
+G_END_DECLS
+
+#endif /* __CLUTTER_COLUMN_STORE_H__ */
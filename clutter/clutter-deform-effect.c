@@ -49,6 +49,26 @@
  * Each passed vertex is an in-out parameter that initially contains the
  * position of the vertex and should be modified according to a specific
  * deformation algorithm.
+ *
+ * ## Deforming on the GPU
+ *
+ * Sub-classes can also override the
+ * #ClutterDeformEffectClass.create_vertex_snippet() virtual function to
+ * return a #CoglSnippet for the %COGL_SNIPPET_HOOK_VERTEX hook. In that
+ * case, if the GL driver supports GLSL, #ClutterDeformEffect will upload
+ * the undeformed grid of tiles only when the size of the actor or the
+ * number of tiles change, and the deformation will be computed entirely
+ * by the snippet. The snippet receives the undeformed position, in pixels,
+ * in `cogl_position_in`, and it is responsible for writing the transformed
+ * position to `cogl_position_out`.
+ *
+ * Sub-classes using a vertex snippet should also override the
+ * #ClutterDeformEffectClass.update_uniforms() virtual function, which is
+ * called before each paint to update the uniforms declared by the snippet,
+ * and should call clutter_deform_effect_invalidate() whenever the
+ * parameters of the deformation change. The
+ * #ClutterDeformEffectClass.deform_vertex() implementation is still used
+ * as a fallback when %CLUTTER_FEATURE_SHADERS_GLSL is not available.
  */
 
 #ifdef HAVE_CONFIG_H
@@ -80,11 +100,25 @@ struct _ClutterDeformEffectPrivate
 
   CoglPrimitive *lines_primitive;
 
+  /* the GPU path uses the same vertex buffer, but does not use the
+   * per-vertex color attribute
+   */
+  CoglPrimitive *grid_primitive;
+
+  CoglSnippet *vertex_snippet;
+  CoglPipeline *grid_pipeline;
+  CoglPipeline *grid_back_pipeline;
+
+  /* the size used when the undeformed grid was last uploaded */
+  gfloat grid_width;
+  gfloat grid_height;
+
   gint n_vertices;
 
   gulong allocation_id;
 
   guint is_dirty : 1;
+  guint grid_is_dirty : 1;
 };
 
 enum
@@ -163,119 +197,323 @@ clutter_deform_effect_set_actor (ClutterActorMeta *meta,
                                             meta);
 
   priv->is_dirty = TRUE;
+  priv->grid_is_dirty = TRUE;
 
   CLUTTER_ACTOR_META_CLASS (clutter_deform_effect_parent_class)->set_actor (meta, actor);
 }
 
 static void
-clutter_deform_effect_paint_target (ClutterOffscreenEffect *effect)
+clutter_deform_effect_update_uniforms (ClutterDeformEffect *self,
+                                       CoglPipeline        *pipeline,
+                                       gfloat               width,
+                                       gfloat               height)
+{
+  ClutterDeformEffectClass *klass = CLUTTER_DEFORM_EFFECT_GET_CLASS (self);
+
+  if (klass->update_uniforms != NULL)
+    klass->update_uniforms (self, pipeline, width, height);
+}
+
+/*< private >
+ * clutter_deform_effect_ensure_vertex_snippet:
+ * @self: a #ClutterDeformEffect
+ *
+ * Retrieves the vertex snippet of the sub-class, creating it the first
+ * time it is needed.
+ *
+ * Return value: (transfer none): the vertex snippet, or %NULL
+ */
+static CoglSnippet *
+clutter_deform_effect_ensure_vertex_snippet (ClutterDeformEffect *self)
 {
-  ClutterDeformEffect *self= CLUTTER_DEFORM_EFFECT (effect);
   ClutterDeformEffectPrivate *priv = self->priv;
-  CoglHandle material;
-  CoglPipeline *pipeline;
-  CoglDepthState depth_state;
-  CoglFramebuffer *fb = cogl_get_draw_framebuffer ();
 
-  if (priv->is_dirty)
+  if (priv->vertex_snippet == NULL)
     {
-      ClutterRect rect;
-      gboolean mapped_buffer;
-      CoglVertexP3T2C4 *verts;
-      ClutterActor *actor;
-      gfloat width, height;
-      guint opacity;
-      gint i, j;
-
-      actor = clutter_actor_meta_get_actor (CLUTTER_ACTOR_META (effect));
-      opacity = clutter_actor_get_paint_opacity (actor);
-
-      /* if we don't have a target size, fall back to the actor's
-       * allocation, though wrong it might be
-       */
-      if (clutter_offscreen_effect_get_target_rect (effect, &rect))
-        {
-          width = clutter_rect_get_width (&rect);
-          height = clutter_rect_get_height (&rect);
-        }
-      else
-        clutter_actor_get_size (actor, &width, &height);
+      ClutterDeformEffectClass *klass = CLUTTER_DEFORM_EFFECT_GET_CLASS (self);
 
-      /* XXX ideally, the sub-classes should tell us what they
-       * changed in the texture vertices; we then would be able to
-       * avoid resubmitting the same data, if it did not change. for
-       * the time being, we resubmit everything
-       */
-      verts = cogl_buffer_map (COGL_BUFFER (priv->buffer),
-                               COGL_BUFFER_ACCESS_WRITE,
-                               COGL_BUFFER_MAP_HINT_DISCARD);
+      priv->vertex_snippet = klass->create_vertex_snippet (self);
+      g_assert (priv->vertex_snippet == NULL ||
+                cogl_is_snippet (priv->vertex_snippet));
+    }
 
-      /* If the map failed then we'll resort to allocating a temporary
-         buffer */
-      if (verts == NULL)
-        {
-          mapped_buffer = FALSE;
-          verts = g_malloc (sizeof (*verts) * priv->n_vertices);
-        }
-      else
-        mapped_buffer = TRUE;
+  return priv->vertex_snippet;
+}
 
-      for (i = 0; i < priv->y_tiles + 1; i++)
+/*< private >
+ * clutter_deform_effect_use_vertex_snippet:
+ * @self: a #ClutterDeformEffect
+ *
+ * Checks whether the deformation can be computed on the GPU, that is
+ * whether the GL driver supports GLSL and the sub-class provides a
+ * vertex snippet.
+ */
+static gboolean
+clutter_deform_effect_use_vertex_snippet (ClutterDeformEffect *self)
+{
+  ClutterDeformEffectClass *klass = CLUTTER_DEFORM_EFFECT_GET_CLASS (self);
+
+  if (klass->create_vertex_snippet == NULL)
+    return FALSE;
+
+  if (!clutter_feature_available (CLUTTER_FEATURE_SHADERS_GLSL))
+    return FALSE;
+
+  return clutter_deform_effect_ensure_vertex_snippet (self) != NULL;
+}
+
+/*< private >
+ * clutter_deform_effect_update_vertices:
+ * @self: a #ClutterDeformEffect
+ * @width: the width of the deformed area
+ * @height: the height of the deformed area
+ * @opacity: the paint opacity
+ * @deform: whether the vertices should be passed to the
+ *   #ClutterDeformEffectClass.deform_vertex() virtual function
+ *
+ * Fills the vertex buffer with the grid of tiles, optionally deforming
+ * each vertex on the CPU.
+ */
+static void
+clutter_deform_effect_update_vertices (ClutterDeformEffect *self,
+                                       gfloat               width,
+                                       gfloat               height,
+                                       guint                opacity,
+                                       gboolean             deform)
+{
+  ClutterDeformEffectPrivate *priv = self->priv;
+  gboolean mapped_buffer;
+  CoglVertexP3T2C4 *verts;
+  gint i, j;
+
+  /* XXX ideally, the sub-classes should tell us what they
+   * changed in the texture vertices; we then would be able to
+   * avoid resubmitting the same data, if it did not change. for
+   * the time being, we resubmit everything
+   */
+  verts = cogl_buffer_map (COGL_BUFFER (priv->buffer),
+                           COGL_BUFFER_ACCESS_WRITE,
+                           COGL_BUFFER_MAP_HINT_DISCARD);
+
+  /* If the map failed then we'll resort to allocating a temporary
+     buffer */
+  if (verts == NULL)
+    {
+      mapped_buffer = FALSE;
+      verts = g_malloc (sizeof (*verts) * priv->n_vertices);
+    }
+  else
+    mapped_buffer = TRUE;
+
+  for (i = 0; i < priv->y_tiles + 1; i++)
+    {
+      for (j = 0; j < priv->x_tiles + 1; j++)
         {
-          for (j = 0; j < priv->x_tiles + 1; j++)
-            {
-              CoglVertexP3T2C4 *vertex_out;
-              CoglTextureVertex vertex;
-
-              /* CoglTextureVertex isn't an ideal structure to use for
-                 this because it contains a CoglColor. The internal
-                 layout of CoglColor is mean to be private so Clutter
-                 can not pass a pointer to it as a vertex
-                 attribute. Also it contains padding so we end up
-                 storing more data in the vertex buffer than we need
-                 to. Instead we let the application modify a dummy
-                 vertex and then copy the details back out to a more
-                 well-defined struct */
-
-              vertex.tx = (float) j / priv->x_tiles;
-              vertex.ty = (float) i / priv->y_tiles;
-
-              vertex.x = width * vertex.tx;
-              vertex.y = height * vertex.ty;
-              vertex.z = 0.0f;
-
-              cogl_color_init_from_4ub (&vertex.color, 255, 255, 255, opacity);
-
-              clutter_deform_effect_deform_vertex (self,
-                                                   width, height,
-                                                   &vertex);
-
-              vertex_out = verts + i * (priv->x_tiles + 1) + j;
-
-              vertex_out->x = vertex.x;
-              vertex_out->y = vertex.y;
-              vertex_out->z = vertex.z;
-              vertex_out->s = vertex.tx;
-              vertex_out->t = vertex.ty;
-              vertex_out->r = cogl_color_get_red_byte (&vertex.color);
-              vertex_out->g = cogl_color_get_green_byte (&vertex.color);
-              vertex_out->b = cogl_color_get_blue_byte (&vertex.color);
-              vertex_out->a = cogl_color_get_alpha_byte (&vertex.color);
-            }
+          CoglVertexP3T2C4 *vertex_out;
+          CoglTextureVertex vertex;
+
+          /* CoglTextureVertex isn't an ideal structure to use for
+             this because it contains a CoglColor. The internal
+             layout of CoglColor is mean to be private so Clutter
+             can not pass a pointer to it as a vertex
+             attribute. Also it contains padding so we end up
+             storing more data in the vertex buffer than we need
+             to. Instead we let the application modify a dummy
+             vertex and then copy the details back out to a more
+             well-defined struct */
+
+          vertex.tx = (float) j / priv->x_tiles;
+          vertex.ty = (float) i / priv->y_tiles;
+
+          vertex.x = width * vertex.tx;
+          vertex.y = height * vertex.ty;
+          vertex.z = 0.0f;
+
+          cogl_color_init_from_4ub (&vertex.color, 255, 255, 255, opacity);
+
+          if (deform)
+            clutter_deform_effect_deform_vertex (self,
+                                                 width, height,
+                                                 &vertex);
+
+          vertex_out = verts + i * (priv->x_tiles + 1) + j;
+
+          vertex_out->x = vertex.x;
+          vertex_out->y = vertex.y;
+          vertex_out->z = vertex.z;
+          vertex_out->s = vertex.tx;
+          vertex_out->t = vertex.ty;
+          vertex_out->r = cogl_color_get_red_byte (&vertex.color);
+          vertex_out->g = cogl_color_get_green_byte (&vertex.color);
+          vertex_out->b = cogl_color_get_blue_byte (&vertex.color);
+          vertex_out->a = cogl_color_get_alpha_byte (&vertex.color);
         }
+    }
 
-      if (mapped_buffer)
-        cogl_buffer_unmap (COGL_BUFFER (priv->buffer));
-      else
+  if (mapped_buffer)
+    cogl_buffer_unmap (COGL_BUFFER (priv->buffer));
+  else
+    {
+      cogl_buffer_set_data (COGL_BUFFER (priv->buffer),
+                            0, /* offset */
+                            verts,
+                            sizeof (*verts) * priv->n_vertices);
+      g_free (verts);
+    }
+}
+
+static void
+clutter_deform_effect_paint_grid (ClutterDeformEffect *self,
+                                  CoglFramebuffer     *fb,
+                                  gfloat               width,
+                                  gfloat               height,
+                                  guint                opacity)
+{
+  ClutterOffscreenEffect *effect = CLUTTER_OFFSCREEN_EFFECT (self);
+  ClutterDeformEffectPrivate *priv = self->priv;
+  CoglDepthState depth_state;
+  CoglHandle texture;
+
+  /* the undeformed grid only depends on the size of the target and
+   * on the number of tiles, so we can avoid touching the vertex buffer
+   * when the deformation alone changes
+   */
+  if (priv->grid_is_dirty ||
+      priv->grid_width != width ||
+      priv->grid_height != height)
+    {
+      clutter_deform_effect_update_vertices (self, width, height, 255, FALSE);
+
+      priv->grid_width = width;
+      priv->grid_height = height;
+      priv->grid_is_dirty = FALSE;
+    }
+
+  priv->is_dirty = FALSE;
+
+  cogl_depth_state_init (&depth_state);
+  cogl_depth_state_set_test_enabled (&depth_state, TRUE);
+
+  if (priv->grid_pipeline == NULL)
+    {
+      CoglContext *ctx =
+        clutter_backend_get_cogl_context (clutter_get_default_backend ());
+
+      priv->grid_pipeline = cogl_pipeline_new (ctx);
+      cogl_pipeline_add_snippet (priv->grid_pipeline,
+                                 clutter_deform_effect_ensure_vertex_snippet (self));
+      cogl_pipeline_set_layer_null_texture (priv->grid_pipeline,
+                                            0, /* layer number */
+                                            COGL_TEXTURE_TYPE_2D);
+      cogl_pipeline_set_depth_state (priv->grid_pipeline, &depth_state, NULL);
+    }
+
+  /* enable backface culling if we have a back material */
+  cogl_pipeline_set_cull_face_mode (priv->grid_pipeline,
+                                    priv->back_pipeline != NULL
+                                      ? COGL_PIPELINE_CULL_FACE_MODE_BACK
+                                      : COGL_PIPELINE_CULL_FACE_MODE_NONE);
+
+  texture = clutter_offscreen_effect_get_texture (effect);
+  if (texture != NULL)
+    {
+      cogl_pipeline_set_layer_texture (priv->grid_pipeline, 0, texture);
+      cogl_pipeline_set_color4ub (priv->grid_pipeline,
+                                  opacity,
+                                  opacity,
+                                  opacity,
+                                  opacity);
+      clutter_deform_effect_update_uniforms (self, priv->grid_pipeline,
+                                             width, height);
+
+      /* draw the front */
+      cogl_framebuffer_draw_primitive (fb, priv->grid_pipeline,
+                                       priv->grid_primitive);
+    }
+
+  /* draw the back */
+  if (priv->back_pipeline != NULL)
+    {
+      /* we keep a copy of the user's material with our snippet,
+       * which is dropped when the back material changes
+       */
+      if (priv->grid_back_pipeline == NULL)
         {
-          cogl_buffer_set_data (COGL_BUFFER (priv->buffer),
-                                0, /* offset */
-                                verts,
-                                sizeof (*verts) * priv->n_vertices);
-          g_free (verts);
+          priv->grid_back_pipeline = cogl_pipeline_copy (priv->back_pipeline);
+          cogl_pipeline_add_snippet (priv->grid_back_pipeline,
+                                     clutter_deform_effect_ensure_vertex_snippet (self));
+          cogl_pipeline_set_depth_state (priv->grid_back_pipeline,
+                                         &depth_state,
+                                         NULL);
+          cogl_pipeline_set_cull_face_mode (priv->grid_back_pipeline,
+                                            COGL_PIPELINE_CULL_FACE_MODE_FRONT);
         }
 
+      clutter_deform_effect_update_uniforms (self, priv->grid_back_pipeline,
+                                             width, height);
+
+      cogl_framebuffer_draw_primitive (fb, priv->grid_back_pipeline,
+                                       priv->grid_primitive);
+    }
+
+  if (G_UNLIKELY (priv->lines_primitive != NULL))
+    {
+      CoglContext *ctx =
+        clutter_backend_get_cogl_context (clutter_get_default_backend ());
+      CoglPipeline *lines_pipeline = cogl_pipeline_new (ctx);
+      cogl_pipeline_add_snippet (lines_pipeline,
+                                 clutter_deform_effect_ensure_vertex_snippet (self));
+      cogl_pipeline_set_color4f (lines_pipeline, 1.0, 0, 0, 1.0);
+      clutter_deform_effect_update_uniforms (self, lines_pipeline,
+                                             width, height);
+      cogl_framebuffer_draw_primitive (fb, lines_pipeline,
+                                       priv->lines_primitive);
+      cogl_object_unref (lines_pipeline);
+    }
+}
+
+static void
+clutter_deform_effect_paint_target (ClutterOffscreenEffect *effect)
+{
+  ClutterDeformEffect *self= CLUTTER_DEFORM_EFFECT (effect);
+  ClutterDeformEffectPrivate *priv = self->priv;
+  CoglHandle material;
+  CoglPipeline *pipeline;
+  CoglDepthState depth_state;
+  CoglFramebuffer *fb = cogl_get_draw_framebuffer ();
+  ClutterActor *actor;
+  ClutterRect rect;
+  gfloat width, height;
+  guint opacity;
+
+  actor = clutter_actor_meta_get_actor (CLUTTER_ACTOR_META (effect));
+  opacity = clutter_actor_get_paint_opacity (actor);
+
+  /* if we don't have a target size, fall back to the actor's
+   * allocation, though wrong it might be
+   */
+  if (clutter_offscreen_effect_get_target_rect (effect, &rect))
+    {
+      width = clutter_rect_get_width (&rect);
+      height = clutter_rect_get_height (&rect);
+    }
+  else
+    clutter_actor_get_size (actor, &width, &height);
+
+  if (clutter_deform_effect_use_vertex_snippet (self))
+    {
+      clutter_deform_effect_paint_grid (self, fb, width, height, opacity);
+      return;
+    }
+
+  if (priv->is_dirty)
+    {
+      clutter_deform_effect_update_vertices (self, width, height, opacity, TRUE);
+
       priv->is_dirty = FALSE;
+
+      /* the vertex buffer does not contain the undeformed grid any more */
+      priv->grid_is_dirty = TRUE;
     }
 
   material = clutter_offscreen_effect_get_target (effect);
@@ -346,6 +584,12 @@ clutter_deform_effect_free_arrays (ClutterDeformEffect *self)
       cogl_object_unref (priv->lines_primitive);
       priv->lines_primitive = NULL;
     }
+
+  if (priv->grid_primitive)
+    {
+      cogl_object_unref (priv->grid_primitive);
+      priv->grid_primitive = NULL;
+    }
 }
 
 static void
@@ -468,6 +712,19 @@ clutter_deform_effect_init_arrays (ClutterDeformEffect *self)
                               indices,
                               n_indices);
 
+  /* the deformation snippets take the color from the pipeline, so
+   * that changing the paint opacity does not require updating the
+   * vertex buffer
+   */
+  priv->grid_primitive =
+    cogl_primitive_new_with_attributes (COGL_VERTICES_MODE_TRIANGLE_STRIP,
+                                        priv->n_vertices,
+                                        attributes,
+                                        2 /* n_attributes */);
+  cogl_primitive_set_indices (priv->grid_primitive,
+                              indices,
+                              n_indices);
+
   if (G_UNLIKELY (clutter_paint_debug_flags & CLUTTER_DEBUG_PAINT_DEFORM_TILES))
     {
       priv->lines_primitive =
@@ -486,6 +743,7 @@ clutter_deform_effect_init_arrays (ClutterDeformEffect *self)
     cogl_object_unref (attributes[i]);
 
   priv->is_dirty = TRUE;
+  priv->grid_is_dirty = TRUE;
 }
 
 static inline void
@@ -498,6 +756,30 @@ clutter_deform_effect_free_back_pipeline (ClutterDeformEffect *self)
       cogl_object_unref (priv->back_pipeline);
       priv->back_pipeline = NULL;
     }
+
+  if (priv->grid_back_pipeline != NULL)
+    {
+      cogl_object_unref (priv->grid_back_pipeline);
+      priv->grid_back_pipeline = NULL;
+    }
+}
+
+static inline void
+clutter_deform_effect_free_grid_pipeline (ClutterDeformEffect *self)
+{
+  ClutterDeformEffectPrivate *priv = self->priv;
+
+  if (priv->grid_pipeline != NULL)
+    {
+      cogl_object_unref (priv->grid_pipeline);
+      priv->grid_pipeline = NULL;
+    }
+
+  if (priv->vertex_snippet != NULL)
+    {
+      cogl_object_unref (priv->vertex_snippet);
+      priv->vertex_snippet = NULL;
+    }
 }
 
 static void
@@ -507,6 +789,7 @@ clutter_deform_effect_finalize (GObject *gobject)
 
   clutter_deform_effect_free_arrays (self);
   clutter_deform_effect_free_back_pipeline (self);
+  clutter_deform_effect_free_grid_pipeline (self);
 
   G_OBJECT_CLASS (clutter_deform_effect_parent_class)->finalize (gobject);
 }
@@ -65,6 +65,12 @@ struct _ClutterDeformEffect
  * ClutterDeformEffectClass:
  * @deform_vertex: virtual function; sub-classes should override this
  *   function to compute the deformation of each vertex
+ * @create_vertex_snippet: virtual function; sub-classes can override
+ *   this function to return a handle to a #CoglSnippet that deforms the
+ *   vertices on the GPU. Available since 1.28
+ * @update_uniforms: virtual function; sub-classes implementing
+ *   @create_vertex_snippet should override this function to update the
+ *   uniforms used by the snippet. Available since 1.28
  *
  * The #ClutterDeformEffectClass structure contains
  * only private data
@@ -82,9 +88,13 @@ struct _ClutterDeformEffectClass
                           gfloat               height,
                           CoglTextureVertex   *vertex);
 
+  CoglHandle (* create_vertex_snippet) (ClutterDeformEffect *effect);
+  void       (* update_uniforms)       (ClutterDeformEffect *effect,
+                                        CoglHandle           pipeline,
+                                        gfloat               width,
+                                        gfloat               height);
+
   /*< private >*/
-  void (*_clutter_deform1) (void);
-  void (*_clutter_deform2) (void);
   void (*_clutter_deform3) (void);
   void (*_clutter_deform4) (void);
   void (*_clutter_deform5) (void);
@@ -134,6 +134,7 @@ struct _ClutterInputDevice
 
   guint has_cursor : 1;
   guint is_enabled : 1;
+  guint event_resampling : 1;
 };
 
 struct _ClutterInputDeviceClass
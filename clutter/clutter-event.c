@@ -61,6 +61,9 @@ typedef struct _ClutterEventPrivate {
   ClutterModifierType latched_state;
   ClutterModifierType locked_state;
 
+  /* the time of the event, in microseconds, if known */
+  gint64 time_usec;
+
   guint is_pointer_emulated : 1;
 } ClutterEventPrivate;
 
@@ -153,6 +156,49 @@ _clutter_event_set_pointer_emulated (ClutterEvent *event,
   ((ClutterEventPrivate *) event)->is_pointer_emulated = !!is_emulated;
 }
 
+void
+_clutter_event_set_time_usec (ClutterEvent *event,
+                              gint64        time_usec)
+{
+  if (!is_event_allocated (event))
+    return;
+
+  ((ClutterEventPrivate *) event)->time_usec = time_usec;
+}
+
+/*< private >
+ * _clutter_event_get_time_usec:
+ * @event: a #ClutterEvent
+ *
+ * Retrieves the time of @event in microseconds; if the backend did not
+ * provide a time with that granularity, the time in milliseconds of
+ * clutter_event_get_time() is used instead.
+ *
+ * The time in milliseconds wraps around every 49.7 days, so it is
+ * assumed to be in the same time base as g_get_monotonic_time(), and
+ * within 24 days of the current time.
+ *
+ * Return value: the time of the event, in microseconds
+ */
+gint64
+_clutter_event_get_time_usec (const ClutterEvent *event)
+{
+  gint64 now_ms;
+  guint32 time_ms;
+
+  if (is_event_allocated (event) &&
+      ((ClutterEventPrivate *) event)->time_usec != 0)
+    return ((ClutterEventPrivate *) event)->time_usec;
+
+  time_ms = clutter_event_get_time (event);
+  if (time_ms == CLUTTER_CURRENT_TIME)
+    return 0;
+
+  now_ms = g_get_monotonic_time () / 1000;
+
+  return (now_ms + (gint32) (time_ms - (guint32) now_ms)) * 1000;
+}
+
 /**
  * clutter_event_type:
  * @event: a #ClutterEvent
@@ -1265,6 +1311,7 @@ clutter_event_copy (const ClutterEvent *event)
       new_real_event->delta_x = real_event->delta_x;
       new_real_event->delta_y = real_event->delta_y;
       new_real_event->is_pointer_emulated = real_event->is_pointer_emulated;
+      new_real_event->time_usec = real_event->time_usec;
       new_real_event->base_state = real_event->base_state;
       new_real_event->button_state = real_event->button_state;
       new_real_event->latched_state = real_event->latched_state;
@@ -70,6 +70,34 @@
 #include "clutter-layout-meta.h"
 #include "clutter-private.h"
 
+/* the cell of a child along the flow; the cells are cached between
+ * layouts, so that changing a child only lays out the lines from the
+ * one containing the child
+ */
+typedef struct _FlowItem
+{
+  /* not referenced; only used to detect changes in the children */
+  ClutterActor *child;
+
+  /* offset and size of the cell along the flow, relative to the line */
+  gfloat offset;
+  gfloat size;
+} FlowItem;
+
+typedef struct _FlowLine
+{
+  guint first_item;
+  guint n_items;
+
+  /* size and offset of the line across the flow */
+  gfloat min_size;
+  gfloat natural_size;
+  gfloat offset;
+
+  /* the cells of the line changed since the last allocation */
+  guint needs_allocation : 1;
+} FlowLine;
+
 struct _ClutterFlowLayoutPrivate
 {
   ClutterContainer *container;
@@ -87,16 +115,30 @@ struct _ClutterFlowLayoutPrivate
   gfloat max_row_height;
   gfloat row_height;
 
-  /* per-line size */
-  GArray *line_min;
-  GArray *line_natural;
   gfloat req_width;
   gfloat req_height;
 
-  guint line_count;
+  /* array of FlowItem, one for each visible child */
+  GArray *items;
+
+  /* array of FlowLine; see clutter_flow_layout_update_lines() */
+  GArray *lines;
+  gfloat lines_for_size;
+  gint lines_items_per_line;
+
+  /* the sizes across the flow, computed from the lines */
+  gfloat lines_min_size;
+  gfloat lines_natural_size;
+  gfloat lines_total_size;
+
+  /* the origin of the last allocation */
+  gfloat allocation_x;
+  gfloat allocation_y;
 
   guint is_homogeneous : 1;
   guint snap_to_grid : 1;
+  guint lines_valid : 1;
+  guint allocation_valid : 1;
 };
 
 enum
@@ -170,198 +212,387 @@ get_rows (ClutterFlowLayout *self,
   return n_rows;
 }
 
-static gint
-compute_lines (ClutterFlowLayout *self,
-               gfloat             avail_width,
-               gfloat             avail_height)
+/* returns the index of the first line in @lines, starting from @start,
+ * whose first item is at or after @item
+ */
+static guint
+flow_lines_lower_bound (GArray *lines,
+                        guint   start,
+                        guint   item)
 {
-  ClutterFlowLayoutPrivate *priv = self->priv;
+  guint low = start, high = lines->len;
 
-  if (priv->orientation == CLUTTER_FLOW_HORIZONTAL)
-    return get_columns (self, avail_width);
-  else
-    return get_rows (self, avail_height);
+  while (low < high)
+    {
+      guint mid = low + (high - low) / 2;
+
+      if (g_array_index (lines, FlowLine, mid).first_item < item)
+        low = mid + 1;
+      else
+        high = mid;
+    }
+
+  return low;
 }
 
+/*
+ * clutter_flow_layout_update_lines:
+ * @self: a #ClutterFlowLayout
+ * @container: the container using the layout
+ * @for_size: the available size along the flow
+ *
+ * Breaks the visible children of @container into lines of at most
+ * @for_size along the flow.
+ *
+ * The line breaks of the previous call are kept, and only the lines
+ * from the one before the first child that was added, removed, moved
+ * or that queued a relayout are computed again; the computation stops
+ * as soon as a line starts at the same child as before, after the last
+ * changed child, since the lines following it cannot change either.
+ */
 static void
-clutter_flow_layout_get_preferred_width (ClutterLayoutManager *manager,
-                                         ClutterContainer     *container,
-                                         gfloat                for_height,
-                                         gfloat               *min_width_p,
-                                         gfloat               *nat_width_p)
+clutter_flow_layout_update_lines (ClutterFlowLayout *self,
+                                  ClutterActor      *container,
+                                  gfloat             for_size)
 {
-  ClutterFlowLayoutPrivate *priv = CLUTTER_FLOW_LAYOUT (manager)->priv;
-  gint n_rows, line_item_count, line_count;
-  gfloat total_min_width, total_natural_width;
-  gfloat line_min_width, line_natural_width;
-  gfloat max_min_width, max_natural_width;
-  ClutterActor *actor, *child;
+  ClutterFlowLayoutPrivate *priv = self->priv;
+  gboolean is_horizontal = priv->orientation == CLUTTER_FLOW_HORIZONTAL;
+  guint first_dirty, last_dirty, n_items;
+  guint start_line, end_line, restart_item, i;
+  gfloat spacing, line_spacing, pos;
+  gint items_per_line;
+  gboolean resync;
   ClutterActorIter iter;
-  gfloat item_y;
+  ClutterActor *child;
+  GArray *new_lines;
+  FlowLine line;
 
-  n_rows = get_rows (CLUTTER_FLOW_LAYOUT (manager), for_height);
+  if (is_horizontal)
+    {
+      items_per_line = get_columns (self, for_size);
+      spacing = priv->col_spacing;
+      line_spacing = priv->row_spacing;
+    }
+  else
+    {
+      items_per_line = get_rows (self, for_size);
+      spacing = priv->row_spacing;
+      line_spacing = priv->col_spacing;
+    }
 
-  total_min_width = 0;
-  total_natural_width = 0;
+  if (priv->lines_valid &&
+      (priv->lines_for_size != for_size ||
+       (priv->snap_to_grid && priv->lines_items_per_line != items_per_line)))
+    priv->lines_valid = FALSE;
 
-  line_min_width = 0;
-  line_natural_width = 0;
+  first_dirty = G_MAXUINT;
+  last_dirty = 0;
+  n_items = 0;
 
-  line_item_count = 0;
-  line_count = 0;
+  /* this is the only pass over all the children, and it does not
+   * query them, unless they changed
+   */
+  clutter_actor_iter_init (&iter, container);
+  while (clutter_actor_iter_next (&iter, &child))
+    {
+      FlowItem *item;
+      gboolean is_dirty;
 
-  item_y = 0;
+      if (!clutter_actor_is_visible (child))
+        continue;
 
-  actor = CLUTTER_ACTOR (container);
+      if (n_items == priv->items->len)
+        g_array_set_size (priv->items, n_items + 1);
 
-  /* clear the line width arrays */
-  if (priv->line_min != NULL)
-    g_array_free (priv->line_min, TRUE);
+      item = &g_array_index (priv->items, FlowItem, n_items);
 
-  if (priv->line_natural != NULL)
-    g_array_free (priv->line_natural, TRUE);
+      is_dirty = !clutter_actor_has_allocation (child);
 
-  priv->line_min = g_array_sized_new (FALSE, FALSE,
-                                      sizeof (gfloat),
-                                      16);
-  priv->line_natural = g_array_sized_new (FALSE, FALSE,
-                                          sizeof (gfloat),
-                                          16);
+      if (item->child != child)
+        {
+          item->child = child;
+          is_dirty = TRUE;
+        }
 
-  if (clutter_actor_get_n_children (actor) != 0)
-    line_count = 1;
+      if (is_dirty)
+        {
+          first_dirty = MIN (first_dirty, n_items);
+          last_dirty = n_items;
+        }
 
-  max_min_width = max_natural_width = 0;
+      n_items += 1;
+    }
 
-  clutter_actor_iter_init (&iter, actor);
-  while (clutter_actor_iter_next (&iter, &child))
+  /* some children were removed or hidden */
+  if (n_items < priv->items->len)
     {
+      first_dirty = MIN (first_dirty, n_items);
+      last_dirty = G_MAXUINT;
+    }
+
+  if (!priv->lines_valid)
+    {
+      g_array_set_size (priv->lines, 0);
+
+      first_dirty = 0;
+      last_dirty = G_MAXUINT;
+    }
+
+  g_array_set_size (priv->items, n_items);
+
+  if (first_dirty == G_MAXUINT)
+    return;
+
+  /* a change in the first child of a line can move it to the end of
+   * the line before, so we start from there; the empty line left by a
+   * first child larger than @for_size belongs to the line after it
+   */
+  start_line = flow_lines_lower_bound (priv->lines, 0, first_dirty + 1);
+  start_line = start_line > 0 ? start_line - 1 : 0;
+
+  if (start_line > 0)
+    start_line -= 1;
+
+  while (start_line > 0 &&
+         g_array_index (priv->lines, FlowLine, start_line - 1).n_items == 0)
+    start_line -= 1;
+
+  line.n_items = 0;
+  line.min_size = 0;
+  line.natural_size = 0;
+  line.needs_allocation = TRUE;
+
+  if (start_line < priv->lines->len)
+    {
+      line.first_item = g_array_index (priv->lines, FlowLine, start_line).first_item;
+      line.offset = g_array_index (priv->lines, FlowLine, start_line).offset;
+    }
+  else
+    {
+      line.first_item = 0;
+      line.offset = 0;
+    }
+
+  CLUTTER_NOTE (LAYOUT,
+                "Flow: updating lines from %u (item %u of %u) for size %.2f",
+                start_line, line.first_item, n_items,
+                for_size);
+
+  new_lines = g_array_new (FALSE, FALSE, sizeof (FlowLine));
+  end_line = priv->lines->len;
+  resync = FALSE;
+  pos = 0;
+
+  /* apart from the first one, a line starts because its first child
+   * did not fit in the line before, so we must not break it again
+   */
+  restart_item = line.first_item;
+
+  for (i = restart_item; i < n_items; i++)
+    {
+      FlowItem *item = &g_array_index (priv->items, FlowItem, i);
       gfloat child_min, child_natural;
-      gfloat new_y, item_height;
+      gfloat new_pos;
 
-      if (!clutter_actor_is_visible (child))
-        continue;
+      if (is_horizontal)
+        clutter_actor_get_preferred_width (item->child, -1,
+                                           &child_min,
+                                           &child_natural);
+      else
+        clutter_actor_get_preferred_height (item->child, -1,
+                                            &child_min,
+                                            &child_natural);
 
-      if (priv->orientation == CLUTTER_FLOW_VERTICAL && for_height > 0)
+      if ((i > restart_item || restart_item == 0) &&
+          ((priv->snap_to_grid && line.n_items == (guint) items_per_line) ||
+           (!priv->snap_to_grid && pos + child_natural > for_size)))
         {
-          clutter_actor_get_preferred_height (child, -1,
-                                              &child_min,
-                                              &child_natural);
+          gboolean was_empty = line.n_items == 0;
 
-          if ((priv->snap_to_grid && line_item_count == n_rows) ||
-              (!priv->snap_to_grid && item_y + child_natural > for_height))
-            {
-              total_min_width += line_min_width;
-              total_natural_width += line_natural_width;
+          g_array_append_val (new_lines, line);
 
-              g_array_append_val (priv->line_min,
-                                  line_min_width);
-              g_array_append_val (priv->line_natural,
-                                  line_natural_width);
+          line.first_item = i;
+          line.n_items = 0;
+          line.offset += line.natural_size + line_spacing;
+          line.min_size = line.natural_size = 0;
 
-              line_min_width = line_natural_width = 0;
+          pos = 0;
 
-              line_item_count = 0;
-              line_count += 1;
-              item_y = 0;
-            }
-
-          if (priv->snap_to_grid)
-            {
-              new_y = ((line_item_count + 1) * (for_height + priv->row_spacing))
-                    / n_rows;
-              item_height = new_y - item_y - priv->row_spacing;
-            }
-          else
+          /* past the last changed child, a line starting at the same
+           * child as before is followed by the same lines as before
+           */
+          if (!was_empty && i > last_dirty)
             {
-              new_y = item_y + child_natural + priv->row_spacing;
-              item_height = child_natural;
-            }
-
-          clutter_actor_get_preferred_width (child, item_height,
-                                             &child_min,
-                                             &child_natural);
+              end_line = flow_lines_lower_bound (priv->lines, start_line, i);
 
-          line_min_width = MAX (line_min_width, child_min);
-          line_natural_width = MAX (line_natural_width, child_natural);
+              if (end_line < priv->lines->len &&
+                  g_array_index (priv->lines, FlowLine, end_line).first_item == i)
+                {
+                  resync = TRUE;
+                  break;
+                }
 
-          item_y = new_y;
-          line_item_count += 1;
+              end_line = priv->lines->len;
+            }
+        }
 
-          max_min_width = MAX (max_min_width, line_min_width);
-          max_natural_width = MAX (max_natural_width, line_natural_width);
+      if (priv->snap_to_grid)
+        {
+          new_pos = ((line.n_items + 1) * (for_size + spacing))
+                  / items_per_line;
+          item->size = new_pos - pos - spacing;
         }
       else
         {
-          clutter_actor_get_preferred_width (child, for_height,
-                                             &child_min,
-                                             &child_natural);
+          new_pos = pos + child_natural + spacing;
+          item->size = child_natural;
+        }
 
-          max_min_width = MAX (max_min_width, child_min);
-          max_natural_width = MAX (max_natural_width, child_natural);
+      item->offset = pos;
 
-          total_min_width += max_min_width;
-          total_natural_width += max_natural_width;
-          line_count += 1;
-        }
+      if (is_horizontal)
+        clutter_actor_get_preferred_height (item->child, item->size,
+                                            &child_min,
+                                            &child_natural);
+      else
+        clutter_actor_get_preferred_width (item->child, item->size,
+                                           &child_min,
+                                           &child_natural);
+
+      line.min_size = MAX (line.min_size, child_min);
+      line.natural_size = MAX (line.natural_size, child_natural);
+
+      line.n_items += 1;
+      pos = new_pos;
     }
 
-  priv->col_width = max_natural_width;
+  if (resync)
+    {
+      gfloat delta;
 
-  if (priv->max_col_width > 0 && priv->col_width > priv->max_col_width)
-    priv->col_width = MAX (priv->max_col_width, max_min_width);
+      delta = line.offset - g_array_index (priv->lines, FlowLine, end_line).offset;
 
-  if (priv->col_width < priv->min_col_width)
-    priv->col_width = priv->min_col_width;
+      CLUTTER_NOTE (LAYOUT, "Flow: reusing lines from %u", end_line);
 
-  if (priv->orientation == CLUTTER_FLOW_VERTICAL && for_height > 0)
-    {
-      /* if we have a non-full row we need to add it */
-      if (line_item_count > 0)
+      for (i = end_line; i < priv->lines->len; i++)
         {
-          total_min_width += line_min_width;
-          total_natural_width += line_natural_width;
+          FlowLine *old_line = &g_array_index (priv->lines, FlowLine, i);
 
-          g_array_append_val (priv->line_min,
-                              line_min_width);
-          g_array_append_val (priv->line_natural,
-                              line_natural_width);
+          if (delta != 0)
+            {
+              old_line->offset += delta;
+              old_line->needs_allocation = TRUE;
+            }
         }
+    }
+  else if (line.n_items > 0)
+    g_array_append_val (new_lines, line);
 
-      priv->line_count = line_count;
+  g_array_remove_range (priv->lines, start_line, end_line - start_line);
 
-      if (priv->line_count > 0)
-        {
-          gfloat total_spacing;
+  if (new_lines->len > 0)
+    g_array_insert_vals (priv->lines, start_line,
+                         new_lines->data,
+                         new_lines->len);
 
-          total_spacing = priv->col_spacing * (priv->line_count - 1);
+  g_array_unref (new_lines);
 
-          total_min_width += total_spacing;
-          total_natural_width += total_spacing;
-        }
+  priv->lines_min_size = 0;
+  priv->lines_natural_size = 0;
+  priv->lines_total_size = 0;
+
+  for (i = 0; i < priv->lines->len; i++)
+    {
+      const FlowLine *l = &g_array_index (priv->lines, FlowLine, i);
+
+      priv->lines_min_size = MAX (priv->lines_min_size, l->min_size);
+      priv->lines_natural_size = MAX (priv->lines_natural_size, l->natural_size);
+    }
+
+  if (priv->lines->len > 0)
+    {
+      const FlowLine *l = &g_array_index (priv->lines, FlowLine, priv->lines->len - 1);
+
+      priv->lines_total_size = l->offset + l->natural_size;
+    }
+
+  priv->lines_for_size = for_size;
+  priv->lines_items_per_line = items_per_line;
+  priv->lines_valid = TRUE;
+}
+
+static void
+clutter_flow_layout_get_preferred_width (ClutterLayoutManager *manager,
+                                         ClutterContainer     *container,
+                                         gfloat                for_height,
+                                         gfloat               *min_width_p,
+                                         gfloat               *nat_width_p)
+{
+  ClutterFlowLayout *self = CLUTTER_FLOW_LAYOUT (manager);
+  ClutterFlowLayoutPrivate *priv = self->priv;
+  gfloat max_min_width, max_natural_width;
+  gfloat total_natural_width;
+  ClutterActor *actor, *child;
+  ClutterActorIter iter;
+  gint line_count;
+
+  actor = CLUTTER_ACTOR (container);
+
+  if (priv->orientation == CLUTTER_FLOW_VERTICAL && for_height > 0)
+    {
+      clutter_flow_layout_update_lines (self, actor, for_height);
+
+      max_min_width = priv->lines_min_size;
+      max_natural_width = priv->lines_natural_size;
+      total_natural_width = priv->lines_total_size;
+
+      line_count = priv->lines->len;
     }
   else
     {
-      g_array_append_val (priv->line_min, line_min_width);
-      g_array_append_val (priv->line_natural, line_natural_width);
+      total_natural_width = 0;
+      line_count = 0;
+
+      if (clutter_actor_get_n_children (actor) != 0)
+        line_count = 1;
 
-      priv->line_count = line_count;
+      max_min_width = max_natural_width = 0;
 
-      if (priv->line_count > 0)
+      clutter_actor_iter_init (&iter, actor);
+      while (clutter_actor_iter_next (&iter, &child))
         {
-          gfloat total_spacing;
+          gfloat child_min, child_natural;
+
+          if (!clutter_actor_is_visible (child))
+            continue;
 
-          total_spacing = priv->col_spacing * (priv->line_count - 1);
+          clutter_actor_get_preferred_width (child, for_height,
+                                             &child_min,
+                                             &child_natural);
+
+          max_min_width = MAX (max_min_width, child_min);
+          max_natural_width = MAX (max_natural_width, child_natural);
 
-          total_min_width += total_spacing;
-          total_natural_width += total_spacing;
+          total_natural_width += max_natural_width;
+          line_count += 1;
         }
+
+      if (line_count > 0)
+        total_natural_width += priv->col_spacing * (line_count - 1);
     }
 
+  priv->col_width = max_natural_width;
+
+  if (priv->max_col_width > 0 && priv->col_width > priv->max_col_width)
+    priv->col_width = MAX (priv->max_col_width, max_min_width);
+
+  if (priv->col_width < priv->min_col_width)
+    priv->col_width = priv->min_col_width;
+
   CLUTTER_NOTE (LAYOUT,
-                "Flow[w]: %d lines (%d per line): w [ %.2f, %.2f ] for h %.2f",
-                n_rows, priv->line_count,
-                total_min_width,
+                "Flow[w]: %d lines: w [ %.2f, %.2f ] for h %.2f",
+                line_count,
+                max_min_width,
                 total_natural_width,
                 for_height);
 
@@ -381,109 +612,44 @@ clutter_flow_layout_get_preferred_height (ClutterLayoutManager *manager,
                                           gfloat               *min_height_p,
                                           gfloat               *nat_height_p)
 {
-  ClutterFlowLayoutPrivate *priv = CLUTTER_FLOW_LAYOUT (manager)->priv;
-  gint n_columns, line_item_count, line_count;
-  gfloat total_min_height, total_natural_height;
-  gfloat line_min_height, line_natural_height;
+  ClutterFlowLayout *self = CLUTTER_FLOW_LAYOUT (manager);
+  ClutterFlowLayoutPrivate *priv = self->priv;
   gfloat max_min_height, max_natural_height;
+  gfloat total_natural_height;
   ClutterActor *actor, *child;
   ClutterActorIter iter;
-  gfloat item_x;
-
-  n_columns = get_columns (CLUTTER_FLOW_LAYOUT (manager), for_width);
-
-  total_min_height = 0;
-  total_natural_height = 0;
-
-  line_min_height = 0;
-  line_natural_height = 0;
-
-  line_item_count = 0;
-  line_count = 0;
-
-  item_x = 0;
+  gint line_count;
 
   actor = CLUTTER_ACTOR (container);
 
-  /* clear the line height arrays */
-  if (priv->line_min != NULL)
-    g_array_free (priv->line_min, TRUE);
-
-  if (priv->line_natural != NULL)
-    g_array_free (priv->line_natural, TRUE);
-
-  priv->line_min = g_array_sized_new (FALSE, FALSE,
-                                      sizeof (gfloat),
-                                      16);
-  priv->line_natural = g_array_sized_new (FALSE, FALSE,
-                                          sizeof (gfloat),
-                                          16);
-
-  if (clutter_actor_get_n_children (actor) != 0)
-    line_count = 1;
-
-  max_min_height = max_natural_height = 0;
-
-  clutter_actor_iter_init (&iter, actor);
-  while (clutter_actor_iter_next (&iter, &child))
+  if (priv->orientation == CLUTTER_FLOW_HORIZONTAL && for_width > 0)
     {
-      gfloat child_min, child_natural;
-      gfloat new_x, item_width;
-
-      if (!clutter_actor_is_visible (child))
-        continue;
-
-      if (priv->orientation == CLUTTER_FLOW_HORIZONTAL && for_width > 0)
-        {
-          clutter_actor_get_preferred_width (child, -1,
-                                             &child_min,
-                                             &child_natural);
-
-          if ((priv->snap_to_grid && line_item_count == n_columns) ||
-              (!priv->snap_to_grid && item_x + child_natural > for_width))
-            {
-              total_min_height += line_min_height;
-              total_natural_height += line_natural_height;
-
-              g_array_append_val (priv->line_min,
-                                  line_min_height);
-              g_array_append_val (priv->line_natural,
-                                  line_natural_height);
+      clutter_flow_layout_update_lines (self, actor, for_width);
 
-              line_min_height = line_natural_height = 0;
+      max_min_height = priv->lines_min_size;
+      max_natural_height = priv->lines_natural_size;
+      total_natural_height = priv->lines_total_size;
 
-              line_item_count = 0;
-              line_count += 1;
-              item_x = 0;
-            }
+      line_count = priv->lines->len;
+    }
+  else
+    {
+      total_natural_height = 0;
+      line_count = 0;
 
-          if (priv->snap_to_grid)
-            {
-              new_x = ((line_item_count + 1) * (for_width + priv->col_spacing))
-                    / n_columns;
-              item_width = new_x - item_x - priv->col_spacing;
-            }
-          else
-            {
-              new_x = item_x + child_natural + priv->col_spacing;
-              item_width = child_natural;
-            }
+      if (clutter_actor_get_n_children (actor) != 0)
+        line_count = 1;
 
-          clutter_actor_get_preferred_height (child, item_width,
-                                              &child_min,
-                                              &child_natural);
+      max_min_height = max_natural_height = 0;
 
-          line_min_height = MAX (line_min_height, child_min);
-          line_natural_height = MAX (line_natural_height, child_natural);
+      clutter_actor_iter_init (&iter, actor);
+      while (clutter_actor_iter_next (&iter, &child))
+        {
+          gfloat child_min, child_natural;
 
-          item_x = new_x;
-          line_item_count += 1;
+          if (!clutter_actor_is_visible (child))
+            continue;
 
-          max_min_height = MAX (max_min_height, line_min_height);
-          max_natural_height = MAX (max_natural_height, line_natural_height);
-        }
-      else
-        {
           clutter_actor_get_preferred_height (child, for_width,
                                               &child_min,
                                               &child_natural);
@@ -491,11 +657,12 @@ clutter_flow_layout_get_preferred_height (ClutterLayoutManager *manager,
           max_min_height = MAX (max_min_height, child_min);
           max_natural_height = MAX (max_natural_height, child_natural);
 
-          total_min_height += max_min_height;
           total_natural_height += max_natural_height;
-
           line_count += 1;
         }
+
+      if (line_count > 0)
+        total_natural_height += priv->col_spacing * line_count;
     }
 
   priv->row_height = max_natural_height;
@@ -506,53 +673,10 @@ clutter_flow_layout_get_preferred_height (ClutterLayoutManager *manager,
   if (priv->row_height < priv->min_row_height)
     priv->row_height = priv->min_row_height;
 
-  if (priv->orientation == CLUTTER_FLOW_HORIZONTAL && for_width > 0)
-    {
-      /* if we have a non-full row we need to add it */
-      if (line_item_count > 0)
-        {
-          total_min_height += line_min_height;
-          total_natural_height += line_natural_height;
-
-          g_array_append_val (priv->line_min,
-                              line_min_height);
-          g_array_append_val (priv->line_natural,
-                              line_natural_height);
-        }
-
-      priv->line_count = line_count;
-      if (priv->line_count > 0)
-        {
-          gfloat total_spacing;
-
-          total_spacing = priv->row_spacing * (priv->line_count - 1);
-
-          total_min_height += total_spacing;
-          total_natural_height += total_spacing;
-        }
-    }
-  else
-    {
-      g_array_append_val (priv->line_min, line_min_height);
-      g_array_append_val (priv->line_natural, line_natural_height);
-
-      priv->line_count = line_count;
-
-      if (priv->line_count > 0)
-        {
-          gfloat total_spacing;
-
-          total_spacing = priv->col_spacing * priv->line_count;
-
-          total_min_height += total_spacing;
-          total_natural_height += total_spacing;
-        }
-    }
-
   CLUTTER_NOTE (LAYOUT,
-                "Flow[h]: %d lines (%d per line): w [ %.2f, %.2f ] for h %.2f",
-                n_columns, priv->line_count,
-                total_min_height,
+                "Flow[h]: %d lines: h [ %.2f, %.2f ] for w %.2f",
+                line_count,
+                max_min_height,
                 total_natural_height,
                 for_width);
 
@@ -571,15 +695,13 @@ clutter_flow_layout_allocate (ClutterLayoutManager   *manager,
                               const ClutterActorBox  *allocation,
                               ClutterAllocationFlags  flags)
 {
-  ClutterFlowLayoutPrivate *priv = CLUTTER_FLOW_LAYOUT (manager)->priv;
-  ClutterActor *actor, *child;
-  ClutterActorIter iter;
+  ClutterFlowLayout *self = CLUTTER_FLOW_LAYOUT (manager);
+  ClutterFlowLayoutPrivate *priv = self->priv;
+  ClutterActor *actor;
   gfloat x_off, y_off;
   gfloat avail_width, avail_height;
-  gfloat item_x, item_y;
-  gint line_item_count;
-  gint items_per_line;
-  gint line_index;
+  gboolean allocate_all;
+  guint i, j;
 
   actor = CLUTTER_ACTOR (container);
   if (clutter_actor_get_n_children (actor) == 0)
@@ -603,143 +725,99 @@ clutter_flow_layout_allocate (ClutterLayoutManager   *manager,
                                                 NULL, NULL);
     }
 
-  items_per_line = compute_lines (CLUTTER_FLOW_LAYOUT (manager),
-                                  avail_width, avail_height);
-
-  item_x = x_off;
-  item_y = y_off;
+  if (priv->orientation == CLUTTER_FLOW_HORIZONTAL)
+    clutter_flow_layout_update_lines (self, actor, avail_width);
+  else
+    clutter_flow_layout_update_lines (self, actor, avail_height);
 
-  line_item_count = 0;
-  line_index = 0;
+  /* the children of the lines that did not change keep their
+   * allocation, unless the whole layout moved
+   */
+  allocate_all = !priv->allocation_valid ||
+                 (flags & CLUTTER_ABSOLUTE_ORIGIN_CHANGED) != 0 ||
+                 priv->allocation_x != x_off ||
+                 priv->allocation_y != y_off;
 
-  clutter_actor_iter_init (&iter, actor);
-  while (clutter_actor_iter_next (&iter, &child))
+  for (i = 0; i < priv->lines->len; i++)
     {
-      ClutterActorBox child_alloc;
-      gfloat item_width, item_height;
-      gfloat new_x, new_y;
-      gfloat child_min, child_natural;
+      FlowLine *line = &g_array_index (priv->lines, FlowLine, i);
 
-      if (!clutter_actor_is_visible (child))
+      if (!allocate_all && !line->needs_allocation)
         continue;
 
-      new_x = new_y = 0;
-
-      if (!priv->snap_to_grid)
-        clutter_actor_get_preferred_size (child,
-                                          NULL, NULL,
-                                          &item_width,
-                                          &item_height);
-
-      if (priv->orientation == CLUTTER_FLOW_HORIZONTAL)
+      for (j = line->first_item; j < line->first_item + line->n_items; j++)
         {
-          if ((priv->snap_to_grid &&
-               line_item_count == items_per_line && line_item_count > 0) ||
-              (!priv->snap_to_grid && item_x + item_width > avail_width))
+          const FlowItem *item = &g_array_index (priv->items, FlowItem, j);
+          ClutterActor *child = item->child;
+          ClutterActorBox child_alloc;
+          gfloat item_x, item_y;
+          gfloat item_width, item_height;
+          gfloat child_min, child_natural;
+
+          if (priv->orientation == CLUTTER_FLOW_HORIZONTAL)
             {
-              item_y += g_array_index (priv->line_natural,
-                                       gfloat,
-                                       line_index);
-
-              if (line_index >= 0)
-                item_y += priv->row_spacing;
-
-              line_item_count = 0;
-              line_index += 1;
-
-              item_x = x_off;
-            }
-
-          if (priv->snap_to_grid)
-            {
-              new_x = x_off + ((line_item_count + 1) * (avail_width + priv->col_spacing))
-                    / items_per_line;
-              item_width = new_x - item_x - priv->col_spacing;
+              item_x = x_off + item->offset;
+              item_y = y_off + line->offset;
+              item_width = item->size;
+              item_height = line->natural_size;
             }
           else
             {
-              new_x = item_x + item_width + priv->col_spacing;
+              item_x = x_off + line->offset;
+              item_y = y_off + item->offset;
+              item_width = line->natural_size;
+              item_height = item->size;
             }
 
-          item_height = g_array_index (priv->line_natural,
-                                       gfloat,
-                                       line_index);
-
-        }
-      else
-        {
-          if ((priv->snap_to_grid &&
-               line_item_count == items_per_line && line_item_count > 0) ||
-              (!priv->snap_to_grid && item_y + item_height > avail_height))
+          if (!priv->is_homogeneous &&
+              !clutter_actor_needs_expand (child,
+                                           CLUTTER_ORIENTATION_HORIZONTAL))
             {
-              item_x += g_array_index (priv->line_natural,
-                                       gfloat,
-                                       line_index);
-
-              if (line_index >= 0)
-                item_x += priv->col_spacing;
-
-              line_item_count = 0;
-              line_index += 1;
-
-              item_y = y_off;
+              clutter_actor_get_preferred_width (child, item_height,
+                                                 &child_min,
+                                                 &child_natural);
+              item_width = MIN (item_width, child_natural);
             }
 
-          if (priv->snap_to_grid)
+          if (!priv->is_homogeneous &&
+              !clutter_actor_needs_expand (child,
+                                           CLUTTER_ORIENTATION_VERTICAL))
             {
-              new_y = y_off + ((line_item_count + 1) * (avail_height + priv->row_spacing))
-                    / items_per_line;
-              item_height = new_y - item_y - priv->row_spacing;
-            }
-          else
-            {
-              new_y = item_y + item_height + priv->row_spacing;
+              clutter_actor_get_preferred_height (child, item_width,
+                                                  &child_min,
+                                                  &child_natural);
+              item_height = MIN (item_height, child_natural);
             }
 
-          item_width = g_array_index (priv->line_natural,
-                                      gfloat,
-                                      line_index);
+          CLUTTER_NOTE (LAYOUT,
+                        "flow[line:%u, item:%u/%u] ="
+                        "{ %.2f, %.2f, %.2f, %.2f }",
+                        i, j - line->first_item + 1, line->n_items,
+                        item_x, item_y, item_width, item_height);
+
+          child_alloc.x1 = ceil (item_x);
+          child_alloc.y1 = ceil (item_y);
+          child_alloc.x2 = ceil (child_alloc.x1 + item_width);
+          child_alloc.y2 = ceil (child_alloc.y1 + item_height);
+          clutter_actor_allocate (child, &child_alloc, flags);
         }
 
-      if (!priv->is_homogeneous &&
-          !clutter_actor_needs_expand (child,
-                                       CLUTTER_ORIENTATION_HORIZONTAL))
-        {
-          clutter_actor_get_preferred_width (child, item_height,
-                                             &child_min,
-                                             &child_natural);
-          item_width = MIN (item_width, child_natural);
-        }
-
-      if (!priv->is_homogeneous &&
-          !clutter_actor_needs_expand (child,
-                                       CLUTTER_ORIENTATION_VERTICAL))
-        {
-          clutter_actor_get_preferred_height (child, item_width,
-                                              &child_min,
-                                              &child_natural);
-          item_height = MIN (item_height, child_natural);
-        }
-
-      CLUTTER_NOTE (LAYOUT,
-                    "flow[line:%d, item:%d/%d] ="
-                    "{ %.2f, %.2f, %.2f, %.2f }",
-                    line_index, line_item_count + 1, items_per_line,
-                    item_x, item_y, item_width, item_height);
+      line->needs_allocation = FALSE;
+    }
 
-      child_alloc.x1 = ceil (item_x);
-      child_alloc.y1 = ceil (item_y);
-      child_alloc.x2 = ceil (child_alloc.x1 + item_width);
-      child_alloc.y2 = ceil (child_alloc.y1 + item_height);
-      clutter_actor_allocate (child, &child_alloc, flags);
+  priv->allocation_x = x_off;
+  priv->allocation_y = y_off;
+  priv->allocation_valid = TRUE;
+}
 
-      if (priv->orientation == CLUTTER_FLOW_HORIZONTAL)
-        item_x = new_x;
-      else
-        item_y = new_y;
+static void
+clutter_flow_layout_layout_changed (ClutterLayoutManager *manager)
+{
+  ClutterFlowLayoutPrivate *priv = CLUTTER_FLOW_LAYOUT (manager)->priv;
 
-      line_item_count += 1;
-    }
+  /* all the properties affect either the lines or the cells */
+  priv->lines_valid = FALSE;
+  priv->allocation_valid = FALSE;
 }
 
 static void
@@ -751,6 +829,11 @@ clutter_flow_layout_set_container (ClutterLayoutManager *manager,
 
   priv->container = container;
 
+  g_array_set_size (priv->items, 0);
+  g_array_set_size (priv->lines, 0);
+  priv->lines_valid = FALSE;
+  priv->allocation_valid = FALSE;
+
   if (priv->container != NULL)
     {
       ClutterRequestMode request_mode;
@@ -887,11 +970,8 @@ clutter_flow_layout_finalize (GObject *gobject)
 {
   ClutterFlowLayoutPrivate *priv = CLUTTER_FLOW_LAYOUT (gobject)->priv;
 
-  if (priv->line_min != NULL)
-    g_array_free (priv->line_min, TRUE);
-
-  if (priv->line_natural != NULL)
-    g_array_free (priv->line_natural, TRUE);
+  g_array_unref (priv->items);
+  g_array_unref (priv->lines);
 
   G_OBJECT_CLASS (clutter_flow_layout_parent_class)->finalize (gobject);
 }
@@ -911,6 +991,7 @@ clutter_flow_layout_class_init (ClutterFlowLayoutClass *klass)
     clutter_flow_layout_get_preferred_height;
   layout_class->allocate = clutter_flow_layout_allocate;
   layout_class->set_container = clutter_flow_layout_set_container;
+  layout_class->layout_changed = clutter_flow_layout_layout_changed;
 
   /**
    * ClutterFlowLayout:orientation:
@@ -1079,8 +1160,8 @@ clutter_flow_layout_init (ClutterFlowLayout *self)
   priv->min_col_width = priv->min_row_height = 0;
   priv->max_col_width = priv->max_row_height = -1;
 
-  priv->line_min = NULL;
-  priv->line_natural = NULL;
+  priv->items = g_array_new (FALSE, TRUE, sizeof (FlowItem));
+  priv->lines = g_array_new (FALSE, FALSE, sizeof (FlowLine));
   priv->snap_to_grid = TRUE;
 }
 
@@ -26,6 +26,11 @@
 
 G_BEGIN_DECLS
 
+gfloat  _clutter_gesture_action_get_fling_velocity      (ClutterGestureAction *action,
+                                                         guint                 point,
+                                                         gfloat               *velocity_x,
+                                                         gfloat               *velocity_y);
+
 G_END_DECLS
 
 #endif /* __CLUTTER_GESTURE_ACTION_PRIVATE_H__ */
@@ -91,6 +91,7 @@
 
 #include "clutter-debug.h"
 #include "clutter-enum-types.h"
+#include "clutter-event-private.h"
 #include "clutter-marshal.h"
 #include "clutter-private.h"
 
@@ -99,6 +100,21 @@
 #define MAX_GESTURE_POINTS (10)
 #define FLOAT_EPSILON   (1e-15)
 
+/* the velocity tracker keeps the most recent motion samples of each
+ * point, and fits a line through the ones inside the horizon; samples
+ * separated by a longer gap than the stop time are assumed to belong
+ * to a different movement
+ */
+#define VELOCITY_HISTORY_SIZE   (20)
+#define VELOCITY_HORIZON_USEC   (100000)
+#define VELOCITY_STOP_USEC      (40000)
+
+typedef struct
+{
+  gint64 time_us;
+  gfloat x, y;
+} VelocitySample;
+
 typedef struct
 {
   ClutterInputDevice *device;
@@ -111,6 +127,11 @@ typedef struct
   gint64 last_delta_time;
   gfloat last_delta_x, last_delta_y;
   gfloat release_x, release_y;
+
+  /* ring buffer, with samples_last the index of the newest sample */
+  VelocitySample samples[VELOCITY_HISTORY_SIZE];
+  guint n_samples;
+  guint samples_last;
 } GesturePoint;
 
 struct _ClutterGestureActionPrivate
@@ -156,6 +177,98 @@ static guint gesture_signals[LAST_SIGNAL] = { 0, };
 
 G_DEFINE_TYPE_WITH_PRIVATE (ClutterGestureAction, clutter_gesture_action, CLUTTER_TYPE_ACTION)
 
+static void
+gesture_point_add_sample (GesturePoint *point,
+                          ClutterEvent *event)
+{
+  VelocitySample *sample;
+  gint64 time_us;
+
+  time_us = _clutter_event_get_time_usec (event);
+
+  if (point->n_samples > 0)
+    {
+      sample = &point->samples[point->samples_last];
+
+      /* events with the same timestamp replace the newest sample */
+      if (time_us < sample->time_us)
+        return;
+
+      if (time_us > sample->time_us)
+        {
+          point->samples_last = (point->samples_last + 1) % VELOCITY_HISTORY_SIZE;
+          point->n_samples = MIN (point->n_samples + 1, VELOCITY_HISTORY_SIZE);
+        }
+    }
+  else
+    {
+      point->samples_last = 0;
+      point->n_samples = 1;
+    }
+
+  sample = &point->samples[point->samples_last];
+  sample->time_us = time_us;
+  clutter_event_get_coords (event, &sample->x, &sample->y);
+}
+
+/* least squares fit of a line through the recent samples; the slope
+ * is the velocity, in pixels per millisecond
+ */
+static void
+gesture_point_estimate_velocity (const GesturePoint *point,
+                                 gfloat             *velocity_x,
+                                 gfloat             *velocity_y)
+{
+  const VelocitySample *newest, *sample, *prev;
+  double sum_t = 0, sum_x = 0, sum_y = 0;
+  double sum_tt = 0, sum_tx = 0, sum_ty = 0;
+  double denominator;
+  guint i, n = 0;
+
+  *velocity_x = *velocity_y = 0.f;
+
+  if (point->n_samples < 2)
+    return;
+
+  newest = prev = &point->samples[point->samples_last];
+
+  for (i = 0; i < point->n_samples; i++)
+    {
+      double t;
+
+      sample = &point->samples[(point->samples_last + VELOCITY_HISTORY_SIZE - i) % VELOCITY_HISTORY_SIZE];
+
+      if (newest->time_us - sample->time_us > VELOCITY_HORIZON_USEC ||
+          prev->time_us - sample->time_us > VELOCITY_STOP_USEC)
+        break;
+
+      /* relative to the newest sample, in milliseconds, to keep the
+       * sums small
+       */
+      t = (double) (sample->time_us - newest->time_us) / 1000.0;
+
+      sum_t += t;
+      sum_x += sample->x;
+      sum_y += sample->y;
+      sum_tt += t * t;
+      sum_tx += t * sample->x;
+      sum_ty += t * sample->y;
+
+      prev = sample;
+      n += 1;
+    }
+
+  if (n < 2)
+    return;
+
+  denominator = n * sum_tt - sum_t * sum_t;
+  if (fabs (denominator) < FLOAT_EPSILON)
+    return;
+
+  *velocity_x = (n * sum_tx - sum_t * sum_x) / denominator;
+  *velocity_y = (n * sum_ty - sum_t * sum_y) / denominator;
+}
+
 static GesturePoint *
 gesture_register_point (ClutterGestureAction *action, ClutterEvent *event)
 {
@@ -179,6 +292,9 @@ gesture_register_point (ClutterGestureAction *action, ClutterEvent *event)
   point->last_delta_x = point->last_delta_y = 0;
   point->last_delta_time = 0;
 
+  point->n_samples = 0;
+  gesture_point_add_sample (point, event);
+
   if (clutter_event_type (event) != CLUTTER_BUTTON_PRESS)
     point->sequence = clutter_event_get_event_sequence (event);
   else
@@ -250,6 +366,8 @@ gesture_update_motion_point (GesturePoint *point,
   _time = clutter_event_get_time (event);
   point->last_delta_time = _time - point->last_motion_time;
   point->last_motion_time = _time;
+
+  gesture_point_add_sample (point, event);
 }
 
 static void
@@ -268,6 +386,11 @@ gesture_update_release_point (GesturePoint *point,
    * releasing it. */
    _time = clutter_event_get_time (event);
    point->last_delta_time += _time - point->last_motion_time;
+
+  /* this also makes the tracked velocity drop to zero if the pointer
+   * stopped before being released
+   */
+  gesture_point_add_sample (point, event);
 }
 
 static gint
@@ -1055,6 +1178,49 @@ clutter_gesture_action_get_velocity (ClutterGestureAction *action,
   return velocity;
 }
 
+/*< private >
+ * _clutter_gesture_action_get_fling_velocity:
+ * @action: a #ClutterGestureAction
+ * @point: the touch point index, with 0 being the first touch
+ *   point received by the action
+ * @velocity_x: (out) (allow-none): return location for the X velocity
+ * @velocity_y: (out) (allow-none): return location for the Y velocity
+ *
+ * Estimates the velocity, in stage pixels per millisecond, of the
+ * touch point over its most recent motion samples.
+ *
+ * Unlike clutter_gesture_action_get_velocity(), which only uses the
+ * last motion delta, the estimate is a least squares fit of the
+ * samples received in the last 100 milliseconds, which makes it
+ * resilient to noise in the timestamps and positions of the events.
+ *
+ * Return value: the magnitude of the velocity
+ */
+gfloat
+_clutter_gesture_action_get_fling_velocity (ClutterGestureAction *action,
+                                            guint                 point,
+                                            gfloat               *velocity_x,
+                                            gfloat               *velocity_y)
+{
+  gfloat v_x, v_y;
+
+  g_return_val_if_fail (CLUTTER_IS_GESTURE_ACTION (action), 0);
+  g_return_val_if_fail (action->priv->points->len > point, 0);
+
+  gesture_point_estimate_velocity (&g_array_index (action->priv->points,
+                                                   GesturePoint,
+                                                   point),
+                                   &v_x, &v_y);
+
+  if (velocity_x)
+    *velocity_x = v_x;
+
+  if (velocity_y)
+    *velocity_y = v_y;
+
+  return sqrtf (v_x * v_x + v_y * v_y);
+}
+
 /**
  * clutter_gesture_action_get_n_touch_points:
  * @action: a #ClutterGestureAction
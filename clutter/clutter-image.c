@@ -33,6 +33,15 @@
  * See [image.c](https://git.gnome.org/browse/clutter/tree/examples/image-content.c?h=clutter-1.18)
  * for an example of how to use #ClutterImage.
  *
+ * Small images share their texture storage with other images, so that
+ * many of them can be painted with a single draw call; replacing the
+ * image data with data of the same size and format reuses the same
+ * storage.
+ *
+ * Image files can be loaded without blocking the main loop by using
+ * clutter_image_load_async(): the image data is decoded in a worker
+ * thread, and then uploaded to the GPU during the following frames.
+ *
  * #ClutterImage is available since Clutter 1.10.
  */
 
@@ -48,15 +57,73 @@
 #include "clutter-color.h"
 #include "clutter-content-private.h"
 #include "clutter-debug.h"
+#include "clutter-main.h"
+#include "clutter-master-clock.h"
 #include "clutter-paint-node.h"
 #include "clutter-paint-nodes.h"
 #include "clutter-private.h"
+#include "clutter-stage-manager.h"
+
+/* images at least this large, in either dimension, get their own
+ * texture instead of being packed in the shared texture atlas
+ */
+#define ATLAS_MAX_SIZE          512
+
+/* the maximum number of threads decoding images at the same time */
+#define MAX_LOAD_THREADS        2
+
+/* the maximum amount of time spent uploading decoded images to the
+ * GPU in each frame, in microseconds
+ */
+#define UPLOAD_BUDGET_USEC      (5 * 1000)
 
 struct _ClutterImagePrivate
 {
   CoglTexture *texture;
+
+  /* the format of the data used to create the texture */
+  CoglPixelFormat pixel_format;
+
+  /* incremented each time the image data changes; asynchronous loads
+   * started before the last change are discarded
+   */
+  guint load_serial;
 };
 
+typedef struct _ClutterImageLoad
+{
+  gchar *filename;
+
+  CoglBitmap *bitmap;
+  GError *error;
+
+  gint io_priority;
+  guint serial;
+
+  /* used to keep loads with the same priority in FIFO order */
+  guint sequence;
+
+  /* the handler of GCancellable::cancelled, which completes the task
+   * immediately; the task stays in the queues until it is uploaded
+   */
+  gulong cancelled_id;
+
+  /* set by whoever returns the result of the task first, from either
+   * the main thread or the thread that cancelled the load
+   */
+  volatile gint completed;
+} ClutterImageLoad;
+
+/* the pool of threads decoding the image data, and the queue of the
+ * decoded images waiting to be uploaded; the upload queue is shared
+ * between the worker threads and the main thread
+ */
+static GThreadPool *load_thread_pool = NULL;
+static GQueue       upload_queue = G_QUEUE_INIT;
+static GMutex       upload_queue_lock;
+static guint        upload_repaint_func = 0;
+static guint        upload_idle = 0;
+
 static void clutter_content_iface_init (ClutterContentIface *iface);
 
 G_DEFINE_TYPE_WITH_CODE (ClutterImage, clutter_image, G_TYPE_OBJECT,
@@ -70,6 +137,24 @@ clutter_image_error_quark (void)
   return g_quark_from_static_string ("clutter-image-error-quark");
 }
 
+static void
+clutter_image_load_free (gpointer data)
+{
+  ClutterImageLoad *load = data;
+
+  if (load == NULL)
+    return;
+
+  g_free (load->filename);
+
+  if (load->bitmap != NULL)
+    cogl_object_unref (load->bitmap);
+
+  g_clear_error (&load->error);
+
+  g_slice_free (ClutterImageLoad, load);
+}
+
 static void
 clutter_image_finalize (GObject *gobject)
 {
@@ -84,6 +169,102 @@ clutter_image_finalize (GObject *gobject)
   G_OBJECT_CLASS (clutter_image_parent_class)->finalize (gobject);
 }
 
+/* Small images are packed by Cogl inside shared atlas textures; all the
+ * images in the same atlas use the same GL texture, which allows Cogl to
+ * batch their rectangles in a single draw call. Large images, or images
+ * much longer in one dimension than in the other, would force the atlas
+ * to grow, and to copy all the images it contains, so we give them
+ * their own texture instead.
+ */
+static CoglTextureFlags
+clutter_image_get_texture_flags (guint width,
+                                 guint height)
+{
+  if (width >= ATLAS_MAX_SIZE || height >= ATLAS_MAX_SIZE)
+    return COGL_TEXTURE_NO_ATLAS;
+
+  return COGL_TEXTURE_NONE;
+}
+
+static gboolean
+clutter_image_replace_texture (ClutterImage *image,
+                               CoglTexture  *texture,
+                               GError      **error)
+{
+  ClutterImagePrivate *priv = image->priv;
+
+  if (priv->texture != NULL)
+    cogl_object_unref (priv->texture);
+
+  priv->texture = texture;
+
+  /* any load in progress would overwrite the new image data */
+  priv->load_serial += 1;
+
+  if (priv->texture == NULL)
+    {
+      g_set_error_literal (error, CLUTTER_IMAGE_ERROR,
+                           CLUTTER_IMAGE_ERROR_INVALID_DATA,
+                           _("Unable to load image data"));
+      return FALSE;
+    }
+
+  clutter_content_invalidate (CLUTTER_CONTENT (image));
+
+  return TRUE;
+}
+
+static gboolean
+clutter_image_update_texture (ClutterImage     *image,
+                              const guint8     *data,
+                              CoglPixelFormat   pixel_format,
+                              guint             width,
+                              guint             height,
+                              guint             row_stride,
+                              GError          **error)
+{
+  ClutterImagePrivate *priv = image->priv;
+  CoglTexture *texture;
+
+  /* if the size and format did not change we can reuse the texture; this
+   * keeps the image in the same slot in the atlas, instead of freeing it
+   * and allocating a new one, which could cause the atlas to be
+   * reorganized
+   */
+  if (priv->texture != NULL &&
+      priv->pixel_format == pixel_format &&
+      cogl_texture_get_width (priv->texture) == width &&
+      cogl_texture_get_height (priv->texture) == height)
+    {
+      if (cogl_texture_set_region (priv->texture,
+                                   0, 0,
+                                   0, 0,
+                                   width, height,
+                                   width, height,
+                                   pixel_format,
+                                   row_stride,
+                                   data))
+        {
+          priv->load_serial += 1;
+
+          clutter_content_invalidate (CLUTTER_CONTENT (image));
+
+          return TRUE;
+        }
+    }
+
+  texture = cogl_texture_new_from_data (width, height,
+                                        clutter_image_get_texture_flags (width, height),
+                                        pixel_format,
+                                        COGL_PIXEL_FORMAT_ANY,
+                                        row_stride,
+                                        data);
+
+  priv->pixel_format = pixel_format;
+
+  return clutter_image_replace_texture (image, texture, error);
+}
+
 static void
 clutter_image_class_init (ClutterImageClass *klass)
 {
@@ -172,7 +353,10 @@ clutter_image_new (void)
  * In case of error, the @error value will be set, and this function will
  * return %FALSE.
  *
- * The image data is copied in texture memory.
+ * The image data is copied in texture memory. If the new image data has
+ * the same size and pixel format as the current one, the texture returned
+ * by clutter_image_get_texture() is updated in place; otherwise a new
+ * texture is created.
  *
  * The image data is expected to be a linear array of RGBA or RGB pixel data;
  * how to retrieve that data is left to platform specific image loaders. For
@@ -210,38 +394,15 @@ clutter_image_set_data (ClutterImage     *image,
                         guint             row_stride,
                         GError          **error)
 {
-  ClutterImagePrivate *priv;
-  CoglTextureFlags flags;
-
   g_return_val_if_fail (CLUTTER_IS_IMAGE (image), FALSE);
   g_return_val_if_fail (data != NULL, FALSE);
 
-  priv = image->priv;
-
-  if (priv->texture != NULL)
-    cogl_object_unref (priv->texture);
-
-  flags = COGL_TEXTURE_NONE;
-  if (width >= 512 && height >= 512)
-    flags |= COGL_TEXTURE_NO_ATLAS;
-
-  priv->texture = cogl_texture_new_from_data (width, height,
-                                              flags,
-                                              pixel_format,
-                                              COGL_PIXEL_FORMAT_ANY,
-                                              row_stride,
-                                              data);
-  if (priv->texture == NULL)
-    {
-      g_set_error_literal (error, CLUTTER_IMAGE_ERROR,
-                           CLUTTER_IMAGE_ERROR_INVALID_DATA,
-                           _("Unable to load image data"));
-      return FALSE;
-    }
-
-  clutter_content_invalidate (CLUTTER_CONTENT (image));
-
-  return TRUE;
+  return clutter_image_update_texture (image,
+                                       data,
+                                       pixel_format,
+                                       width, height,
+                                       row_stride,
+                                       error);
 }
 
 /**
@@ -262,7 +423,9 @@ clutter_image_set_data (ClutterImage     *image,
  * return %FALSE.
  *
  * The image data contained inside the #GBytes is copied in texture memory,
- * and no additional reference is acquired on the @data.
+ * and no additional reference is acquired on the @data. As with
+ * clutter_image_set_data(), the current texture is updated in place if
+ * the size and pixel format of the image data did not change.
  *
  * Return value: %TRUE if the image data was successfully loaded,
  *   and %FALSE otherwise.
@@ -278,38 +441,15 @@ clutter_image_set_bytes (ClutterImage     *image,
                          guint             row_stride,
                          GError          **error)
 {
-  ClutterImagePrivate *priv;
-  CoglTextureFlags flags;
-
   g_return_val_if_fail (CLUTTER_IS_IMAGE (image), FALSE);
   g_return_val_if_fail (data != NULL, FALSE);
 
-  priv = image->priv;
-
-  if (priv->texture != NULL)
-    cogl_object_unref (priv->texture);
-
-  flags = COGL_TEXTURE_NONE;
-  if (width >= 512 && height >= 512)
-    flags |= COGL_TEXTURE_NO_ATLAS;
-
-  priv->texture = cogl_texture_new_from_data (width, height,
-                                              flags,
-                                              pixel_format,
-                                              COGL_PIXEL_FORMAT_ANY,
-                                              row_stride,
-                                              g_bytes_get_data (data, NULL));
-  if (priv->texture == NULL)
-    {
-      g_set_error_literal (error, CLUTTER_IMAGE_ERROR,
-                           CLUTTER_IMAGE_ERROR_INVALID_DATA,
-                           _("Unable to load image data"));
-      return FALSE;
-    }
-
-  clutter_content_invalidate (CLUTTER_CONTENT (image));
-
-  return TRUE;
+  return clutter_image_update_texture (image,
+                                       g_bytes_get_data (data, NULL),
+                                       pixel_format,
+                                       width, height,
+                                       row_stride,
+                                       error);
 }
 
 /**
@@ -359,18 +499,15 @@ clutter_image_set_area (ClutterImage                 *image,
 
   if (priv->texture == NULL)
     {
-      CoglTextureFlags flags = COGL_TEXTURE_NONE;
-
-      if (area->width >= 512 && area->height >= 512)
-        flags |= COGL_TEXTURE_NO_ATLAS;
-
       priv->texture = cogl_texture_new_from_data (area->width,
                                                   area->height,
-                                                  flags,
+                                                  clutter_image_get_texture_flags (area->width,
+                                                                                   area->height),
                                                   pixel_format,
                                                   COGL_PIXEL_FORMAT_ANY,
                                                   row_stride,
                                                   data);
+      priv->pixel_format = pixel_format;
     }
   else
     {
@@ -392,6 +529,8 @@ clutter_image_set_area (ClutterImage                 *image,
         }
     }
 
+  priv->load_serial += 1;
+
   if (priv->texture == NULL)
     {
       g_set_error_literal (error, CLUTTER_IMAGE_ERROR,
@@ -415,6 +554,12 @@ clutter_image_set_area (ClutterImage                 *image,
  * to manually invalidate the @image with clutter_content_invalidate()
  * in order to update the actors using @image as their content.
  *
+ * Setting new image data with the same size and pixel format changes the
+ * contents of the returned texture, instead of replacing it; if you need
+ * to keep the current contents, you should copy them before calling
+ * clutter_image_set_data(), clutter_image_set_bytes() or
+ * clutter_image_set_area().
+ *
  * Return value: (transfer none): a pointer to the Cogl texture, or %NULL
  *
  * Since: 1.10
@@ -427,3 +572,394 @@ clutter_image_get_texture (ClutterImage *image)
 
   return image->priv->texture;
 }
+
+static void
+clutter_image_upload (GTask *task)
+{
+  ClutterImage *image = g_task_get_source_object (task);
+  ClutterImageLoad *load = g_task_get_task_data (task);
+  CoglTexture *texture;
+  GError *error = NULL;
+
+  if (load->cancelled_id != 0)
+    {
+      g_cancellable_disconnect (g_task_get_cancellable (task),
+                                load->cancelled_id);
+      load->cancelled_id = 0;
+    }
+
+  /* the task was already completed when it was cancelled */
+  if (!g_atomic_int_compare_and_exchange (&load->completed, FALSE, TRUE))
+    return;
+
+  if (g_task_return_error_if_cancelled (task))
+    {
+      CLUTTER_NOTE (TEXTURE, "[async] load of '%s' cancelled", load->filename);
+      return;
+    }
+
+  if (load->error != NULL)
+    {
+      g_task_return_error (task, load->error);
+      load->error = NULL;
+      return;
+    }
+
+  /* a newer load, or new image data, replaced this one */
+  if (load->serial != image->priv->load_serial)
+    {
+      CLUTTER_NOTE (TEXTURE, "[async] load of '%s' superseded", load->filename);
+      g_task_return_new_error (task, G_IO_ERROR, G_IO_ERROR_CANCELLED,
+                               _("The image data was replaced"));
+      return;
+    }
+
+  texture =
+    cogl_texture_new_from_bitmap (load->bitmap,
+                                  clutter_image_get_texture_flags (cogl_bitmap_get_width (load->bitmap),
+                                                                   cogl_bitmap_get_height (load->bitmap)),
+                                  COGL_PIXEL_FORMAT_ANY);
+  image->priv->pixel_format = cogl_bitmap_get_format (load->bitmap);
+
+  CLUTTER_NOTE (TEXTURE, "[async] uploaded '%s'", load->filename);
+
+  /* the decoded data is not needed any more */
+  cogl_object_unref (load->bitmap);
+  load->bitmap = NULL;
+
+  if (clutter_image_replace_texture (image, texture, &error))
+    g_task_return_boolean (task, TRUE);
+  else
+    g_task_return_error (task, error);
+}
+
+/* uploads the decoded images in the order in which they finished
+ * decoding, as long as we do not go over the budget; we always upload
+ * at least one image, to guarantee progress
+ *
+ * returns whether there are images left to upload
+ */
+static gboolean
+clutter_image_upload_queued (void)
+{
+  gint64 start_time;
+  gboolean pending;
+
+  start_time = g_get_monotonic_time ();
+
+  do
+    {
+      GTask *task;
+
+      g_mutex_lock (&upload_queue_lock);
+      task = g_queue_pop_head (&upload_queue);
+      g_mutex_unlock (&upload_queue_lock);
+
+      if (task == NULL)
+        break;
+
+      clutter_image_upload (task);
+      g_object_unref (task);
+    }
+  while (g_get_monotonic_time () < start_time + UPLOAD_BUDGET_USEC);
+
+  g_mutex_lock (&upload_queue_lock);
+  pending = !g_queue_is_empty (&upload_queue);
+  g_mutex_unlock (&upload_queue_lock);
+
+  return pending;
+}
+
+static void clutter_image_queue_upload (void);
+
+static gboolean
+clutter_image_has_active_stage (void)
+{
+  ClutterStageManager *stage_manager = clutter_stage_manager_get_default ();
+  const GSList *l;
+
+  for (l = clutter_stage_manager_peek_stages (stage_manager);
+       l != NULL;
+       l = l->next)
+    {
+      if (clutter_actor_is_mapped (l->data))
+        return TRUE;
+    }
+
+  return FALSE;
+}
+
+/* the repaint function only runs while there are images to upload;
+ * it is removed once the queue has been drained, and added again by
+ * clutter_image_queue_upload() when new images are queued
+ */
+static gboolean
+clutter_image_upload_repaint_func (gpointer data G_GNUC_UNUSED)
+{
+  gboolean pending;
+
+  pending = clutter_image_upload_queued ();
+
+  /* continue during the next frame */
+  if (pending && clutter_image_has_active_stage ())
+    {
+      _clutter_master_clock_ensure_next_iteration (_clutter_master_clock_get_default ());
+      return G_SOURCE_CONTINUE;
+    }
+
+  upload_repaint_func = 0;
+
+  /* the stages went away in the meantime */
+  if (pending)
+    clutter_image_queue_upload ();
+
+  return G_SOURCE_REMOVE;
+}
+
+static gboolean
+clutter_image_upload_idle (gpointer data G_GNUC_UNUSED)
+{
+  upload_idle = 0;
+
+  if (clutter_image_upload_queued ())
+    clutter_image_queue_upload ();
+
+  return G_SOURCE_REMOVE;
+}
+
+/* the uploads are spread over the frames of the master clock; if no
+ * stage is being painted there are no frames to wait for, and we use
+ * an idle source instead
+ */
+static void
+clutter_image_queue_upload (void)
+{
+  if (clutter_image_has_active_stage ())
+    {
+      if (upload_repaint_func == 0)
+        {
+          upload_repaint_func =
+            clutter_threads_add_repaint_func (clutter_image_upload_repaint_func,
+                                              NULL,
+                                              NULL);
+        }
+
+      _clutter_master_clock_ensure_next_iteration (_clutter_master_clock_get_default ());
+    }
+  else if (upload_idle == 0)
+    upload_idle = clutter_threads_add_idle (clutter_image_upload_idle, NULL);
+}
+
+static gboolean
+clutter_image_schedule_upload (gpointer data G_GNUC_UNUSED)
+{
+  clutter_image_queue_upload ();
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+clutter_image_thread_load (gpointer task_data,
+                           gpointer pool_data G_GNUC_UNUSED)
+{
+  GTask *task = task_data;
+  ClutterImageLoad *load = g_task_get_task_data (task);
+  gboolean was_empty;
+
+  /* do not bother decoding the image data of a cancelled load */
+  if (!g_cancellable_is_cancelled (g_task_get_cancellable (task)))
+    {
+      CLUTTER_NOTE (TEXTURE, "[async] decoding '%s'", load->filename);
+
+      load->bitmap = cogl_bitmap_new_from_file (load->filename, &load->error);
+
+      if (load->bitmap == NULL && load->error == NULL)
+        {
+          g_set_error_literal (&load->error, CLUTTER_IMAGE_ERROR,
+                               CLUTTER_IMAGE_ERROR_INVALID_DATA,
+                               _("Unable to load image data"));
+        }
+    }
+
+  /* the completion always happens on the main thread, and within the
+   * upload budget of each frame
+   */
+  g_mutex_lock (&upload_queue_lock);
+  was_empty = g_queue_is_empty (&upload_queue);
+  g_queue_push_tail (&upload_queue, task);
+  g_mutex_unlock (&upload_queue_lock);
+
+  if (was_empty)
+    clutter_threads_add_idle (clutter_image_schedule_upload, NULL);
+}
+
+static void
+clutter_image_load_cancelled (GCancellable *cancellable,
+                              gpointer      data)
+{
+  GTask *task = data;
+  ClutterImageLoad *load = g_task_get_task_data (task);
+
+  /* the task is still queued; it is released once it reaches the
+   * upload queue, without doing any work
+   */
+  if (g_atomic_int_compare_and_exchange (&load->completed, FALSE, TRUE))
+    {
+      CLUTTER_NOTE (TEXTURE, "[async] load of '%s' cancelled", load->filename);
+      g_task_return_error_if_cancelled (task);
+    }
+}
+
+static gint
+clutter_image_load_compare (gconstpointer a,
+                            gconstpointer b,
+                            gpointer      data G_GNUC_UNUSED)
+{
+  const ClutterImageLoad *load_a = g_task_get_task_data ((GTask *) a);
+  const ClutterImageLoad *load_b = g_task_get_task_data ((GTask *) b);
+
+  if (load_a->io_priority != load_b->io_priority)
+    return load_a->io_priority < load_b->io_priority ? -1 : 1;
+
+  if (load_a->sequence != load_b->sequence)
+    return load_a->sequence < load_b->sequence ? -1 : 1;
+
+  return 0;
+}
+
+/**
+ * clutter_image_load_async:
+ * @image: a #ClutterImage
+ * @file: the #GFile to load
+ * @io_priority: the I/O priority of the request, e.g. %G_PRIORITY_DEFAULT
+ * @cancellable: (nullable): a #GCancellable, or %NULL
+ * @callback: (scope async): a callback to call when the image data
+ *   has been loaded
+ * @user_data: data to pass to @callback
+ *
+ * Asynchronously loads the contents of @file into @image.
+ *
+ * The image data is decoded in a thread pool with a bounded number of
+ * threads; pending requests with a lower @io_priority value are decoded
+ * first. The decoded data is uploaded to the GPU on the main thread,
+ * while painting the following frames; at most a few milliseconds of
+ * each frame are spent uploading images, so that loading many images
+ * at once does not stall the frame rate.
+ *
+ * Once the image data has been uploaded, the @image is invalidated and
+ * @callback is called; you can then call clutter_image_load_finish() to
+ * get the result of the operation.
+ *
+ * If the image data of @image is changed before the load completes,
+ * for instance by calling this function again, the load will fail with
+ * a %G_IO_ERROR_CANCELLED error. Cancelling @cancellable completes the
+ * load immediately with the same error.
+ *
+ * Only files that have a local path are supported.
+ *
+ * Since: 1.28
+ */
+void
+clutter_image_load_async (ClutterImage        *image,
+                          GFile               *file,
+                          int                  io_priority,
+                          GCancellable        *cancellable,
+                          GAsyncReadyCallback  callback,
+                          gpointer             user_data)
+{
+  static guint load_sequence = 0;
+  ClutterImageLoad *load;
+  GTask *task;
+  gchar *filename;
+
+  g_return_if_fail (CLUTTER_IS_IMAGE (image));
+  g_return_if_fail (G_IS_FILE (file));
+  g_return_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable));
+
+  task = g_task_new (image, cancellable, callback, user_data);
+  g_task_set_source_tag (task, clutter_image_load_async);
+  g_task_set_priority (task, io_priority);
+
+  if (g_task_return_error_if_cancelled (task))
+    {
+      g_object_unref (task);
+      return;
+    }
+
+  filename = g_file_get_path (file);
+  if (filename == NULL)
+    {
+      gchar *uri = g_file_get_uri (file);
+
+      g_task_return_new_error (task, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                               _("Unable to load '%s': only local files "
+                                 "are supported"),
+                               uri);
+      g_object_unref (task);
+      g_free (uri);
+      return;
+    }
+
+  image->priv->load_serial += 1;
+
+  load = g_slice_new0 (ClutterImageLoad);
+  load->filename = filename;
+  load->io_priority = io_priority;
+  load->serial = image->priv->load_serial;
+  load->sequence = load_sequence++;
+  g_task_set_task_data (task, load, clutter_image_load_free);
+
+  if (cancellable != NULL)
+    {
+      load->cancelled_id =
+        g_cancellable_connect (cancellable,
+                               G_CALLBACK (clutter_image_load_cancelled),
+                               g_object_ref (task),
+                               g_object_unref);
+    }
+
+  if (G_UNLIKELY (load_thread_pool == NULL))
+    {
+      load_thread_pool = g_thread_pool_new (clutter_image_thread_load,
+                                            NULL,
+                                            MAX_LOAD_THREADS,
+                                            FALSE,
+                                            NULL);
+      g_thread_pool_set_sort_function (load_thread_pool,
+                                       clutter_image_load_compare,
+                                       NULL);
+    }
+
+  CLUTTER_NOTE (TEXTURE, "[async] queueing load of '%s' (priority: %d)",
+                filename,
+                io_priority);
+
+  /* the reference on the task is released after the upload */
+  g_thread_pool_push (load_thread_pool, task, NULL);
+}
+
+/**
+ * clutter_image_load_finish:
+ * @image: a #ClutterImage
+ * @result: the #GAsyncResult passed to the callback of
+ *   clutter_image_load_async()
+ * @error: return location for a #GError, or %NULL
+ *
+ * Finishes an asynchronous load started with clutter_image_load_async().
+ *
+ * Return value: %TRUE if the image data was successfully loaded,
+ *   and %FALSE otherwise
+ *
+ * Since: 1.28
+ */
+gboolean
+clutter_image_load_finish (ClutterImage  *image,
+                           GAsyncResult  *result,
+                           GError       **error)
+{
+  g_return_val_if_fail (CLUTTER_IS_IMAGE (image), FALSE);
+  g_return_val_if_fail (g_task_is_valid (result, image), FALSE);
+  g_return_val_if_fail (g_task_get_source_tag (G_TASK (result)) == clutter_image_load_async, FALSE);
+
+  return g_task_propagate_boolean (G_TASK (result), error);
+}
@@ -69,6 +69,8 @@ enum
   PROP_VENDOR_ID,
   PROP_PRODUCT_ID,
 
+  PROP_EVENT_RESAMPLING,
+
   PROP_LAST
 };
 
@@ -169,6 +171,10 @@ clutter_input_device_set_property (GObject      *gobject,
       self->product_id = g_value_dup_string (value);
       break;
 
+    case PROP_EVENT_RESAMPLING:
+      clutter_input_device_set_event_resampling (self, g_value_get_boolean (value));
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id, pspec);
       break;
@@ -229,6 +235,10 @@ clutter_input_device_get_property (GObject    *gobject,
       g_value_set_string (value, self->product_id);
       break;
 
+    case PROP_EVENT_RESAMPLING:
+      g_value_set_boolean (value, self->event_resampling);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id, pspec);
       break;
@@ -406,6 +416,23 @@ clutter_input_device_class_init (ClutterInputDeviceClass *klass)
                          NULL,
                          CLUTTER_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY);
 
+  /**
+   * ClutterInputDevice:event-resampling:
+   *
+   * Whether the motion and touch update events of the device should be
+   * resampled at the time the next frame is presented.
+   *
+   * See clutter_input_device_set_event_resampling().
+   *
+   * Since: 1.28
+   */
+  obj_props[PROP_EVENT_RESAMPLING] =
+    g_param_spec_boolean ("event-resampling",
+                          P_("Event Resampling"),
+                          P_("Whether motion events are resampled at the frame time"),
+                          FALSE,
+                          CLUTTER_PARAM_READWRITE);
+
   gobject_class->dispose = clutter_input_device_dispose;
   gobject_class->set_property = clutter_input_device_set_property;
   gobject_class->get_property = clutter_input_device_get_property;
@@ -867,6 +894,60 @@ clutter_input_device_get_enabled (ClutterInputDevice *device)
   return device->is_enabled;
 }
 
+/**
+ * clutter_input_device_set_event_resampling:
+ * @device: a #ClutterInputDevice
+ * @resampling: %TRUE to resample the events of @device
+ *
+ * Sets whether the motion and touch update events of @device should be
+ * resampled.
+ *
+ * When a #ClutterStage compresses the motion events received between
+ * two frames (see clutter_stage_set_throttle_motion_events()), the
+ * position carried by the last event depends on when the device was
+ * sampled, which is not synchronized with the refresh of the display;
+ * this results in dragged content moving unevenly. If resampling is
+ * enabled, the stage keeps a short history of the positions of each
+ * pointer and touch point of @device, and the compressed event is moved
+ * to the position interpolated, or conservatively extrapolated, at the
+ * time the next frame is expected to be presented.
+ *
+ * Since: 1.28
+ */
+void
+clutter_input_device_set_event_resampling (ClutterInputDevice *device,
+                                           gboolean            resampling)
+{
+  g_return_if_fail (CLUTTER_IS_INPUT_DEVICE (device));
+
+  resampling = !!resampling;
+
+  if (device->event_resampling == resampling)
+    return;
+
+  device->event_resampling = resampling;
+
+  g_object_notify_by_pspec (G_OBJECT (device), obj_props[PROP_EVENT_RESAMPLING]);
+}
+
+/**
+ * clutter_input_device_get_event_resampling:
+ * @device: a #ClutterInputDevice
+ *
+ * Retrieves whether the events of @device are resampled.
+ *
+ * Return value: %TRUE if the events of the device are resampled
+ *
+ * Since: 1.28
+ */
+gboolean
+clutter_input_device_get_event_resampling (ClutterInputDevice *device)
+{
+  g_return_val_if_fail (CLUTTER_IS_INPUT_DEVICE (device), FALSE);
+
+  return device->event_resampling;
+}
+
 /**
  * clutter_input_device_get_coords:
  * @device: a #ClutterInputDevice
@@ -76,6 +76,11 @@ void                    clutter_input_device_set_enabled        (ClutterInputDev
                                                                  gboolean             enabled);
 CLUTTER_AVAILABLE_IN_1_2
 gboolean                clutter_input_device_get_enabled        (ClutterInputDevice  *device);
+CLUTTER_AVAILABLE_IN_1_28
+void                    clutter_input_device_set_event_resampling (ClutterInputDevice *device,
+                                                                   gboolean            resampling);
+CLUTTER_AVAILABLE_IN_1_28
+gboolean                clutter_input_device_get_event_resampling (ClutterInputDevice *device);
 
 CLUTTER_AVAILABLE_IN_1_2
 guint                   clutter_input_device_get_n_axes         (ClutterInputDevice  *device);
@@ -388,4 +388,22 @@
 # define CLUTTER_AVAILABLE_IN_1_26              _CLUTTER_EXTERN
 #endif
 
+#if CLUTTER_VERSION_MIN_REQUIRED >= CLUTTER_VERSION_1_28
+# define CLUTTER_DEPRECATED_IN_1_28             CLUTTER_DEPRECATED
+# define CLUTTER_DEPRECATED_IN_1_28_FOR(f)      CLUTTER_DEPRECATED_FOR(f)
+# define CLUTTER_MACRO_DEPRECATED_IN_1_28       CLUTTER_DEPRECATED_MACRO
+# define CLUTTER_MACRO_DEPRECATED_IN_1_28_FOR(f) CLUTTER_DEPRECATED_MACRO_FOR(f)
+#else
+# define CLUTTER_DEPRECATED_IN_1_28             _CLUTTER_EXTERN
+# define CLUTTER_DEPRECATED_IN_1_28_FOR(f)      _CLUTTER_EXTERN
+# define CLUTTER_MACRO_DEPRECATED_IN_1_28
+# define CLUTTER_MACRO_DEPRECATED_IN_1_28_FOR(f)
+#endif
+
+#if CLUTTER_VERSION_MAX_ALLOWED < CLUTTER_VERSION_1_28
+# define CLUTTER_AVAILABLE_IN_1_28              CLUTTER_UNAVAILABLE(1, 28)
+#else
+# define CLUTTER_AVAILABLE_IN_1_28              _CLUTTER_EXTERN
+#endif
+
 #endif /* __CLUTTER_MACROS_H__ */
@@ -91,6 +91,9 @@
 #ifdef CLUTTER_WINDOWING_MIR
 #include "mir/clutter-backend-mir.h"
 #endif
+#ifdef CLUTTER_WINDOWING_HEADLESS
+#include "headless/clutter-backend-headless.h"
+#endif
 
 #include <cogl/cogl.h>
 #include <cogl-pango/cogl-pango.h>
@@ -3707,6 +3710,12 @@ clutter_check_windowing_backend (const char *backend_type)
       CLUTTER_IS_BACKEND_X11 (context->backend))
     return TRUE;
   else
+#endif
+#ifdef CLUTTER_WINDOWING_HEADLESS
+  if (backend_type == I_(CLUTTER_WINDOWING_HEADLESS) &&
+      CLUTTER_IS_BACKEND_HEADLESS (context->backend))
+    return TRUE;
+  else
 #endif
   return FALSE;
 }
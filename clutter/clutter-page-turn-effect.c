@@ -32,6 +32,10 @@
  *
  * A simple page turning effect
  *
+ * When GLSL is available, the page curl is computed by a vertex
+ * snippet, and changing the period, angle or radius of the effect
+ * only updates a set of uniforms.
+ *
  * #ClutterPageTurnEffect is available since Clutter 1.4
  */
 
@@ -58,6 +62,11 @@ struct _ClutterPageTurnEffect
   gdouble angle;
 
   gfloat radius;
+
+  gint period_uniform;
+  gint angle_uniform;
+  gint radius_uniform;
+  gint size_uniform;
 };
 
 struct _ClutterPageTurnEffectClass
@@ -78,6 +87,48 @@ enum
 
 static GParamSpec *obj_props[PROP_LAST];
 
+/* this is the same algorithm used by deform_vertex(), computed on
+ * the undeformed position of each vertex of the grid
+ */
+static const gchar *page_turn_glsl_declarations =
+  "uniform float period;\n"
+  "uniform float angle;\n"
+  "uniform float radius;\n"
+  "uniform vec2 size;\n";
+
+static const gchar *page_turn_glsl_source =
+  "  if (period > 0.0)\n"
+  "    {\n"
+  "      vec4 position = cogl_position_in;\n"
+  "      vec2 center = (1.0 - period) * size;\n"
+  "      vec2 delta = position.xy - center;\n"
+  "      float c = cos (angle);\n"
+  "      float s = sin (angle);\n"
+  "      float rx = (delta.x * c) + (delta.y * s) - radius;\n"
+  "      float ry = (delta.y * c) - (delta.x * s);\n"
+  "      float turn_angle = 0.0;\n"
+  "\n"
+  "      if (rx > radius * -2.0)\n"
+  "        {\n"
+  "          turn_angle = (rx / radius * 1.5707963) - 1.5707963;\n"
+  "          cogl_color_out.rgb *= ((sin (turn_angle) * 96.0) + 159.0) / 255.0;\n"
+  "        }\n"
+  "\n"
+  "      if (rx > 0.0)\n"
+  "        {\n"
+  "          float small_radius = radius\n"
+  "                             - min (radius, (turn_angle * 10.0) / 3.1415926);\n"
+  "\n"
+  "          rx = (small_radius * cos (turn_angle)) + radius;\n"
+  "\n"
+  "          position.x = (rx * c) - (ry * s) + center.x;\n"
+  "          position.y = (rx * s) + (ry * c) + center.y;\n"
+  "          position.z = (small_radius * sin (turn_angle)) + radius;\n"
+  "        }\n"
+  "\n"
+  "      cogl_position_out = cogl_modelview_projection_matrix * position;\n"
+  "    }\n";
+
 G_DEFINE_TYPE (ClutterPageTurnEffect,
                clutter_page_turn_effect,
                CLUTTER_TYPE_DEFORM_EFFECT);
@@ -147,6 +198,48 @@ clutter_page_turn_effect_deform_vertex (ClutterDeformEffect *effect,
     }
 }
 
+static CoglHandle
+clutter_page_turn_effect_create_vertex_snippet (ClutterDeformEffect *effect)
+{
+  return cogl_snippet_new (COGL_SNIPPET_HOOK_VERTEX,
+                           page_turn_glsl_declarations,
+                           page_turn_glsl_source);
+}
+
+static void
+clutter_page_turn_effect_update_uniforms (ClutterDeformEffect *effect,
+                                          CoglHandle           handle,
+                                          gfloat               width,
+                                          gfloat               height)
+{
+  ClutterPageTurnEffect *self = CLUTTER_PAGE_TURN_EFFECT (effect);
+  CoglPipeline *pipeline = handle;
+  float size[2] = { width, height };
+
+  if (self->period_uniform < 0)
+    {
+      self->period_uniform =
+        cogl_pipeline_get_uniform_location (pipeline, "period");
+      self->angle_uniform =
+        cogl_pipeline_get_uniform_location (pipeline, "angle");
+      self->radius_uniform =
+        cogl_pipeline_get_uniform_location (pipeline, "radius");
+      self->size_uniform =
+        cogl_pipeline_get_uniform_location (pipeline, "size");
+    }
+
+  cogl_pipeline_set_uniform_1f (pipeline, self->period_uniform,
+                                self->period);
+  cogl_pipeline_set_uniform_1f (pipeline, self->angle_uniform,
+                                self->angle / (180.0f / G_PI));
+  cogl_pipeline_set_uniform_1f (pipeline, self->radius_uniform,
+                                self->radius);
+  cogl_pipeline_set_uniform_float (pipeline, self->size_uniform,
+                                   2, /* n_components */
+                                   1, /* count */
+                                   size);
+}
+
 static void
 clutter_page_turn_effect_set_property (GObject      *gobject,
                                        guint         prop_id,
@@ -263,6 +356,8 @@ clutter_page_turn_effect_class_init (ClutterPageTurnEffectClass *klass)
   g_object_class_install_property (gobject_class, PROP_RADIUS, pspec);
 
   deform_class->deform_vertex = clutter_page_turn_effect_deform_vertex;
+  deform_class->create_vertex_snippet = clutter_page_turn_effect_create_vertex_snippet;
+  deform_class->update_uniforms = clutter_page_turn_effect_update_uniforms;
 }
 
 static void
@@ -271,6 +366,11 @@ clutter_page_turn_effect_init (ClutterPageTurnEffect *self)
   self->period = 0.0;
   self->angle = 0.0;
   self->radius = 24.0f;
+
+  self->period_uniform = -1;
+  self->angle_uniform = -1;
+  self->radius_uniform = -1;
+  self->size_uniform = -1;
 }
 
 /**
@@ -807,6 +807,63 @@ _clutter_paint_volume_get_bounding_box (ClutterPaintVolume *pv,
   box->y2 = y_max;
 }
 
+/* Checks whether @matrix maps the plane of the axis aligned 2D paint
+ * volume @pv into an axis aligned rectangle on a plane of constant
+ * depth; in that case only two opposite corners of the volume need to
+ * be transformed, and the other two can be derived from them.
+ *
+ * This is the common case for actors that are only translated or
+ * scaled with respect to their parent, or to the stage.
+ */
+static inline gboolean
+_clutter_paint_volume_can_transform_2d (const ClutterPaintVolume *pv,
+                                        const CoglMatrix         *matrix)
+{
+  return pv->is_2d && pv->is_axis_aligned &&
+         matrix->xy == 0.f && matrix->yx == 0.f &&
+         matrix->zx == 0.f && matrix->zy == 0.f;
+}
+
+/* Same as _clutter_paint_volume_can_transform_2d(), for the product of
+ * @projection and @modelview; we only compute the entries we need, and
+ * since the result is projected we also need the perspective divide
+ * to be constant over the volume
+ */
+#define MVP_ENTRY(p,m,row,col) \
+  ((p)->row##x * (m)->x##col + (p)->row##y * (m)->y##col + \
+   (p)->row##z * (m)->z##col + (p)->row##w * (m)->w##col)
+
+static inline gboolean
+_clutter_paint_volume_can_project_2d (const ClutterPaintVolume *pv,
+                                      const CoglMatrix         *modelview,
+                                      const CoglMatrix         *projection)
+{
+  return pv->is_2d && pv->is_axis_aligned &&
+         MVP_ENTRY (projection, modelview, x, y) == 0.f &&
+         MVP_ENTRY (projection, modelview, y, x) == 0.f &&
+         MVP_ENTRY (projection, modelview, z, x) == 0.f &&
+         MVP_ENTRY (projection, modelview, z, y) == 0.f &&
+         MVP_ENTRY (projection, modelview, w, x) == 0.f &&
+         MVP_ENTRY (projection, modelview, w, y) == 0.f;
+}
+
+#undef MVP_ENTRY
+
+/* Sets the front vertices of a 2D volume from the two transformed
+ * opposite corners stored in vertices[0] and vertices[2]
+ */
+static inline void
+_clutter_paint_volume_set_2d_corners (ClutterPaintVolume *pv)
+{
+  pv->vertices[1].x = pv->vertices[2].x;
+  pv->vertices[1].y = pv->vertices[0].y;
+  pv->vertices[1].z = pv->vertices[0].z;
+
+  pv->vertices[3].x = pv->vertices[0].x;
+  pv->vertices[3].y = pv->vertices[2].y;
+  pv->vertices[3].z = pv->vertices[0].z;
+}
+
 void
 _clutter_paint_volume_project (ClutterPaintVolume *pv,
                                const CoglMatrix *modelview,
@@ -834,7 +891,36 @@ _clutter_paint_volume_project (ClutterPaintVolume *pv,
   /* Most actors are 2D so we only have to transform the front 4
    * vertices of the paint volume... */
   if (G_LIKELY (pv->is_2d))
-    transform_count = 4;
+    {
+      /* if the modelview-projection matrix does not mix the x and y
+       * axes, and the perspective divide does not depend on them, we
+       * only need to project two opposite corners of the volume
+       */
+      if (_clutter_paint_volume_can_project_2d (pv, modelview, projection))
+        {
+          ClutterVertex corners[2];
+
+          corners[0] = pv->vertices[0];
+          corners[1] = pv->vertices[2];
+
+          _clutter_util_fully_transform_vertices (modelview,
+                                                  projection,
+                                                  viewport,
+                                                  corners,
+                                                  corners,
+                                                  2);
+
+          pv->vertices[0] = corners[0];
+          pv->vertices[2] = corners[1];
+          _clutter_paint_volume_set_2d_corners (pv);
+
+          pv->is_axis_aligned = FALSE;
+
+          return;
+        }
+
+      transform_count = 4;
+    }
   else
     transform_count = 8;
 
@@ -873,7 +959,26 @@ _clutter_paint_volume_transform (ClutterPaintVolume *pv,
   /* Most actors are 2D so we only have to transform the front 4
    * vertices of the paint volume... */
   if (G_LIKELY (pv->is_2d))
-    transform_count = 4;
+    {
+      /* a scale and a translation only need two corners */
+      if (_clutter_paint_volume_can_transform_2d (pv, matrix))
+        {
+          cogl_matrix_transform_points (matrix,
+                                        3,
+                                        sizeof (ClutterVertex) * 2,
+                                        pv->vertices,
+                                        sizeof (ClutterVertex) * 2,
+                                        pv->vertices,
+                                        2);
+          _clutter_paint_volume_set_2d_corners (pv);
+
+          pv->is_axis_aligned = FALSE;
+
+          return;
+        }
+
+      transform_count = 4;
+    }
   else
     transform_count = 8;
 
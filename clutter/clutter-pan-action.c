@@ -94,10 +94,14 @@ struct _ClutterPanActionPrivate
 
   PanState state;
 
-  /* Variables for storing acceleration information */
+  /* Variables for storing acceleration information; the timeline
+   * is only used to get a tick from the master clock, and is reused
+   * across flings
+   */
   ClutterTimeline *deceleration_timeline;
-  gfloat target_x;
-  gfloat target_y;
+  gfloat fling_velocity_x;
+  gfloat fling_velocity_y;
+  gfloat fling_tau;
   gfloat dx;
   gfloat dy;
   gdouble deceleration_rate;
@@ -191,12 +195,8 @@ on_deceleration_stopped (ClutterTimeline           *timeline,
                          gboolean                   is_finished,
                          ClutterPanAction *self)
 {
-  ClutterPanActionPrivate *priv = self->priv;
   ClutterActor *actor;
 
-  g_object_unref (timeline);
-  priv->deceleration_timeline = NULL;
-
   actor = clutter_actor_meta_get_actor (CLUTTER_ACTOR_META (self));
   emit_pan_stopped (self, actor);
 }
@@ -208,13 +208,14 @@ on_deceleration_new_frame (ClutterTimeline     *timeline,
 {
   ClutterPanActionPrivate *priv = self->priv;
   ClutterActor *actor;
-  gdouble progress;
+  gfloat decay;
   gfloat interpolated_x, interpolated_y;
 
-  progress = clutter_timeline_get_progress (timeline);
+  /* Position at time t: x(t) = v(0) * tau * [1 - exp(-t/tau)] */
+  decay = priv->fling_tau * (1.0f - expf (- (gfloat) elapsed_time / priv->fling_tau));
 
-  interpolated_x = priv->target_x * progress;
-  interpolated_y = priv->target_y * progress;
+  interpolated_x = priv->fling_velocity_x * decay;
+  interpolated_y = priv->fling_velocity_y * decay;
   priv->dx = interpolated_x - priv->interpolated_x;
   priv->dy = interpolated_y - priv->interpolated_y;
   priv->interpolated_x = interpolated_x;
@@ -231,7 +232,9 @@ gesture_prepare (ClutterGestureAction  *gesture,
   ClutterPanAction *self = CLUTTER_PAN_ACTION (gesture);
   ClutterPanActionPrivate *priv = self->priv;
 
-  if (priv->state == PAN_STATE_INTERPOLATING && priv->deceleration_timeline)
+  if (priv->state == PAN_STATE_INTERPOLATING &&
+      priv->deceleration_timeline != NULL &&
+      clutter_timeline_is_playing (priv->deceleration_timeline))
     clutter_timeline_stop (priv->deceleration_timeline);
 
   return TRUE;
@@ -280,7 +283,6 @@ gesture_end (ClutterGestureAction *gesture,
   ClutterPanAction *self = CLUTTER_PAN_ACTION (gesture);
   ClutterPanActionPrivate *priv = self->priv;
   gfloat velocity, velocity_x, velocity_y;
-  gfloat delta_x, delta_y;
   gfloat tau;
   gint duration;
 
@@ -294,8 +296,14 @@ gesture_end (ClutterGestureAction *gesture,
 
   priv->state = PAN_STATE_INTERPOLATING;
 
-  clutter_gesture_action_get_motion_delta (gesture, 0, &delta_x, &delta_y);
-  velocity = clutter_gesture_action_get_velocity (gesture, 0, &velocity_x, &velocity_y);
+  /* the velocity of the last motion event is too noisy to be used as
+   * the initial velocity of the fling; use the one estimated over the
+   * most recent samples instead
+   */
+  velocity = _clutter_gesture_action_get_fling_velocity (gesture, 0,
+                                                         &velocity_x,
+                                                         &velocity_y);
+  velocity *= priv->acceleration_factor;
 
   /* Exponential timing constant v(t) = v(0) * exp(-t/tau)
    * tau = 1000ms / (frame_per_second * - ln(decay_per_frame))
@@ -303,31 +311,44 @@ gesture_end (ClutterGestureAction *gesture,
    * see http://ariya.ofilabs.com/2011/10/flick-list-with-its-momentum-scrolling-and-deceleration.html */
   tau = 1000.0f / (reference_fps * - logf (priv->deceleration_rate));
 
+  if (velocity <= min_velocity)
+    {
+      emit_pan_stopped (self, actor);
+      return;
+    }
+
   /* See where the decreasing velocity reaches $min_velocity px/ms
    * v(t) = v(0) * exp(-t/tau) = min_velocity
    * t = - tau * ln( min_velocity / |v(0)|) */
-  duration = - tau * logf (min_velocity / (ABS (velocity) * priv->acceleration_factor));
+  duration = - tau * logf (min_velocity / velocity);
 
-  /* Target point: x(t) = v(0) * tau * [1 - exp(-t/tau)] */
-  priv->target_x = velocity_x * priv->acceleration_factor * tau * (1 - exp ((float)-duration / tau));
-  priv->target_y = velocity_y * priv->acceleration_factor * tau * (1 - exp ((float)-duration / tau));
+  if (duration <= 0)
+    {
+      emit_pan_stopped (self, actor);
+      return;
+    }
 
-  if (ABS (velocity) * priv->acceleration_factor > min_velocity && duration > FLOAT_EPSILON)
+  priv->fling_velocity_x = velocity_x * priv->acceleration_factor;
+  priv->fling_velocity_y = velocity_y * priv->acceleration_factor;
+  priv->fling_tau = tau;
+  priv->interpolated_x = priv->interpolated_y = 0.0f;
+
+  if (priv->deceleration_timeline == NULL)
     {
-      priv->interpolated_x = priv->interpolated_y = 0.0f;
       priv->deceleration_timeline = clutter_timeline_new (duration);
-      clutter_timeline_set_progress_mode (priv->deceleration_timeline, CLUTTER_EASE_OUT_EXPO);
 
       g_signal_connect (priv->deceleration_timeline, "new_frame",
                         G_CALLBACK (on_deceleration_new_frame), self);
       g_signal_connect (priv->deceleration_timeline, "stopped",
                         G_CALLBACK (on_deceleration_stopped), self);
-      clutter_timeline_start (priv->deceleration_timeline);
     }
   else
     {
-      emit_pan_stopped (self, actor);
+      clutter_timeline_rewind (priv->deceleration_timeline);
+      clutter_timeline_set_duration (priv->deceleration_timeline, duration);
     }
+
+  clutter_timeline_start (priv->deceleration_timeline);
 }
 
 static gboolean
@@ -0,0 +1,88 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __CLUTTER_SCRIPT_BINARY_PRIVATE_H__
+#define __CLUTTER_SCRIPT_BINARY_PRIVATE_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/*
+ * The compiled form of a ClutterScript definition, as generated by
+ * clutter-script-compiler and loaded by clutter_script_load_from_file(),
+ * clutter_script_load_from_data() and clutter_script_load_from_resource().
+ *
+ * The image is made of 32-bit little endian words:
+ *
+ *   header    := magic (8 bytes)
+ *                version
+ *                strings offset
+ *                strings size
+ *                root offset
+ *
+ *   strings   := a sequence of NUL-terminated UTF-8 strings; each string
+ *                is stored once, and referenced by its offset inside
+ *                the table
+ *
+ *   value     := tag word, with the tag in the lower 8 bits and, for
+ *                arrays and objects, the number of elements or members
+ *                in the upper 24 bits; followed by:
+ *
+ *                  INT, DOUBLE  the 64-bit value, as two words
+ *                  STRING       the offset of the string
+ *                  ARRAY        the elements, as values
+ *                  OBJECT       for each member, the offset of the name
+ *                               followed by the value
+ *
+ * The magic starts with a byte that cannot begin a JSON document, so
+ * that the loaders can tell the two formats apart.
+ *
+ * The compiler resolves the enumerations, flags and colors of the
+ * properties of Clutter classes to integers and arrays, and normalizes
+ * knots, geometries, points and sizes to their array form, so that the
+ * loader does not need to parse them again.
+ */
+
+#define CLUTTER_SCRIPT_BINARY_MAGIC             "\211CSCR\r\n\032"
+#define CLUTTER_SCRIPT_BINARY_MAGIC_LEN         8
+#define CLUTTER_SCRIPT_BINARY_VERSION           1
+
+#define CLUTTER_SCRIPT_BINARY_HEADER_SIZE       (CLUTTER_SCRIPT_BINARY_MAGIC_LEN + 4 * sizeof (guint32))
+
+typedef enum {
+  CLUTTER_SCRIPT_BINARY_NULL,
+  CLUTTER_SCRIPT_BINARY_FALSE,
+  CLUTTER_SCRIPT_BINARY_TRUE,
+  CLUTTER_SCRIPT_BINARY_INT,
+  CLUTTER_SCRIPT_BINARY_DOUBLE,
+  CLUTTER_SCRIPT_BINARY_STRING,
+  CLUTTER_SCRIPT_BINARY_ARRAY,
+  CLUTTER_SCRIPT_BINARY_OBJECT
+} ClutterScriptBinaryTag;
+
+#define CLUTTER_SCRIPT_BINARY_TAG(word)         ((word) & 0xff)
+#define CLUTTER_SCRIPT_BINARY_COUNT(word)       ((word) >> 8)
+#define CLUTTER_SCRIPT_BINARY_WORD(tag,count)   ((guint32) (tag) | ((guint32) (count) << 8))
+
+#define CLUTTER_SCRIPT_BINARY_MAX_COUNT         0xffffff
+
+G_END_DECLS
+
+#endif /* __CLUTTER_SCRIPT_BINARY_PRIVATE_H__ */
@@ -0,0 +1,349 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Loader for the compiled form of the ClutterScript definitions; see
+ * clutter-script-binary-private.h for the description of the format.
+ *
+ * The loader walks the image and creates the object definitions in the
+ * same order as the JSON parser, so the rest of ClutterScript does not
+ * know where the definitions came from; what it saves is the tokenizing
+ * of the JSON data, and the parsing of the values that the compiler has
+ * already resolved.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+
+#include "clutter-script-binary-private.h"
+#include "clutter-script-private.h"
+
+#include "clutter-debug.h"
+#include "clutter-private.h"
+
+/* the maximum nesting of values we accept, to avoid running out of
+ * stack on corrupt images
+ */
+#define MAX_DEPTH       512
+
+typedef struct {
+  ClutterScript *script;
+
+  const guint8 *data;
+  gsize size;
+  gsize pos;
+
+  const gchar *strings;
+  gsize strings_size;
+} BinaryReader;
+
+static gboolean
+binary_reader_read_word (BinaryReader *reader,
+                         guint32      *word)
+{
+  guint32 value;
+
+  if (reader->size - reader->pos < sizeof (guint32))
+    return FALSE;
+
+  memcpy (&value, reader->data + reader->pos, sizeof (guint32));
+  reader->pos += sizeof (guint32);
+
+  *word = GUINT32_FROM_LE (value);
+
+  return TRUE;
+}
+
+static gboolean
+binary_reader_read_uint64 (BinaryReader *reader,
+                           guint64      *value)
+{
+  guint64 res;
+
+  if (reader->size - reader->pos < sizeof (guint64))
+    return FALSE;
+
+  memcpy (&res, reader->data + reader->pos, sizeof (guint64));
+  reader->pos += sizeof (guint64);
+
+  *value = GUINT64_FROM_LE (res);
+
+  return TRUE;
+}
+
+static const gchar *
+binary_reader_read_string (BinaryReader *reader)
+{
+  guint32 offset;
+
+  if (!binary_reader_read_word (reader, &offset))
+    return NULL;
+
+  /* the table is NUL-terminated, see _clutter_script_load_binary();
+   * an offset pointing inside a multi-byte character would yield an
+   * invalid UTF-8 string
+   */
+  if (offset >= reader->strings_size ||
+      (reader->strings[offset] & 0xc0) == 0x80)
+    return NULL;
+
+  return reader->strings + offset;
+}
+
+/* the table is a sequence of NUL-terminated strings, each of which
+ * must be valid UTF-8
+ */
+static gboolean
+binary_reader_validate_strings (BinaryReader *reader)
+{
+  const gchar *str = reader->strings;
+  const gchar *end = reader->strings + reader->strings_size;
+
+  if (reader->strings_size == 0 || end[-1] != '\0')
+    return FALSE;
+
+  while (str < end)
+    {
+      const gchar *nul = memchr (str, '\0', end - str);
+
+      if (!g_utf8_validate (str, nul - str, NULL))
+        return FALSE;
+
+      str = nul + 1;
+    }
+
+  return TRUE;
+}
+
+static JsonNode *
+binary_reader_read_value (BinaryReader *reader,
+                          guint         depth)
+{
+  JsonNode *node = NULL;
+  guint32 word, count, i;
+  guint64 value;
+  gdouble number;
+  const gchar *str;
+
+  if (depth > MAX_DEPTH)
+    return NULL;
+
+  if (!binary_reader_read_word (reader, &word))
+    return NULL;
+
+  count = CLUTTER_SCRIPT_BINARY_COUNT (word);
+
+  /* each element takes at least a word, and each member two, so we
+   * can reject corrupt counts before allocating anything for them
+   */
+  if ((CLUTTER_SCRIPT_BINARY_TAG (word) == CLUTTER_SCRIPT_BINARY_ARRAY &&
+       count > (reader->size - reader->pos) / sizeof (guint32)) ||
+      (CLUTTER_SCRIPT_BINARY_TAG (word) == CLUTTER_SCRIPT_BINARY_OBJECT &&
+       count > (reader->size - reader->pos) / (2 * sizeof (guint32))))
+    return NULL;
+
+  switch (CLUTTER_SCRIPT_BINARY_TAG (word))
+    {
+    case CLUTTER_SCRIPT_BINARY_NULL:
+      node = json_node_new (JSON_NODE_NULL);
+      break;
+
+    case CLUTTER_SCRIPT_BINARY_FALSE:
+    case CLUTTER_SCRIPT_BINARY_TRUE:
+      node = json_node_new (JSON_NODE_VALUE);
+      json_node_set_boolean (node,
+                             CLUTTER_SCRIPT_BINARY_TAG (word) == CLUTTER_SCRIPT_BINARY_TRUE);
+      break;
+
+    case CLUTTER_SCRIPT_BINARY_INT:
+      if (!binary_reader_read_uint64 (reader, &value))
+        return NULL;
+
+      node = json_node_new (JSON_NODE_VALUE);
+      json_node_set_int (node, (gint64) value);
+      break;
+
+    case CLUTTER_SCRIPT_BINARY_DOUBLE:
+      if (!binary_reader_read_uint64 (reader, &value))
+        return NULL;
+
+      memcpy (&number, &value, sizeof (gdouble));
+
+      node = json_node_new (JSON_NODE_VALUE);
+      json_node_set_double (node, number);
+      break;
+
+    case CLUTTER_SCRIPT_BINARY_STRING:
+      str = binary_reader_read_string (reader);
+      if (str == NULL)
+        return NULL;
+
+      node = json_node_new (JSON_NODE_VALUE);
+      json_node_set_string (node, str);
+      break;
+
+    case CLUTTER_SCRIPT_BINARY_ARRAY:
+      {
+        JsonArray *array = json_array_sized_new (count);
+
+        node = json_node_new (JSON_NODE_ARRAY);
+        json_node_take_array (node, array);
+
+        for (i = 0; i < count; i++)
+          {
+            JsonNode *element = binary_reader_read_value (reader, depth + 1);
+
+            if (element == NULL)
+              {
+                json_node_free (node);
+                return NULL;
+              }
+
+            json_array_add_element (array, element);
+          }
+      }
+      break;
+
+    case CLUTTER_SCRIPT_BINARY_OBJECT:
+      {
+        JsonObject *object = json_object_new ();
+
+        node = json_node_new (JSON_NODE_OBJECT);
+        json_node_take_object (node, object);
+
+        for (i = 0; i < count; i++)
+          {
+            JsonNode *member;
+
+            str = binary_reader_read_string (reader);
+            if (str == NULL)
+              {
+                json_node_free (node);
+                return NULL;
+              }
+
+            member = binary_reader_read_value (reader, depth + 1);
+            if (member == NULL)
+              {
+                json_node_free (node);
+                return NULL;
+              }
+
+            json_object_set_member (object, str, member);
+          }
+
+        /* this is where the JSON parser would emit ::object-end */
+        _clutter_script_parse_object (reader->script, object);
+      }
+      break;
+
+    default:
+      return NULL;
+    }
+
+  return node;
+}
+
+/*
+ * _clutter_script_load_binary:
+ * @script: a #ClutterScript
+ * @data: the compiled definitions
+ * @size: the size of @data, in bytes
+ * @error: return location for a #GError, or %NULL
+ *
+ * Loads the object definitions compiled by clutter-script-compiler.
+ *
+ * The caller is responsible for checking the magic at the beginning
+ * of @data, and for updating the merge id.
+ *
+ * Return value: %TRUE on success
+ */
+gboolean
+_clutter_script_load_binary (ClutterScript  *script,
+                             const guint8   *data,
+                             gsize           size,
+                             GError        **error)
+{
+  BinaryReader reader = { NULL, };
+  guint32 version, strings_offset, strings_size, root_offset;
+  JsonNode *root;
+
+  reader.script = script;
+  reader.data = data;
+  reader.size = size;
+  reader.pos = CLUTTER_SCRIPT_BINARY_MAGIC_LEN;
+
+  if (size < CLUTTER_SCRIPT_BINARY_HEADER_SIZE ||
+      memcmp (data, CLUTTER_SCRIPT_BINARY_MAGIC, CLUTTER_SCRIPT_BINARY_MAGIC_LEN) != 0)
+    goto invalid;
+
+  binary_reader_read_word (&reader, &version);
+  binary_reader_read_word (&reader, &strings_offset);
+  binary_reader_read_word (&reader, &strings_size);
+  binary_reader_read_word (&reader, &root_offset);
+
+  if (version != CLUTTER_SCRIPT_BINARY_VERSION)
+    {
+      g_set_error (error, CLUTTER_SCRIPT_ERROR,
+                   CLUTTER_SCRIPT_ERROR_INVALID_VALUE,
+                   "Unsupported version %u of the compiled definitions; "
+                   "the definitions must be compiled again",
+                   version);
+      return FALSE;
+    }
+
+  if (strings_offset > size ||
+      strings_size > size - strings_offset ||
+      root_offset >= size)
+    goto invalid;
+
+  reader.strings = (const gchar *) data + strings_offset;
+  reader.strings_size = strings_size;
+
+  /* validating the whole table once is cheaper than validating each
+   * reference to it
+   */
+  if (!binary_reader_validate_strings (&reader))
+    goto invalid;
+
+  reader.pos = root_offset;
+
+  root = binary_reader_read_value (&reader, 0);
+  if (root == NULL)
+    goto invalid;
+
+  CLUTTER_NOTE (SCRIPT, "Loaded %" G_GSIZE_FORMAT " bytes of compiled definitions",
+                size);
+
+  json_node_free (root);
+
+  if (!_clutter_script_is_lazy (script))
+    clutter_script_ensure_objects (script);
+
+  return TRUE;
+
+invalid:
+  g_set_error_literal (error, CLUTTER_SCRIPT_ERROR,
+                       CLUTTER_SCRIPT_ERROR_INVALID_VALUE,
+                       "Invalid compiled definitions");
+  return FALSE;
+}
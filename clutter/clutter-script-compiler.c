@@ -0,0 +1,593 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * clutter-script-compiler: compiles ClutterScript definitions from JSON
+ * to the binary form described in clutter-script-binary-private.h
+ *
+ * The compiler only uses the public API, as it's linked against the
+ * shared library like any other application.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <glib.h>
+#include <json-glib/json-glib.h>
+
+#define CLUTTER_DISABLE_DEPRECATION_WARNINGS
+#include <clutter/clutter.h>
+
+#include "clutter-script-binary-private.h"
+
+typedef struct {
+  ClutterScript *script;
+
+  /* interned strings, mapped to their offset in the table */
+  GHashTable *string_offsets;
+  GString *strings;
+
+  GByteArray *values;
+
+  gboolean resolve;
+} Compiler;
+
+static gchar *output_file = NULL;
+static gboolean no_resolve = FALSE;
+
+static GOptionEntry entries[] = {
+  {
+    "output", 'o',
+    0,
+    G_OPTION_ARG_FILENAME, &output_file,
+    "Write the compiled definitions to FILE", "FILE"
+  },
+  {
+    "no-resolve", 0,
+    0,
+    G_OPTION_ARG_NONE, &no_resolve,
+    "Do not resolve the values of the properties", NULL
+  },
+  { NULL }
+};
+
+static guint32
+compiler_intern_string (Compiler    *compiler,
+                        const gchar *str)
+{
+  gpointer offset;
+
+  if (g_hash_table_lookup_extended (compiler->string_offsets, str, NULL, &offset))
+    return GPOINTER_TO_UINT (offset);
+
+  offset = GUINT_TO_POINTER (compiler->strings->len);
+
+  g_string_append_len (compiler->strings, str, strlen (str) + 1);
+  g_hash_table_insert (compiler->string_offsets, g_strdup (str), offset);
+
+  return GPOINTER_TO_UINT (offset);
+}
+
+static void
+compiler_write_word (Compiler *compiler,
+                     guint32   word)
+{
+  guint32 value = GUINT32_TO_LE (word);
+
+  g_byte_array_append (compiler->values, (const guint8 *) &value, sizeof (value));
+}
+
+static void
+compiler_write_uint64 (Compiler *compiler,
+                       guint64   word)
+{
+  guint64 value = GUINT64_TO_LE (word);
+
+  g_byte_array_append (compiler->values, (const guint8 *) &value, sizeof (value));
+}
+
+static void
+compiler_write_int (Compiler *compiler,
+                    gint64    value)
+{
+  compiler_write_word (compiler,
+                       CLUTTER_SCRIPT_BINARY_WORD (CLUTTER_SCRIPT_BINARY_INT, 0));
+  compiler_write_uint64 (compiler, (guint64) value);
+}
+
+static void
+compiler_write_double (Compiler *compiler,
+                       gdouble   value)
+{
+  guint64 bits;
+
+  memcpy (&bits, &value, sizeof (bits));
+
+  compiler_write_word (compiler,
+                       CLUTTER_SCRIPT_BINARY_WORD (CLUTTER_SCRIPT_BINARY_DOUBLE, 0));
+  compiler_write_uint64 (compiler, bits);
+}
+
+static void
+compiler_write_string (Compiler    *compiler,
+                       const gchar *str)
+{
+  compiler_write_word (compiler,
+                       CLUTTER_SCRIPT_BINARY_WORD (CLUTTER_SCRIPT_BINARY_STRING, 0));
+  compiler_write_word (compiler, compiler_intern_string (compiler, str));
+}
+
+static void
+compiler_write_int_array (Compiler    *compiler,
+                          const gint64 *values,
+                          guint        n_values)
+{
+  guint i;
+
+  compiler_write_word (compiler,
+                       CLUTTER_SCRIPT_BINARY_WORD (CLUTTER_SCRIPT_BINARY_ARRAY, n_values));
+
+  for (i = 0; i < n_values; i++)
+    compiler_write_int (compiler, values[i]);
+}
+
+static gboolean compiler_write_node (Compiler  *compiler,
+                                     JsonNode  *node,
+                                     GError   **error);
+
+static gboolean
+enum_from_string (GType        gtype,
+                  const gchar *str,
+                  gint64      *retval)
+{
+  GEnumClass *eclass = g_type_class_ref (gtype);
+  GEnumValue *ev;
+
+  ev = g_enum_get_value_by_name (eclass, str);
+  if (ev == NULL)
+    ev = g_enum_get_value_by_nick (eclass, str);
+
+  if (ev != NULL)
+    *retval = ev->value;
+
+  g_type_class_unref (eclass);
+
+  return ev != NULL;
+}
+
+static gboolean
+flags_from_string (GType        gtype,
+                   const gchar *str,
+                   gint64      *retval)
+{
+  GFlagsClass *fclass = g_type_class_ref (gtype);
+  gchar **flags;
+  gboolean res = TRUE;
+  guint value = 0;
+  gint i;
+
+  flags = g_strsplit (str, "|", -1);
+  for (i = 0; flags[i] != NULL; i++)
+    {
+      const gchar *flag = g_strstrip (flags[i]);
+      GFlagsValue *fv;
+
+      if (*flag == '\0')
+        continue;
+
+      fv = g_flags_get_value_by_name (fclass, flag);
+      if (fv == NULL)
+        fv = g_flags_get_value_by_nick (fclass, flag);
+
+      if (fv == NULL)
+        {
+          res = FALSE;
+          break;
+        }
+
+      value |= fv->value;
+    }
+
+  g_strfreev (flags);
+  g_type_class_unref (fclass);
+
+  if (res)
+    *retval = value;
+
+  return res;
+}
+
+/* reads the integer members of @object in order; any missing member
+ * makes the whole object unresolvable
+ */
+static gboolean
+object_get_int_members (JsonObject   *object,
+                        const gchar **names,
+                        gint64       *values)
+{
+  gint i;
+
+  if (json_object_get_size (object) != g_strv_length ((gchar **) names))
+    return FALSE;
+
+  for (i = 0; names[i] != NULL; i++)
+    {
+      JsonNode *member = json_object_get_member (object, names[i]);
+
+      if (member == NULL || JSON_NODE_TYPE (member) != JSON_NODE_VALUE)
+        return FALSE;
+
+      if (json_node_get_value_type (member) == G_TYPE_INT64)
+        values[i] = json_node_get_int (member);
+      else if (json_node_get_value_type (member) == G_TYPE_DOUBLE)
+        values[i] = json_node_get_double (member);
+      else
+        return FALSE;
+    }
+
+  return TRUE;
+}
+
+/* writes the value of a property in the form that the parser in
+ * ClutterScript can convert the fastest; returns FALSE if the value
+ * must be written as it is
+ */
+static gboolean
+compiler_write_resolved_property (Compiler   *compiler,
+                                  GParamSpec *pspec,
+                                  JsonNode   *node)
+{
+  GType value_type = G_PARAM_SPEC_VALUE_TYPE (pspec);
+  gint64 values[4];
+
+  if (JSON_NODE_TYPE (node) == JSON_NODE_VALUE &&
+      json_node_get_value_type (node) == G_TYPE_STRING)
+    {
+      const gchar *str = json_node_get_string (node);
+
+      if (G_TYPE_IS_ENUM (value_type))
+        {
+          if (!enum_from_string (value_type, str, &values[0]))
+            return FALSE;
+
+          compiler_write_int (compiler, values[0]);
+          return TRUE;
+        }
+
+      if (G_TYPE_IS_FLAGS (value_type))
+        {
+          if (!flags_from_string (value_type, str, &values[0]))
+            return FALSE;
+
+          compiler_write_int (compiler, values[0]);
+          return TRUE;
+        }
+
+      if (value_type == CLUTTER_TYPE_COLOR)
+        {
+          ClutterColor color;
+
+          if (!clutter_color_from_string (&color, str))
+            return FALSE;
+
+          values[0] = color.red;
+          values[1] = color.green;
+          values[2] = color.blue;
+          values[3] = color.alpha;
+
+          compiler_write_int_array (compiler, values, 4);
+          return TRUE;
+        }
+
+      return FALSE;
+    }
+
+  if (JSON_NODE_TYPE (node) == JSON_NODE_OBJECT)
+    {
+      static const gchar *color_names[] = { "red", "green", "blue", "alpha", NULL };
+      static const gchar *geometry_names[] = { "x", "y", "width", "height", NULL };
+      static const gchar *point_names[] = { "x", "y", NULL };
+      static const gchar *size_names[] = { "width", "height", NULL };
+      JsonObject *object = json_node_get_object (node);
+
+      if (value_type == CLUTTER_TYPE_COLOR &&
+          object_get_int_members (object, color_names, values))
+        {
+          compiler_write_int_array (compiler, values, 4);
+          return TRUE;
+        }
+
+      if (value_type == CLUTTER_TYPE_GEOMETRY &&
+          object_get_int_members (object, geometry_names, values))
+        {
+          compiler_write_int_array (compiler, values, 4);
+          return TRUE;
+        }
+
+      if ((value_type == CLUTTER_TYPE_KNOT || value_type == CLUTTER_TYPE_POINT) &&
+          object_get_int_members (object, point_names, values))
+        {
+          compiler_write_int_array (compiler, values, 2);
+          return TRUE;
+        }
+
+      if (value_type == CLUTTER_TYPE_SIZE &&
+          object_get_int_members (object, size_names, values))
+        {
+          compiler_write_int_array (compiler, values, 2);
+          return TRUE;
+        }
+    }
+
+  return FALSE;
+}
+
+static gboolean
+compiler_write_object (Compiler    *compiler,
+                       JsonObject  *object,
+                       GError     **error)
+{
+  GObjectClass *klass = NULL;
+  GList *members, *l;
+  guint n_members;
+
+  /* we only know how the classes in Clutter parse their custom
+   * properties, so we leave the values of any other class alone
+   */
+  if (compiler->resolve &&
+      json_object_has_member (object, "type") &&
+      !json_object_has_member (object, "type_func"))
+    {
+      JsonNode *type_node = json_object_get_member (object, "type");
+      const gchar *type_name = NULL;
+      GType gtype = G_TYPE_INVALID;
+
+      if (JSON_NODE_TYPE (type_node) == JSON_NODE_VALUE &&
+          json_node_get_value_type (type_node) == G_TYPE_STRING)
+        type_name = json_node_get_string (type_node);
+
+      if (type_name != NULL && g_str_has_prefix (type_name, "Clutter"))
+        gtype = clutter_script_get_type_from_name (compiler->script, type_name);
+
+      if (G_TYPE_IS_OBJECT (gtype))
+        klass = g_type_class_ref (gtype);
+    }
+
+  members = json_object_get_members (object);
+  n_members = g_list_length (members);
+
+  if (n_members > CLUTTER_SCRIPT_BINARY_MAX_COUNT)
+    {
+      g_set_error (error, CLUTTER_SCRIPT_ERROR,
+                   CLUTTER_SCRIPT_ERROR_INVALID_VALUE,
+                   "Too many members in object");
+      g_list_free (members);
+      return FALSE;
+    }
+
+  compiler_write_word (compiler,
+                       CLUTTER_SCRIPT_BINARY_WORD (CLUTTER_SCRIPT_BINARY_OBJECT, n_members));
+
+  for (l = members; l != NULL; l = l->next)
+    {
+      const gchar *name = l->data;
+      JsonNode *member = json_object_get_member (object, name);
+      GParamSpec *pspec = NULL;
+
+      compiler_write_word (compiler, compiler_intern_string (compiler, name));
+
+      if (klass != NULL)
+        pspec = g_object_class_find_property (klass, name);
+
+      if (pspec != NULL &&
+          compiler_write_resolved_property (compiler, pspec, member))
+        continue;
+
+      if (!compiler_write_node (compiler, member, error))
+        {
+          g_list_free (members);
+          if (klass != NULL)
+            g_type_class_unref (klass);
+          return FALSE;
+        }
+    }
+
+  g_list_free (members);
+
+  if (klass != NULL)
+    g_type_class_unref (klass);
+
+  return TRUE;
+}
+
+static gboolean
+compiler_write_node (Compiler  *compiler,
+                     JsonNode  *node,
+                     GError   **error)
+{
+  switch (JSON_NODE_TYPE (node))
+    {
+    case JSON_NODE_NULL:
+      compiler_write_word (compiler,
+                           CLUTTER_SCRIPT_BINARY_WORD (CLUTTER_SCRIPT_BINARY_NULL, 0));
+      return TRUE;
+
+    case JSON_NODE_VALUE:
+      {
+        GType value_type = json_node_get_value_type (node);
+
+        if (value_type == G_TYPE_BOOLEAN)
+          compiler_write_word (compiler,
+                               json_node_get_boolean (node)
+                                 ? CLUTTER_SCRIPT_BINARY_TRUE
+                                 : CLUTTER_SCRIPT_BINARY_FALSE);
+        else if (value_type == G_TYPE_INT64)
+          compiler_write_int (compiler, json_node_get_int (node));
+        else if (value_type == G_TYPE_DOUBLE)
+          compiler_write_double (compiler, json_node_get_double (node));
+        else
+          compiler_write_string (compiler, json_node_get_string (node));
+      }
+      return TRUE;
+
+    case JSON_NODE_ARRAY:
+      {
+        JsonArray *array = json_node_get_array (node);
+        guint i, len = json_array_get_length (array);
+
+        if (len > CLUTTER_SCRIPT_BINARY_MAX_COUNT)
+          {
+            g_set_error (error, CLUTTER_SCRIPT_ERROR,
+                         CLUTTER_SCRIPT_ERROR_INVALID_VALUE,
+                         "Too many elements in array");
+            return FALSE;
+          }
+
+        compiler_write_word (compiler,
+                             CLUTTER_SCRIPT_BINARY_WORD (CLUTTER_SCRIPT_BINARY_ARRAY, len));
+
+        for (i = 0; i < len; i++)
+          {
+            if (!compiler_write_node (compiler,
+                                      json_array_get_element (array, i),
+                                      error))
+              return FALSE;
+          }
+      }
+      return TRUE;
+
+    case JSON_NODE_OBJECT:
+      return compiler_write_object (compiler, json_node_get_object (node), error);
+    }
+
+  return FALSE;
+}
+
+static gboolean
+compile_file (const gchar  *input_file,
+              const gchar  *output_file,
+              gboolean      resolve,
+              GError      **error)
+{
+  Compiler compiler = { NULL, };
+  JsonParser *parser;
+  GByteArray *image;
+  guint32 header[4];
+  gboolean res = FALSE;
+  guint i;
+
+  parser = json_parser_new ();
+  if (!json_parser_load_from_file (parser, input_file, error))
+    goto out;
+
+  compiler.script = clutter_script_new ();
+  compiler.string_offsets = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                                   g_free,
+                                                   NULL);
+  compiler.strings = g_string_new (NULL);
+  compiler.values = g_byte_array_new ();
+  compiler.resolve = resolve;
+
+  if (json_parser_get_root (parser) == NULL)
+    {
+      g_set_error_literal (error, CLUTTER_SCRIPT_ERROR,
+                           CLUTTER_SCRIPT_ERROR_INVALID_VALUE,
+                           "No definitions found");
+      goto out;
+    }
+
+  if (!compiler_write_node (&compiler, json_parser_get_root (parser), error))
+    goto out;
+
+  /* the header is followed by the values, and then by the strings */
+  header[0] = CLUTTER_SCRIPT_BINARY_VERSION;
+  header[1] = CLUTTER_SCRIPT_BINARY_HEADER_SIZE + compiler.values->len;
+  header[2] = compiler.strings->len;
+  header[3] = CLUTTER_SCRIPT_BINARY_HEADER_SIZE;
+
+  image = g_byte_array_sized_new (header[1] + header[2]);
+  g_byte_array_append (image,
+                       (const guint8 *) CLUTTER_SCRIPT_BINARY_MAGIC,
+                       CLUTTER_SCRIPT_BINARY_MAGIC_LEN);
+
+  for (i = 0; i < G_N_ELEMENTS (header); i++)
+    {
+      guint32 word = GUINT32_TO_LE (header[i]);
+
+      g_byte_array_append (image, (const guint8 *) &word, sizeof (word));
+    }
+
+  g_byte_array_append (image, compiler.values->data, compiler.values->len);
+  g_byte_array_append (image,
+                       (const guint8 *) compiler.strings->str,
+                       compiler.strings->len);
+
+  res = g_file_set_contents (output_file,
+                             (const gchar *) image->data, image->len,
+                             error);
+
+  g_byte_array_unref (image);
+
+out:
+  g_clear_object (&compiler.script);
+  g_clear_pointer (&compiler.string_offsets, g_hash_table_unref);
+  if (compiler.strings != NULL)
+    g_string_free (compiler.strings, TRUE);
+  g_clear_pointer (&compiler.values, g_byte_array_unref);
+  g_object_unref (parser);
+
+  return res;
+}
+
+int
+main (int argc, char *argv[])
+{
+  GOptionContext *context;
+  GError *error = NULL;
+
+  context = g_option_context_new ("FILE - compile ClutterScript definitions");
+  g_option_context_add_main_entries (context, entries, NULL);
+
+  if (!g_option_context_parse (context, &argc, &argv, &error))
+    {
+      g_printerr ("%s\n", error->message);
+      return EXIT_FAILURE;
+    }
+
+  g_option_context_free (context);
+
+  if (argc != 2 || output_file == NULL)
+    {
+      g_printerr ("Usage: %s --output=FILE FILE\n", g_get_prgname ());
+      return EXIT_FAILURE;
+    }
+
+  if (!compile_file (argv[1], output_file, !no_resolve, &error))
+    {
+      g_printerr ("%s: %s\n", argv[1], error->message);
+      g_error_free (error);
+      return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -423,7 +423,7 @@ static gboolean
 parse_color_from_array (JsonArray    *array,
                         ClutterColor *color)
 {
-  if (json_array_get_length (array) != 3 ||
+  if (json_array_get_length (array) != 3 &&
       json_array_get_length (array) != 4)
     return FALSE;
 
@@ -1031,7 +1031,23 @@ clutter_script_parser_object_end (JsonParser *json_parser,
                                   JsonObject *object)
 {
   ClutterScriptParser *parser = CLUTTER_SCRIPT_PARSER (json_parser);
-  ClutterScript *script = parser->script;
+
+  _clutter_script_parse_object (parser->script, object);
+}
+
+/*
+ * _clutter_script_parse_object:
+ * @script: a #ClutterScript
+ * @object: a JSON object
+ *
+ * Creates the #ObjectInfo for the object definition in @object, and
+ * constructs the object. Object definitions must be parsed leaf-first,
+ * which is the order in which the parser finishes them.
+ */
+void
+_clutter_script_parse_object (ClutterScript *script,
+                              JsonObject    *object)
+{
   ObjectInfo *oinfo;
   JsonNode *val;
   const gchar *id_;
@@ -1189,13 +1205,18 @@ clutter_script_parser_object_end (JsonParser *json_parser,
                 g_list_length (oinfo->signals));
 
   _clutter_script_add_object_info (script, oinfo);
-  _clutter_script_construct_object (script, oinfo);
+
+  if (!_clutter_script_is_lazy (script))
+    _clutter_script_construct_object (script, oinfo);
 }
 
 static void
 clutter_script_parser_parse_end (JsonParser *parser)
 {
-  clutter_script_ensure_objects (CLUTTER_SCRIPT_PARSER (parser)->script);
+  ClutterScript *script = CLUTTER_SCRIPT_PARSER (parser)->script;
+
+  if (!_clutter_script_is_lazy (script))
+    clutter_script_ensure_objects (script);
 }
 
 gboolean
@@ -1309,9 +1330,13 @@ _clutter_script_parse_node (ClutterScript *script,
                   /* force construction, even though it should
                    * not be necessary; we don't need the properties
                    * to be applied as well: they will when the
-                   * ScriptParser finishes
+                   * ScriptParser finishes, unless the construction
+                   * is lazy, in which case nothing else will
                    */
-                  _clutter_script_construct_object (script, oinfo);
+                  if (_clutter_script_is_lazy (script))
+                    _clutter_script_realize_object (script, oinfo);
+                  else
+                    _clutter_script_construct_object (script, oinfo);
 
                   g_value_set_object (value, oinfo->object);
 
@@ -2021,6 +2046,12 @@ add_children (ClutterScript *script,
                     g_type_name (G_OBJECT_TYPE (container)));
 
       clutter_container_add_actor (container, CLUTTER_ACTOR (object));
+
+      /* the child is only constructed when the parent needs it, so
+       * we need to apply its properties now that it has a parent
+       */
+      if (_clutter_script_is_lazy (script))
+        _clutter_script_realize_object (script, child_info);
     }
 
   g_list_foreach (oinfo->children, (GFunc) g_free, NULL);
@@ -71,6 +71,7 @@ typedef struct {
   guint is_stage_default : 1;
   guint has_unresolved   : 1;
   guint is_unmerged      : 1;
+  guint is_realizing     : 1;
 } ObjectInfo;
 
 void object_info_free (gpointer data);
@@ -141,10 +142,22 @@ gboolean _clutter_script_parse_translatable_string (ClutterScript *script,
                                                     JsonNode      *node,
                                                     char         **str);
 
+void _clutter_script_parse_object (ClutterScript *script,
+                                   JsonObject    *object);
+
+gboolean _clutter_script_load_binary (ClutterScript *script,
+                                      const guint8  *data,
+                                      gsize          size,
+                                      GError       **error);
+
 void _clutter_script_construct_object (ClutterScript *script,
                                        ObjectInfo    *oinfo);
 void _clutter_script_apply_properties (ClutterScript *script,
                                        ObjectInfo    *oinfo);
+void _clutter_script_realize_object (ClutterScript *script,
+                                     ObjectInfo    *oinfo);
+
+gboolean _clutter_script_is_lazy (ClutterScript *script);
 
 gchar *_clutter_script_generate_fake_id (ClutterScript *script);
 
@@ -263,6 +263,26 @@
  *                   of creating a new #ClutterStage instance
  * ]]></programlisting>
  *
+ * Large UI definitions can be compiled ahead of time, to avoid parsing
+ * the JSON data every time the application starts, using the
+ * clutter-script-compiler tool as part of the build:
+ *
+ * |[
+ *   clutter-script-compiler --output=main-window.clsc main-window.json
+ * ]|
+ *
+ * The compiled file can be loaded with the same functions used for the
+ * JSON definitions, including clutter_script_load_from_resource(). The
+ * compiled format is tied to the version of Clutter that generated it,
+ * so it should not be distributed separately from the application.
+ *
+ * UI definitions that describe many screens can also be loaded with
+ * #ClutterScript:lazy-construction set, so that each object is only
+ * constructed when the application retrieves it, or retrieves an object
+ * that references it; clutter_script_prefetch_objects() can be used to
+ * construct the screens that are likely to be shown next while the
+ * application is idle.
+ *
  * #ClutterScript is available since Clutter 0.6
  */
 
@@ -282,10 +302,12 @@
 #define CLUTTER_DISABLE_DEPRECATION_WARNINGS
 
 #include "clutter-actor.h"
+#include "clutter-main.h"
 #include "clutter-stage.h"
 #include "clutter-texture.h"
 
 #include "clutter-script.h"
+#include "clutter-script-binary-private.h"
 #include "clutter-script-private.h"
 #include "clutter-scriptable.h"
 
@@ -305,6 +327,7 @@ enum
   PROP_FILENAME_SET,
   PROP_FILENAME,
   PROP_TRANSLATION_DOMAIN,
+  PROP_LAZY_CONSTRUCTION,
 
   PROP_LAST
 };
@@ -329,7 +352,13 @@ struct _ClutterScriptPrivate
   gchar *translation_domain;
 
   gchar *filename;
+
+  /* the ids of the objects to construct on idle */
+  GQueue prefetch_queue;
+  guint prefetch_id;
+
   guint is_filename : 1;
+  guint is_lazy : 1;
 };
 
 G_DEFINE_TYPE_WITH_PRIVATE (ClutterScript, clutter_script, G_TYPE_OBJECT)
@@ -437,6 +466,12 @@ clutter_script_finalize (GObject *gobject)
   g_hash_table_destroy (priv->states);
   g_free (priv->translation_domain);
 
+  if (priv->prefetch_id != 0)
+    g_source_remove (priv->prefetch_id);
+
+  g_queue_foreach (&priv->prefetch_queue, (GFunc) g_free, NULL);
+  g_queue_clear (&priv->prefetch_queue);
+
   G_OBJECT_CLASS (clutter_script_parent_class)->finalize (gobject);
 }
 
@@ -454,6 +489,10 @@ clutter_script_set_property (GObject      *gobject,
       clutter_script_set_translation_domain (script, g_value_get_string (value));
       break;
 
+    case PROP_LAZY_CONSTRUCTION:
+      clutter_script_set_lazy_construction (script, g_value_get_boolean (value));
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id, pspec);
       break;
@@ -482,6 +521,10 @@ clutter_script_get_property (GObject    *gobject,
       g_value_set_string (value, script->priv->translation_domain);
       break;
 
+    case PROP_LAZY_CONSTRUCTION:
+      g_value_set_boolean (value, script->priv->is_lazy);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id, pspec);
       break;
@@ -544,6 +587,23 @@ clutter_script_class_init (ClutterScriptClass *klass)
                          NULL,
                          CLUTTER_PARAM_READWRITE);
 
+  /**
+   * ClutterScript:lazy-construction:
+   *
+   * Whether the objects defined by the UI definitions loaded by the
+   * #ClutterScript should be constructed only when they are needed.
+   *
+   * See clutter_script_set_lazy_construction().
+   *
+   * Since: 1.28
+   */
+  obj_props[PROP_LAZY_CONSTRUCTION] =
+    g_param_spec_boolean ("lazy-construction",
+                          P_("Lazy Construction"),
+                          P_("Whether objects are constructed when needed"),
+                          FALSE,
+                          CLUTTER_PARAM_READWRITE);
+
   gobject_class->set_property = clutter_script_set_property;
   gobject_class->get_property = clutter_script_get_property;
   gobject_class->finalize = clutter_script_finalize;
@@ -594,6 +654,16 @@ clutter_script_new (void)
   return g_object_new (CLUTTER_TYPE_SCRIPT, NULL);
 }
 
+static inline gboolean
+is_compiled_definition (const gchar *data,
+                        gsize        length)
+{
+  return length >= CLUTTER_SCRIPT_BINARY_MAGIC_LEN &&
+         memcmp (data,
+                 CLUTTER_SCRIPT_BINARY_MAGIC,
+                 CLUTTER_SCRIPT_BINARY_MAGIC_LEN) == 0;
+}
+
 /**
  * clutter_script_load_from_file:
  * @script: a #ClutterScript
@@ -603,6 +673,10 @@ clutter_script_new (void)
  * Loads the definitions from @filename into @script and merges with
  * the currently loaded ones, if any.
  *
+ * Since Clutter 1.28, @filename can also contain definitions compiled
+ * by clutter-script-compiler; the compiled file is mapped in memory
+ * instead of being read.
+ *
  * Return value: on error, zero is returned and @error is set
  *   accordingly. On success, the merge id for the UI definitions is
  *   returned. You can use the merge id with clutter_script_unmerge_objects().
@@ -616,6 +690,7 @@ clutter_script_load_from_file (ClutterScript  *script,
 {
   ClutterScriptPrivate *priv;
   GError *internal_error;
+  GMappedFile *mapped_file;
 
   g_return_val_if_fail (CLUTTER_IS_SCRIPT (script), 0);
   g_return_val_if_fail (filename != NULL, 0);
@@ -628,9 +703,36 @@ clutter_script_load_from_file (ClutterScript  *script,
   priv->last_merge_id += 1;
 
   internal_error = NULL;
-  json_parser_load_from_file (JSON_PARSER (priv->parser),
-                              filename,
-                              &internal_error);
+
+  /* the file is mapped once, and used for either format; empty or
+   * unreadable files are left to the JSON parser, which reports the
+   * error
+   */
+  mapped_file = g_mapped_file_new (filename, FALSE, NULL);
+  if (mapped_file != NULL && g_mapped_file_get_length (mapped_file) > 0)
+    {
+      const gchar *contents = g_mapped_file_get_contents (mapped_file);
+      gsize length = g_mapped_file_get_length (mapped_file);
+
+      if (is_compiled_definition (contents, length))
+        _clutter_script_load_binary (script,
+                                     (const guint8 *) contents, length,
+                                     &internal_error);
+      else
+        json_parser_load_from_data (JSON_PARSER (priv->parser),
+                                    contents, length,
+                                    &internal_error);
+    }
+  else
+    {
+      json_parser_load_from_file (JSON_PARSER (priv->parser),
+                                  filename,
+                                  &internal_error);
+    }
+
+  if (mapped_file != NULL)
+    g_mapped_file_unref (mapped_file);
+
   if (internal_error)
     {
       g_propagate_error (error, internal_error);
@@ -652,6 +754,9 @@ clutter_script_load_from_file (ClutterScript  *script,
  * Loads the definitions from @data into @script and merges with
  * the currently loaded ones, if any.
  *
+ * Since Clutter 1.28, @data can also contain definitions compiled
+ * by clutter-script-compiler; in that case, @length must be set.
+ *
  * Return value: on error, zero is returned and @error is set
  *   accordingly. On success, the merge id for the UI definitions is
  *   returned. You can use the merge id with clutter_script_unmerge_objects().
@@ -681,9 +786,15 @@ clutter_script_load_from_data (ClutterScript  *script,
   priv->last_merge_id += 1;
 
   internal_error = NULL;
-  json_parser_load_from_data (JSON_PARSER (priv->parser),
-                              data, length,
-                              &internal_error);
+
+  if (is_compiled_definition (data, length))
+    _clutter_script_load_binary (script,
+                                 (const guint8 *) data, length,
+                                 &internal_error);
+  else
+    json_parser_load_from_data (JSON_PARSER (priv->parser),
+                                data, length,
+                                &internal_error);
   if (internal_error)
     {
       g_propagate_error (error, internal_error);
@@ -759,8 +870,7 @@ clutter_script_get_object (ClutterScript *script,
   if (!oinfo)
     return NULL;
 
-  _clutter_script_construct_object (script, oinfo);
-  _clutter_script_apply_properties (script, oinfo);
+  _clutter_script_realize_object (script, oinfo);
 
   return oinfo->object;
 }
@@ -897,7 +1007,8 @@ clutter_script_unmerge_objects (ClutterScript *script,
   g_slist_foreach (data.ids, (GFunc) g_free, NULL);
   g_slist_free (data.ids);
 
-  clutter_script_ensure_objects (script);
+  if (!priv->is_lazy)
+    clutter_script_ensure_objects (script);
 }
 
 static void
@@ -931,6 +1042,9 @@ construct_each_objects (gpointer key,
  * Ensure that every object defined inside @script is correctly
  * constructed. You should rarely need to use this function.
  *
+ * If #ClutterScript:lazy-construction is set, this function will
+ * construct every object that has not been constructed yet.
+ *
  * Since: 0.6
  */
 void
@@ -1158,11 +1272,22 @@ connect_each_object (gpointer key,
   SignalConnectData *connect_data = data;
   ClutterScript *script = connect_data->script;
   ObjectInfo *oinfo = value;
-  GObject *object = oinfo->object;
+  GObject *object;
   GList *unresolved, *l;
 
+  /* with lazy construction, only the objects with signal handlers
+   * are constructed here; their properties and children are still
+   * resolved the first time they are needed
+   */
+  if (oinfo->signals == NULL && script->priv->is_lazy)
+    return;
+
   _clutter_script_construct_object (script, oinfo);
 
+  object = oinfo->object;
+  if (object == NULL)
+    return;
+
   unresolved = NULL;
   for (l = oinfo->signals; l != NULL; l = l->next)
     {
@@ -1581,6 +1706,210 @@ clutter_script_get_translation_domain (ClutterScript *script)
   return script->priv->translation_domain;
 }
 
+/**
+ * clutter_script_set_lazy_construction:
+ * @script: a #ClutterScript
+ * @lazy: whether objects should be constructed when needed
+ *
+ * Sets whether the objects defined by the UI definitions loaded by
+ * @script should be constructed only when they are needed.
+ *
+ * By default, every object is constructed when its definition is
+ * loaded. If @lazy is %TRUE, the definitions are only parsed, and each
+ * object is constructed the first time it is retrieved through
+ * clutter_script_get_object(), or when an object that references it,
+ * for instance through its "children" member, is constructed. This
+ * allows loading a file that defines many screens while only paying
+ * for the ones that are actually shown.
+ *
+ * The objects with signal handlers are constructed by
+ * clutter_script_connect_signals(); clutter_script_list_objects() and
+ * clutter_script_ensure_objects() construct every object.
+ *
+ * This function should be called before loading any definition.
+ *
+ * Since: 1.28
+ */
+void
+clutter_script_set_lazy_construction (ClutterScript *script,
+                                      gboolean       lazy)
+{
+  ClutterScriptPrivate *priv;
+
+  g_return_if_fail (CLUTTER_IS_SCRIPT (script));
+
+  priv = script->priv;
+
+  lazy = !!lazy;
+
+  if (priv->is_lazy == lazy)
+    return;
+
+  priv->is_lazy = lazy;
+
+  g_object_notify_by_pspec (G_OBJECT (script), obj_props[PROP_LAZY_CONSTRUCTION]);
+}
+
+/**
+ * clutter_script_get_lazy_construction:
+ * @script: a #ClutterScript
+ *
+ * Retrieves the value set by clutter_script_set_lazy_construction().
+ *
+ * Return value: %TRUE if the objects are constructed when needed
+ *
+ * Since: 1.28
+ */
+gboolean
+clutter_script_get_lazy_construction (ClutterScript *script)
+{
+  g_return_val_if_fail (CLUTTER_IS_SCRIPT (script), FALSE);
+
+  return script->priv->is_lazy;
+}
+
+static gboolean
+clutter_script_prefetch_idle (gpointer data)
+{
+  ClutterScript *script = data;
+  ClutterScriptPrivate *priv = script->priv;
+  ObjectInfo *oinfo;
+  gchar *name;
+
+  /* construct one object for each iteration of the main loop */
+  name = g_queue_peek_head (&priv->prefetch_queue);
+  oinfo = _clutter_script_get_object_info (script, name);
+
+  if (oinfo != NULL && oinfo->object == NULL && oinfo->children != NULL)
+    {
+      GList *l;
+
+      CLUTTER_NOTE (SCRIPT, "Prefetching container '%s'", name);
+
+      /* the properties of a container are applied after its children
+       * have been constructed, each one in its own iteration
+       */
+      _clutter_script_construct_object (script, oinfo);
+
+      if (oinfo->object != NULL)
+        {
+          for (l = g_list_last (oinfo->children); l != NULL; l = l->prev)
+            {
+              ObjectInfo *child_info;
+
+              child_info = _clutter_script_get_object_info (script, l->data);
+              if (child_info != NULL && child_info->object == NULL)
+                g_queue_push_head (&priv->prefetch_queue, g_strdup (l->data));
+            }
+
+          return G_SOURCE_CONTINUE;
+        }
+    }
+
+  name = g_queue_pop_head (&priv->prefetch_queue);
+
+  if (oinfo != NULL)
+    {
+      CLUTTER_NOTE (SCRIPT, "Prefetching object '%s'", name);
+
+      _clutter_script_realize_object (script, oinfo);
+    }
+
+  g_free (name);
+
+  if (g_queue_is_empty (&priv->prefetch_queue))
+    {
+      priv->prefetch_id = 0;
+      return G_SOURCE_REMOVE;
+    }
+
+  return G_SOURCE_CONTINUE;
+}
+
+/**
+ * clutter_script_prefetch_objects:
+ * @script: a #ClutterScript
+ * @names: (array zero-terminated=1): a %NULL-terminated array of
+ *   object names
+ *
+ * Queues the construction of the objects named in @names, and of the
+ * objects they reference, like their children, when the main loop is
+ * idle.
+ *
+ * Each object is constructed in a separate iteration of the main loop,
+ * children first, so that prefetching a large subtree does not block
+ * the frames being drawn in the meantime for longer than it takes to
+ * construct a single object. The objects referenced by the properties
+ * of an object are constructed together with it.
+ *
+ * This function is only useful if #ClutterScript:lazy-construction is
+ * set; objects that have already been constructed are skipped.
+ *
+ * Since: 1.28
+ */
+void
+clutter_script_prefetch_objects (ClutterScript      *script,
+                                 const gchar * const *names)
+{
+  ClutterScriptPrivate *priv;
+  gint i;
+
+  g_return_if_fail (CLUTTER_IS_SCRIPT (script));
+  g_return_if_fail (names != NULL);
+
+  priv = script->priv;
+
+  for (i = 0; names[i] != NULL; i++)
+    g_queue_push_tail (&priv->prefetch_queue, g_strdup (names[i]));
+
+  if (priv->prefetch_id == 0 && !g_queue_is_empty (&priv->prefetch_queue))
+    priv->prefetch_id = clutter_threads_add_idle (clutter_script_prefetch_idle,
+                                                  script);
+}
+
+/**
+ * clutter_script_get_object_counts:
+ * @script: a #ClutterScript
+ * @n_declared: (out) (optional): return location for the number of
+ *   objects defined by the loaded UI definitions, or %NULL
+ * @n_constructed: (out) (optional): return location for the number of
+ *   objects that have been constructed, or %NULL
+ *
+ * Retrieves the number of objects defined by the UI definitions loaded
+ * by @script, and how many of them have been constructed.
+ *
+ * The two numbers are the same unless #ClutterScript:lazy-construction
+ * is set.
+ *
+ * Since: 1.28
+ */
+void
+clutter_script_get_object_counts (ClutterScript *script,
+                                  guint         *n_declared,
+                                  guint         *n_constructed)
+{
+  GHashTableIter iter;
+  gpointer value;
+  guint constructed = 0;
+
+  g_return_if_fail (CLUTTER_IS_SCRIPT (script));
+
+  g_hash_table_iter_init (&iter, script->priv->objects);
+  while (g_hash_table_iter_next (&iter, NULL, &value))
+    {
+      ObjectInfo *oinfo = value;
+
+      if (oinfo->object != NULL)
+        constructed += 1;
+    }
+
+  if (n_declared != NULL)
+    *n_declared = g_hash_table_size (script->priv->objects);
+
+  if (n_constructed != NULL)
+    *n_constructed = constructed;
+}
+
 /*
  * _clutter_script_generate_fake_id:
  * @script: a #ClutterScript
@@ -1733,3 +2062,45 @@ _clutter_script_add_object_info (ClutterScript *script,
   g_hash_table_steal (priv->objects, oinfo->id);
   g_hash_table_insert (priv->objects, oinfo->id, oinfo);
 }
+
+/*
+ * _clutter_script_is_lazy:
+ * @script: a #ClutterScript
+ *
+ * Checks whether the objects of @script should only be constructed
+ * when needed
+ *
+ * Return value: the value of #ClutterScript:lazy-construction
+ */
+gboolean
+_clutter_script_is_lazy (ClutterScript *script)
+{
+  return script->priv->is_lazy;
+}
+
+/*
+ * _clutter_script_realize_object:
+ * @script: a #ClutterScript
+ * @oinfo: a #ObjectInfo
+ *
+ * Constructs the object for @oinfo, if needed, and applies its
+ * properties. If @script is lazy, this also realizes the objects
+ * referenced by @oinfo, like its children.
+ */
+void
+_clutter_script_realize_object (ClutterScript *script,
+                                ObjectInfo    *oinfo)
+{
+  /* properties can reference each other, and we don't want to apply
+   * the properties of an object while we are still translating them
+   */
+  if (oinfo->is_realizing)
+    return;
+
+  oinfo->is_realizing = TRUE;
+
+  _clutter_script_construct_object (script, oinfo);
+  _clutter_script_apply_properties (script, oinfo);
+
+  oinfo->is_realizing = FALSE;
+}
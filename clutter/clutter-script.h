@@ -212,6 +212,19 @@ void            clutter_script_set_translation_domain   (ClutterScript
 CLUTTER_AVAILABLE_IN_1_10
 const gchar *   clutter_script_get_translation_domain   (ClutterScript             *script);
 
+CLUTTER_AVAILABLE_IN_1_28
+void            clutter_script_set_lazy_construction    (ClutterScript             *script,
+                                                         gboolean                   lazy);
+CLUTTER_AVAILABLE_IN_1_28
+gboolean        clutter_script_get_lazy_construction    (ClutterScript             *script);
+CLUTTER_AVAILABLE_IN_1_28
+void            clutter_script_prefetch_objects         (ClutterScript             *script,
+                                                         const gchar * const       *names);
+CLUTTER_AVAILABLE_IN_1_28
+void            clutter_script_get_object_counts        (ClutterScript             *script,
+                                                         guint                     *n_declared,
+                                                         guint                     *n_constructed);
+
 CLUTTER_AVAILABLE_IN_ALL
 const gchar *   clutter_get_script_id                   (GObject                   *gobject);
 
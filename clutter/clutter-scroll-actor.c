@@ -36,6 +36,16 @@
  * #ClutterScrollActor does not provide pointer or keyboard event handling,
  * nor does it provide visible scroll handles.
  *
+ * By default, every change of the scroll origin repaints the whole visible
+ * portion of the children. Setting the #ClutterScrollActor:scroll-by-copy
+ * property will keep the last rendered contents in an offscreen texture;
+ * when scrolling, the part of the texture that is still visible is copied
+ * at the new position, and only the newly exposed area is painted. The
+ * cached contents are discarded whenever one of the children queues a
+ * redraw. When using this mode the scroll origin is rounded to whole
+ * pixels, and the scroll actor will fall back to painting its children
+ * directly if it is scaled up.
+ *
  * See [scroll-actor.c](https://git.gnome.org/browse/clutter/tree/examples/scroll-actor.c?h=clutter-1.18)
  * for an example of how to use #ClutterScrollActor.
  *
@@ -46,16 +56,65 @@
 #include "config.h"
 #endif
 
+#include <math.h>
+
+#define CLUTTER_ENABLE_EXPERIMENTAL_API
 #include "clutter-scroll-actor.h"
 
 #include "clutter-actor-private.h"
 #include "clutter-animatable.h"
+#include "clutter-backend.h"
 #include "clutter-debug.h"
 #include "clutter-enum-types.h"
+#include "clutter-main.h"
 #include "clutter-private.h"
 #include "clutter-property-transition.h"
+#include "clutter-stage-private.h"
+#include "clutter-stage-window.h"
 #include "clutter-transition.h"
 
+#include "cogl/cogl.h"
+
+/* how much the scroll actor can be scaled up before we consider the
+ * cached contents too blurry and paint the children directly
+ */
+#define SCROLL_CACHE_SCALE_THRESHOLD    1.01f
+
+/* the depth range of the children that is retained when painting
+ * them inside the cache
+ */
+#define SCROLL_CACHE_DEPTH              1000.f
+
+/* The rendered contents of the visible area of a scroll actor; we use
+ * two buffers, since the still visible portion of the front buffer is
+ * copied into the back buffer when scrolling
+ */
+typedef struct _ScrollCache
+{
+  CoglHandle texture[2];
+  CoglHandle offscreen[2];
+  CoglPipeline *copy_pipeline;
+  CoglPipeline *pipeline;
+
+  /* the index of the buffer holding the current contents */
+  guint front;
+
+  /* the size of the cached area, in units of the scroll actor */
+  gint width;
+  gint height;
+
+  /* the number of texels for each unit of the scroll actor */
+  gint scale;
+
+  /* the translation of the children used when painting the front
+   * buffer
+   */
+  gint dx;
+  gint dy;
+
+  guint is_valid : 1;
+} ScrollCache;
+
 struct _ClutterScrollActorPrivate
 {
   ClutterPoint scroll_to;
@@ -63,6 +122,11 @@ struct _ClutterScrollActorPrivate
   ClutterScrollMode scroll_mode;
 
   ClutterTransition *transition;
+
+  ScrollCache *cache;
+
+  guint scroll_by_copy : 1;
+  guint in_scroll_update : 1;
 };
 
 enum
@@ -70,6 +134,7 @@ enum
   PROP_0,
 
   PROP_SCROLL_MODE,
+  PROP_SCROLL_BY_COPY,
 
   PROP_LAST
 };
@@ -96,14 +161,80 @@ G_DEFINE_TYPE_WITH_CODE (ClutterScrollActor, clutter_scroll_actor, CLUTTER_TYPE_
                                                 clutter_animatable_iface_init))
 
 static void
-clutter_scroll_actor_set_scroll_to_internal (ClutterScrollActor *self,
-                                             const ClutterPoint *point)
+scroll_cache_free (ScrollCache *cache)
+{
+  guint i;
+
+  for (i = 0; i < 2; i++)
+    {
+      if (cache->offscreen[i] != NULL)
+        cogl_handle_unref (cache->offscreen[i]);
+
+      if (cache->texture[i] != NULL)
+        cogl_handle_unref (cache->texture[i]);
+    }
+
+  if (cache->copy_pipeline != NULL)
+    cogl_object_unref (cache->copy_pipeline);
+
+  if (cache->pipeline != NULL)
+    cogl_object_unref (cache->pipeline);
+
+  g_slice_free (ScrollCache, cache);
+}
+
+static void
+clutter_scroll_actor_clear_cache (ClutterScrollActor *self)
+{
+  ClutterScrollActorPrivate *priv = self->priv;
+
+  if (priv->cache != NULL)
+    {
+      scroll_cache_free (priv->cache);
+      priv->cache = NULL;
+    }
+}
+
+static void
+clutter_scroll_actor_update_child_transform (ClutterScrollActor *self)
 {
   ClutterScrollActorPrivate *priv = self->priv;
-  ClutterActor *actor = CLUTTER_ACTOR (self);
   ClutterMatrix m = CLUTTER_MATRIX_INIT_IDENTITY;
   float dx, dy;
 
+  if (priv->scroll_mode & CLUTTER_SCROLL_HORIZONTALLY)
+    dx = -priv->scroll_to.x;
+  else
+    dx = 0.f;
+
+  if (priv->scroll_mode & CLUTTER_SCROLL_VERTICALLY)
+    dy = -priv->scroll_to.y;
+  else
+    dy = 0.f;
+
+  /* the cached contents can only be copied by whole pixels */
+  if (priv->scroll_by_copy)
+    {
+      dx = floorf (dx + 0.5f);
+      dy = floorf (dy + 0.5f);
+    }
+
+  cogl_matrix_translate (&m, dx, dy, 0.f);
+
+  /* changing the scroll origin does not change the contents of the
+   * children, so it must not invalidate the cache
+   */
+  priv->in_scroll_update = TRUE;
+  clutter_actor_set_child_transform (CLUTTER_ACTOR (self), &m);
+  priv->in_scroll_update = FALSE;
+}
+
+static void
+clutter_scroll_actor_set_scroll_to_internal (ClutterScrollActor *self,
+                                             const ClutterPoint *point)
+{
+  ClutterScrollActorPrivate *priv = self->priv;
+
   if (clutter_point_equals (&priv->scroll_to, point))
     return;
 
@@ -112,18 +243,376 @@ clutter_scroll_actor_set_scroll_to_internal (ClutterScrollActor *self,
   else
     priv->scroll_to = *point;
 
-  if (priv->scroll_mode & CLUTTER_SCROLL_HORIZONTALLY)
-    dx = -priv->scroll_to.x;
+  clutter_scroll_actor_update_child_transform (self);
+}
+
+static gfloat
+matrix_get_axis_scale (const CoglMatrix *matrix,
+                       gint              axis)
+{
+  const float *m = cogl_matrix_get_array (matrix);
+  const float *column = m + (axis * 4);
+
+  return sqrtf (column[0] * column[0]
+              + column[1] * column[1]
+              + column[2] * column[2]);
+}
+
+/* Retrieves the number of texels for each unit of the scroll actor,
+ * or returns %FALSE if the cached contents cannot be used
+ */
+static gboolean
+clutter_scroll_actor_get_cache_scale (ClutterScrollActor *self,
+                                      gint               *scale_p)
+{
+  ClutterActor *actor = CLUTTER_ACTOR (self);
+  ClutterStageWindow *stage_window;
+  ClutterActor *stage;
+  CoglMatrix modelview, view;
+  gfloat unit_scale, x_scale, y_scale;
+  gint scale;
+
+  stage = _clutter_actor_get_stage_internal (actor);
+  if (stage == NULL)
+    return FALSE;
+
+  stage_window = _clutter_stage_get_window (CLUTTER_STAGE (stage));
+  scale = stage_window != NULL
+        ? _clutter_stage_window_get_scale_factor (stage_window)
+        : 1;
+
+  cogl_matrix_init_identity (&view);
+  _clutter_actor_apply_modelview_transform (stage, &view);
+  unit_scale = matrix_get_axis_scale (&view, 0) / scale;
+  if (unit_scale <= 0.f)
+    return FALSE;
+
+  cogl_get_modelview_matrix (&modelview);
+  x_scale = matrix_get_axis_scale (&modelview, 0) / unit_scale;
+  y_scale = matrix_get_axis_scale (&modelview, 1) / unit_scale;
+
+  if (x_scale > scale * SCROLL_CACHE_SCALE_THRESHOLD ||
+      y_scale > scale * SCROLL_CACHE_SCALE_THRESHOLD)
+    {
+      CLUTTER_NOTE (PAINT, "Scroll actor '%s' is scaled by %.2fx%.2f, "
+                           "painting its children directly",
+                    _clutter_actor_get_debug_name (actor),
+                    x_scale, y_scale);
+      return FALSE;
+    }
+
+  *scale_p = scale;
+
+  return TRUE;
+}
+
+static gboolean
+clutter_scroll_actor_ensure_cache (ClutterScrollActor *self,
+                                   gint                width,
+                                   gint                height,
+                                   gint                scale)
+{
+  ClutterScrollActorPrivate *priv = self->priv;
+  ScrollCache *cache;
+  guint i;
+
+  if (priv->cache != NULL &&
+      priv->cache->width == width &&
+      priv->cache->height == height &&
+      priv->cache->scale == scale)
+    return TRUE;
+
+  clutter_scroll_actor_clear_cache (self);
+
+  cache = g_slice_new0 (ScrollCache);
+  cache->width = width;
+  cache->height = height;
+  cache->scale = scale;
+
+  for (i = 0; i < 2; i++)
+    {
+      cache->texture[i] = cogl_texture_new_with_size (width * scale,
+                                                      height * scale,
+                                                      COGL_TEXTURE_NO_SLICING,
+                                                      COGL_PIXEL_FORMAT_RGBA_8888_PRE);
+      if (cache->texture[i] == NULL)
+        goto error;
+
+      cache->offscreen[i] = cogl_offscreen_new_to_texture (cache->texture[i]);
+      if (cache->offscreen[i] == NULL)
+        goto error;
+    }
+
+  priv->cache = cache;
+
+  return TRUE;
+
+error:
+  CLUTTER_NOTE (PAINT, "Unable to create an offscreen buffer "
+                       "of %dx%d for the scroll actor '%s'",
+                width * scale, height * scale,
+                _clutter_actor_get_debug_name (CLUTTER_ACTOR (self)));
+
+  scroll_cache_free (cache);
+
+  return FALSE;
+}
+
+/* paints the children inside the given area of the current framebuffer,
+ * which is in the coordinate space of the scroll actor
+ */
+static void
+clutter_scroll_actor_paint_area (ClutterScrollActor *self,
+                                 gint                x1,
+                                 gint                y1,
+                                 gint                x2,
+                                 gint                y2)
+{
+  ClutterActorBox box;
+
+  if (x2 <= x1 || y2 <= y1)
+    return;
+
+  CLUTTER_NOTE (PAINT, "Painting the area { %d, %d - %d x %d } of '%s'",
+                x1, y1, x2 - x1, y2 - y1,
+                _clutter_actor_get_debug_name (CLUTTER_ACTOR (self)));
+
+  /* the children are painted as clones, so they are not culled against
+   * the stage clip; we only paint the ones inside the exposed area
+   */
+  clutter_actor_box_init (&box, x1, y1, x2, y2);
+
+  cogl_clip_push_rectangle (x1, y1, x2, y2);
+  _clutter_actor_paint_children_in_box (CLUTTER_ACTOR (self), &box);
+  cogl_clip_pop ();
+}
+
+static void
+clutter_scroll_actor_update_cache (ClutterScrollActor *self)
+{
+  ClutterScrollActorPrivate *priv = self->priv;
+  ClutterActor *actor = CLUTTER_ACTOR (self);
+  ScrollCache *cache = priv->cache;
+  ClutterMatrix child_transform;
+  CoglMatrix modelview;
+  CoglColor transparent;
+  gint dx, dy, sx, sy;
+  gint old_opacity;
+  guint back;
+
+  clutter_actor_get_child_transform (actor, &child_transform);
+  dx = (gint) floorf (child_transform.xw + 0.5f);
+  dy = (gint) floorf (child_transform.yw + 0.5f);
+
+  if (cache->is_valid && cache->dx == dx && cache->dy == dy)
+    return;
+
+  /* the offset of the old contents inside the new ones */
+  sx = dx - cache->dx;
+  sy = dy - cache->dy;
+
+  if (!cache->is_valid ||
+      ABS (sx) >= cache->width ||
+      ABS (sy) >= cache->height)
+    {
+      back = cache->front;
+      cache->is_valid = FALSE;
+    }
   else
-    dx = 0.f;
+    back = 1 - cache->front;
 
-  if (priv->scroll_mode & CLUTTER_SCROLL_VERTICALLY)
-    dy = -priv->scroll_to.y;
+  cogl_push_framebuffer (cache->offscreen[back]);
+
+  cogl_ortho (0, cache->width, cache->height, 0,
+              -SCROLL_CACHE_DEPTH, SCROLL_CACHE_DEPTH);
+
+  cogl_matrix_init_identity (&modelview);
+  cogl_set_modelview_matrix (&modelview);
+
+  cogl_color_init_from_4ub (&transparent, 0, 0, 0, 0);
+  cogl_clear (&transparent,
+              COGL_BUFFER_BIT_COLOR |
+              COGL_BUFFER_BIT_DEPTH);
+
+  /* the paint opacity of the scroll actor is applied when painting the
+   * cached texture, and the children must not be culled against the
+   * clip of the stage, since the contents are reused in later frames
+   */
+  old_opacity = clutter_actor_get_opacity_override (actor);
+  clutter_actor_set_opacity_override (actor, 0xff);
+  _clutter_actor_push_clone_paint ();
+
+  if (cache->is_valid)
+    {
+      gint y1, y2;
+
+      if (cache->copy_pipeline == NULL)
+        {
+          CoglContext *ctx =
+            clutter_backend_get_cogl_context (clutter_get_default_backend ());
+
+          cache->copy_pipeline = cogl_pipeline_new (ctx);
+          cogl_pipeline_set_blend (cache->copy_pipeline,
+                                   "RGBA = ADD (SRC_COLOR, 0)",
+                                   NULL);
+          cogl_pipeline_set_layer_filters (cache->copy_pipeline, 0,
+                                           COGL_PIPELINE_FILTER_NEAREST,
+                                           COGL_PIPELINE_FILTER_NEAREST);
+        }
+
+      cogl_pipeline_set_layer_texture (cache->copy_pipeline, 0,
+                                       cache->texture[cache->front]);
+      cogl_set_source (cache->copy_pipeline);
+      cogl_rectangle (sx, sy, sx + cache->width, sy + cache->height);
+
+      /* paint the newly exposed rows, and then the newly exposed
+       * columns of the remaining rows, so that no area is painted
+       * twice
+       */
+      if (sy > 0)
+        {
+          clutter_scroll_actor_paint_area (self, 0, 0, cache->width, sy);
+          y1 = sy;
+          y2 = cache->height;
+        }
+      else
+        {
+          clutter_scroll_actor_paint_area (self,
+                                           0, cache->height + sy,
+                                           cache->width, cache->height);
+          y1 = 0;
+          y2 = cache->height + sy;
+        }
+
+      if (sx > 0)
+        clutter_scroll_actor_paint_area (self, 0, y1, sx, y2);
+      else
+        clutter_scroll_actor_paint_area (self,
+                                         cache->width + sx, y1,
+                                         cache->width, y2);
+    }
   else
-    dy = 0.f;
+    {
+      CLUTTER_NOTE (PAINT, "Painting the whole cache of '%s' (%dx%d)",
+                    _clutter_actor_get_debug_name (actor),
+                    cache->width * cache->scale,
+                    cache->height * cache->scale);
 
-  cogl_matrix_translate (&m, dx, dy, 0.f);
-  clutter_actor_set_child_transform (actor, &m);
+      clutter_scroll_actor_paint_area (self, 0, 0, cache->width, cache->height);
+    }
+
+  _clutter_actor_pop_clone_paint ();
+  clutter_actor_set_opacity_override (actor, old_opacity);
+
+  cogl_pop_framebuffer ();
+
+  cache->front = back;
+  cache->dx = dx;
+  cache->dy = dy;
+  cache->is_valid = TRUE;
+}
+
+static gboolean
+clutter_scroll_actor_paint_cached (ClutterScrollActor *self)
+{
+  ClutterScrollActorPrivate *priv = self->priv;
+  ClutterActor *actor = CLUTTER_ACTOR (self);
+  ClutterActorBox box;
+  ScrollCache *cache;
+  guint8 paint_opacity;
+  gint width, height;
+  gint scale;
+
+  if (!clutter_scroll_actor_get_cache_scale (self, &scale))
+    return FALSE;
+
+  clutter_actor_get_allocation_box (actor, &box);
+  width = (gint) ceilf (clutter_actor_box_get_width (&box));
+  height = (gint) ceilf (clutter_actor_box_get_height (&box));
+
+  if (width <= 0 || height <= 0)
+    return TRUE;
+
+  if (!clutter_scroll_actor_ensure_cache (self, width, height, scale))
+    return FALSE;
+
+  clutter_scroll_actor_update_cache (self);
+
+  cache = priv->cache;
+
+  if (cache->pipeline == NULL)
+    {
+      CoglContext *ctx =
+        clutter_backend_get_cogl_context (clutter_get_default_backend ());
+
+      cache->pipeline = cogl_pipeline_new (ctx);
+    }
+
+  paint_opacity = clutter_actor_get_paint_opacity (actor);
+  cogl_pipeline_set_layer_texture (cache->pipeline, 0,
+                                   cache->texture[cache->front]);
+  cogl_pipeline_set_color4ub (cache->pipeline,
+                              paint_opacity,
+                              paint_opacity,
+                              paint_opacity,
+                              paint_opacity);
+  cogl_set_source (cache->pipeline);
+  cogl_rectangle (0, 0, cache->width, cache->height);
+
+  return TRUE;
+}
+
+static void
+clutter_scroll_actor_paint (ClutterActor *actor)
+{
+  ClutterScrollActor *self = CLUTTER_SCROLL_ACTOR (actor);
+
+  if (self->priv->scroll_by_copy && clutter_scroll_actor_paint_cached (self))
+    return;
+
+  CLUTTER_ACTOR_CLASS (clutter_scroll_actor_parent_class)->paint (actor);
+}
+
+static void
+clutter_scroll_actor_queue_redraw (ClutterActor *actor,
+                                   ClutterActor *leaf_that_queued)
+{
+  ClutterScrollActorPrivate *priv = CLUTTER_SCROLL_ACTOR (actor)->priv;
+
+  if (priv->cache != NULL && priv->cache->is_valid && !priv->in_scroll_update)
+    {
+      CLUTTER_NOTE (PAINT, "Invalidating the cache of '%s' (redraw from '%s')",
+                    _clutter_actor_get_debug_name (actor),
+                    _clutter_actor_get_debug_name (leaf_that_queued));
+
+      priv->cache->is_valid = FALSE;
+
+      /* the children are not culled nor tracked when painted inside the
+       * cache, so we cannot rely on their paint volumes to clip the
+       * redraw; we redraw the whole visible area instead
+       */
+      if (leaf_that_queued != actor)
+        clutter_actor_queue_redraw (actor);
+    }
+
+  CLUTTER_ACTOR_CLASS (clutter_scroll_actor_parent_class)->queue_redraw (actor,
+                                                                          leaf_that_queued);
+}
+
+static void
+clutter_scroll_actor_unrealize (ClutterActor *actor)
+{
+  clutter_scroll_actor_clear_cache (CLUTTER_SCROLL_ACTOR (actor));
+
+  CLUTTER_ACTOR_CLASS (clutter_scroll_actor_parent_class)->unrealize (actor);
+}
+
+static void
+clutter_scroll_actor_finalize (GObject *gobject)
+{
+  clutter_scroll_actor_clear_cache (CLUTTER_SCROLL_ACTOR (gobject));
+
+  G_OBJECT_CLASS (clutter_scroll_actor_parent_class)->finalize (gobject);
 }
 
 static void
@@ -140,6 +629,10 @@ clutter_scroll_actor_set_property (GObject      *gobject,
       clutter_scroll_actor_set_scroll_mode (actor, g_value_get_flags (value));
       break;
 
+    case PROP_SCROLL_BY_COPY:
+      clutter_scroll_actor_set_scroll_by_copy (actor, g_value_get_boolean (value));
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id, pspec);
     }
@@ -159,6 +652,10 @@ clutter_scroll_actor_get_property (GObject    *gobject,
       g_value_set_flags (value, actor->priv->scroll_mode);
       break;
 
+    case PROP_SCROLL_BY_COPY:
+      g_value_set_boolean (value, actor->priv->scroll_by_copy);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id, pspec);
     }
@@ -168,9 +665,15 @@ static void
 clutter_scroll_actor_class_init (ClutterScrollActorClass *klass)
 {
   GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  ClutterActorClass *actor_class = CLUTTER_ACTOR_CLASS (klass);
 
   gobject_class->set_property = clutter_scroll_actor_set_property;
   gobject_class->get_property = clutter_scroll_actor_get_property;
+  gobject_class->finalize = clutter_scroll_actor_finalize;
+
+  actor_class->paint = clutter_scroll_actor_paint;
+  actor_class->queue_redraw = clutter_scroll_actor_queue_redraw;
+  actor_class->unrealize = clutter_scroll_actor_unrealize;
 
   /**
    * ClutterScrollActor:scroll-mode:
@@ -188,6 +691,23 @@ clutter_scroll_actor_class_init (ClutterScrollActorClass *klass)
                         G_PARAM_READWRITE |
                         G_PARAM_STATIC_STRINGS);
 
+  /**
+   * ClutterScrollActor:scroll-by-copy:
+   *
+   * Whether the scroll actor should keep its visible contents in an
+   * offscreen buffer, and only paint the newly exposed area of its
+   * children when scrolling.
+   *
+   * Since: 1.28
+   */
+  obj_props[PROP_SCROLL_BY_COPY] =
+    g_param_spec_boolean ("scroll-by-copy",
+                          P_("Scroll By Copy"),
+                          P_("Whether scrolling should reuse the contents painted in the previous frame"),
+                          FALSE,
+                          G_PARAM_READWRITE |
+                          G_PARAM_STATIC_STRINGS);
+
   g_object_class_install_properties (gobject_class, PROP_LAST, obj_props);
 }
 
@@ -434,3 +954,60 @@ clutter_scroll_actor_scroll_to_rect (ClutterScrollActor *actor,
 
   clutter_scroll_actor_scroll_to_point (actor, &n_rect.origin);
 }
+
+/**
+ * clutter_scroll_actor_set_scroll_by_copy:
+ * @actor: a #ClutterScrollActor
+ * @scroll_by_copy: whether to reuse the painted contents when scrolling
+ *
+ * Sets the #ClutterScrollActor:scroll-by-copy property.
+ *
+ * This is useful for long lists of children that scroll often but
+ * rarely change, since each step of the scrolling will only paint the
+ * children inside the newly exposed area of @actor. The scroll origin
+ * is rounded to whole pixels when @scroll_by_copy is %TRUE.
+ *
+ * Since: 1.28
+ */
+void
+clutter_scroll_actor_set_scroll_by_copy (ClutterScrollActor *actor,
+                                         gboolean            scroll_by_copy)
+{
+  ClutterScrollActorPrivate *priv;
+
+  g_return_if_fail (CLUTTER_IS_SCROLL_ACTOR (actor));
+
+  priv = actor->priv;
+
+  scroll_by_copy = !!scroll_by_copy;
+  if (priv->scroll_by_copy == scroll_by_copy)
+    return;
+
+  priv->scroll_by_copy = scroll_by_copy;
+
+  if (!priv->scroll_by_copy)
+    clutter_scroll_actor_clear_cache (actor);
+
+  clutter_scroll_actor_update_child_transform (actor);
+  clutter_actor_queue_redraw (CLUTTER_ACTOR (actor));
+
+  g_object_notify_by_pspec (G_OBJECT (actor), obj_props[PROP_SCROLL_BY_COPY]);
+}
+
+/**
+ * clutter_scroll_actor_get_scroll_by_copy:
+ * @actor: a #ClutterScrollActor
+ *
+ * Retrieves the value set using clutter_scroll_actor_set_scroll_by_copy().
+ *
+ * Return value: %TRUE if the painted contents are reused when scrolling
+ *
+ * Since: 1.28
+ */
+gboolean
+clutter_scroll_actor_get_scroll_by_copy (ClutterScrollActor *actor)
+{
+  g_return_val_if_fail (CLUTTER_IS_SCROLL_ACTOR (actor), FALSE);
+
+  return actor->priv->scroll_by_copy;
+}
@@ -92,6 +92,12 @@ CLUTTER_AVAILABLE_IN_1_12
 void                    clutter_scroll_actor_scroll_to_rect     (ClutterScrollActor *actor,
                                                                  const ClutterRect  *rect);
 
+CLUTTER_AVAILABLE_IN_1_28
+void                    clutter_scroll_actor_set_scroll_by_copy (ClutterScrollActor *actor,
+                                                                 gboolean            scroll_by_copy);
+CLUTTER_AVAILABLE_IN_1_28
+gboolean                clutter_scroll_actor_get_scroll_by_copy (ClutterScrollActor *actor);
+
 G_END_DECLS
 
 #endif /* __CLUTTER_SCROLL_ACTOR_H__ */
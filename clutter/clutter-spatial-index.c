@@ -0,0 +1,861 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ClutterSpatialIndex: a bounding volume hierarchy of 2D boxes
+ *
+ * The index is a dynamic AABB tree: every item is a leaf, and every
+ * inner node holds the union of the boxes of its two children. Leaves
+ * are inserted next to the sibling that minimizes the growth of the
+ * tree, and the tree is kept balanced using rotations, so that both
+ * updates and queries are O(log n).
+ *
+ * The boxes of the leaves are slightly enlarged, so that items that
+ * move by small amounts do not need to be reinserted every time.
+ *
+ * Items are invalidated cheaply, and their boxes are only computed,
+ * using the function passed to the constructor, when the index is
+ * queried. Items without a box, or whose box does not lie on the
+ * z = 0 plane, are kept outside of the tree; they are matched by
+ * every query they could possibly satisfy.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "clutter-spatial-index.h"
+
+#include "clutter-actor-box.h"
+#include "clutter-debug.h"
+
+#define NULL_NODE       (-1)
+
+/* the fraction of the size of a box added on each side when storing
+ * it in the tree
+ */
+#define FAT_BOX_FACTOR  0.1f
+
+typedef struct _Entry
+{
+  gpointer data;
+
+  /* the exact box, as returned by the box function */
+  ClutterActorBox box;
+
+  /* the leaf node, or NULL_NODE if the entry is not in the tree */
+  gint node;
+
+  guint order;
+
+  guint is_dirty   : 1;
+  guint is_removed : 1;
+  guint has_box    : 1;
+  guint is_flat    : 1;
+} Entry;
+
+typedef struct _Node
+{
+  ClutterActorBox box;
+
+  /* the parent node, or the next free node if the node is unused */
+  gint parent;
+
+  gint child1;
+  gint child2;
+
+  /* 0 for leaves, -1 for unused nodes */
+  gint height;
+
+  Entry *entry;
+} Node;
+
+struct _ClutterSpatialIndex
+{
+  GArray *nodes;
+  gint root;
+  gint free_list;
+
+  /* data -> Entry */
+  GHashTable *entries;
+
+  /* entries that are not in the tree */
+  GHashTable *outliers;
+
+  /* entries that need to be updated before the next query */
+  GPtrArray *dirty;
+
+  /* scratch space for the tree traversal */
+  GArray *stack;
+
+  ClutterSpatialIndexBoxFunc box_func;
+  gpointer box_data;
+};
+
+#define NODE(index_,n)  (&g_array_index ((index_)->nodes, Node, (n)))
+#define IS_LEAF(node)   ((node)->child1 == NULL_NODE)
+
+static inline void
+box_union (const ClutterActorBox *a,
+           const ClutterActorBox *b,
+           ClutterActorBox       *res)
+{
+  res->x1 = MIN (a->x1, b->x1);
+  res->y1 = MIN (a->y1, b->y1);
+  res->x2 = MAX (a->x2, b->x2);
+  res->y2 = MAX (a->y2, b->y2);
+}
+
+static inline float
+box_perimeter (const ClutterActorBox *box)
+{
+  return 2.f * ((box->x2 - box->x1) + (box->y2 - box->y1));
+}
+
+static inline gboolean
+box_contains (const ClutterActorBox *outer,
+              const ClutterActorBox *inner)
+{
+  return outer->x1 <= inner->x1 &&
+         outer->y1 <= inner->y1 &&
+         outer->x2 >= inner->x2 &&
+         outer->y2 >= inner->y2;
+}
+
+static inline gboolean
+box_intersects (const ClutterActorBox *a,
+                const ClutterActorBox *b)
+{
+  return a->x1 <= b->x2 &&
+         a->x2 >= b->x1 &&
+         a->y1 <= b->y2 &&
+         a->y2 >= b->y1;
+}
+
+/* a box is outside of a half-plane if the corner that maximizes
+ * a * x + b * y + c is on the negative side
+ */
+static inline gboolean
+box_inside_half_planes (const ClutterActorBox *box,
+                        const float           *half_planes,
+                        guint                  n_half_planes)
+{
+  guint i;
+
+  for (i = 0; i < n_half_planes; i++)
+    {
+      const float *p = half_planes + i * 3;
+      float x = p[0] > 0.f ? box->x2 : box->x1;
+      float y = p[1] > 0.f ? box->y2 : box->y1;
+
+      if (p[0] * x + p[1] * y + p[2] < 0.f)
+        return FALSE;
+    }
+
+  return TRUE;
+}
+
+static gint
+node_allocate (ClutterSpatialIndex *index_)
+{
+  Node *node;
+  gint retval;
+
+  if (index_->free_list != NULL_NODE)
+    {
+      retval = index_->free_list;
+      index_->free_list = NODE (index_, retval)->parent;
+    }
+  else
+    {
+      retval = index_->nodes->len;
+      g_array_set_size (index_->nodes, retval + 1);
+    }
+
+  node = NODE (index_, retval);
+  node->parent = NULL_NODE;
+  node->child1 = NULL_NODE;
+  node->child2 = NULL_NODE;
+  node->height = 0;
+  node->entry = NULL;
+
+  return retval;
+}
+
+static void
+node_free (ClutterSpatialIndex *index_,
+           gint                 n)
+{
+  Node *node = NODE (index_, n);
+
+  node->parent = index_->free_list;
+  node->height = -1;
+  node->entry = NULL;
+
+  index_->free_list = n;
+}
+
+static inline void
+node_update (ClutterSpatialIndex *index_,
+             gint                 n)
+{
+  Node *node = NODE (index_, n);
+  Node *child1 = NODE (index_, node->child1);
+  Node *child2 = NODE (index_, node->child2);
+
+  box_union (&child1->box, &child2->box, &node->box);
+  node->height = 1 + MAX (child1->height, child2->height);
+}
+
+static inline void
+node_replace_child (ClutterSpatialIndex *index_,
+                    gint                 parent,
+                    gint                 old_child,
+                    gint                 new_child)
+{
+  if (parent == NULL_NODE)
+    {
+      index_->root = new_child;
+      return;
+    }
+
+  if (NODE (index_, parent)->child1 == old_child)
+    NODE (index_, parent)->child1 = new_child;
+  else
+    NODE (index_, parent)->child2 = new_child;
+}
+
+/* performs a left or right rotation if node @a is imbalanced, and
+ * returns the new root of the sub-tree
+ */
+static gint
+tree_balance (ClutterSpatialIndex *index_,
+              gint                 a)
+{
+  Node *A = NODE (index_, a);
+  Node *B, *C;
+  gint b, c;
+  gint balance;
+
+  if (IS_LEAF (A) || A->height < 2)
+    return a;
+
+  b = A->child1;
+  c = A->child2;
+  B = NODE (index_, b);
+  C = NODE (index_, c);
+
+  balance = C->height - B->height;
+
+  /* rotate C up */
+  if (balance > 1)
+    {
+      gint f = C->child1;
+      gint g = C->child2;
+      Node *F = NODE (index_, f);
+      Node *G = NODE (index_, g);
+
+      C->child1 = a;
+      C->parent = A->parent;
+      A->parent = c;
+
+      node_replace_child (index_, C->parent, a, c);
+
+      if (F->height > G->height)
+        {
+          C->child2 = f;
+          A->child2 = g;
+          G->parent = a;
+        }
+      else
+        {
+          C->child2 = g;
+          A->child2 = f;
+          F->parent = a;
+        }
+
+      node_update (index_, a);
+      node_update (index_, c);
+
+      return c;
+    }
+
+  /* rotate B up */
+  if (balance < -1)
+    {
+      gint d = B->child1;
+      gint e = B->child2;
+      Node *D = NODE (index_, d);
+      Node *E = NODE (index_, e);
+
+      B->child1 = a;
+      B->parent = A->parent;
+      A->parent = b;
+
+      node_replace_child (index_, B->parent, a, b);
+
+      if (D->height > E->height)
+        {
+          B->child2 = d;
+          A->child1 = e;
+          E->parent = a;
+        }
+      else
+        {
+          B->child2 = e;
+          A->child1 = d;
+          D->parent = a;
+        }
+
+      node_update (index_, a);
+      node_update (index_, b);
+
+      return b;
+    }
+
+  return a;
+}
+
+static void
+tree_refit (ClutterSpatialIndex *index_,
+            gint                 n)
+{
+  while (n != NULL_NODE)
+    {
+      n = tree_balance (index_, n);
+      node_update (index_, n);
+
+      n = NODE (index_, n)->parent;
+    }
+}
+
+static void
+tree_insert_leaf (ClutterSpatialIndex *index_,
+                  gint                 leaf)
+{
+  ClutterActorBox leaf_box;
+  gint sibling, old_parent, new_parent;
+
+  if (index_->root == NULL_NODE)
+    {
+      index_->root = leaf;
+      NODE (index_, leaf)->parent = NULL_NODE;
+      return;
+    }
+
+  leaf_box = NODE (index_, leaf)->box;
+
+  /* find the best sibling for the new leaf, using the perimeter of
+   * the boxes as the cost function
+   */
+  sibling = index_->root;
+  while (!IS_LEAF (NODE (index_, sibling)))
+    {
+      Node *node = NODE (index_, sibling);
+      Node *child1 = NODE (index_, node->child1);
+      Node *child2 = NODE (index_, node->child2);
+      ClutterActorBox combined;
+      float cost, inheritance_cost, cost1, cost2;
+
+      box_union (&node->box, &leaf_box, &combined);
+
+      /* the cost of creating a new parent for this node and the leaf */
+      cost = 2.f * box_perimeter (&combined);
+
+      /* the minimum cost of pushing the leaf further down the tree */
+      inheritance_cost = 2.f * (box_perimeter (&combined) - box_perimeter (&node->box));
+
+      box_union (&child1->box, &leaf_box, &combined);
+      cost1 = box_perimeter (&combined) + inheritance_cost;
+      if (!IS_LEAF (child1))
+        cost1 -= box_perimeter (&child1->box);
+
+      box_union (&child2->box, &leaf_box, &combined);
+      cost2 = box_perimeter (&combined) + inheritance_cost;
+      if (!IS_LEAF (child2))
+        cost2 -= box_perimeter (&child2->box);
+
+      if (cost < cost1 && cost < cost2)
+        break;
+
+      sibling = cost1 < cost2 ? node->child1 : node->child2;
+    }
+
+  old_parent = NODE (index_, sibling)->parent;
+
+  new_parent = node_allocate (index_);
+  NODE (index_, new_parent)->parent = old_parent;
+  NODE (index_, new_parent)->child1 = sibling;
+  NODE (index_, new_parent)->child2 = leaf;
+  node_update (index_, new_parent);
+
+  node_replace_child (index_, old_parent, sibling, new_parent);
+
+  NODE (index_, sibling)->parent = new_parent;
+  NODE (index_, leaf)->parent = new_parent;
+
+  tree_refit (index_, old_parent);
+}
+
+static void
+tree_remove_leaf (ClutterSpatialIndex *index_,
+                  gint                 leaf)
+{
+  gint parent, grand_parent, sibling;
+
+  if (leaf == index_->root)
+    {
+      index_->root = NULL_NODE;
+      return;
+    }
+
+  parent = NODE (index_, leaf)->parent;
+  grand_parent = NODE (index_, parent)->parent;
+
+  if (NODE (index_, parent)->child1 == leaf)
+    sibling = NODE (index_, parent)->child2;
+  else
+    sibling = NODE (index_, parent)->child1;
+
+  node_replace_child (index_, grand_parent, parent, sibling);
+  NODE (index_, sibling)->parent = grand_parent;
+
+  node_free (index_, parent);
+
+  tree_refit (index_, grand_parent);
+}
+
+static void
+entry_unlink (ClutterSpatialIndex *index_,
+              Entry               *entry)
+{
+  if (entry->node != NULL_NODE)
+    {
+      tree_remove_leaf (index_, entry->node);
+      node_free (index_, entry->node);
+      entry->node = NULL_NODE;
+    }
+  else
+    g_hash_table_remove (index_->outliers, entry);
+}
+
+static void
+entry_update (ClutterSpatialIndex *index_,
+              Entry               *entry)
+{
+  ClutterActorBox box;
+  gboolean is_flat = TRUE;
+  Node *node;
+  float dx, dy;
+
+  entry->is_dirty = FALSE;
+
+  entry->has_box = index_->box_func (entry->data, &box, &is_flat,
+                                     index_->box_data);
+  entry->is_flat = is_flat;
+
+  if (!entry->has_box || !entry->is_flat)
+    {
+      if (entry->node != NULL_NODE)
+        {
+          entry_unlink (index_, entry);
+          g_hash_table_add (index_->outliers, entry);
+        }
+
+      if (entry->has_box)
+        entry->box = box;
+
+      return;
+    }
+
+  entry->box = box;
+
+  dx = (box.x2 - box.x1) * FAT_BOX_FACTOR;
+  dy = (box.y2 - box.y1) * FAT_BOX_FACTOR;
+
+  if (entry->node != NULL_NODE)
+    {
+      ClutterActorBox *fat_box = &NODE (index_, entry->node)->box;
+
+      /* if the box is still contained in the enlarged one, and it did
+       * not shrink too much, then we can leave the tree alone
+       */
+      if (box_contains (fat_box, &box) &&
+          (fat_box->x2 - fat_box->x1) <= (box.x2 - box.x1) + 4.f * dx + 1.f &&
+          (fat_box->y2 - fat_box->y1) <= (box.y2 - box.y1) + 4.f * dy + 1.f)
+        return;
+
+      tree_remove_leaf (index_, entry->node);
+    }
+  else
+    {
+      g_hash_table_remove (index_->outliers, entry);
+      entry->node = node_allocate (index_);
+      NODE (index_, entry->node)->entry = entry;
+    }
+
+  node = NODE (index_, entry->node);
+  node->box.x1 = box.x1 - dx;
+  node->box.y1 = box.y1 - dy;
+  node->box.x2 = box.x2 + dx;
+  node->box.y2 = box.y2 + dy;
+
+  tree_insert_leaf (index_, entry->node);
+}
+
+static void
+entry_free (gpointer data)
+{
+  g_slice_free (Entry, data);
+}
+
+static void
+_clutter_spatial_index_flush (ClutterSpatialIndex *index_)
+{
+  guint i;
+
+  if (index_->dirty->len == 0)
+    return;
+
+  CLUTTER_NOTE (CLIPPING, "Updating %u entries of the spatial index %p",
+                index_->dirty->len,
+                index_);
+
+  for (i = 0; i < index_->dirty->len; i++)
+    {
+      Entry *entry = g_ptr_array_index (index_->dirty, i);
+
+      if (entry->is_removed)
+        entry_free (entry);
+      else if (entry->is_dirty)
+        entry_update (index_, entry);
+    }
+
+  g_ptr_array_set_size (index_->dirty, 0);
+}
+
+ClutterSpatialIndex *
+_clutter_spatial_index_new (ClutterSpatialIndexBoxFunc box_func,
+                            gpointer                   user_data)
+{
+  ClutterSpatialIndex *index_;
+
+  g_return_val_if_fail (box_func != NULL, NULL);
+
+  index_ = g_slice_new (ClutterSpatialIndex);
+
+  index_->nodes = g_array_new (FALSE, FALSE, sizeof (Node));
+  index_->root = NULL_NODE;
+  index_->free_list = NULL_NODE;
+  index_->entries = g_hash_table_new (NULL, NULL);
+  index_->outliers = g_hash_table_new (NULL, NULL);
+  index_->dirty = g_ptr_array_new ();
+  index_->stack = g_array_new (FALSE, FALSE, sizeof (gint));
+  index_->box_func = box_func;
+  index_->box_data = user_data;
+
+  return index_;
+}
+
+void
+_clutter_spatial_index_free (ClutterSpatialIndex *index_)
+{
+  GHashTableIter iter;
+  gpointer value;
+  guint i;
+
+  g_return_if_fail (index_ != NULL);
+
+  /* removed entries are only referenced by the dirty array */
+  for (i = 0; i < index_->dirty->len; i++)
+    {
+      Entry *entry = g_ptr_array_index (index_->dirty, i);
+
+      if (entry->is_removed)
+        entry_free (entry);
+    }
+
+  g_hash_table_iter_init (&iter, index_->entries);
+  while (g_hash_table_iter_next (&iter, NULL, &value))
+    entry_free (value);
+
+  g_hash_table_unref (index_->entries);
+  g_hash_table_unref (index_->outliers);
+  g_ptr_array_unref (index_->dirty);
+  g_array_unref (index_->nodes);
+  g_array_unref (index_->stack);
+
+  g_slice_free (ClutterSpatialIndex, index_);
+}
+
+/*< private >
+ * _clutter_spatial_index_add:
+ * @index_: a #ClutterSpatialIndex
+ * @data: the item to add
+ * @order: the sort key of @data in the results of a query
+ *
+ * Adds @data to the index. The box of @data will be computed
+ * during the next query.
+ */
+void
+_clutter_spatial_index_add (ClutterSpatialIndex *index_,
+                            gpointer             data,
+                            guint                order)
+{
+  Entry *entry;
+
+  g_return_if_fail (index_ != NULL);
+  g_return_if_fail (!g_hash_table_contains (index_->entries, data));
+
+  entry = g_slice_new0 (Entry);
+  entry->data = data;
+  entry->node = NULL_NODE;
+  entry->order = order;
+  entry->is_dirty = TRUE;
+
+  g_hash_table_insert (index_->entries, data, entry);
+  g_hash_table_add (index_->outliers, entry);
+  g_ptr_array_add (index_->dirty, entry);
+}
+
+void
+_clutter_spatial_index_remove (ClutterSpatialIndex *index_,
+                               gpointer             data)
+{
+  Entry *entry;
+
+  g_return_if_fail (index_ != NULL);
+
+  entry = g_hash_table_lookup (index_->entries, data);
+  if (entry == NULL)
+    return;
+
+  g_hash_table_remove (index_->entries, data);
+  entry_unlink (index_, entry);
+
+  /* the entry is still referenced by the dirty array, and it
+   * will be freed when flushing it
+   */
+  if (entry->is_dirty)
+    entry->is_removed = TRUE;
+  else
+    entry_free (entry);
+}
+
+/*< private >
+ * _clutter_spatial_index_invalidate:
+ * @index_: a #ClutterSpatialIndex
+ * @data: an item in the index
+ *
+ * Marks the box of @data as changed. This function is cheap to call,
+ * as the box is only computed during the next query.
+ */
+void
+_clutter_spatial_index_invalidate (ClutterSpatialIndex *index_,
+                                   gpointer             data)
+{
+  Entry *entry;
+
+  entry = g_hash_table_lookup (index_->entries, data);
+  if (entry == NULL || entry->is_dirty)
+    return;
+
+  entry->is_dirty = TRUE;
+  g_ptr_array_add (index_->dirty, entry);
+}
+
+void
+_clutter_spatial_index_set_order (ClutterSpatialIndex *index_,
+                                  gpointer             data,
+                                  guint                order)
+{
+  Entry *entry;
+
+  entry = g_hash_table_lookup (index_->entries, data);
+  if (entry != NULL)
+    entry->order = order;
+}
+
+guint
+_clutter_spatial_index_get_size (ClutterSpatialIndex *index_)
+{
+  return g_hash_table_size (index_->entries);
+}
+
+static gint
+sort_by_order (gconstpointer a,
+               gconstpointer b)
+{
+  const Entry *entry_a = *((const Entry **) a);
+  const Entry *entry_b = *((const Entry **) b);
+
+  if (entry_a->order < entry_b->order)
+    return -1;
+
+  if (entry_a->order > entry_b->order)
+    return 1;
+
+  return 0;
+}
+
+static GPtrArray *
+finish_query (GPtrArray *entries)
+{
+  guint i;
+
+  g_ptr_array_sort (entries, sort_by_order);
+
+  for (i = 0; i < entries->len; i++)
+    {
+      Entry *entry = g_ptr_array_index (entries, i);
+
+      g_ptr_array_index (entries, i) = entry->data;
+    }
+
+  return entries;
+}
+
+/*< private >
+ * _clutter_spatial_index_query_box:
+ * @index_: a #ClutterSpatialIndex
+ * @box: a box
+ *
+ * Retrieves the items whose bounding box intersects @box. Items that
+ * do not lie on the z = 0 plane are tested using the 2D bounding box
+ * of their projection; items without a bounding box are ignored.
+ *
+ * Return value: (transfer full): an array of items, sorted using the
+ *   order passed to _clutter_spatial_index_add()
+ */
+GPtrArray *
+_clutter_spatial_index_query_box (ClutterSpatialIndex   *index_,
+                                  const ClutterActorBox *box)
+{
+  GHashTableIter iter;
+  GPtrArray *retval;
+  gpointer key;
+
+  g_return_val_if_fail (index_ != NULL, NULL);
+  g_return_val_if_fail (box != NULL, NULL);
+
+  _clutter_spatial_index_flush (index_);
+
+  retval = g_ptr_array_new ();
+
+  if (index_->root != NULL_NODE)
+    {
+      g_array_set_size (index_->stack, 0);
+      g_array_append_val (index_->stack, index_->root);
+
+      while (index_->stack->len > 0)
+        {
+          gint n = g_array_index (index_->stack, gint, index_->stack->len - 1);
+          Node *node = NODE (index_, n);
+
+          g_array_set_size (index_->stack, index_->stack->len - 1);
+
+          if (!box_intersects (&node->box, box))
+            continue;
+
+          if (IS_LEAF (node))
+            {
+              /* the leaf box is enlarged; check the real one */
+              if (box_intersects (&node->entry->box, box))
+                g_ptr_array_add (retval, node->entry);
+            }
+          else
+            {
+              g_array_append_val (index_->stack, node->child1);
+              g_array_append_val (index_->stack, node->child2);
+            }
+        }
+    }
+
+  g_hash_table_iter_init (&iter, index_->outliers);
+  while (g_hash_table_iter_next (&iter, &key, NULL))
+    {
+      Entry *entry = key;
+
+      if (entry->has_box && box_intersects (&entry->box, box))
+        g_ptr_array_add (retval, entry);
+    }
+
+  return finish_query (retval);
+}
+
+/*< private >
+ * _clutter_spatial_index_query_half_planes:
+ * @index_: a #ClutterSpatialIndex
+ * @half_planes: (array length=n_half_planes): an array of triplets
+ *   (a, b, c), each describing the half-plane a * x + b * y + c >= 0
+ * @n_half_planes: the number of half-planes
+ *
+ * Retrieves the items that could intersect the convex region defined
+ * by the intersection of @half_planes on the z = 0 plane. Items that
+ * do not lie on the z = 0 plane, or do not have a bounding box, are
+ * always returned.
+ *
+ * Return value: (transfer full): an array of items, sorted using the
+ *   order passed to _clutter_spatial_index_add()
+ */
+GPtrArray *
+_clutter_spatial_index_query_half_planes (ClutterSpatialIndex *index_,
+                                          const float         *half_planes,
+                                          guint                n_half_planes)
+{
+  GHashTableIter iter;
+  GPtrArray *retval;
+  gpointer key;
+
+  g_return_val_if_fail (index_ != NULL, NULL);
+  g_return_val_if_fail (half_planes != NULL || n_half_planes == 0, NULL);
+
+  _clutter_spatial_index_flush (index_);
+
+  retval = g_ptr_array_new ();
+
+  if (index_->root != NULL_NODE)
+    {
+      g_array_set_size (index_->stack, 0);
+      g_array_append_val (index_->stack, index_->root);
+
+      while (index_->stack->len > 0)
+        {
+          gint n = g_array_index (index_->stack, gint, index_->stack->len - 1);
+          Node *node = NODE (index_, n);
+
+          g_array_set_size (index_->stack, index_->stack->len - 1);
+
+          if (!box_inside_half_planes (&node->box, half_planes, n_half_planes))
+            continue;
+
+          if (IS_LEAF (node))
+            g_ptr_array_add (retval, node->entry);
+          else
+            {
+              g_array_append_val (index_->stack, node->child1);
+              g_array_append_val (index_->stack, node->child2);
+            }
+        }
+    }
+
+  g_hash_table_iter_init (&iter, index_->outliers);
+  while (g_hash_table_iter_next (&iter, &key, NULL))
+    g_ptr_array_add (retval, key);
+
+  return finish_query (retval);
+}
@@ -0,0 +1,73 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ClutterSpatialIndex: a bounding volume hierarchy of 2D boxes
+ */
+
+#ifndef __CLUTTER_SPATIAL_INDEX_H__
+#define __CLUTTER_SPATIAL_INDEX_H__
+
+#include <glib.h>
+#include "clutter-types.h"
+
+G_BEGIN_DECLS
+
+typedef struct _ClutterSpatialIndex     ClutterSpatialIndex;
+
+/*< private >
+ * ClutterSpatialIndexBoxFunc:
+ * @data: the item
+ * @box: (out): return location for the bounding box of @data
+ * @is_flat: (out): return location for whether the item lies on the
+ *   z = 0 plane of the coordinate space of the index
+ * @user_data: data passed to _clutter_spatial_index_new()
+ *
+ * Computes the bounding box of an item.
+ *
+ * Return value: %FALSE if the bounding box of @data cannot be determined
+ */
+typedef gboolean (* ClutterSpatialIndexBoxFunc) (gpointer         data,
+                                                 ClutterActorBox *box,
+                                                 gboolean        *is_flat,
+                                                 gpointer         user_data);
+
+ClutterSpatialIndex *   _clutter_spatial_index_new              (ClutterSpatialIndexBoxFunc  box_func,
+                                                                 gpointer                    user_data);
+void                    _clutter_spatial_index_free             (ClutterSpatialIndex        *index_);
+
+void                    _clutter_spatial_index_add              (ClutterSpatialIndex        *index_,
+                                                                 gpointer                    data,
+                                                                 guint                       order);
+void                    _clutter_spatial_index_remove           (ClutterSpatialIndex        *index_,
+                                                                 gpointer                    data);
+void                    _clutter_spatial_index_invalidate       (ClutterSpatialIndex        *index_,
+                                                                 gpointer                    data);
+void                    _clutter_spatial_index_set_order        (ClutterSpatialIndex        *index_,
+                                                                 gpointer                    data,
+                                                                 guint                       order);
+guint                   _clutter_spatial_index_get_size         (ClutterSpatialIndex        *index_);
+
+GPtrArray *             _clutter_spatial_index_query_box        (ClutterSpatialIndex        *index_,
+                                                                 const ClutterActorBox      *box);
+GPtrArray *             _clutter_spatial_index_query_half_planes (ClutterSpatialIndex       *index_,
+                                                                  const float               *half_planes,
+                                                                  guint                      n_half_planes);
+
+G_END_DECLS
+
+#endif /* __CLUTTER_SPATIAL_INDEX_H__ */
@@ -33,6 +33,11 @@ G_BEGIN_DECLS
 
 typedef struct _ClutterStageQueueRedrawEntry ClutterStageQueueRedrawEntry;
 
+typedef enum {
+  CLUTTER_STAGE_UPDATE_RELAYOUT = 1 << 0,
+  CLUTTER_STAGE_UPDATE_REDRAW   = 1 << 1
+} ClutterStageUpdateFlags;
+
 /* stage */
 ClutterStageWindow *_clutter_stage_get_default_window    (void);
 
@@ -70,6 +75,7 @@ void     _clutter_stage_update_input_devices              (ClutterStage *stage);
 void     _clutter_stage_schedule_update                   (ClutterStage *stage);
 gint64    _clutter_stage_get_update_time                  (ClutterStage *stage);
 void     _clutter_stage_clear_update_time                 (ClutterStage *stage);
+gint64   _clutter_stage_get_presentation_time             (ClutterStage *stage);
 gboolean _clutter_stage_has_full_redraw_queued            (ClutterStage *stage);
 
 ClutterActor *_clutter_stage_do_pick (ClutterStage    *stage,
@@ -123,6 +129,12 @@ gboolean                _clutter_stage_update_state     (ClutterStage      *stag
 void                    _clutter_stage_set_scale_factor (ClutterStage      *stage,
                                                          int                factor);
 
+gboolean                _clutter_stage_defer_actor_update (ClutterActor            *actor,
+                                                           ClutterStageUpdateFlags  flags);
+
+void                    _clutter_stage_queue_boundary_relayout (ClutterStage *stage,
+                                                                ClutterActor *actor);
+
 G_END_DECLS
 
 #endif /* __CLUTTER_STAGE_PRIVATE_H__ */
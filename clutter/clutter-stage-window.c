@@ -360,3 +360,26 @@ _clutter_stage_window_get_scale_factor (ClutterStageWindow *window)
 
   return 1;
 }
+
+/*< private >
+ * _clutter_stage_window_get_presentation_time:
+ * @window: a #ClutterStageWindow
+ *
+ * Predicts the time at which the next frame drawn on @window will be
+ * presented, in the time base of g_get_monotonic_time().
+ *
+ * Return value: the predicted presentation time, or -1 if unknown
+ */
+gint64
+_clutter_stage_window_get_presentation_time (ClutterStageWindow *window)
+{
+  ClutterStageWindowIface *iface;
+
+  g_return_val_if_fail (CLUTTER_IS_STAGE_WINDOW (window), -1);
+
+  iface = CLUTTER_STAGE_WINDOW_GET_IFACE (window);
+  if (iface->get_presentation_time != NULL)
+    return iface->get_presentation_time (window);
+
+  return -1;
+}
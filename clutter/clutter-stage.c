@@ -97,6 +97,47 @@ typedef enum { /*< prefix=CLUTTER_STAGE >*/
 
 #define STAGE_NO_CLEAR_ON_PAINT(s)      ((((ClutterStage *) (s))->priv->stage_hints & CLUTTER_STAGE_NO_CLEAR_ON_PAINT) != 0)
 
+/* the entries are allocated in chunks, which are recycled from one
+ * frame to the next; the actor is not referenced, since it will clear
+ * the entry when removed from the stage or disposed
+ */
+#define N_REDRAW_ENTRIES_PER_CHUNK      128
+
+/* the motion history kept for each device and touch sequence that has
+ * event resampling enabled; see clutter_input_device_set_event_resampling()
+ */
+#define EVENT_HISTORY_SIZE              4
+
+/* samples farther apart than this are not used to extrapolate, as the
+ * velocity they give is not meaningful anymore; samples closer than
+ * this are too noisy
+ */
+#define RESAMPLE_MAX_DELTA_USEC         20000
+#define RESAMPLE_MIN_DELTA_USEC         2000
+
+/* the maximum amount of time we are allowed to predict the position
+ * past the newest sample
+ */
+#define RESAMPLE_MAX_PREDICTION_USEC    8000
+
+typedef struct _EventSample
+{
+  gint64 time_us;
+  gfloat x;
+  gfloat y;
+} EventSample;
+
+typedef struct _EventHistory
+{
+  ClutterInputDevice *device;
+  ClutterEventSequence *sequence;
+
+  /* ring buffer; @last is the index of the newest sample */
+  EventSample samples[EVENT_HISTORY_SIZE];
+  guint n_samples;
+  guint last;
+} EventHistory;
+
 struct _ClutterStageQueueRedrawEntry
 {
   ClutterActor *actor;
@@ -122,13 +163,17 @@ struct _ClutterStagePrivate
 
   GQueue *event_queue;
 
+  /* array of EventHistory */
+  GArray *event_histories;
+
   ClutterStageHint stage_hints;
 
   GArray *paint_volume_stack;
 
   ClutterPlane current_clip_planes[4];
 
-  GList *pending_queue_redraws;
+  GPtrArray *redraw_entry_chunks;
+  guint n_redraw_entries;
 
   CoglFramebuffer *active_framebuffer;
 
@@ -148,6 +193,15 @@ struct _ClutterStagePrivate
   gpointer paint_data;
   GDestroyNotify paint_notify;
 
+  /* see clutter_stage_begin_update() */
+  gint update_depth;
+  GHashTable *deferred_updates;
+
+  /* actors isolating the layout of their children, with a relayout
+   * queued inside them; see clutter_actor_set_isolate_layout()
+   */
+  GPtrArray *pending_boundaries;
+
   guint relayout_pending       : 1;
   guint redraw_pending         : 1;
   guint is_fullscreen          : 1;
@@ -200,7 +254,8 @@ static guint stage_signals[LAST_SIGNAL] = { 0, };
 static const ClutterColor default_stage_color = { 255, 255, 255, 255 };
 
 static void clutter_stage_maybe_finish_queue_redraws (ClutterStage *stage);
-static void free_queue_redraw_entry (ClutterStageQueueRedrawEntry *entry);
+static void clutter_stage_clear_redraw_entries (ClutterStage *stage);
+static void clutter_stage_drop_deferred_updates (ClutterStage *stage);
 
 static void clutter_container_iface_init (ClutterContainerIface *iface);
 
@@ -696,28 +751,18 @@ _clutter_stage_do_paint (ClutterStage                *stage,
 static void
 clutter_stage_paint (ClutterActor *self)
 {
-  ClutterActorIter iter;
-  ClutterActor *child;
-
-  clutter_actor_iter_init (&iter, self);
-  while (clutter_actor_iter_next (&iter, &child))
-    clutter_actor_paint (child);
+  _clutter_actor_paint_children (self);
 }
 
 static void
 clutter_stage_pick (ClutterActor       *self,
 		    const ClutterColor *color)
 {
-  ClutterActorIter iter;
-  ClutterActor *child;
-
   /* Note: we don't chain up to our parent as we don't want any geometry
    * emitted for the stage itself. The stage's pick id is effectively handled
    * by the call to cogl_clear done in clutter-main.c:_clutter_do_pick_async()
    */
-  clutter_actor_iter_init (&iter, self);
-  while (clutter_actor_iter_next (&iter, &child))
-    clutter_actor_paint (child);
+  _clutter_actor_paint_children (self);
 }
 
 static gboolean
@@ -957,11 +1002,231 @@ _clutter_stage_has_queued_events (ClutterStage *stage)
   return priv->event_queue->length > 0;
 }
 
+static EventHistory *
+clutter_stage_get_event_history (ClutterStage         *stage,
+                                 ClutterInputDevice   *device,
+                                 ClutterEventSequence *sequence,
+                                 gboolean              create)
+{
+  GArray *histories = stage->priv->event_histories;
+  EventHistory *history;
+  guint i;
+
+  for (i = 0; i < histories->len; i++)
+    {
+      history = &g_array_index (histories, EventHistory, i);
+
+      if (history->device == device && history->sequence == sequence)
+        return history;
+    }
+
+  if (!create)
+    return NULL;
+
+  g_array_set_size (histories, histories->len + 1);
+
+  history = &g_array_index (histories, EventHistory, histories->len - 1);
+  history->device = device;
+  history->sequence = sequence;
+  history->n_samples = 0;
+  history->last = 0;
+
+  return history;
+}
+
+static void
+clutter_stage_remove_event_history (ClutterStage         *stage,
+                                    ClutterInputDevice   *device,
+                                    ClutterEventSequence *sequence)
+{
+  GArray *histories = stage->priv->event_histories;
+  guint i;
+
+  for (i = 0; i < histories->len; i++)
+    {
+      EventHistory *history = &g_array_index (histories, EventHistory, i);
+
+      if (history->device == device && history->sequence == sequence)
+        {
+          g_array_remove_index_fast (histories, i);
+          return;
+        }
+    }
+}
+
+static void
+event_history_add_sample (EventHistory       *history,
+                          const ClutterEvent *event)
+{
+  EventSample *sample;
+  gint64 time_us;
+
+  time_us = _clutter_event_get_time_usec (event);
+
+  /* the samples must be ordered in time; discard anything that goes
+   * backwards, and replace samples with the same timestamp
+   */
+  if (history->n_samples > 0)
+    {
+      sample = &history->samples[history->last];
+
+      if (time_us < sample->time_us)
+        return;
+
+      if (time_us > sample->time_us)
+        {
+          history->last = (history->last + 1) % EVENT_HISTORY_SIZE;
+          history->n_samples = MIN (history->n_samples + 1, EVENT_HISTORY_SIZE);
+        }
+    }
+  else
+    history->n_samples = 1;
+
+  sample = &history->samples[history->last];
+  sample->time_us = time_us;
+  clutter_event_get_coords (event, &sample->x, &sample->y);
+}
+
+/* computes the position at @target_time, either by interpolating
+ * between the two samples around it, or by extrapolating from the
+ * two newest samples
+ */
+static gboolean
+event_history_resample (const EventHistory *history,
+                        gint64              target_time,
+                        gfloat             *x,
+                        gfloat             *y)
+{
+  const EventSample *a, *b;
+  gint64 delta;
+  gfloat alpha;
+  guint i;
+
+  if (history->n_samples < 2)
+    return FALSE;
+
+  b = &history->samples[history->last];
+
+  /* the two times are in different time bases */
+  if (ABS (target_time - b->time_us) > G_USEC_PER_SEC)
+    return FALSE;
+
+  if (target_time <= b->time_us)
+    {
+      /* find the newest sample before the target time */
+      for (i = 1; i < history->n_samples; i++)
+        {
+          guint index_ = (history->last + EVENT_HISTORY_SIZE - i) % EVENT_HISTORY_SIZE;
+
+          a = &history->samples[index_];
+          if (a->time_us <= target_time)
+            break;
+
+          b = a;
+        }
+
+      if (i == history->n_samples)
+        return FALSE;
+    }
+  else
+    {
+      a = &history->samples[(history->last + EVENT_HISTORY_SIZE - 1) % EVENT_HISTORY_SIZE];
+
+      delta = b->time_us - a->time_us;
+      if (delta < RESAMPLE_MIN_DELTA_USEC || delta > RESAMPLE_MAX_DELTA_USEC)
+        return FALSE;
+
+      /* do not predict too far in the future, as the error grows
+       * with the distance from the newest sample
+       */
+      target_time = MIN (target_time,
+                         b->time_us + MIN (delta / 2, RESAMPLE_MAX_PREDICTION_USEC));
+    }
+
+  delta = b->time_us - a->time_us;
+  if (delta == 0)
+    return FALSE;
+
+  alpha = (gfloat) (target_time - a->time_us) / (gfloat) delta;
+
+  *x = a->x + (b->x - a->x) * alpha;
+  *y = a->y + (b->y - a->y) * alpha;
+
+  return TRUE;
+}
+
+/* keeps the motion history of the devices with event resampling
+ * enabled up to date; returns the history that applies to @event,
+ * if any
+ */
+static EventHistory *
+clutter_stage_track_event (ClutterStage       *stage,
+                           const ClutterEvent *event)
+{
+  ClutterInputDevice *device;
+  ClutterEventSequence *sequence;
+  EventHistory *history;
+
+  device = clutter_event_get_source_device (event);
+  if (device == NULL || !device->event_resampling)
+    return NULL;
+
+  sequence = clutter_event_get_event_sequence (event);
+
+  switch (event->type)
+    {
+    case CLUTTER_BUTTON_PRESS:
+    case CLUTTER_TOUCH_BEGIN:
+      /* start a new stroke */
+      history = clutter_stage_get_event_history (stage, device, sequence, TRUE);
+      history->n_samples = 0;
+      event_history_add_sample (history, event);
+      return NULL;
+
+    case CLUTTER_MOTION:
+    case CLUTTER_TOUCH_UPDATE:
+      history = clutter_stage_get_event_history (stage, device, sequence, TRUE);
+      event_history_add_sample (history, event);
+      return history;
+
+    case CLUTTER_BUTTON_RELEASE:
+    case CLUTTER_TOUCH_END:
+    case CLUTTER_TOUCH_CANCEL:
+    case CLUTTER_LEAVE:
+      clutter_stage_remove_event_history (stage, device, sequence);
+      return NULL;
+
+    default:
+      return NULL;
+    }
+}
+
+static void
+clutter_stage_resample_event (ClutterStage       *stage,
+                              ClutterEvent       *event,
+                              const EventHistory *history,
+                              gint64              target_time)
+{
+  gfloat x, y;
+
+  if (!event_history_resample (history, target_time, &x, &y))
+    return;
+
+  CLUTTER_NOTE (EVENT,
+                "Resampling event at %.2f, %.2f to %.2f, %.2f",
+                history->samples[history->last].x,
+                history->samples[history->last].y,
+                x, y);
+
+  clutter_event_set_coords (event, x, y);
+}
+
 void
 _clutter_stage_process_queued_events (ClutterStage *stage)
 {
   ClutterStagePrivate *priv;
   GList *events, *l;
+  gint64 target_time = -1;
 
   g_return_if_fail (CLUTTER_IS_STAGE (stage));
 
@@ -986,11 +1251,18 @@ _clutter_stage_process_queued_events (ClutterStage *stage)
       ClutterEvent *next_event;
       ClutterInputDevice *device;
       ClutterInputDevice *next_device;
+      EventHistory *history = NULL;
       gboolean check_device = FALSE;
 
       event = l->data;
       next_event = l->next ? l->next->data : NULL;
 
+      /* the events we compress are still used to resample the ones
+       * we end up delivering
+       */
+      if (priv->throttle_motion_events)
+        history = clutter_stage_track_event (stage, event);
+
       device = clutter_event_get_device (event);
 
       if (next_event != NULL)
@@ -1028,6 +1300,23 @@ _clutter_stage_process_queued_events (ClutterStage *stage)
             }
         }
 
+      /* move the last motion of the frame to where the pointer is
+       * expected to be when the frame is presented, so that the
+       * movement on screen is not affected by the beat between the
+       * input and the display rates
+       */
+      if (history != NULL)
+        {
+          if (target_time < 0)
+            {
+              target_time = _clutter_stage_get_presentation_time (stage);
+              if (target_time < 0)
+                target_time = g_get_monotonic_time ();
+            }
+
+          clutter_stage_resample_event (stage, event, history, target_time);
+        }
+
       _clutter_process_event (event);
 
     next_event:
@@ -1096,6 +1385,25 @@ _clutter_stage_maybe_relayout (ClutterActor *actor)
       clutter_actor_allocate (CLUTTER_ACTOR (stage),
                               &box, CLUTTER_ALLOCATION_NONE);
 
+      /* the boundaries that have been allocated by their parent
+       * in the pass above are skipped
+       */
+      if (priv->pending_boundaries != NULL)
+        {
+          GPtrArray *boundaries = priv->pending_boundaries;
+          guint i;
+
+          priv->pending_boundaries = NULL;
+
+          CLUTTER_NOTE (ACTOR, "Allocating %u relayout boundaries",
+                        boundaries->len);
+
+          for (i = 0; i < boundaries->len; i++)
+            _clutter_actor_allocate_boundary (g_ptr_array_index (boundaries, i));
+
+          g_ptr_array_unref (boundaries);
+        }
+
       CLUTTER_UNSET_PRIVATE_FLAGS (stage, CLUTTER_IN_RELAYOUT);
     }
 }
@@ -1437,11 +1745,21 @@ _clutter_stage_do_pick (ClutterStage   *stage,
   dither_enabled_save = cogl_framebuffer_get_dither_enabled (fb);
   cogl_framebuffer_set_dither_enabled (fb, FALSE);
 
-  /* Render the entire scence in pick mode - just single colored silhouette's
-   * are drawn offscreen (as we never swap buffers)
+  /* Render the scene in pick mode - just single colored silhouette's
+   * are drawn offscreen (as we never swap buffers). The stage clip is
+   * restricted to the pick point, so that actors can cull the branches
+   * of the scene graph that do not contain it, unless we are dumping
+   * the whole pick buffer
   */
   context->pick_mode = mode;
-  _clutter_stage_do_paint (stage, NULL);
+  if (G_LIKELY (!(clutter_pick_debug_flags & CLUTTER_DEBUG_DUMP_PICK_BUFFERS)))
+    {
+      cairo_rectangle_int_t pick_clip = { x, y, 1, 1 };
+
+      _clutter_stage_do_paint (stage, &pick_clip);
+    }
+  else
+    _clutter_stage_do_paint (stage, NULL);
   context->pick_mode = CLUTTER_PICK_NONE;
 
   /* Read the color of the screen co-ords pixel. RGBA_8888_PRE is used
@@ -1717,9 +2035,14 @@ clutter_stage_dispose (GObject *object)
 
   clutter_actor_destroy_all_children (CLUTTER_ACTOR (object));
 
-  g_list_free_full (priv->pending_queue_redraws,
-                    (GDestroyNotify) free_queue_redraw_entry);
-  priv->pending_queue_redraws = NULL;
+  clutter_stage_clear_redraw_entries (stage);
+
+  g_clear_pointer (&priv->pending_boundaries, g_ptr_array_unref);
+
+  /* the children are gone, so there is nothing left to lay out or
+   * to redraw; we just release the actors of any update left open
+   */
+  clutter_stage_drop_deferred_updates (stage);
 
   /* this will release the reference on the stage */
   stage_manager = clutter_stage_manager_get_default ();
@@ -1737,10 +2060,14 @@ clutter_stage_finalize (GObject *object)
   g_queue_foreach (priv->event_queue, (GFunc) clutter_event_free, NULL);
   g_queue_free (priv->event_queue);
 
+  g_array_free (priv->event_histories, TRUE);
+
   g_free (priv->title);
 
   g_array_free (priv->paint_volume_stack, TRUE);
 
+  g_ptr_array_unref (priv->redraw_entry_chunks);
+
   _clutter_id_pool_free (priv->pick_id_pool);
 
   if (priv->fps_timer != NULL)
@@ -2160,6 +2487,7 @@ clutter_stage_init (ClutterStage *self)
     }
 
   priv->event_queue = g_queue_new ();
+  priv->event_histories = g_array_new (FALSE, FALSE, sizeof (EventHistory));
 
   priv->is_fullscreen = FALSE;
   priv->is_user_resizable = FALSE;
@@ -2226,6 +2554,8 @@ clutter_stage_init (ClutterStage *self)
   priv->paint_volume_stack =
     g_array_new (FALSE, FALSE, sizeof (ClutterPaintVolume));
 
+  priv->redraw_entry_chunks = g_ptr_array_new_with_free_func (g_free);
+
   priv->pick_id_pool = _clutter_id_pool_new (256);
 }
 
@@ -3815,6 +4145,22 @@ _clutter_stage_get_update_time (ClutterStage *stage)
   return _clutter_stage_window_get_update_time (stage_window);
 }
 
+/* Returns the predicted presentation time of the next frame, or -1 */
+gint64
+_clutter_stage_get_presentation_time (ClutterStage *stage)
+{
+  ClutterStageWindow *stage_window;
+
+  if (CLUTTER_ACTOR_IN_DESTRUCTION (stage))
+    return -1;
+
+  stage_window = _clutter_stage_get_window (stage);
+  if (stage_window == NULL)
+    return -1;
+
+  return _clutter_stage_window_get_presentation_time (stage_window);
+}
+
 void
 _clutter_stage_clear_update_time (ClutterStage *stage)
 {
@@ -3938,7 +4284,58 @@ _clutter_stage_get_clip (ClutterStage *stage)
  * allocations improving the chance that we can determine the actors
  * paint volume so we can clip the redraw request even if the user
  * didn't explicitly do so.
+ *
+ * The entries are stored in a vector of chunks owned by the stage, and
+ * indexed in the order in which they have been queued; the vector is
+ * emptied, but not freed, once all the entries have been processed.
  */
+static inline ClutterStageQueueRedrawEntry *
+clutter_stage_get_redraw_entry (ClutterStage *stage,
+                                guint         index_)
+{
+  ClutterStageQueueRedrawEntry *chunk;
+
+  chunk = g_ptr_array_index (stage->priv->redraw_entry_chunks,
+                             index_ / N_REDRAW_ENTRIES_PER_CHUNK);
+
+  return &chunk[index_ % N_REDRAW_ENTRIES_PER_CHUNK];
+}
+
+static ClutterStageQueueRedrawEntry *
+clutter_stage_allocate_redraw_entry (ClutterStage *stage)
+{
+  ClutterStagePrivate *priv = stage->priv;
+  guint index_ = priv->n_redraw_entries;
+
+  if (index_ / N_REDRAW_ENTRIES_PER_CHUNK == priv->redraw_entry_chunks->len)
+    {
+      g_ptr_array_add (priv->redraw_entry_chunks,
+                       g_new (ClutterStageQueueRedrawEntry,
+                              N_REDRAW_ENTRIES_PER_CHUNK));
+    }
+
+  priv->n_redraw_entries += 1;
+
+  return clutter_stage_get_redraw_entry (stage, index_);
+}
+
+static void
+clutter_stage_clear_redraw_entries (ClutterStage *stage)
+{
+  ClutterStagePrivate *priv = stage->priv;
+  guint i;
+
+  for (i = 0; i < priv->n_redraw_entries; i++)
+    {
+      ClutterStageQueueRedrawEntry *entry;
+
+      entry = clutter_stage_get_redraw_entry (stage, i);
+      _clutter_stage_queue_redraw_entry_invalidate (entry);
+    }
+
+  priv->n_redraw_entries = 0;
+}
+
 ClutterStageQueueRedrawEntry *
 _clutter_stage_queue_actor_redraw (ClutterStage *stage,
                                    ClutterStageQueueRedrawEntry *entry,
@@ -3998,8 +4395,8 @@ _clutter_stage_queue_actor_redraw (ClutterStage *stage,
     }
   else
     {
-      entry = g_slice_new (ClutterStageQueueRedrawEntry);
-      entry->actor = g_object_ref (actor);
+      entry = clutter_stage_allocate_redraw_entry (stage);
+      entry->actor = actor;
 
       if (clip)
         {
@@ -4010,34 +4407,17 @@ _clutter_stage_queue_actor_redraw (ClutterStage *stage,
       else
         entry->has_clip = FALSE;
 
-      stage->priv->pending_queue_redraws =
-        g_list_prepend (stage->priv->pending_queue_redraws, entry);
-
       return entry;
     }
 }
 
-static void
-free_queue_redraw_entry (ClutterStageQueueRedrawEntry *entry)
-{
-  if (entry->actor)
-    g_object_unref (entry->actor);
-  if (entry->has_clip)
-    clutter_paint_volume_free (&entry->clip);
-  g_slice_free (ClutterStageQueueRedrawEntry, entry);
-}
-
 void
 _clutter_stage_queue_redraw_entry_invalidate (ClutterStageQueueRedrawEntry *entry)
 {
   if (entry == NULL)
     return;
 
-  if (entry->actor != NULL)
-    {
-      g_object_unref (entry->actor);
-      entry->actor = NULL;
-    }
+  entry->actor = NULL;
 
   if (entry->has_clip)
     {
@@ -4049,39 +4429,37 @@ _clutter_stage_queue_redraw_entry_invalidate (ClutterStageQueueRedrawEntry *entr
 static void
 clutter_stage_maybe_finish_queue_redraws (ClutterStage *stage)
 {
-  /* Note: we have to repeat until the pending_queue_redraws list is
-   * empty because actors are allowed to queue redraws in response to
-   * the queue-redraw signal. For example Clone actors or
+  ClutterStagePrivate *priv = stage->priv;
+  guint i;
+
+  /* Note: we have to check the number of entries at each iteration
+   * because actors are allowed to queue redraws in response to the
+   * queue-redraw signal. For example Clone actors or
    * texture_new_from_actor actors will have to queue a redraw if
-   * their source queues a redraw.
+   * their source queues a redraw. The new entries are appended, and
+   * the existing ones never move, so we can keep going until we
+   * reach the end.
    */
-  while (stage->priv->pending_queue_redraws)
+  for (i = 0; i < priv->n_redraw_entries; i++)
     {
-      GList *l;
-      /* XXX: we need to allow stage->priv->pending_queue_redraws to
-       * be updated while we process the current entries in the list
-       * so we steal the list pointer and then reset it to an empty
-       * list before processing... */
-      GList *stolen_list = stage->priv->pending_queue_redraws;
-      stage->priv->pending_queue_redraws = NULL;
-
-      for (l = stolen_list; l; l = l->next)
+      ClutterStageQueueRedrawEntry *entry;
+
+      entry = clutter_stage_get_redraw_entry (stage, i);
+
+      /* NB: Entries may be invalidated if the actor gets destroyed */
+      if (G_LIKELY (entry->actor != NULL))
         {
-          ClutterStageQueueRedrawEntry *entry = l->data;
           ClutterPaintVolume *clip;
 
-          /* NB: Entries may be invalidated if the actor gets destroyed */
-          if (G_LIKELY (entry->actor != NULL))
-	    {
-	      clip = entry->has_clip ? &entry->clip : NULL;
-
-	      _clutter_actor_finish_queue_redraw (entry->actor, clip);
-	    }
+          clip = entry->has_clip ? &entry->clip : NULL;
 
-          free_queue_redraw_entry (entry);
+          _clutter_actor_finish_queue_redraw (entry->actor, clip);
         }
-      g_list_free (stolen_list);
+
+      _clutter_stage_queue_redraw_entry_invalidate (entry);
     }
+
+  priv->n_redraw_entries = 0;
 }
 
 /**
@@ -4507,3 +4885,242 @@ _clutter_stage_set_scale_factor (ClutterStage *stage,
 
   clutter_actor_queue_redraw (CLUTTER_ACTOR (stage));
 }
+
+/* the number of stages with an update in progress; this allows actors
+ * to skip looking up their stage in the common case
+ */
+static guint n_stages_in_update = 0;
+
+/**
+ * clutter_stage_begin_update:
+ * @stage: a #ClutterStage
+ *
+ * Starts a batch of changes to the actors inside @stage.
+ *
+ * Until the matching call to clutter_stage_end_update(), requests to
+ * queue a relayout or a redraw of the actors inside @stage are deferred,
+ * and the property notifications of those actors are frozen. Multiple
+ * requests on the same actor, and multiple notifications of the same
+ * property, are coalesced and only emitted once the update ends.
+ *
+ * This is useful when changing the geometry or the state of a large
+ * number of actors at once, for instance:
+ *
+ * |[<!-- language="C" -->
+ *   clutter_stage_begin_update (stage);
+ *
+ *   for (i = 0; i < n_items; i++)
+ *     {
+ *       clutter_actor_set_position (items[i], x[i], y[i]);
+ *       clutter_actor_set_opacity (items[i], opacity[i]);
+ *     }
+ *
+ *   clutter_stage_end_update (stage);
+ * ]|
+ *
+ * While an update is in progress the layout information of the actors,
+ * like their preferred size, may not reflect the changes made since
+ * the beginning of the update.
+ *
+ * Calls to this function can be nested; the deferred changes are
+ * applied when the outermost update ends.
+ *
+ * Since: 1.28
+ */
+void
+clutter_stage_begin_update (ClutterStage *stage)
+{
+  ClutterStagePrivate *priv;
+
+  g_return_if_fail (CLUTTER_IS_STAGE (stage));
+
+  priv = stage->priv;
+
+  if (priv->update_depth == 0)
+    {
+      if (priv->deferred_updates == NULL)
+        priv->deferred_updates = g_hash_table_new_full (NULL, NULL,
+                                                        g_object_unref,
+                                                        NULL);
+
+      n_stages_in_update += 1;
+    }
+
+  priv->update_depth += 1;
+}
+
+/**
+ * clutter_stage_end_update:
+ * @stage: a #ClutterStage
+ *
+ * Ends a batch of changes started by clutter_stage_begin_update().
+ *
+ * If this is the outermost update, all the deferred relayouts and
+ * redraws are queued, and the pending property notifications of
+ * the actors inside @stage are emitted.
+ *
+ * Since: 1.28
+ */
+void
+clutter_stage_end_update (ClutterStage *stage)
+{
+  ClutterStagePrivate *priv;
+  GHashTableIter iter;
+  GHashTable *updates;
+  gpointer key, value;
+
+  g_return_if_fail (CLUTTER_IS_STAGE (stage));
+
+  priv = stage->priv;
+
+  if (priv->update_depth == 0)
+    {
+      g_warning ("Unbalanced call to clutter_stage_end_update() on "
+                 "the stage %p",
+                 stage);
+      return;
+    }
+
+  priv->update_depth -= 1;
+  if (priv->update_depth > 0)
+    return;
+
+  n_stages_in_update -= 1;
+
+  /* any change made while flushing is applied immediately */
+  updates = priv->deferred_updates;
+  priv->deferred_updates = NULL;
+
+  CLUTTER_NOTE (ACTOR, "Flushing the deferred updates of %u actors",
+                g_hash_table_size (updates));
+
+  /* layout and redraws first, so that the notification handlers
+   * see a consistent state of the scene graph
+   */
+  g_hash_table_iter_init (&iter, updates);
+  while (g_hash_table_iter_next (&iter, &key, &value))
+    {
+      ClutterActor *actor = key;
+      guint flags = GPOINTER_TO_UINT (value);
+
+      if (flags & CLUTTER_STAGE_UPDATE_RELAYOUT)
+        clutter_actor_queue_relayout (actor);
+      else if (flags & CLUTTER_STAGE_UPDATE_REDRAW)
+        clutter_actor_queue_redraw (actor);
+    }
+
+  g_hash_table_iter_init (&iter, updates);
+  while (g_hash_table_iter_next (&iter, &key, NULL))
+    g_object_thaw_notify (key);
+
+  g_hash_table_unref (updates);
+}
+
+static void
+clutter_stage_drop_deferred_updates (ClutterStage *stage)
+{
+  ClutterStagePrivate *priv = stage->priv;
+  GHashTableIter iter;
+  GHashTable *updates;
+  gpointer key;
+
+  if (priv->update_depth == 0)
+    return;
+
+  priv->update_depth = 0;
+  n_stages_in_update -= 1;
+
+  updates = priv->deferred_updates;
+  priv->deferred_updates = NULL;
+
+  CLUTTER_NOTE (ACTOR, "Dropping the deferred updates of %u actors",
+                g_hash_table_size (updates));
+
+  /* the actors may outlive the stage, so they cannot be left frozen */
+  g_hash_table_iter_init (&iter, updates);
+  while (g_hash_table_iter_next (&iter, &key, NULL))
+    g_object_thaw_notify (key);
+
+  g_hash_table_unref (updates);
+}
+
+/*< private >
+ * _clutter_stage_queue_boundary_relayout:
+ * @stage: a #ClutterStage
+ * @actor: a #ClutterActor isolating the layout of its children
+ *
+ * Queues a relayout of the children of @actor, without going through
+ * the allocation of the whole scene graph.
+ *
+ * The stage holds a reference on @actor until the next relayout.
+ */
+void
+_clutter_stage_queue_boundary_relayout (ClutterStage *stage,
+                                        ClutterActor *actor)
+{
+  ClutterStagePrivate *priv = stage->priv;
+
+  if (priv->pending_boundaries == NULL)
+    priv->pending_boundaries = g_ptr_array_new_with_free_func (g_object_unref);
+
+  g_ptr_array_add (priv->pending_boundaries, g_object_ref (actor));
+
+  if (!priv->relayout_pending)
+    {
+      _clutter_stage_schedule_update (stage);
+      priv->relayout_pending = TRUE;
+    }
+}
+
+/*< private >
+ * _clutter_stage_defer_actor_update:
+ * @actor: a #ClutterActor
+ * @flags: the update to defer
+ *
+ * Records an update of @actor, if the stage of @actor has an update
+ * in progress; see clutter_stage_begin_update().
+ *
+ * The property notifications of @actor are frozen until the end of
+ * the update, so that the notifications emitted after queueing the
+ * update are coalesced.
+ *
+ * Return value: %TRUE if the update was deferred
+ */
+gboolean
+_clutter_stage_defer_actor_update (ClutterActor            *actor,
+                                   ClutterStageUpdateFlags  flags)
+{
+  ClutterStagePrivate *priv;
+  ClutterActor *stage;
+  gpointer value;
+  guint old_flags;
+
+  if (G_LIKELY (n_stages_in_update == 0))
+    return FALSE;
+
+  if (CLUTTER_ACTOR_IN_DESTRUCTION (actor))
+    return FALSE;
+
+  stage = _clutter_actor_get_stage_internal (actor);
+  if (stage == NULL)
+    return FALSE;
+
+  priv = CLUTTER_STAGE (stage)->priv;
+  if (priv->update_depth == 0)
+    return FALSE;
+
+  if (g_hash_table_lookup_extended (priv->deferred_updates, actor, NULL, &value))
+    old_flags = GPOINTER_TO_UINT (value);
+  else
+    {
+      g_object_ref (actor);
+      g_object_freeze_notify (G_OBJECT (actor));
+      old_flags = 0;
+    }
+
+  g_hash_table_replace (priv->deferred_updates,
+                        actor,
+                        GUINT_TO_POINTER (old_flags | flags));
+
+  return TRUE;
+}
@@ -17,6 +17,7 @@ typedef struct {
   ClutterActor *stage;
 
   guint no_display : 1;
+  guint no_rendering : 1;
 } ClutterTestEnvironment;
 
 static ClutterTestEnvironment *test_environ = NULL;
@@ -35,6 +36,7 @@ clutter_test_init (int    *argc,
                    char ***argv)
 {
   gboolean no_display = FALSE;
+  gboolean no_rendering = FALSE;
 
   if (G_UNLIKELY (test_environ != NULL))
     g_error ("Attempting to initialize the test suite more than once, "
@@ -70,6 +72,14 @@ clutter_test_init (int    *argc,
   /* perform the actual initialization */
   g_assert (clutter_init (NULL, NULL) == CLUTTER_INIT_SUCCESS);
 
+#ifdef CLUTTER_WINDOWING_HEADLESS
+  /* the headless backend uses the no-op driver of Cogl, so nothing is
+   * ever rendered, and picking does not work either
+   */
+  if (clutter_check_windowing_backend (CLUTTER_WINDOWING_HEADLESS))
+    no_rendering = TRUE;
+#endif
+
 out:
   g_test_init (argc, argv, NULL);
   g_test_bug_base ("https://bugzilla.gnome.org/show_bug.cgi?id=%s");
@@ -77,6 +87,7 @@ out:
   /* our global state, accessible from each test unit */
   test_environ = g_new0 (ClutterTestEnvironment, 1);
   test_environ->no_display = no_display;
+  test_environ->no_rendering = no_rendering;
 }
 
 /**
@@ -105,6 +116,33 @@ clutter_test_get_stage (void)
   return test_environ->stage;
 }
 
+/**
+ * clutter_test_skip_without_rendering:
+ *
+ * Skips the current test unit if the windowing system backend does
+ * not render the contents of the stage, like the headless backend.
+ *
+ * Test units that read back the contents of the stage, or that rely
+ * on picking, should return immediately if this function returns
+ * %TRUE.
+ *
+ * Return value: %TRUE if the test unit was skipped
+ *
+ * Since: 1.28
+ */
+gboolean
+clutter_test_skip_without_rendering (void)
+{
+  g_assert (test_environ != NULL);
+
+  if (!test_environ->no_rendering)
+    return FALSE;
+
+  g_test_skip ("The backend does not render the stage");
+
+  return TRUE;
+}
+
 typedef struct {
   gpointer test_func;
   gpointer test_data;
@@ -110,6 +110,9 @@ void            clutter_test_add_data_full      (const char     *test_path,
 CLUTTER_AVAILABLE_IN_1_18
 ClutterActor *  clutter_test_get_stage          (void);
 
+CLUTTER_AVAILABLE_IN_1_28
+gboolean        clutter_test_skip_without_rendering     (void);
+
 #define clutter_test_assert_actor_at_point(stage,point,actor) \
 G_STMT_START { \
   const ClutterPoint *__p = (point); \
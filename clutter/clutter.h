@@ -51,6 +51,7 @@
 #include "clutter-color.h"
 #include "clutter-color-static.h"
 #include "clutter-colorize-effect.h"
+#include "clutter-column-store.h"
 #include "clutter-constraint.h"
 #include "clutter-container.h"
 #include "clutter-content.h"
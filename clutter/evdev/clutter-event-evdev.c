@@ -96,6 +96,8 @@ _clutter_evdev_event_set_time_usec       (ClutterEvent *event,
 
   event_evdev = clutter_evdev_event_ensure_platform_data (event);
   event_evdev->time_usec = time_usec;
+
+  _clutter_event_set_time_usec (event, time_usec);
 }
 
 void
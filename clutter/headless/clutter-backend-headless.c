@@ -0,0 +1,163 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* The headless backend does not need a display server or a GPU: the
+ * stage is painted on an offscreen framebuffer using the Cogl stub
+ * window system and the no-op driver, so that it can be used to run
+ * the test suites and to measure the CPU side of the frame cost on
+ * machines without a display.
+ *
+ * The no-op driver discards every drawing command, so nothing is
+ * actually rendered: reading back the contents of the stage returns
+ * undefined pixels, and picking never finds an actor. The test units
+ * that depend on either are skipped; see
+ * clutter_test_skip_without_rendering().
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+
+#include "clutter-backend-headless.h"
+#include "clutter-device-manager-headless.h"
+#include "clutter-stage-headless.h"
+
+#include "clutter-debug.h"
+#include "clutter-private.h"
+
+#define DEFAULT_REFRESH_RATE    60.0f
+
+G_DEFINE_TYPE (ClutterBackendHeadless, clutter_backend_headless, CLUTTER_TYPE_BACKEND)
+
+static gboolean
+clutter_backend_headless_create_context (ClutterBackend  *backend,
+                                         GError         **error)
+{
+  CoglSwapChain *swap_chain = NULL;
+  CoglOnscreenTemplate *tmpl = NULL;
+  GError *internal_error = NULL;
+
+  if (backend->cogl_context != NULL)
+    return TRUE;
+
+  CLUTTER_NOTE (BACKEND, "Creating the headless Cogl context");
+
+  backend->cogl_renderer = cogl_renderer_new ();
+  cogl_renderer_set_winsys_id (backend->cogl_renderer, COGL_WINSYS_ID_STUB);
+  cogl_renderer_set_driver (backend->cogl_renderer, COGL_DRIVER_NOP);
+
+  if (!cogl_renderer_connect (backend->cogl_renderer, &internal_error))
+    goto error;
+
+  swap_chain = cogl_swap_chain_new ();
+  tmpl = cogl_onscreen_template_new (swap_chain);
+  cogl_object_unref (swap_chain);
+
+  backend->cogl_display = cogl_display_new (backend->cogl_renderer, tmpl);
+  cogl_object_unref (tmpl);
+
+  if (!cogl_display_setup (backend->cogl_display, &internal_error))
+    goto error;
+
+  backend->cogl_context = cogl_context_new (backend->cogl_display, &internal_error);
+  if (backend->cogl_context == NULL)
+    goto error;
+
+  backend->cogl_source = cogl_glib_source_new (backend->cogl_context, G_PRIORITY_DEFAULT);
+  g_source_attach (backend->cogl_source, NULL);
+
+  return TRUE;
+
+error:
+  if (backend->cogl_display != NULL)
+    {
+      cogl_object_unref (backend->cogl_display);
+      backend->cogl_display = NULL;
+    }
+
+  if (backend->cogl_renderer != NULL)
+    {
+      cogl_object_unref (backend->cogl_renderer);
+      backend->cogl_renderer = NULL;
+    }
+
+  if (internal_error != NULL)
+    g_propagate_error (error, internal_error);
+  else
+    g_set_error_literal (error, CLUTTER_INIT_ERROR,
+                         CLUTTER_INIT_ERROR_BACKEND,
+                         "Unable to initialize the headless backend");
+
+  return FALSE;
+}
+
+static void
+clutter_backend_headless_init_events (ClutterBackend *backend)
+{
+  CLUTTER_NOTE (EVENT, "initialising the headless input devices");
+
+  /* there is no event source: events are injected using
+   * clutter_event_put() on the core devices
+   */
+  backend->device_manager =
+    g_object_new (CLUTTER_TYPE_DEVICE_MANAGER_HEADLESS,
+                  "backend", backend,
+                  NULL);
+}
+
+static void
+clutter_backend_headless_class_init (ClutterBackendHeadlessClass *klass)
+{
+  ClutterBackendClass *backend_class = CLUTTER_BACKEND_CLASS (klass);
+
+  backend_class->stage_window_type = CLUTTER_TYPE_STAGE_HEADLESS;
+
+  backend_class->create_context = clutter_backend_headless_create_context;
+  backend_class->init_events = clutter_backend_headless_init_events;
+}
+
+static void
+clutter_backend_headless_init (ClutterBackendHeadless *backend_headless)
+{
+  const char *env;
+
+  backend_headless->refresh_rate = DEFAULT_REFRESH_RATE;
+
+  env = g_getenv ("CLUTTER_HEADLESS_REFRESH_RATE");
+  if (env != NULL)
+    {
+      double rate = g_ascii_strtod (env, NULL);
+
+      if (rate > 0.0)
+        backend_headless->refresh_rate = rate;
+      else
+        g_warning ("Invalid refresh rate '%s' for the headless backend", env);
+    }
+
+  CLUTTER_NOTE (BACKEND, "Simulating a refresh rate of %.2f Hz",
+                backend_headless->refresh_rate);
+}
+
+ClutterBackend *
+clutter_backend_headless_new (void)
+{
+  return g_object_new (CLUTTER_TYPE_BACKEND_HEADLESS, NULL);
+}
@@ -0,0 +1,298 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <glib.h>
+#include <cogl/cogl.h>
+
+#include "clutter-stage-headless.h"
+#include "clutter-backend-headless.h"
+
+#include "clutter-debug.h"
+#include "clutter-main.h"
+#include "clutter-private.h"
+#include "clutter-stage-private.h"
+#include "clutter-stage-window.h"
+
+/* The headless stage paints on an offscreen framebuffer instead of a
+ * window, and simulates the presentation of each frame at the next
+ * vertical refresh, so that the master clock is throttled in the same
+ * way it would be with an onscreen framebuffer.
+ */
+
+static ClutterStageWindowIface *clutter_stage_window_parent_iface = NULL;
+
+static void clutter_stage_window_iface_init (ClutterStageWindowIface *iface);
+
+G_DEFINE_TYPE_WITH_CODE (ClutterStageHeadless,
+                         _clutter_stage_headless,
+                         CLUTTER_TYPE_STAGE_COGL,
+                         G_IMPLEMENT_INTERFACE (CLUTTER_TYPE_STAGE_WINDOW,
+                                                clutter_stage_window_iface_init));
+
+static void
+clutter_stage_headless_clear_offscreen (ClutterStageHeadless *stage_headless)
+{
+  if (stage_headless->offscreen != NULL)
+    {
+      cogl_object_unref (stage_headless->offscreen);
+      stage_headless->offscreen = NULL;
+    }
+}
+
+static gboolean
+clutter_stage_headless_ensure_offscreen (ClutterStageHeadless *stage_headless)
+{
+  ClutterBackend *backend = clutter_get_default_backend ();
+  CoglTexture *texture;
+  GError *error = NULL;
+
+  if (stage_headless->offscreen != NULL)
+    return TRUE;
+
+  texture = cogl_texture_2d_new_with_size (backend->cogl_context,
+                                           MAX (stage_headless->width, 1),
+                                           MAX (stage_headless->height, 1));
+  stage_headless->offscreen = cogl_offscreen_new_with_texture (texture);
+  cogl_object_unref (texture);
+
+  if (!cogl_framebuffer_allocate (COGL_FRAMEBUFFER (stage_headless->offscreen), &error))
+    {
+      g_warning ("Failed to allocate stage: %s", error->message);
+      g_error_free (error);
+      clutter_stage_headless_clear_offscreen (stage_headless);
+      return FALSE;
+    }
+
+  CLUTTER_NOTE (BACKEND, "Allocated offscreen stage framebuffer of %dx%d pixels",
+                stage_headless->width,
+                stage_headless->height);
+
+  return TRUE;
+}
+
+static gboolean
+clutter_stage_headless_realize (ClutterStageWindow *stage_window)
+{
+  ClutterStageHeadless *stage_headless = CLUTTER_STAGE_HEADLESS (stage_window);
+  ClutterBackendHeadless *backend_headless;
+  ClutterBackend *backend;
+
+  CLUTTER_NOTE (BACKEND, "Realizing headless stage [%p]", stage_headless);
+
+  backend = clutter_get_default_backend ();
+  if (backend->cogl_context == NULL)
+    {
+      g_warning ("Failed to realize stage: missing Cogl context");
+      return FALSE;
+    }
+
+  backend_headless = CLUTTER_BACKEND_HEADLESS (backend);
+  stage_headless->vblank_interval =
+    (gint64) (0.5 + G_USEC_PER_SEC / backend_headless->refresh_rate);
+  stage_headless->vblank_start_time = g_get_monotonic_time ();
+
+  CLUTTER_STAGE_COGL (stage_headless)->refresh_rate = backend_headless->refresh_rate;
+
+  return clutter_stage_headless_ensure_offscreen (stage_headless);
+}
+
+static void
+clutter_stage_headless_unrealize (ClutterStageWindow *stage_window)
+{
+  ClutterStageHeadless *stage_headless = CLUTTER_STAGE_HEADLESS (stage_window);
+
+  CLUTTER_NOTE (BACKEND, "Unrealizing headless stage [%p]", stage_headless);
+
+  if (stage_headless->vblank_source != 0)
+    {
+      g_source_remove (stage_headless->vblank_source);
+      stage_headless->vblank_source = 0;
+    }
+
+  clutter_stage_headless_clear_offscreen (stage_headless);
+
+  clutter_stage_window_parent_iface->unrealize (stage_window);
+}
+
+static void
+clutter_stage_headless_get_geometry (ClutterStageWindow    *stage_window,
+                                     cairo_rectangle_int_t *geometry)
+{
+  ClutterStageHeadless *stage_headless = CLUTTER_STAGE_HEADLESS (stage_window);
+
+  if (geometry != NULL)
+    {
+      geometry->x = geometry->y = 0;
+      geometry->width = stage_headless->width;
+      geometry->height = stage_headless->height;
+    }
+}
+
+static void
+clutter_stage_headless_resize (ClutterStageWindow *stage_window,
+                               gint                width,
+                               gint                height)
+{
+  ClutterStageHeadless *stage_headless = CLUTTER_STAGE_HEADLESS (stage_window);
+
+  if (stage_headless->width == width && stage_headless->height == height)
+    return;
+
+  stage_headless->width = width;
+  stage_headless->height = height;
+
+  /* the framebuffer is allocated again at the next redraw */
+  clutter_stage_headless_clear_offscreen (stage_headless);
+}
+
+static gboolean
+clutter_stage_headless_vblank (gpointer data)
+{
+  ClutterStageHeadless *stage_headless = data;
+  ClutterStageCogl *stage_cogl = CLUTTER_STAGE_COGL (stage_headless);
+  gint64 now, elapsed;
+
+  stage_headless->vblank_source = 0;
+
+  now = g_get_monotonic_time ();
+  elapsed = now - stage_headless->vblank_start_time;
+
+  /* the frame was presented on the last refresh */
+  stage_cogl->last_presentation_time =
+    now - (elapsed % stage_headless->vblank_interval);
+
+  if (stage_cogl->pending_swaps > 0)
+    stage_cogl->pending_swaps--;
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+clutter_stage_headless_redraw (ClutterStageWindow *stage_window)
+{
+  ClutterStageHeadless *stage_headless = CLUTTER_STAGE_HEADLESS (stage_window);
+  ClutterStageCogl *stage_cogl = CLUTTER_STAGE_COGL (stage_window);
+  gint64 now, elapsed, delay;
+
+  if (!clutter_stage_headless_ensure_offscreen (stage_headless))
+    return;
+
+  _clutter_stage_do_paint (stage_cogl->wrapper, NULL);
+
+  /* make sure that the cost of flushing the rendering commands is
+   * accounted for in the frame, like it would be by a buffer swap
+   */
+  cogl_framebuffer_finish (COGL_FRAMEBUFFER (stage_headless->offscreen));
+
+  stage_cogl->initialized_redraw_clip = FALSE;
+  stage_cogl->frame_count++;
+
+  now = g_get_monotonic_time ();
+
+  if (!_clutter_get_sync_to_vblank ())
+    {
+      stage_cogl->last_presentation_time = now;
+      return;
+    }
+
+  /* the frame is presented at the next refresh; until then, the
+   * master clock will not schedule a new frame
+   */
+  stage_cogl->pending_swaps++;
+
+  if (stage_headless->vblank_source != 0)
+    return;
+
+  elapsed = now - stage_headless->vblank_start_time;
+  delay = stage_headless->vblank_interval - (elapsed % stage_headless->vblank_interval);
+
+  stage_headless->vblank_source =
+    clutter_threads_add_timeout_full (CLUTTER_PRIORITY_REDRAW,
+                                      (delay + 999) / 1000,
+                                      clutter_stage_headless_vblank,
+                                      stage_headless,
+                                      NULL);
+}
+
+static gboolean
+clutter_stage_headless_can_clip_redraws (ClutterStageWindow *stage_window)
+{
+  return FALSE;
+}
+
+static CoglFramebuffer *
+clutter_stage_headless_get_active_framebuffer (ClutterStageWindow *stage_window)
+{
+  ClutterStageHeadless *stage_headless = CLUTTER_STAGE_HEADLESS (stage_window);
+
+  clutter_stage_headless_ensure_offscreen (stage_headless);
+
+  return COGL_FRAMEBUFFER (stage_headless->offscreen);
+}
+
+static void
+clutter_stage_headless_dispose (GObject *gobject)
+{
+  ClutterStageHeadless *stage_headless = CLUTTER_STAGE_HEADLESS (gobject);
+
+  if (stage_headless->vblank_source != 0)
+    {
+      g_source_remove (stage_headless->vblank_source);
+      stage_headless->vblank_source = 0;
+    }
+
+  clutter_stage_headless_clear_offscreen (stage_headless);
+
+  G_OBJECT_CLASS (_clutter_stage_headless_parent_class)->dispose (gobject);
+}
+
+static void
+_clutter_stage_headless_class_init (ClutterStageHeadlessClass *klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+  gobject_class->dispose = clutter_stage_headless_dispose;
+}
+
+static void
+_clutter_stage_headless_init (ClutterStageHeadless *stage_headless)
+{
+  stage_headless->width = 640;
+  stage_headless->height = 480;
+
+  stage_headless->vblank_interval = 16667; /* 1/60th second */
+}
+
+static void
+clutter_stage_window_iface_init (ClutterStageWindowIface *iface)
+{
+  clutter_stage_window_parent_iface = g_type_interface_peek_parent (iface);
+
+  iface->realize = clutter_stage_headless_realize;
+  iface->unrealize = clutter_stage_headless_unrealize;
+  iface->get_geometry = clutter_stage_headless_get_geometry;
+  iface->resize = clutter_stage_headless_resize;
+  iface->redraw = clutter_stage_headless_redraw;
+  iface->can_clip_redraws = clutter_stage_headless_can_clip_redraws;
+  iface->get_active_framebuffer = clutter_stage_headless_get_active_framebuffer;
+}
@@ -31,6 +31,14 @@
  * #ClutterWaylandSurface is an actor for displaying the contents of a client
  * surface. It is intended to support developers implementing Clutter based
  * wayland compositors.
+ *
+ * When the contents of a surface come from a shared memory buffer the
+ * actor keeps the same #CoglTexture across attaches for as long as the
+ * size and the format of the client buffers do not change, and only
+ * uploads the regions passed to clutter_wayland_surface_damage_buffer().
+ * Compositors that call clutter_wayland_surface_commit() when the client
+ * commits the surface state also let the actor take care of releasing
+ * the client buffers as soon as they are not needed any more.
  */
 
 #ifdef HAVE_CONFIG_H
@@ -76,6 +84,25 @@ struct _ClutterWaylandSurfacePrivate
   CoglTexture2D *buffer;
   int width, height;
   CoglPipeline *pipeline;
+
+  /* the currently attached client buffer */
+  struct wl_resource *buffer_resource;
+  struct wl_listener buffer_destroy_listener;
+
+  /* the SHM format of the contents of @buffer, or -1 if the texture
+   * was not created from a SHM buffer
+   */
+  gint64 shm_format;
+
+  /* whether @buffer was just imported from @buffer_resource, in which
+   * case the damaged regions do not need to be uploaded again
+   */
+  guint buffer_is_fresh : 1;
+
+  /* whether the compositor notifies us of commits, which means that
+   * we are responsible for releasing the client buffers
+   */
+  guint release_buffers : 1;
 };
 
 G_DEFINE_TYPE_WITH_PRIVATE (ClutterWaylandSurface,
@@ -135,6 +162,73 @@ clutter_wayland_surface_queue_damage_redraw (ClutterWaylandSurface *texture,
   clutter_actor_queue_redraw_with_clip (self, &clip);
 }
 
+static void
+buffer_destroy_cb (struct wl_listener *listener,
+                   void *data)
+{
+  ClutterWaylandSurfacePrivate *priv =
+    wl_container_of (listener, priv, buffer_destroy_listener);
+
+  /* the texture keeps its own copy, or reference, of the contents */
+  priv->buffer_resource = NULL;
+  wl_list_init (&priv->buffer_destroy_listener.link);
+}
+
+static void
+set_buffer_resource (ClutterWaylandSurface *self,
+                     struct wl_resource *buffer)
+{
+  ClutterWaylandSurfacePrivate *priv = self->priv;
+
+  if (priv->buffer_resource == buffer)
+    return;
+
+  if (priv->buffer_resource != NULL)
+    {
+      wl_list_remove (&priv->buffer_destroy_listener.link);
+      wl_list_init (&priv->buffer_destroy_listener.link);
+
+      /* SHM buffers have already been released on commit, so only the
+       * buffers that we were sampling directly are left to release
+       */
+      if (priv->release_buffers &&
+          wl_shm_buffer_get (priv->buffer_resource) == NULL)
+        wl_buffer_send_release (priv->buffer_resource);
+    }
+
+  priv->buffer_resource = buffer;
+
+  if (priv->buffer_resource != NULL)
+    wl_resource_add_destroy_listener (priv->buffer_resource,
+                                      &priv->buffer_destroy_listener);
+}
+
+static gboolean
+get_shm_pixel_format (struct wl_shm_buffer *shm_buffer,
+                      CoglPixelFormat *format_p)
+{
+  switch (wl_shm_buffer_get_format (shm_buffer))
+    {
+#if G_BYTE_ORDER == G_BIG_ENDIAN
+    case WL_SHM_FORMAT_ARGB8888:
+      *format_p = COGL_PIXEL_FORMAT_ARGB_8888_PRE;
+      return TRUE;
+    case WL_SHM_FORMAT_XRGB8888:
+      *format_p = COGL_PIXEL_FORMAT_ARGB_8888;
+      return TRUE;
+#elif G_BYTE_ORDER == G_LITTLE_ENDIAN
+    case WL_SHM_FORMAT_ARGB8888:
+      *format_p = COGL_PIXEL_FORMAT_BGRA_8888_PRE;
+      return TRUE;
+    case WL_SHM_FORMAT_XRGB8888:
+      *format_p = COGL_PIXEL_FORMAT_BGRA_8888;
+      return TRUE;
+#endif
+    default:
+      return FALSE;
+    }
+}
+
 static void
 free_pipeline (ClutterWaylandSurface *self)
 {
@@ -162,6 +256,10 @@ clutter_wayland_surface_init (ClutterWaylandSurface *self)
   priv->surface = NULL;
   priv->width = 0;
   priv->height = 0;
+  priv->shm_format = -1;
+
+  priv->buffer_destroy_listener.notify = buffer_destroy_cb;
+  wl_list_init (&priv->buffer_destroy_listener.link);
 
   self->priv = priv;
 
@@ -177,6 +275,8 @@ free_surface_buffers (ClutterWaylandSurface *self)
     {
       cogl_object_unref (priv->buffer);
       priv->buffer = NULL;
+      priv->shm_format = -1;
+      priv->buffer_is_fresh = FALSE;
       free_pipeline (self);
     }
 }
@@ -189,6 +289,7 @@ clutter_wayland_surface_dispose (GObject *object)
 
   free_pipeline (self);
   free_surface_buffers (self);
+  set_buffer_resource (self, NULL);
   priv->surface = NULL;
 
   G_OBJECT_CLASS (clutter_wayland_surface_parent_class)->dispose (object);
@@ -258,6 +359,7 @@ clutter_wayland_surface_set_surface (ClutterWaylandSurface *self,
     {
       free_pipeline (self);
       free_surface_buffers (self);
+      set_buffer_resource (self, NULL);
       g_signal_emit (self, signals[QUEUE_DAMAGE_REDRAW],
                      0,
                      0, 0, priv->width, priv->height);
@@ -518,6 +620,11 @@ clutter_wayland_surface_new (struct wl_surface *surface)
  * actor @self. This will automatically result in @self being re-drawn
  * with the new buffer contents.
  *
+ * If @buffer is a shared memory buffer with the same size and format
+ * as the previously attached one, the texture of @self is reused and
+ * only the regions passed to clutter_wayland_surface_damage_buffer()
+ * are uploaded.
+ *
  * Since: 1.8
  * Stability: unstable
  */
@@ -529,16 +636,49 @@ clutter_wayland_surface_attach_buffer (ClutterWaylandSurface *self,
   ClutterWaylandSurfacePrivate *priv;
   ClutterBackend *backend = clutter_get_default_backend ();
   CoglContext *context = clutter_backend_get_cogl_context (backend);
+  struct wl_shm_buffer *shm_buffer;
 
   g_return_val_if_fail (CLUTTER_WAYLAND_IS_SURFACE (self), TRUE);
 
   priv = self->priv;
 
+  set_buffer_resource (self, buffer);
+
+  shm_buffer = wl_shm_buffer_get (buffer);
+
+  /* the contents of the texture stay valid outside of the damaged
+   * regions, so a SHM buffer with the same geometry can just be
+   * uploaded into the texture we already have
+   */
+  if (priv->buffer != NULL &&
+      shm_buffer != NULL &&
+      priv->shm_format == wl_shm_buffer_get_format (shm_buffer) &&
+      cogl_texture_get_width (COGL_TEXTURE (priv->buffer)) ==
+        wl_shm_buffer_get_width (shm_buffer) &&
+      cogl_texture_get_height (COGL_TEXTURE (priv->buffer)) ==
+        wl_shm_buffer_get_height (shm_buffer))
+    {
+      priv->buffer_is_fresh = FALSE;
+      return TRUE;
+    }
+
   free_surface_buffers (self);
 
   priv->buffer =
     cogl_wayland_texture_2d_new_from_buffer (context, buffer, error);
 
+  if (priv->buffer != NULL)
+    {
+      priv->shm_format = shm_buffer != NULL
+                       ? wl_shm_buffer_get_format (shm_buffer)
+                       : -1;
+
+      /* without commit notifications we cannot tell whether damage
+       * belongs to this buffer, so only skip the uploads when we can
+       */
+      priv->buffer_is_fresh = priv->release_buffers;
+    }
+
   g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_COGL_TEXTURE]);
 
   /* NB: We don't queue a redraw of the actor here because we don't
@@ -572,6 +712,9 @@ clutter_wayland_surface_attach_buffer (ClutterWaylandSurface *self,
  * If multiple regions are changed then this should be called multiple
  * times with different damage rectangles.
  *
+ * For shared memory buffers only the damaged rectangle, clamped to the
+ * size of the buffer, is uploaded into the texture of @self.
+ *
  * Since: 1.8
  * Stability: unstable
  */
@@ -585,6 +728,8 @@ clutter_wayland_surface_damage_buffer (ClutterWaylandSurface *self,
 {
   ClutterWaylandSurfacePrivate *priv;
   struct wl_shm_buffer *shm_buffer;
+  gint32 buffer_width, buffer_height;
+  CoglPixelFormat format;
 
   g_return_if_fail (CLUTTER_WAYLAND_IS_SURFACE (self));
 
@@ -592,42 +737,53 @@ clutter_wayland_surface_damage_buffer (ClutterWaylandSurface *self,
 
   shm_buffer = wl_shm_buffer_get (buffer);
 
-  if (priv->buffer && shm_buffer)
+  if (priv->buffer == NULL || shm_buffer == NULL || priv->buffer_is_fresh)
+    goto out;
+
+  buffer_width = wl_shm_buffer_get_width (shm_buffer);
+  buffer_height = wl_shm_buffer_get_height (shm_buffer);
+
+  /* clients are allowed to damage outside of the buffer */
+  if (x < 0)
     {
-      CoglPixelFormat format;
+      width += x;
+      x = 0;
+    }
 
-      switch (wl_shm_buffer_get_format (shm_buffer))
-        {
-#if G_BYTE_ORDER == G_BIG_ENDIAN
-          case WL_SHM_FORMAT_ARGB8888:
-            format = COGL_PIXEL_FORMAT_ARGB_8888_PRE;
-            break;
-          case WL_SHM_FORMAT_XRGB8888:
-            format = COGL_PIXEL_FORMAT_ARGB_8888;
-            break;
-#elif G_BYTE_ORDER == G_LITTLE_ENDIAN
-          case WL_SHM_FORMAT_ARGB8888:
-            format = COGL_PIXEL_FORMAT_BGRA_8888_PRE;
-            break;
-          case WL_SHM_FORMAT_XRGB8888:
-            format = COGL_PIXEL_FORMAT_BGRA_8888;
-            break;
-#endif
-          default:
-            g_warn_if_reached ();
-            format = COGL_PIXEL_FORMAT_ARGB_8888;
-        }
-
-      cogl_texture_set_region (COGL_TEXTURE (priv->buffer),
-                               x, y,
-                               x, y,
-                               width, height,
-                               width, height,
-                               format,
-                               wl_shm_buffer_get_stride (shm_buffer),
-                               wl_shm_buffer_get_data (shm_buffer));
+  if (y < 0)
+    {
+      height += y;
+      y = 0;
     }
 
+  width = MIN (width, buffer_width - x);
+  height = MIN (height, buffer_height - y);
+
+  /* nothing of the damage is inside the buffer */
+  if (width <= 0 || height <= 0)
+    return;
+
+  if (!get_shm_pixel_format (shm_buffer, &format))
+    {
+      g_warn_if_reached ();
+      format = COGL_PIXEL_FORMAT_ARGB_8888;
+    }
+
+  wl_shm_buffer_begin_access (shm_buffer);
+
+  cogl_texture_set_region (COGL_TEXTURE (priv->buffer),
+                           x, y,
+                           x, y,
+                           width, height,
+                           width, height,
+                           format,
+                           wl_shm_buffer_get_stride (shm_buffer),
+                           wl_shm_buffer_get_data (shm_buffer));
+
+  wl_shm_buffer_end_access (shm_buffer);
+
+out:
+
   g_signal_emit (self, signals[QUEUE_DAMAGE_REDRAW],
                  0,
                  x, y, width, height);
@@ -650,3 +806,45 @@ clutter_wayland_surface_get_cogl_texture (ClutterWaylandSurface *self)
 
   return COGL_TEXTURE (self->priv->buffer);
 }
+
+/**
+ * clutter_wayland_surface_commit:
+ * @self: a #ClutterWaylandSurface
+ *
+ * Notifies @self that the client committed the state of its surface,
+ * after the calls to clutter_wayland_surface_attach_buffer() and
+ * clutter_wayland_surface_damage_buffer() for the new state.
+ *
+ * Once this function has been called the actor takes care of sending
+ * the release event for the buffers it uses: shared memory buffers
+ * are released as soon as their contents have been copied, which
+ * allows clients to reuse them immediately, while other buffers are
+ * released when they are replaced by a new buffer.
+ *
+ * Since: 1.28
+ * Stability: unstable
+ */
+void
+clutter_wayland_surface_commit (ClutterWaylandSurface *self)
+{
+  ClutterWaylandSurfacePrivate *priv;
+
+  g_return_if_fail (CLUTTER_WAYLAND_IS_SURFACE (self));
+
+  priv = self->priv;
+
+  priv->release_buffers = TRUE;
+
+  /* any damage posted from now on belongs to the next commit */
+  priv->buffer_is_fresh = FALSE;
+
+  if (priv->buffer_resource != NULL &&
+      wl_shm_buffer_get (priv->buffer_resource) != NULL)
+    {
+      wl_buffer_send_release (priv->buffer_resource);
+
+      wl_list_remove (&priv->buffer_destroy_listener.link);
+      wl_list_init (&priv->buffer_destroy_listener.link);
+      priv->buffer_resource = NULL;
+    }
+}
@@ -111,6 +111,8 @@ void          clutter_wayland_surface_damage_buffer     (ClutterWaylandSurface *
                                                          gint32 height);
 CLUTTER_AVAILABLE_IN_1_10
 CoglTexture  *clutter_wayland_surface_get_cogl_texture  (ClutterWaylandSurface *self);
+CLUTTER_AVAILABLE_IN_1_28
+void          clutter_wayland_surface_commit            (ClutterWaylandSurface *self);
 
 G_END_DECLS
 
@@ -54,6 +54,8 @@
 #include <X11/extensions/XInput2.h>
 #endif
 
+#include <X11/extensions/Xdamage.h>
+
 #include <cogl/cogl.h>
 #include <cogl/cogl-xlib.h>
 
@@ -352,6 +354,7 @@ clutter_backend_x11_post_parse (ClutterBackend  *backend,
   ClutterBackendX11 *backend_x11 = CLUTTER_BACKEND_X11 (backend);
   ClutterSettings *settings;
   Atom atoms[N_ATOM_NAMES];
+  int damage_error_base;
   double dpi;
 
   if (_foreign_dpy)
@@ -428,6 +431,14 @@ clutter_backend_x11_post_parse (ClutterBackend  *backend,
   /* add event filter for XSETTINGS events */
   clutter_x11_add_filter (xsettings_filter, backend_x11);
 
+  /* we need the base of the Damage events to dispatch them to the
+   * filters registered for a Damage object
+   */
+  if (!XDamageQueryExtension (backend_x11->xdpy,
+                              &backend_x11->damage_event_base,
+                              &damage_error_base))
+    backend_x11->damage_event_base = 0;
+
   if (clutter_synchronise)
     XSynchronize (backend_x11->xdpy, True);
 
@@ -551,6 +562,9 @@ clutter_backend_x11_finalize (GObject *gobject)
   clutter_x11_remove_filter (xsettings_filter, backend_x11);
   _clutter_xsettings_client_destroy (backend_x11->xsettings);
 
+  if (backend_x11->xid_filters != NULL)
+    g_hash_table_unref (backend_x11->xid_filters);
+
   XCloseDisplay (backend_x11->xdpy);
 
   G_OBJECT_CLASS (clutter_backend_x11_parent_class)->finalize (gobject);
@@ -618,6 +632,49 @@ update_last_event_time (ClutterBackendX11 *backend_x11,
     backend_x11->last_event_time = current_time;
 }
 
+/*< private >
+ * get_event_xid:
+ * @backend_x11: a #ClutterBackendX11
+ * @xevent: an X event
+ *
+ * Retrieves the XID used to look up the filters registered with
+ * _clutter_x11_add_xid_filter(): the Damage object for XDamageNotify
+ * events, and the event window for everything else.
+ */
+static XID
+get_event_xid (ClutterBackendX11 *backend_x11,
+               XEvent            *xevent)
+{
+  if (backend_x11->damage_event_base != 0 &&
+      xevent->type == backend_x11->damage_event_base + XDamageNotify)
+    return ((XDamageNotifyEvent *) xevent)->damage;
+
+  return xevent->xany.window;
+}
+
+static ClutterX11FilterReturn
+run_event_filters (GSList       *filters,
+                   XEvent       *xevent,
+                   ClutterEvent *event)
+{
+  GSList *node = filters;
+
+  while (node != NULL)
+    {
+      ClutterX11EventFilter *filter = node->data;
+      ClutterX11FilterReturn res;
+
+      /* the filter might remove itself */
+      node = node->next;
+
+      res = filter->func (xevent, event, filter->data);
+      if (res != CLUTTER_X11_FILTER_CONTINUE)
+        return res;
+    }
+
+  return CLUTTER_X11_FILTER_CONTINUE;
+}
+
 static gboolean
 clutter_backend_x11_translate_event (ClutterBackend *backend,
                                      gpointer        native,
@@ -627,16 +684,21 @@ clutter_backend_x11_translate_event (ClutterBackend *backend,
   ClutterBackendClass *parent_class;
   XEvent *xevent = native;
 
-  /* X11 filter functions have a higher priority */
-  if (backend_x11->event_filters != NULL)
+  /* X11 filter functions have a higher priority; the filters registered
+   * for a specific XID are invoked before the catch-all ones
+   */
+  if (backend_x11->xid_filters != NULL)
     {
-      GSList *node = backend_x11->event_filters;
+      XID xid = get_event_xid (backend_x11, xevent);
 
-      while (node != NULL)
+      if (xid != None)
         {
-          ClutterX11EventFilter *filter = node->data;
+          GSList *filters;
 
-          switch (filter->func (xevent, event, filter->data))
+          filters = g_hash_table_lookup (backend_x11->xid_filters,
+                                         GSIZE_TO_POINTER (xid));
+
+          switch (run_event_filters (filters, xevent, event))
             {
             case CLUTTER_X11_FILTER_CONTINUE:
               break;
@@ -650,11 +712,24 @@ clutter_backend_x11_translate_event (ClutterBackend *backend,
             default:
               break;
             }
-
-          node = node->next;
         }
     }
 
+  switch (run_event_filters (backend_x11->event_filters, xevent, event))
+    {
+    case CLUTTER_X11_FILTER_CONTINUE:
+      break;
+
+    case CLUTTER_X11_FILTER_TRANSLATE:
+      return TRUE;
+
+    case CLUTTER_X11_FILTER_REMOVE:
+      return FALSE;
+
+    default:
+      break;
+    }
+
   /* we update the event time only for events that can
    * actually reach Clutter's event queue
    */
@@ -1185,6 +1260,126 @@ clutter_x11_remove_filter (ClutterX11FilterFunc func,
     }
 }
 
+static ClutterBackendX11 *
+get_backend_x11 (void)
+{
+  ClutterBackend *backend = clutter_get_default_backend ();
+
+  if (backend == NULL)
+    {
+      g_critical ("The Clutter backend has not been initialised");
+      return NULL;
+    }
+
+  if (!CLUTTER_IS_BACKEND_X11 (backend))
+    {
+      g_critical ("The Clutter backend is not a X11 backend");
+      return NULL;
+    }
+
+  return CLUTTER_BACKEND_X11 (backend);
+}
+
+static void
+xid_filters_free (gpointer data)
+{
+  g_slist_free_full (data, g_free);
+}
+
+/*< private >
+ * _clutter_x11_add_xid_filter:
+ * @xid: the XID of a Window or of a Damage object
+ * @func: a filter function
+ * @data: user data to be passed to the filter function, or %NULL
+ *
+ * Adds an event filter function that is only invoked for the events
+ * targeting @xid, that is the XDamageNotify events for a Damage object,
+ * or the events whose window is @xid.
+ *
+ * Unlike the filters added with clutter_x11_add_filter(), which are
+ * invoked for every X event, these filters are looked up using a hash
+ * table, so their cost does not depend on the number of XIDs being
+ * monitored.
+ */
+void
+_clutter_x11_add_xid_filter (XID                  xid,
+                             ClutterX11FilterFunc func,
+                             gpointer             data)
+{
+  ClutterBackendX11 *backend_x11 = get_backend_x11 ();
+  ClutterX11EventFilter *filter;
+  GSList *filters;
+
+  g_assert (xid != None);
+  g_assert (func != NULL);
+
+  if (backend_x11 == NULL)
+    return;
+
+  if (backend_x11->xid_filters == NULL)
+    backend_x11->xid_filters = g_hash_table_new_full (NULL, NULL,
+                                                      NULL,
+                                                      xid_filters_free);
+
+  filter = g_new0 (ClutterX11EventFilter, 1);
+  filter->func = func;
+  filter->data = data;
+
+  /* we steal the list, to avoid the destroy notification */
+  filters = g_hash_table_lookup (backend_x11->xid_filters,
+                                 GSIZE_TO_POINTER (xid));
+  g_hash_table_steal (backend_x11->xid_filters, GSIZE_TO_POINTER (xid));
+
+  filters = g_slist_append (filters, filter);
+  g_hash_table_insert (backend_x11->xid_filters,
+                       GSIZE_TO_POINTER (xid),
+                       filters);
+}
+
+/*< private >
+ * _clutter_x11_remove_xid_filter:
+ * @xid: the XID passed to _clutter_x11_add_xid_filter()
+ * @func: a filter function
+ * @data: user data to be passed to the filter function, or %NULL
+ *
+ * Removes a filter function added with _clutter_x11_add_xid_filter().
+ */
+void
+_clutter_x11_remove_xid_filter (XID                  xid,
+                                ClutterX11FilterFunc func,
+                                gpointer             data)
+{
+  ClutterBackendX11 *backend_x11 = get_backend_x11 ();
+  GSList *filters, *l;
+
+  if (backend_x11 == NULL || backend_x11->xid_filters == NULL)
+    return;
+
+  filters = g_hash_table_lookup (backend_x11->xid_filters,
+                                 GSIZE_TO_POINTER (xid));
+
+  for (l = filters; l != NULL; l = l->next)
+    {
+      ClutterX11EventFilter *filter = l->data;
+
+      if (filter->func == func && filter->data == data)
+        {
+          g_hash_table_steal (backend_x11->xid_filters,
+                              GSIZE_TO_POINTER (xid));
+
+          filters = g_slist_delete_link (filters, l);
+          g_free (filter);
+
+          if (filters != NULL)
+            g_hash_table_insert (backend_x11->xid_filters,
+                                 GSIZE_TO_POINTER (xid),
+                                 filters);
+
+          return;
+        }
+    }
+}
+
 /**
  * clutter_x11_get_input_devices:
  *
@@ -83,6 +83,13 @@ struct _ClutterBackendX11
   GSource *event_source;
   GSList  *event_filters;
 
+  /* XID -> GSList of ClutterX11EventFilter; filters in this table
+   * are only invoked for events targeting the given XID
+   */
+  GHashTable *xid_filters;
+
+  int damage_event_base;
+
   /* props */
   Atom atom_NET_WM_PID;
   Atom atom_NET_WM_PING;
@@ -140,6 +147,13 @@ gboolean        _clutter_x11_input_device_translate_screen_coord (ClutterInputDe
                                                                   gdouble             value,
                                                                   gdouble            *axis_value);
 
+void            _clutter_x11_add_xid_filter     (XID                  xid,
+                                                 ClutterX11FilterFunc func,
+                                                 gpointer             data);
+void            _clutter_x11_remove_xid_filter  (XID                  xid,
+                                                 ClutterX11FilterFunc func,
+                                                 gpointer             data);
+
 G_END_DECLS
 
 #endif /* __CLUTTER_BACKEND_X11_H__ */
@@ -121,6 +121,10 @@ struct _ClutterX11TexturePixmapPrivate
 
   Damage        damage;
 
+  /* the damage accumulated since the last frame */
+  cairo_region_t *damage_region;
+  guint           damage_flush_id;
+
   gint          window_x, window_y;
   gint          window_width, window_height;
 
@@ -160,18 +164,85 @@ check_extensions (ClutterX11TexturePixmap *texture)
   return TRUE;
 }
 
+static gboolean
+flush_damage (gpointer data)
+{
+  ClutterX11TexturePixmap *texture = data;
+  ClutterX11TexturePixmapPrivate *priv = texture->priv;
+  cairo_rectangle_int_t extents;
+  int i, n_rects;
+
+  priv->damage_flush_id = 0;
+
+  /* the damage is reported using XDamageReportBoundingBox, so the
+   * accumulated area covers everything up to the last event we got;
+   * we only need to reset the damage object once per frame for the
+   * server to start reporting again
+   */
+  if (priv->damage != None)
+    XDamageSubtract (clutter_x11_get_default_display (),
+                     priv->damage,
+                     None, None);
+
+  if (priv->damage_region == NULL)
+    return G_SOURCE_REMOVE;
+
+  /* update each damaged rectangle; when texture-from-pixmap is not
+   * available, Cogl will only fetch these areas of the pixmap...
+   */
+  n_rects = cairo_region_num_rectangles (priv->damage_region);
+  for (i = 0; i < n_rects; i++)
+    {
+      cairo_rectangle_int_t rect;
+
+      cairo_region_get_rectangle (priv->damage_region, i, &rect);
+      g_signal_emit (texture, signals[UPDATE_AREA], 0,
+                     rect.x, rect.y,
+                     rect.width, rect.height);
+    }
+
+  /* ... but we queue a single clipped redraw */
+  cairo_region_get_extents (priv->damage_region, &extents);
+
+  cairo_region_destroy (priv->damage_region);
+  priv->damage_region = NULL;
+
+  if (extents.width > 0 && extents.height > 0)
+    g_signal_emit (texture, signals[QUEUE_DAMAGE_REDRAW], 0,
+                   extents.x, extents.y,
+                   extents.width, extents.height);
+
+  return G_SOURCE_REMOVE;
+}
+
 static void
 process_damage_event (ClutterX11TexturePixmap *texture,
                       XDamageNotifyEvent *damage_event)
 {
-  /* Cogl will deal with updating the texture and subtracting from the
-     damage region so we only need to queue a redraw */
-  g_signal_emit (texture, signals[QUEUE_DAMAGE_REDRAW],
-                 0,
-                 damage_event->area.x,
-                 damage_event->area.y,
-                 damage_event->area.width,
-                 damage_event->area.height);
+  ClutterX11TexturePixmapPrivate *priv = texture->priv;
+  cairo_rectangle_int_t rect;
+
+  /* we accumulate the damage until the next frame, so that we can
+   * subtract it, and queue a redraw, only once regardless of the
+   * number of XDamageNotify events we receive
+   */
+  rect.x = damage_event->area.x;
+  rect.y = damage_event->area.y;
+  rect.width = damage_event->area.width;
+  rect.height = damage_event->area.height;
+
+  if (priv->damage_region == NULL)
+    priv->damage_region = cairo_region_create_rectangle (&rect);
+  else
+    cairo_region_union_rectangle (priv->damage_region, &rect);
+
+  if (priv->damage_flush_id == 0)
+    priv->damage_flush_id =
+      clutter_threads_add_repaint_func_full (CLUTTER_REPAINT_FLAGS_PRE_PAINT |
+                                             CLUTTER_REPAINT_FLAGS_QUEUE_REDRAW_ON_ADD,
+                                             flush_damage,
+                                             texture,
+                                             NULL);
 }
 
 static ClutterX11FilterReturn
@@ -246,32 +317,6 @@ on_x_event_filter_too (XEvent *xev, ClutterEvent *cev, gpointer data)
   return CLUTTER_X11_FILTER_CONTINUE;
 }
 
-static void
-update_pixmap_damage_object (ClutterX11TexturePixmap *texture)
-{
-  ClutterX11TexturePixmapPrivate *priv = texture->priv;
-  CoglHandle cogl_texture;
-
-  /* If we already have a CoglTexturePixmapX11 then update its
-     damage object */
-  cogl_texture =
-    clutter_texture_get_cogl_texture (CLUTTER_TEXTURE (texture));
-
-  if (cogl_texture && cogl_is_texture_pixmap_x11 (cogl_texture))
-    {
-      if (priv->damage)
-        {
-          const CoglTexturePixmapX11ReportLevel report_level =
-            COGL_TEXTURE_PIXMAP_X11_DAMAGE_BOUNDING_BOX;
-          cogl_texture_pixmap_x11_set_damage_object (cogl_texture,
-                                                     priv->damage,
-                                                     report_level);
-        }
-      else
-        cogl_texture_pixmap_x11_set_damage_object (cogl_texture, 0, 0);
-    }
-}
-
 static void
 create_damage_resources (ClutterX11TexturePixmap *texture)
 {
@@ -299,9 +344,9 @@ create_damage_resources (ClutterX11TexturePixmap *texture)
 
   if (priv->damage)
     {
-      clutter_x11_add_filter (on_x_event_filter, (gpointer)texture);
-
-      update_pixmap_damage_object (texture);
+      _clutter_x11_add_xid_filter (priv->damage,
+                                   on_x_event_filter,
+                                   (gpointer) texture);
     }
 }
 
@@ -316,15 +361,27 @@ free_damage_resources (ClutterX11TexturePixmap *texture)
 
   if (priv->damage)
     {
+      _clutter_x11_remove_xid_filter (priv->damage,
+                                      on_x_event_filter,
+                                      (gpointer) texture);
+
       clutter_x11_trap_x_errors ();
       XDamageDestroy (dpy, priv->damage);
       XSync (dpy, FALSE);
       clutter_x11_untrap_x_errors ();
       priv->damage = None;
+    }
 
-      clutter_x11_remove_filter (on_x_event_filter, (gpointer)texture);
+  if (priv->damage_flush_id != 0)
+    {
+      clutter_threads_remove_repaint_func (priv->damage_flush_id);
+      priv->damage_flush_id = 0;
+    }
 
-      update_pixmap_damage_object (texture);
+  if (priv->damage_region != NULL)
+    {
+      cairo_region_destroy (priv->damage_region);
+      priv->damage_region = NULL;
     }
 }
 
@@ -414,7 +471,11 @@ clutter_x11_texture_pixmap_dispose (GObject *object)
 
   free_damage_resources (texture);
 
-  clutter_x11_remove_filter (on_x_event_filter_too, (gpointer)texture);
+  if (texture->priv->window != None)
+    _clutter_x11_remove_xid_filter (texture->priv->window,
+                                    on_x_event_filter_too,
+                                    (gpointer) texture);
+
   clutter_x11_texture_pixmap_set_pixmap (texture, None);
 
   G_OBJECT_CLASS (clutter_x11_texture_pixmap_parent_class)->dispose (object);
@@ -652,6 +713,13 @@ clutter_x11_texture_pixmap_class_init (ClutterX11TexturePixmapClass *klass)
    * The ::update-area signal is emitted to ask the texture to update its
    * content from its source pixmap.
    *
+   * The signal is emitted when clutter_x11_texture_pixmap_update_area()
+   * is called and, if #ClutterX11TexturePixmap:automatic-updates is
+   * enabled, for the damage reported by the X server. The damage is
+   * accumulated between frames, and the signal is emitted once for each
+   * rectangle of the accumulated region just before the next frame is
+   * painted, instead of once for each damage event.
+   *
    * Since: 0.8
    */
   signals[UPDATE_AREA] =
@@ -682,6 +750,10 @@ clutter_x11_texture_pixmap_class_init (ClutterX11TexturePixmapClass *klass)
    * clutter_x11_texture_pixmap_update_area). This usually means a
    * redraw needs to be queued for the actor.
    *
+   * Automatic damage updates are accumulated until the next frame, so
+   * this signal is emitted at most once per frame with the extents of
+   * all the damaged areas.
+   *
    * The default handler will queue a clipped redraw in response to
    * the damage, using the assumption that the pixmap is being painted
    * to a rectangle covering the transformed allocation of the actor.
@@ -909,7 +981,6 @@ clutter_x11_texture_pixmap_set_pixmap (ClutterX11TexturePixmap *texture,
           clutter_texture_set_cogl_texture (CLUTTER_TEXTURE (texture),
                                             COGL_TEXTURE (texture_pixmap));
           cogl_object_unref (texture_pixmap);
-          update_pixmap_damage_object (texture);
         }
       else
         {
@@ -970,7 +1041,9 @@ clutter_x11_texture_pixmap_set_window (ClutterX11TexturePixmap *texture,
 
   if (priv->window)
     {
-      clutter_x11_remove_filter (on_x_event_filter_too, (gpointer)texture);
+      _clutter_x11_remove_xid_filter (priv->window,
+                                      on_x_event_filter_too,
+                                      (gpointer) texture);
       clutter_x11_trap_x_errors ();
       XCompositeUnredirectWindow(clutter_x11_get_default_display (),
                                   priv->window,
@@ -1013,7 +1086,9 @@ clutter_x11_texture_pixmap_set_window (ClutterX11TexturePixmap *texture,
 
   XSelectInput (dpy, priv->window,
                 attr.your_event_mask | StructureNotifyMask);
-  clutter_x11_add_filter (on_x_event_filter_too, (gpointer)texture);
+  _clutter_x11_add_xid_filter (priv->window,
+                               on_x_event_filter_too,
+                               (gpointer) texture);
 
   g_object_ref (texture);
   g_object_notify (G_OBJECT (texture), "window");
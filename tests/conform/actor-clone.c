@@ -0,0 +1,155 @@
+#include <math.h>
+#include <clutter/clutter.h>
+
+typedef struct _FooActor      FooActor;
+typedef struct _FooActorClass FooActorClass;
+
+struct _FooActorClass
+{
+  ClutterActorClass parent_class;
+};
+
+struct _FooActor
+{
+  ClutterActor parent;
+
+  int clone_paint_count;
+};
+
+GType foo_actor_get_type (void) G_GNUC_CONST;
+
+G_DEFINE_TYPE (FooActor, foo_actor, CLUTTER_TYPE_ACTOR);
+
+static void
+foo_actor_paint (ClutterActor *actor)
+{
+  FooActor *foo_actor = (FooActor *) actor;
+
+  /* we cannot use the ::paint signal, as connecting a handler to it
+   * makes the paint volume of the source unknown, and the clones
+   * would then always paint their source directly
+   */
+  if (clutter_actor_is_in_clone_paint (actor))
+    foo_actor->clone_paint_count++;
+
+  CLUTTER_ACTOR_CLASS (foo_actor_parent_class)->paint (actor);
+}
+
+static void
+foo_actor_class_init (FooActorClass *klass)
+{
+  ClutterActorClass *actor_class = (ClutterActorClass *) klass;
+
+  actor_class->paint = foo_actor_paint;
+}
+
+static void
+foo_actor_init (FooActor *self)
+{
+}
+
+static guint32
+get_pixel (const guchar *pixels,
+           int           stride,
+           int           x,
+           int           y)
+{
+  const guchar *p = pixels + (y * stride) + (x * 4);
+
+  return (((guint32) p[0] << 16) |
+          ((guint32) p[1] << 8) |
+          p[2]);
+}
+
+static void
+verify_paint (ClutterActor *stage,
+              FooActor     *source,
+              guint32       expected_color,
+              int           expected_clone_paint_count)
+{
+  ClutterActorBox box;
+  guchar *pixels;
+  int stride;
+
+  /* this also runs any pending relayout */
+  clutter_actor_get_allocation_box (stage, &box);
+  stride = (int) ceilf (box.x2 - box.x1) * 4;
+
+  source->clone_paint_count = 0;
+
+  /* this forces a full, unclipped, paint of the stage */
+  pixels = clutter_stage_read_pixels (CLUTTER_STAGE (stage), 0, 0, -1, -1);
+  g_assert (pixels != NULL);
+
+  /* source */
+  g_assert_cmpint (get_pixel (pixels, stride, 25, 25), ==, expected_color);
+  /* cached clones */
+  g_assert_cmpint (get_pixel (pixels, stride, 125, 25), ==, expected_color);
+  g_assert_cmpint (get_pixel (pixels, stride, 225, 25), ==, expected_color);
+  /* scaled up clone, painting its source directly */
+  g_assert_cmpint (get_pixel (pixels, stride, 350, 50), ==, expected_color);
+
+  g_assert_cmpint (source->clone_paint_count, ==, expected_clone_paint_count);
+
+  g_free (pixels);
+}
+
+static ClutterActor *
+make_clone (ClutterActor *source,
+            gfloat        x,
+            gfloat        scale)
+{
+  ClutterActor *clone = clutter_clone_new (source);
+
+  clutter_clone_set_cache_paint (CLUTTER_CLONE (clone), TRUE);
+  g_assert (clutter_clone_get_cache_paint (CLUTTER_CLONE (clone)));
+
+  clutter_actor_set_x (clone, x);
+  clutter_actor_set_scale (clone, scale, scale);
+
+  return clone;
+}
+
+static void
+actor_clone_cache_paint (void)
+{
+  ClutterActor *stage, *source;
+
+  if (clutter_test_skip_without_rendering ())
+    return;
+
+  stage = clutter_test_get_stage ();
+
+  source = g_object_new (foo_actor_get_type (), NULL);
+  clutter_actor_set_background_color (source, CLUTTER_COLOR_Red);
+  clutter_actor_set_size (source, 50, 50);
+  clutter_actor_add_child (stage, source);
+
+  clutter_actor_add_child (stage, make_clone (source, 100, 1.0));
+  clutter_actor_add_child (stage, make_clone (source, 200, 1.0));
+  clutter_actor_add_child (stage, make_clone (source, 300, 2.0));
+
+  clutter_actor_show (stage);
+
+  /* the two cached clones share a single paint of the source, and the
+   * scaled up clone paints the source on its own
+   */
+  verify_paint (stage, (FooActor *) source, 0xff0000, 2);
+
+  /* nothing changed in the source, so the cached clones must reuse the
+   * contents of the cache, and only the scaled up clone paints it
+   */
+  verify_paint (stage, (FooActor *) source, 0xff0000, 1);
+
+  /* changing the source must invalidate the cache */
+  clutter_actor_set_background_color (source, CLUTTER_COLOR_Blue);
+  verify_paint (stage, (FooActor *) source, 0x0000ff, 2);
+
+  /* moving a cached clone does not affect its source */
+  clutter_actor_set_x (clutter_actor_get_child_at_index (stage, 1), 110);
+  verify_paint (stage, (FooActor *) source, 0x0000ff, 1);
+}
+
+CLUTTER_TEST_SUITE (
+  CLUTTER_TEST_UNIT ("/actor/clone/cache-paint", actor_clone_cache_paint)
+)
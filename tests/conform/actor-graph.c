@@ -1,3 +1,4 @@
+#include <math.h>
 #include <clutter/clutter.h>
 
 static void
@@ -537,6 +538,390 @@ actor_contains (void)
                        expected_results[x * 10 + y]);
 }
 
+static void
+check_children_order (ClutterActor *actor)
+{
+  ClutterActorIter iter;
+  ClutterActor *child;
+  float last_z = -G_MAXFLOAT;
+  int i = 0;
+
+  clutter_actor_iter_init (&iter, actor);
+  while (clutter_actor_iter_next (&iter, &child))
+    {
+      g_assert (clutter_actor_get_child_at_index (actor, i) == child);
+      g_assert_cmpfloat (clutter_actor_get_z_position (child), >=, last_z);
+
+      last_z = clutter_actor_get_z_position (child);
+      i += 1;
+    }
+
+  g_assert_cmpint (i, ==, clutter_actor_get_n_children (actor));
+  g_assert (clutter_actor_get_child_at_index (actor, i) == NULL);
+
+  i -= 1;
+  clutter_actor_iter_init (&iter, actor);
+  while (clutter_actor_iter_prev (&iter, &child))
+    {
+      g_assert (clutter_actor_get_child_at_index (actor, i) == child);
+      i -= 1;
+    }
+
+  g_assert_cmpint (i, ==, -1);
+}
+
+static void
+actor_many_children (void)
+{
+  ClutterActor *actor = clutter_actor_new ();
+  ClutterActorIter iter;
+  ClutterActor *child;
+  int i;
+
+  g_object_ref_sink (actor);
+
+  /* enough children to make the actor switch to indexed storage */
+  for (i = 0; i < 200; i++)
+    {
+      child = clutter_actor_new ();
+      clutter_actor_set_z_position (child, i % 7);
+      clutter_actor_add_child (actor, child);
+    }
+
+  g_assert_cmpint (clutter_actor_get_n_children (actor), ==, 200);
+  check_children_order (actor);
+
+  /* move a few children around */
+  child = clutter_actor_get_child_at_index (actor, 10);
+  clutter_actor_set_child_at_index (actor, child, 150);
+  g_assert (clutter_actor_get_child_at_index (actor, 150) == child);
+
+  child = clutter_actor_get_child_at_index (actor, 100);
+  clutter_actor_set_child_above_sibling (actor, child, NULL);
+  g_assert (clutter_actor_get_last_child (actor) == child);
+  g_assert (clutter_actor_get_child_at_index (actor, 199) == child);
+
+  child = clutter_actor_get_child_at_index (actor, 199);
+  clutter_actor_set_child_below_sibling (actor, child, NULL);
+  g_assert (clutter_actor_get_first_child (actor) == child);
+  g_assert (clutter_actor_get_child_at_index (actor, 0) == child);
+
+  child = clutter_actor_new ();
+  clutter_actor_insert_child_at_index (actor, child, 42);
+  g_assert (clutter_actor_get_child_at_index (actor, 42) == child);
+
+  /* remove every other child, going below the threshold */
+  i = 0;
+  clutter_actor_iter_init (&iter, actor);
+  while (clutter_actor_iter_next (&iter, &child))
+    {
+      if (i++ % 2 == 0)
+        clutter_actor_iter_destroy (&iter);
+    }
+
+  g_assert_cmpint (clutter_actor_get_n_children (actor), ==, 100);
+
+  while (clutter_actor_get_n_children (actor) > 10)
+    {
+      clutter_actor_destroy (clutter_actor_get_child_at_index (actor, 3));
+
+      for (i = 0; i < clutter_actor_get_n_children (actor); i++)
+        g_assert (clutter_actor_get_child_at_index (actor, i) != NULL);
+    }
+
+  /* and back above it, depth-sorted */
+  for (i = 0; i < 100; i++)
+    {
+      child = clutter_actor_new ();
+      clutter_actor_set_z_position (child, (i * 13) % 5);
+      clutter_actor_add_child (actor, child);
+    }
+
+  g_assert_cmpint (clutter_actor_get_n_children (actor), ==, 110);
+
+  clutter_actor_destroy_all_children (actor);
+  g_assert_cmpint (clutter_actor_get_n_children (actor), ==, 0);
+  g_assert (clutter_actor_get_child_at_index (actor, 0) == NULL);
+
+  clutter_actor_destroy (actor);
+  g_object_unref (actor);
+}
+
+/* the index at which clutter_actor_add_child() inserts a child at the
+ * given depth: before the first child with a bigger depth
+ */
+static int
+get_depth_insertion_index (ClutterActor *actor,
+                           float         depth)
+{
+  ClutterActor *child;
+  int i = 0;
+
+  for (child = clutter_actor_get_first_child (actor);
+       child != NULL;
+       child = clutter_actor_get_next_sibling (child))
+    {
+      if (clutter_actor_get_z_position (child) > depth)
+        break;
+
+      i += 1;
+    }
+
+  return i;
+}
+
+static void
+add_child_at_depth (ClutterActor *actor,
+                    float         depth)
+{
+  ClutterActor *child = clutter_actor_new ();
+  int index_;
+
+  clutter_actor_set_z_position (child, depth);
+
+  index_ = get_depth_insertion_index (actor, depth);
+  clutter_actor_add_child (actor, child);
+
+  g_assert (clutter_actor_get_child_at_index (actor, index_) == child);
+}
+
+static void
+actor_unsorted_depth (void)
+{
+  ClutterActor *actor = clutter_actor_new ();
+  ClutterActor *child;
+  int i;
+
+  g_object_ref_sink (actor);
+
+  /* enough children to make the actor switch to indexed storage */
+  for (i = 0; i < 100; i++)
+    add_child_at_depth (actor, 0);
+
+  /* changing the depth of a child does not sort the children again,
+   * so they are now [0, 5, 0, 0, ...]
+   */
+  child = clutter_actor_get_child_at_index (actor, 1);
+  clutter_actor_set_z_position (child, 5);
+
+  add_child_at_depth (actor, 0);
+  g_assert (clutter_actor_get_child_at_index (actor, 1) != child);
+  g_assert (clutter_actor_get_child_at_index (actor, 2) == child);
+
+  add_child_at_depth (actor, 3);
+  add_child_at_depth (actor, 5);
+  add_child_at_depth (actor, -1);
+
+  /* children inserted at an explicit index can also break the order */
+  child = clutter_actor_new ();
+  clutter_actor_set_z_position (child, 10);
+  clutter_actor_insert_child_at_index (actor, child, 50);
+
+  add_child_at_depth (actor, 7);
+  add_child_at_depth (actor, 0);
+
+  /* once the order is restored, the insertion keeps working */
+  clutter_actor_destroy (child);
+  for (child = clutter_actor_get_first_child (actor);
+       child != NULL;
+       child = clutter_actor_get_next_sibling (child))
+    clutter_actor_set_z_position (child, 0);
+
+  add_child_at_depth (actor, 0);
+  add_child_at_depth (actor, 1);
+  add_child_at_depth (actor, 0);
+  g_assert (clutter_actor_get_z_position (clutter_actor_get_last_child (actor)) == 1);
+
+  clutter_actor_destroy (actor);
+  g_object_unref (actor);
+}
+
+static void
+check_children_in_rect (ClutterActor *actor,
+                        int           n_columns)
+{
+  ClutterRect rect = CLUTTER_RECT_INIT (5, 5, 30, 10);
+  GList *children, *l;
+  int i;
+
+  /* the rectangle intersects the first two columns of the first row */
+  children = clutter_actor_get_children_in_rect (actor, &rect);
+  g_assert_cmpint (g_list_length (children), ==, 2);
+  g_assert (children->data == clutter_actor_get_child_at_index (actor, 0));
+  g_assert (children->next->data == clutter_actor_get_child_at_index (actor, 1));
+  g_list_free (children);
+
+  /* the whole second column, in paint order */
+  clutter_rect_init (&rect, 25, 0, 2, 10000);
+  children = clutter_actor_get_children_in_rect (actor, &rect);
+  g_assert_cmpint (g_list_length (children), ==,
+                   clutter_actor_get_n_children (actor) / n_columns);
+
+  for (l = children, i = 1; l != NULL; l = l->next, i += n_columns)
+    g_assert (l->data == clutter_actor_get_child_at_index (actor, i));
+
+  g_list_free (children);
+
+  /* hidden children are skipped */
+  clutter_actor_hide (clutter_actor_get_child_at_index (actor, 1));
+  clutter_rect_init (&rect, 0, 0, 35, 5);
+  children = clutter_actor_get_children_in_rect (actor, &rect);
+  g_assert_cmpint (g_list_length (children), ==, 1);
+  g_assert (children->data == clutter_actor_get_child_at_index (actor, 0));
+  g_list_free (children);
+
+  /* the gap between the children */
+  clutter_rect_init (&rect, 12, 12, 6, 6);
+  children = clutter_actor_get_children_in_rect (actor, &rect);
+  g_assert (children == NULL);
+}
+
+static void
+actor_children_in_rect (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  int sizes[] = { 8, 200 };
+  ClutterActor *text;
+  ClutterRect rect;
+  GList *children;
+  int i, j;
+
+  /* a grid of 10x10 pixels children, four per row, 20 pixels apart;
+   * both below and above the number of children that makes the actor
+   * use a spatial index
+   */
+  for (i = 0; i < G_N_ELEMENTS (sizes); i++)
+    {
+      ClutterActor *actor = clutter_actor_new ();
+
+      for (j = 0; j < sizes[i]; j++)
+        {
+          ClutterActor *child = clutter_actor_new ();
+
+          clutter_actor_set_background_color (child, CLUTTER_COLOR_Red);
+          clutter_actor_set_position (child, (j % 4) * 20, (j / 4) * 20);
+          clutter_actor_set_size (child, 10, 10);
+          clutter_actor_add_child (actor, child);
+        }
+
+      clutter_actor_add_child (stage, actor);
+      clutter_actor_allocate_preferred_size (actor, CLUTTER_ALLOCATION_NONE);
+
+      check_children_in_rect (actor, 4);
+
+      /* moving a child updates the results */
+      clutter_actor_set_position (clutter_actor_get_child_at_index (actor, 0), 500, 500);
+      clutter_actor_allocate_preferred_size (actor, CLUTTER_ALLOCATION_NONE);
+
+      clutter_rect_init (&rect, 495, 495, 10, 10);
+      children = clutter_actor_get_children_in_rect (actor, &rect);
+      g_assert_cmpint (g_list_length (children), ==, 1);
+      g_assert (children->data == clutter_actor_get_child_at_index (actor, 0));
+      g_list_free (children);
+
+      /* a text actor only paints its ink rectangle, but it is picked
+       * using its allocation, so the empty area of the allocation is
+       * still part of the child
+       */
+      text = clutter_text_new_with_text ("Sans 10px", "x");
+      clutter_actor_set_position (text, 1000, 0);
+      clutter_actor_set_size (text, 100, 100);
+      clutter_actor_add_child (actor, text);
+      clutter_actor_allocate_preferred_size (actor, CLUTTER_ALLOCATION_NONE);
+
+      clutter_rect_init (&rect, 1080, 80, 10, 10);
+      children = clutter_actor_get_children_in_rect (actor, &rect);
+      g_assert_cmpint (g_list_length (children), ==, 1);
+      g_assert (children->data == text);
+      g_list_free (children);
+
+      clutter_actor_destroy (actor);
+    }
+}
+
+static void
+assert_stage_point (ClutterActor *actor,
+                    gfloat        x,
+                    gfloat        y)
+{
+  ClutterActor *stage = clutter_actor_get_stage (actor);
+  ClutterVertex point = { 0, 0, 0 };
+  ClutterVertex vertex;
+
+  clutter_actor_apply_relative_transform_to_point (actor, stage,
+                                                   &point,
+                                                   &vertex);
+
+  g_assert_cmpfloat (fabsf (vertex.x - x), <, 0.001f);
+  g_assert_cmpfloat (fabsf (vertex.y - y), <, 0.001f);
+}
+
+static void
+assert_actor_point (ClutterActor *actor,
+                    gfloat        stage_x,
+                    gfloat        stage_y,
+                    gfloat        x,
+                    gfloat        y)
+{
+  gfloat actor_x, actor_y;
+
+  g_assert (clutter_actor_transform_stage_point (actor,
+                                                 stage_x, stage_y,
+                                                 &actor_x, &actor_y));
+
+  g_assert_cmpfloat (fabsf (actor_x - x), <, 0.01f);
+  g_assert_cmpfloat (fabsf (actor_y - y), <, 0.01f);
+}
+
+static void
+actor_stage_transform (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterActor *parent, *child;
+  ClutterMatrix transform;
+
+  parent = clutter_actor_new ();
+  clutter_actor_set_translation (parent, 10, 20, 0);
+  clutter_actor_add_child (stage, parent);
+
+  child = clutter_actor_new ();
+  clutter_actor_set_size (child, 10, 10);
+  clutter_actor_set_translation (child, 5, 5, 0);
+  clutter_actor_add_child (parent, child);
+
+  clutter_actor_show (stage);
+
+  /* the second query uses the cached transformation */
+  assert_stage_point (child, 15, 25);
+  assert_stage_point (child, 15, 25);
+
+  /* changing the parent must invalidate the children */
+  clutter_actor_set_translation (parent, 100, 0, 0);
+  assert_stage_point (child, 105, 5);
+
+  clutter_matrix_init_identity (&transform);
+  cogl_matrix_scale (&transform, 2, 2, 1);
+  clutter_actor_set_child_transform (parent, &transform);
+  assert_stage_point (child, 110, 10);
+
+  /* the stage coordinates are mapped back to the child; the second
+   * query uses the cached inverse transformation
+   */
+  assert_actor_point (child, 120, 20, 5, 5);
+  assert_actor_point (child, 120, 20, 5, 5);
+
+  /* reparenting changes the chain of transformations */
+  g_object_ref (child);
+  clutter_actor_remove_child (parent, child);
+  clutter_actor_add_child (stage, child);
+  g_object_unref (child);
+  assert_stage_point (child, 5, 5);
+  assert_actor_point (child, 10, 10, 5, 5);
+
+  clutter_actor_destroy (parent);
+  clutter_actor_destroy (child);
+}
+
 CLUTTER_TEST_SUITE (
   CLUTTER_TEST_UNIT ("/actor/graph/add-child", actor_add_child)
   CLUTTER_TEST_UNIT ("/actor/graph/insert-child", actor_insert_child)
@@ -547,4 +932,8 @@ CLUTTER_TEST_SUITE (
   CLUTTER_TEST_UNIT ("/actor/graph/remove-all", actor_remove_all)
   CLUTTER_TEST_UNIT ("/actor/graph/container-signals", actor_container_signals)
   CLUTTER_TEST_UNIT ("/actor/graph/contains", actor_contains)
+  CLUTTER_TEST_UNIT ("/actor/graph/many-children", actor_many_children)
+  CLUTTER_TEST_UNIT ("/actor/graph/unsorted-depth", actor_unsorted_depth)
+  CLUTTER_TEST_UNIT ("/actor/graph/children-in-rect", actor_children_in_rect)
+  CLUTTER_TEST_UNIT ("/actor/graph/stage-transform", actor_stage_transform)
 )
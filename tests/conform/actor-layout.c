@@ -8,6 +8,9 @@ actor_basic_layout (void)
   ClutterActor *flower[3];
   ClutterPoint p;
 
+  if (clutter_test_skip_without_rendering ())
+    return;
+
   vase = clutter_actor_new ();
   clutter_actor_set_name (vase, "Vase");
   clutter_actor_set_layout_manager (vase, clutter_flow_layout_new (CLUTTER_FLOW_HORIZONTAL));
@@ -49,6 +52,9 @@ actor_margin_layout (void)
   ClutterActor *flower[3];
   ClutterPoint p;
 
+  if (clutter_test_skip_without_rendering ())
+    return;
+
   vase = clutter_actor_new ();
   clutter_actor_set_name (vase, "Vase");
   clutter_actor_set_layout_manager (vase, clutter_box_layout_new ());
@@ -86,7 +92,177 @@ actor_margin_layout (void)
   clutter_test_assert_actor_at_point (stage, &p, flower[2]);
 }
 
+static void
+on_queue_relayout (ClutterActor *actor,
+                   gint         *n_relayouts)
+{
+  *n_relayouts += 1;
+}
+
+static void
+actor_isolate_layout (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterActor *vase, *pot;
+  ClutterActor *flower;
+  ClutterActorBox box;
+  gint n_relayouts = 0;
+
+  vase = clutter_actor_new ();
+  clutter_actor_set_name (vase, "Vase");
+  clutter_actor_set_layout_manager (vase, clutter_box_layout_new ());
+  clutter_actor_add_child (stage, vase);
+
+  pot = clutter_actor_new ();
+  clutter_actor_set_name (pot, "Pot");
+  clutter_actor_set_layout_manager (pot, clutter_box_layout_new ());
+  clutter_actor_set_size (pot, 200, 200);
+  clutter_actor_add_child (vase, pot);
+
+  flower = clutter_actor_new ();
+  clutter_actor_set_name (flower, "Flower");
+  clutter_actor_set_size (flower, 100, 100);
+  clutter_actor_add_child (pot, flower);
+
+  clutter_actor_get_allocation_box (flower, &box);
+  g_assert_cmpfloat (clutter_actor_box_get_width (&box), ==, 100);
+
+  g_signal_connect (vase, "queue-relayout",
+                    G_CALLBACK (on_queue_relayout),
+                    &n_relayouts);
+
+  /* without isolation, the relayout reaches the vase */
+  clutter_actor_set_width (flower, 120);
+  clutter_actor_get_allocation_box (flower, &box);
+  g_assert_cmpfloat (clutter_actor_box_get_width (&box), ==, 120);
+  g_assert_cmpint (n_relayouts, ==, 1);
+
+  clutter_actor_set_isolate_layout (pot, TRUE);
+  g_assert (clutter_actor_get_isolate_layout (pot));
+
+  /* with isolation, it stops at the pot */
+  clutter_actor_set_width (flower, 140);
+  clutter_actor_get_allocation_box (flower, &box);
+  g_assert_cmpfloat (clutter_actor_box_get_width (&box), ==, 140);
+  g_assert_cmpint (n_relayouts, ==, 1);
+
+  clutter_actor_get_allocation_box (pot, &box);
+  g_assert_cmpfloat (clutter_actor_box_get_width (&box), ==, 200);
+
+  /* changing the size of the pot itself still goes through the vase */
+  clutter_actor_set_width (pot, 300);
+  clutter_actor_get_allocation_box (pot, &box);
+  g_assert_cmpfloat (clutter_actor_box_get_width (&box), ==, 300);
+  g_assert_cmpint (n_relayouts, ==, 2);
+}
+
+static void
+assert_actor_origin (ClutterActor *actor,
+                     gfloat        x,
+                     gfloat        y)
+{
+  ClutterActorBox box;
+
+  /* querying the parent forces the relayout of its children */
+  clutter_actor_get_allocation_box (clutter_actor_get_parent (actor), &box);
+
+  clutter_actor_get_allocation_box (actor, &box);
+  g_assert_cmpfloat (box.x1, ==, x);
+  g_assert_cmpfloat (box.y1, ==, y);
+}
+
+static void
+on_allocation_changed (ClutterActor           *actor,
+                       const ClutterActorBox  *box,
+                       ClutterAllocationFlags  flags,
+                       gint                   *n_allocations)
+{
+  *n_allocations += 1;
+}
+
+static void
+actor_flow_layout_changes (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterLayoutManager *flow;
+  ClutterActor *vase;
+  ClutterActor *flower[8];
+  gint n_first_allocations = 0;
+  gint n_last_allocations = 0;
+  gint i;
+
+  flow = clutter_flow_layout_new (CLUTTER_FLOW_HORIZONTAL);
+  clutter_flow_layout_set_snap_to_grid (CLUTTER_FLOW_LAYOUT (flow), FALSE);
+
+  vase = clutter_actor_new ();
+  clutter_actor_set_name (vase, "Vase");
+  clutter_actor_set_layout_manager (vase, flow);
+  clutter_actor_set_width (vase, 300);
+  clutter_actor_add_child (stage, vase);
+
+  for (i = 0; i < 7; i++)
+    {
+      flower[i] = clutter_actor_new ();
+      clutter_actor_set_size (flower[i], 100, 100);
+      clutter_actor_add_child (vase, flower[i]);
+    }
+
+  /* three flowers per line */
+  assert_actor_origin (flower[2], 200, 0);
+  assert_actor_origin (flower[3], 0, 100);
+  assert_actor_origin (flower[6], 0, 200);
+
+  /* changing a flower leaves the lines before it alone */
+  g_signal_connect (flower[0], "allocation-changed",
+                    G_CALLBACK (on_allocation_changed),
+                    &n_first_allocations);
+  g_signal_connect (flower[6], "allocation-changed",
+                    G_CALLBACK (on_allocation_changed),
+                    &n_last_allocations);
+
+  clutter_actor_set_width (flower[5], 150);
+  assert_actor_origin (flower[5], 0, 200);
+  assert_actor_origin (flower[6], 150, 200);
+  g_assert_cmpint (n_first_allocations, ==, 0);
+  g_assert_cmpint (n_last_allocations, ==, 1);
+
+  clutter_actor_set_width (flower[5], 100);
+  assert_actor_origin (flower[5], 200, 100);
+  assert_actor_origin (flower[6], 0, 200);
+  g_assert_cmpint (n_first_allocations, ==, 0);
+  g_assert_cmpint (n_last_allocations, ==, 2);
+
+  /* a larger flower pushes the following ones to the next lines */
+  clutter_actor_set_width (flower[1], 150);
+  assert_actor_origin (flower[0], 0, 0);
+  assert_actor_origin (flower[2], 0, 100);
+  assert_actor_origin (flower[5], 0, 200);
+  assert_actor_origin (flower[6], 100, 200);
+
+  /* adding a flower at the end only fills the last line */
+  flower[7] = clutter_actor_new ();
+  clutter_actor_set_size (flower[7], 100, 100);
+  clutter_actor_add_child (vase, flower[7]);
+  assert_actor_origin (flower[4], 200, 100);
+  assert_actor_origin (flower[7], 200, 200);
+
+  /* removing the first flower pulls the others back */
+  clutter_actor_destroy (flower[0]);
+  assert_actor_origin (flower[1], 0, 0);
+  assert_actor_origin (flower[2], 150, 0);
+  assert_actor_origin (flower[3], 0, 100);
+  assert_actor_origin (flower[7], 100, 200);
+
+  /* hiding a flower reflows the lines after it */
+  clutter_actor_hide (flower[4]);
+  assert_actor_origin (flower[5], 100, 100);
+  assert_actor_origin (flower[6], 200, 100);
+  assert_actor_origin (flower[7], 0, 200);
+}
+
 CLUTTER_TEST_SUITE (
   CLUTTER_TEST_UNIT ("/actor/layout/basic", actor_basic_layout)
   CLUTTER_TEST_UNIT ("/actor/layout/margin", actor_margin_layout)
+  CLUTTER_TEST_UNIT ("/actor/layout/isolate", actor_isolate_layout)
+  CLUTTER_TEST_UNIT ("/actor/layout/flow-changes", actor_flow_layout_changes)
 )
@@ -311,6 +311,9 @@ actor_offscreen_redirect (void)
 {
   Data data = { 0 };
 
+  if (clutter_test_skip_without_rendering ())
+    return;
+
   if (!cogl_features_available (COGL_FEATURE_OFFSCREEN))
     return;
 
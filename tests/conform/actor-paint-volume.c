@@ -0,0 +1,181 @@
+#include <clutter/clutter.h>
+
+static void
+check_paint_volume (ClutterActor *actor,
+                    float         x,
+                    float         y,
+                    float         width,
+                    float         height)
+{
+  const ClutterPaintVolume *volume;
+  ClutterVertex origin;
+
+  clutter_actor_allocate_preferred_size (actor, CLUTTER_ALLOCATION_NONE);
+
+  volume = clutter_actor_get_paint_volume (actor);
+  g_assert (volume != NULL);
+
+  clutter_paint_volume_get_origin (volume, &origin);
+
+  if (g_test_verbose ())
+    g_print ("paint volume: origin (%.2f, %.2f), size %.2f x %.2f\n",
+             origin.x, origin.y,
+             clutter_paint_volume_get_width (volume),
+             clutter_paint_volume_get_height (volume));
+
+  g_assert_cmpfloat (origin.x, ==, x);
+  g_assert_cmpfloat (origin.y, ==, y);
+  g_assert_cmpfloat (clutter_paint_volume_get_width (volume), ==, width);
+  g_assert_cmpfloat (clutter_paint_volume_get_height (volume), ==, height);
+}
+
+static ClutterActor *
+make_container (ClutterActor **children,
+                int            n_children)
+{
+  ClutterActor *container;
+  int i;
+
+  container = clutter_actor_new ();
+  clutter_actor_set_size (container, 1, 1);
+
+  for (i = 0; i < n_children; i++)
+    {
+      children[i] = clutter_actor_new ();
+      clutter_actor_set_background_color (children[i], CLUTTER_COLOR_Red);
+      clutter_actor_set_size (children[i], 10, 10);
+      clutter_actor_add_child (container, children[i]);
+    }
+
+  return container;
+}
+
+static void
+actor_paint_volume_children (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterActor *container, *children[3];
+
+  container = make_container (children, G_N_ELEMENTS (children));
+  clutter_actor_set_position (children[1], 50, 0);
+  clutter_actor_set_position (children[2], 100, 100);
+
+  clutter_actor_add_child (stage, container);
+  clutter_actor_show (stage);
+
+  check_paint_volume (container, 0, 0, 110, 110);
+
+  /* a child moving inside the volume shrinks it */
+  clutter_actor_set_position (children[2], 20, 20);
+  check_paint_volume (container, 0, 0, 60, 30);
+
+  /* a child moving outside the volume grows it */
+  clutter_actor_set_position (children[0], -10, -10);
+  check_paint_volume (container, -10, -10, 70, 40);
+
+  /* scaled children */
+  clutter_actor_set_scale (children[1], 2.0, 2.0);
+  check_paint_volume (container, -10, -10, 80, 40);
+
+  /* hidden children do not contribute */
+  clutter_actor_hide (children[1]);
+  check_paint_volume (container, -10, -10, 40, 40);
+
+  clutter_actor_destroy (children[0]);
+  check_paint_volume (container, 0, 0, 30, 30);
+
+  clutter_actor_destroy (container);
+}
+
+static void
+actor_paint_volume_nested (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterActor *container, *inner, *child;
+
+  container = clutter_actor_new ();
+  inner = clutter_actor_new ();
+  child = clutter_actor_new ();
+
+  clutter_actor_set_size (container, 1, 1);
+  clutter_actor_set_size (inner, 1, 1);
+  clutter_actor_set_position (inner, 10, 10);
+  clutter_actor_set_size (child, 10, 10);
+
+  clutter_actor_add_child (inner, child);
+  clutter_actor_add_child (container, inner);
+  clutter_actor_add_child (stage, container);
+  clutter_actor_show (stage);
+
+  check_paint_volume (container, 0, 0, 20, 20);
+
+  /* the second change does not need to notify the ancestors again,
+   * but their volumes must still be up to date
+   */
+  clutter_actor_set_position (child, 20, 0);
+  clutter_actor_set_position (child, 40, 0);
+  check_paint_volume (container, 0, 0, 60, 20);
+
+  /* querying the volume resets the notification */
+  clutter_actor_set_position (child, 0, 40);
+  check_paint_volume (container, 0, 0, 20, 60);
+
+  /* the ancestors are still notified if the inner container changes
+   * after its child
+   */
+  clutter_actor_set_position (child, 0, 0);
+  clutter_actor_set_position (inner, 30, 30);
+  check_paint_volume (container, 0, 0, 40, 40);
+
+  clutter_actor_destroy (container);
+}
+
+static void
+on_paint (ClutterActor *actor)
+{
+}
+
+static void
+actor_paint_volume_paint_handler (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterActor *container, *children[2];
+  gulong handler_id;
+
+  container = make_container (children, G_N_ELEMENTS (children));
+  clutter_actor_set_position (children[1], 50, 0);
+
+  clutter_actor_add_child (stage, container);
+  clutter_actor_show (stage);
+
+  check_paint_volume (container, 0, 0, 60, 10);
+
+  /* a handler of the paint signal makes the volume of the child, and
+   * of its parent, unknown; the parent notices as soon as the volume
+   * of the child is queried, for instance when culling it
+   */
+  handler_id = g_signal_connect (children[0], "paint",
+                                 G_CALLBACK (on_paint),
+                                 NULL);
+
+  g_assert (clutter_actor_get_paint_volume (children[0]) == NULL);
+  g_assert (clutter_actor_get_paint_volume (container) == NULL);
+
+  /* the union of the children is not cached while the handler is
+   * connected, so other children changing does not make it known
+   */
+  clutter_actor_set_position (children[1], 20, 0);
+  g_assert (clutter_actor_get_paint_volume (container) == NULL);
+
+  g_signal_handler_disconnect (children[0], handler_id);
+  clutter_actor_queue_redraw (children[0]);
+  check_paint_volume (container, 0, 0, 30, 10);
+
+  clutter_actor_destroy (container);
+}
+
+CLUTTER_TEST_SUITE (
+  CLUTTER_TEST_UNIT ("/actor/paint-volume/children", actor_paint_volume_children)
+  CLUTTER_TEST_UNIT ("/actor/paint-volume/nested", actor_paint_volume_nested)
+  CLUTTER_TEST_UNIT ("/actor/paint-volume/paint-handler", actor_paint_volume_paint_handler)
+)
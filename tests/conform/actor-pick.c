@@ -262,6 +262,9 @@ actor_pick (void)
   
   state.pass = TRUE;
 
+  if (clutter_test_skip_without_rendering ())
+    return;
+
   state.stage = clutter_test_get_stage ();
 
   state.actor_width = STAGE_WIDTH / ACTORS_X;
@@ -306,6 +309,94 @@ actor_pick (void)
   g_assert (state.pass);
 }
 
+typedef struct {
+  ClutterActor *stage;
+  ClutterActor *text;
+  ClutterActor *child_text;
+  gboolean pass;
+} PaddingState;
+
+static gboolean
+on_padding_idle (gpointer data)
+{
+  PaddingState *state = data;
+  ClutterActor *actor;
+
+  /* the ink rectangle of the text is in the top left corner of its
+   * allocation, so picking the bottom right corner must still return
+   * the text, even if it's outside of its paint volume
+   */
+  actor = clutter_stage_get_actor_at_pos (CLUTTER_STAGE (state->stage),
+                                          CLUTTER_PICK_REACTIVE,
+                                          240, 140);
+  if (g_test_verbose ())
+    g_print ("text: %p, picked: %p\n", state->text, actor);
+
+  if (actor != state->text)
+    state->pass = FALSE;
+
+  /* the same must happen if the paint volume of the parent is also
+   * made of the paint volume of the text
+   */
+  actor = clutter_stage_get_actor_at_pos (CLUTTER_STAGE (state->stage),
+                                          CLUTTER_PICK_REACTIVE,
+                                          240, 340);
+  if (g_test_verbose ())
+    g_print ("child text: %p, picked: %p\n", state->child_text, actor);
+
+  if (actor != state->child_text)
+    state->pass = FALSE;
+
+  clutter_main_quit ();
+
+  return G_SOURCE_REMOVE;
+}
+
+static ClutterActor *
+make_padded_text (void)
+{
+  ClutterActor *text;
+
+  text = clutter_text_new_with_text ("Sans 10px", "Hello");
+  clutter_actor_set_size (text, 200, 100);
+  clutter_actor_set_reactive (text, TRUE);
+
+  return text;
+}
+
+static void
+actor_pick_allocation (void)
+{
+  PaddingState state;
+  ClutterActor *container;
+
+  if (clutter_test_skip_without_rendering ())
+    return;
+
+  state.pass = TRUE;
+  state.stage = clutter_test_get_stage ();
+
+  state.text = make_padded_text ();
+  clutter_actor_set_position (state.text, 50, 50);
+  clutter_actor_add_child (state.stage, state.text);
+
+  container = clutter_actor_new ();
+  clutter_actor_set_position (container, 50, 250);
+  clutter_actor_add_child (state.stage, container);
+
+  state.child_text = make_padded_text ();
+  clutter_actor_add_child (container, state.child_text);
+
+  clutter_actor_show (state.stage);
+
+  clutter_threads_add_idle (on_padding_idle, &state);
+
+  clutter_main ();
+
+  g_assert (state.pass);
+}
+
 CLUTTER_TEST_SUITE (
   CLUTTER_TEST_UNIT ("/actor/pick", actor_pick)
+  CLUTTER_TEST_UNIT ("/actor/pick/allocation", actor_pick_allocation)
 )
@@ -248,6 +248,9 @@ actor_shader_effect (void)
   ClutterActor *rect;
   gboolean was_painted;
 
+  if (clutter_test_skip_without_rendering ())
+    return;
+
   if (!clutter_feature_available (CLUTTER_FEATURE_SHADERS_GLSL))
     return;
 
@@ -210,7 +210,132 @@ actor_fixed_size (void)
   g_object_unref (rect);
 }
 
+static void
+on_notify (GObject    *gobject,
+           GParamSpec *pspec,
+           int        *counter)
+{
+  *counter += 1;
+}
+
+static void
+on_queue_relayout (ClutterActor *actor,
+                   int          *counter)
+{
+  *counter += 1;
+}
+
+static void
+actor_bulk_update (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterActor *container, *actors[3];
+  ClutterRect geometries[3];
+  int n_notify_opacity = 0, n_notify_opacity_2 = 0, n_relayouts = 0;
+  int i;
+
+  container = clutter_actor_new ();
+  clutter_actor_add_child (stage, container);
+
+  for (i = 0; i < G_N_ELEMENTS (actors); i++)
+    {
+      actors[i] = clutter_actor_new ();
+      clutter_actor_add_child (container, actors[i]);
+    }
+
+  /* make sure that the relayout is not short-circuited */
+  clutter_actor_allocate_preferred_size (container, CLUTTER_ALLOCATION_NONE);
+
+  g_signal_connect (actors[0], "notify::opacity", G_CALLBACK (on_notify), &n_notify_opacity);
+  g_signal_connect (actors[2], "notify::opacity", G_CALLBACK (on_notify), &n_notify_opacity_2);
+  g_signal_connect (container, "queue-relayout", G_CALLBACK (on_queue_relayout), &n_relayouts);
+
+  clutter_stage_begin_update (CLUTTER_STAGE (stage));
+
+  clutter_actor_set_x (actors[0], 10);
+  clutter_actor_set_opacity (actors[0], 128);
+  clutter_actor_set_x (actors[0], 20);
+  clutter_actor_set_opacity (actors[0], 64);
+
+  /* updates can be nested */
+  clutter_stage_begin_update (CLUTTER_STAGE (stage));
+  clutter_actor_set_x (actors[1], 30);
+  clutter_actor_set_opacity (actors[0], 32);
+  clutter_stage_end_update (CLUTTER_STAGE (stage));
+
+  /* changes that only queue a redraw are coalesced as well */
+  clutter_actor_set_opacity (actors[2], 128);
+  clutter_actor_set_opacity (actors[2], 64);
+
+  g_assert_cmpint (n_notify_opacity, ==, 0);
+  g_assert_cmpint (n_notify_opacity_2, ==, 0);
+  g_assert_cmpint (n_relayouts, ==, 0);
+
+  clutter_stage_end_update (CLUTTER_STAGE (stage));
+
+  g_assert_cmpint (n_notify_opacity_2, ==, 1);
+
+  g_assert_cmpint (n_notify_opacity, ==, 1);
+  g_assert_cmpint (n_relayouts, ==, 1);
+  g_assert_cmpfloat (clutter_actor_get_x (actors[0]), ==, 20);
+  g_assert_cmpfloat (clutter_actor_get_x (actors[1]), ==, 30);
+  g_assert_cmpint (clutter_actor_get_opacity (actors[0]), ==, 32);
+
+  /* outside of an update, notifications are emitted immediately */
+  clutter_actor_set_opacity (actors[0], 255);
+  g_assert_cmpint (n_notify_opacity, ==, 2);
+
+  for (i = 0; i < G_N_ELEMENTS (actors); i++)
+    clutter_rect_init (&geometries[i], i * 10, i * 20, 100, 50 + i);
+
+  clutter_actor_set_geometry_bulk (actors, geometries, G_N_ELEMENTS (actors));
+
+  for (i = 0; i < G_N_ELEMENTS (actors); i++)
+    {
+      gfloat x, y, width, height;
+
+      clutter_actor_get_position (actors[i], &x, &y);
+      clutter_actor_get_size (actors[i], &width, &height);
+
+      g_assert_cmpfloat (x, ==, i * 10);
+      g_assert_cmpfloat (y, ==, i * 20);
+      g_assert_cmpfloat (width, ==, 100);
+      g_assert_cmpfloat (height, ==, 50 + i);
+    }
+
+  clutter_actor_destroy (container);
+}
+
+static void
+actor_bulk_update_dispose (void)
+{
+  ClutterActor *stage, *actor;
+  int n_notify_opacity = 0;
+
+  stage = clutter_stage_new ();
+  actor = clutter_actor_new ();
+  g_object_ref_sink (actor);
+  clutter_actor_add_child (stage, actor);
+
+  clutter_stage_begin_update (CLUTTER_STAGE (stage));
+  clutter_actor_set_x (actor, 10);
+  clutter_actor_set_opacity (actor, 128);
+
+  /* destroying the stage drops the update left open, and the
+   * notifications of the actor are not frozen any more
+   */
+  clutter_actor_destroy (stage);
+
+  g_signal_connect (actor, "notify::opacity", G_CALLBACK (on_notify), &n_notify_opacity);
+  clutter_actor_set_opacity (actor, 64);
+  g_assert_cmpint (n_notify_opacity, ==, 1);
+
+  g_object_unref (actor);
+}
+
 CLUTTER_TEST_SUITE (
   CLUTTER_TEST_UNIT ("/actor/size/preferred", actor_preferred_size)
   CLUTTER_TEST_UNIT ("/actor/size/fixed", actor_fixed_size)
+  CLUTTER_TEST_UNIT ("/actor/size/bulk-update", actor_bulk_update)
+  CLUTTER_TEST_UNIT ("/actor/size/bulk-update/dispose", actor_bulk_update_dispose)
 )
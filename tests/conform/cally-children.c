@@ -0,0 +1,231 @@
+#include <atk/atk.h>
+#include <clutter/clutter.h>
+
+typedef struct {
+  gboolean added;
+  gint index;
+  AtkObject *child;
+} ChildChange;
+
+typedef struct {
+  GArray *changes;
+  gint n_sensitive;
+  gboolean sensitive;
+} NotifyTest;
+
+static void
+on_children_changed (NotifyTest *data,
+                     gboolean    added,
+                     guint       index_,
+                     gpointer    child)
+{
+  ChildChange change;
+
+  change.added = added;
+  change.index = index_;
+  change.child = child;
+
+  g_array_append_val (data->changes, change);
+}
+
+static void
+on_child_added (AtkObject  *obj,
+                guint       index_,
+                gpointer    child,
+                NotifyTest *data)
+{
+  on_children_changed (data, TRUE, index_, child);
+}
+
+static void
+on_child_removed (AtkObject  *obj,
+                  guint       index_,
+                  gpointer    child,
+                  NotifyTest *data)
+{
+  on_children_changed (data, FALSE, index_, child);
+}
+
+static void
+on_state_change (AtkObject   *obj,
+                 const gchar *name,
+                 gboolean     value,
+                 NotifyTest  *data)
+{
+  if (g_strcmp0 (name, "sensitive") != 0)
+    return;
+
+  data->n_sensitive += 1;
+  data->sensitive = value;
+}
+
+static gboolean
+on_idle (gpointer data)
+{
+  *((gboolean *) data) = TRUE;
+
+  return G_SOURCE_REMOVE;
+}
+
+/* the notifications are emitted from an idle handler, with a higher
+ * priority than this one
+ */
+static void
+wait_for_notifications (NotifyTest *data)
+{
+  gboolean done = FALSE;
+
+  g_array_set_size (data->changes, 0);
+  data->n_sensitive = 0;
+
+  g_idle_add_full (G_PRIORITY_LOW, on_idle, &done, NULL);
+
+  while (!done)
+    g_main_context_iteration (NULL, TRUE);
+}
+
+static void
+assert_change (NotifyTest   *data,
+               guint         index_,
+               gboolean      added,
+               gint          child_index,
+               ClutterActor *child)
+{
+  ChildChange *change;
+
+  g_assert_cmpuint (data->changes->len, >, index_);
+
+  change = &g_array_index (data->changes, ChildChange, index_);
+  g_assert_cmpint (change->added, ==, added);
+  g_assert_cmpint (change->index, ==, child_index);
+  g_assert (change->child == clutter_actor_get_accessible (child));
+}
+
+static AtkObject *
+make_container (ClutterActor **container,
+                NotifyTest    *data)
+{
+  AtkObject *accessible;
+
+  *container = clutter_actor_new ();
+  g_object_ref_sink (*container);
+
+  accessible = clutter_actor_get_accessible (*container);
+  g_assert (ATK_IS_OBJECT (accessible));
+
+  data->changes = g_array_new (FALSE, FALSE, sizeof (ChildChange));
+
+  g_signal_connect (accessible, "children-changed::add",
+                    G_CALLBACK (on_child_added),
+                    data);
+  g_signal_connect (accessible, "children-changed::remove",
+                    G_CALLBACK (on_child_removed),
+                    data);
+  g_signal_connect (accessible, "state-change",
+                    G_CALLBACK (on_state_change),
+                    data);
+
+  return accessible;
+}
+
+static void
+cally_children_changed (void)
+{
+  ClutterActor *container, *children[3], *child;
+  NotifyTest data;
+  guint i;
+
+  make_container (&container, &data);
+
+  /* the additions are notified once the frame is done, in order */
+  for (i = 0; i < G_N_ELEMENTS (children); i++)
+    {
+      children[i] = clutter_actor_new ();
+      clutter_actor_add_child (container, children[i]);
+    }
+
+  g_assert_cmpuint (data.changes->len, ==, 0);
+
+  wait_for_notifications (&data);
+  g_assert_cmpuint (data.changes->len, ==, 3);
+  assert_change (&data, 0, TRUE, 0, children[0]);
+  assert_change (&data, 1, TRUE, 1, children[1]);
+  assert_change (&data, 2, TRUE, 2, children[2]);
+
+  /* removals come first, so that every index is valid when notified */
+  g_object_ref (children[1]);
+  clutter_actor_remove_child (container, children[1]);
+  child = clutter_actor_new ();
+  clutter_actor_insert_child_at_index (container, child, 0);
+
+  wait_for_notifications (&data);
+  g_assert_cmpuint (data.changes->len, ==, 2);
+  assert_change (&data, 0, FALSE, 1, children[1]);
+  assert_change (&data, 1, TRUE, 0, child);
+  g_object_unref (children[1]);
+
+  /* a child added and removed within the same frame is not notified */
+  children[1] = clutter_actor_new ();
+  g_object_ref_sink (children[1]);
+  clutter_actor_add_child (container, children[1]);
+  clutter_actor_remove_child (container, children[1]);
+
+  wait_for_notifications (&data);
+  g_assert_cmpuint (data.changes->len, ==, 0);
+
+  g_object_unref (children[1]);
+  g_array_unref (data.changes);
+  clutter_actor_destroy (container);
+  g_object_unref (container);
+}
+
+static void
+cally_state_changed (void)
+{
+  ClutterActor *container, *children[2];
+  NotifyTest data;
+
+  make_container (&container, &data);
+
+  children[0] = clutter_actor_new ();
+  children[1] = clutter_actor_new ();
+  clutter_actor_add_child (container, children[0]);
+  clutter_actor_add_child (container, children[1]);
+  wait_for_notifications (&data);
+
+  /* only the last value of a state is notified */
+  clutter_actor_set_reactive (container, TRUE);
+  clutter_actor_set_reactive (container, FALSE);
+  clutter_actor_set_reactive (container, TRUE);
+
+  wait_for_notifications (&data);
+  g_assert_cmpint (data.n_sensitive, ==, 1);
+  g_assert (data.sensitive);
+  g_assert_cmpuint (data.changes->len, ==, 0);
+
+  /* re-ordering the children is not notified, and neither is a batch
+   * with only state changes, so the index of a removed child is still
+   * the one of the children last notified
+   */
+  clutter_actor_set_child_above_sibling (container, children[0], NULL);
+  clutter_actor_set_reactive (container, FALSE);
+  wait_for_notifications (&data);
+  g_assert_cmpint (data.n_sensitive, ==, 1);
+  g_assert (!data.sensitive);
+
+  g_object_ref (children[0]);
+  clutter_actor_remove_child (container, children[0]);
+  wait_for_notifications (&data);
+  g_assert_cmpuint (data.changes->len, ==, 1);
+  assert_change (&data, 0, FALSE, 0, children[0]);
+  g_object_unref (children[0]);
+
+  g_array_unref (data.changes);
+  clutter_actor_destroy (container);
+  g_object_unref (container);
+}
+
+CLUTTER_TEST_SUITE (
+  CLUTTER_TEST_UNIT ("/cally/children-changed", cally_children_changed)
+  CLUTTER_TEST_UNIT ("/cally/state-changed", cally_state_changed)
+)
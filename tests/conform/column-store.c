@@ -0,0 +1,103 @@
+#include <clutter/clutter.h>
+
+static void
+column_store_rows (void)
+{
+  const gchar *labels[] = { "one", "two", "three" };
+  const gfloat values[] = { 1.f, 2.f, 3.f };
+  ClutterColumnStore *store;
+  ClutterColumnStoreRow *row;
+  GValue value = G_VALUE_INIT;
+
+  store = clutter_column_store_new (2,
+                                    G_TYPE_STRING, "label",
+                                    G_TYPE_FLOAT, "value");
+
+  g_assert_cmpuint (clutter_column_store_get_n_columns (store), ==, 2);
+  g_assert_cmpint (clutter_column_store_find_column (store, "value"), ==, 1);
+  g_assert_cmpint (clutter_column_store_find_column (store, "missing"), ==, -1);
+  g_assert (g_list_model_get_item_type (G_LIST_MODEL (store)) == CLUTTER_TYPE_COLUMN_STORE_ROW);
+
+  clutter_column_store_insert_rows (store, 0, 3);
+  g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (store)), ==, 3);
+  g_assert_null (clutter_column_store_get_string (store, 0, 1));
+
+  clutter_column_store_set_strings (store, 0, 0, labels, 3);
+  clutter_column_store_set_floats (store, 1, 0, values, 3);
+
+  g_assert_cmpstr (clutter_column_store_get_string (store, 0, 2), ==, "three");
+  g_assert_cmpfloat (clutter_column_store_get_float (store, 1, 1), ==, 2.f);
+
+  /* the rows follow the insertions and removals */
+  row = g_list_model_get_item (G_LIST_MODEL (store), 2);
+  g_assert_cmpuint (clutter_column_store_row_get_index (row), ==, 2);
+
+  clutter_column_store_insert_rows (store, 1, 2);
+  g_assert_cmpuint (clutter_column_store_row_get_index (row), ==, 4);
+  g_assert_cmpfloat (clutter_column_store_get_float (store, 1, 1), ==, 0.f);
+  g_assert_cmpfloat (clutter_column_store_get_float (store, 1, 3), ==, 2.f);
+
+  clutter_column_store_row_get_value (row, 0, &value);
+  g_assert_cmpstr (g_value_get_string (&value), ==, "three");
+  g_value_unset (&value);
+
+  clutter_column_store_remove_rows (store, 3, 2);
+  g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (store)), ==, 3);
+  g_assert_cmpuint (clutter_column_store_row_get_index (row), ==, G_MAXUINT);
+
+  g_object_unref (row);
+  g_object_unref (store);
+}
+
+static void
+column_store_bind (void)
+{
+  const ClutterColor colors[] = { { 255, 0, 0, 255 }, { 0, 255, 0, 255 } };
+  const gfloat widths[] = { 10.f, 20.f, 30.f };
+  const gfloat new_widths[] = { 40.f, 50.f };
+  ClutterColumnStore *store;
+  ClutterActor *actor, *child;
+  ClutterColor color;
+
+  store = clutter_column_store_new (2,
+                                    G_TYPE_FLOAT, "width",
+                                    CLUTTER_TYPE_COLOR, "color");
+  clutter_column_store_insert_rows (store, 0, 3);
+  clutter_column_store_set_floats (store, 0, 0, widths, 3);
+  clutter_column_store_set_colors (store, 1, 0, colors, 2);
+
+  actor = clutter_actor_new ();
+  g_object_ref_sink (actor);
+
+  clutter_actor_bind_model_with_properties (actor, G_LIST_MODEL (store),
+                                            CLUTTER_TYPE_ACTOR,
+                                            "width", "width", G_BINDING_SYNC_CREATE,
+                                            "color", "background-color", G_BINDING_SYNC_CREATE,
+                                            NULL);
+
+  g_assert_cmpint (clutter_actor_get_n_children (actor), ==, 3);
+
+  child = clutter_actor_get_child_at_index (actor, 1);
+  g_assert_cmpfloat (clutter_actor_get_width (child), ==, 20.f);
+  clutter_actor_get_background_color (child, &color);
+  g_assert (clutter_color_equal (&color, &colors[1]));
+
+  /* changing a slice of a column updates the matching children */
+  clutter_column_store_set_floats (store, 0, 1, new_widths, 2);
+  g_assert_cmpfloat (clutter_actor_get_width (clutter_actor_get_child_at_index (actor, 0)), ==, 10.f);
+  g_assert_cmpfloat (clutter_actor_get_width (clutter_actor_get_child_at_index (actor, 1)), ==, 40.f);
+  g_assert_cmpfloat (clutter_actor_get_width (clutter_actor_get_child_at_index (actor, 2)), ==, 50.f);
+
+  clutter_column_store_remove_rows (store, 0, 2);
+  g_assert_cmpint (clutter_actor_get_n_children (actor), ==, 1);
+  g_assert_cmpfloat (clutter_actor_get_width (clutter_actor_get_first_child (actor)), ==, 50.f);
+
+  clutter_actor_destroy (actor);
+  g_object_unref (actor);
+  g_object_unref (store);
+}
+
+CLUTTER_TEST_SUITE (
+  CLUTTER_TEST_UNIT ("/column-store/rows", column_store_rows)
+  CLUTTER_TEST_UNIT ("/column-store/bind", column_store_bind)
+)
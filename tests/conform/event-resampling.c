@@ -0,0 +1,258 @@
+#include <math.h>
+
+#include <clutter/clutter.h>
+
+#define SEQUENCE_1      ((ClutterEventSequence *) GINT_TO_POINTER (1))
+#define SEQUENCE_2      ((ClutterEventSequence *) GINT_TO_POINTER (2))
+
+typedef struct {
+  GArray *points;
+  GArray *sequences;
+} ResampleTest;
+
+static gboolean
+on_captured_event (ClutterActor *stage,
+                   ClutterEvent *event,
+                   ResampleTest *data)
+{
+  ClutterEventSequence *sequence;
+  ClutterPoint point;
+
+  if (event->type != CLUTTER_MOTION && event->type != CLUTTER_TOUCH_UPDATE)
+    return CLUTTER_EVENT_PROPAGATE;
+
+  clutter_event_get_coords (event, &point.x, &point.y);
+  sequence = clutter_event_get_event_sequence (event);
+
+  g_array_append_val (data->points, point);
+  g_array_append_val (data->sequences, sequence);
+
+  return CLUTTER_EVENT_PROPAGATE;
+}
+
+/* queues an event with the given time, relative to @base_time, which
+ * is in the same time base as g_get_monotonic_time(); the time of the
+ * event only keeps the lower 32 bits of the time in milliseconds, like
+ * the time of the events coming from the windowing system
+ */
+static void
+put_event (ClutterActor         *stage,
+           ClutterInputDevice   *device,
+           ClutterEventType      type,
+           ClutterEventSequence *sequence,
+           gint64                base_time,
+           gint                  time_ms,
+           gfloat                x,
+           gfloat                y)
+{
+  ClutterEvent *event = clutter_event_new (type);
+
+  clutter_event_set_stage (event, CLUTTER_STAGE (stage));
+  clutter_event_set_device (event, device);
+  clutter_event_set_time (event, (guint32) (base_time / 1000 + time_ms));
+  clutter_event_set_coords (event, x, y);
+
+  if (type == CLUTTER_BUTTON_PRESS || type == CLUTTER_BUTTON_RELEASE)
+    clutter_event_set_button (event, CLUTTER_BUTTON_PRIMARY);
+
+  if (sequence != NULL)
+    event->touch.sequence = sequence;
+
+  clutter_event_put (event);
+  clutter_event_free (event);
+}
+
+static void
+wait_for_events (ResampleTest *data,
+                 guint         n_expected)
+{
+  g_array_set_size (data->points, 0);
+  g_array_set_size (data->sequences, 0);
+
+  while (data->points->len < n_expected)
+    g_main_context_iteration (NULL, TRUE);
+}
+
+static ClutterInputDevice *
+get_resampled_device (void)
+{
+  ClutterDeviceManager *manager = clutter_device_manager_get_default ();
+  ClutterInputDevice *device;
+
+  device = clutter_device_manager_get_core_device (manager, CLUTTER_POINTER_DEVICE);
+  g_assert (device != NULL);
+
+  g_assert (!clutter_input_device_get_event_resampling (device));
+  clutter_input_device_set_event_resampling (device, TRUE);
+  g_assert (clutter_input_device_get_event_resampling (device));
+
+  return device;
+}
+
+static void
+assert_point (const ResampleTest *data,
+              guint               index_,
+              gfloat              x,
+              gfloat              y)
+{
+  const ClutterPoint *point = &g_array_index (data->points, ClutterPoint, index_);
+
+  if (g_test_verbose ())
+    g_print ("event %u: (%.2f, %.2f), expected (%.2f, %.2f)\n",
+             index_, point->x, point->y, x, y);
+
+  g_assert_cmpfloat (fabsf (point->x - x), <, 0.01f);
+  g_assert_cmpfloat (fabsf (point->y - y), <, 0.01f);
+}
+
+static void
+event_resampling (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ResampleTest data;
+  ClutterInputDevice *device;
+  const ClutterPoint *point;
+  gint64 start, end;
+  gulong handler_id;
+
+  data.points = g_array_new (FALSE, FALSE, sizeof (ClutterPoint));
+  data.sequences = g_array_new (FALSE, FALSE, sizeof (ClutterEventSequence *));
+
+  handler_id = g_signal_connect (stage, "captured-event",
+                                 G_CALLBACK (on_captured_event),
+                                 &data);
+  clutter_actor_show (stage);
+
+  device = get_resampled_device ();
+
+  /* the frame is presented between the two samples, so the position is
+   * interpolated; the second sample is half a second in the future and
+   * the pointer moves by one pixel each millisecond, so the position is
+   * known within the time it took to deliver the event
+   */
+  start = g_get_monotonic_time ();
+  put_event (stage, device, CLUTTER_BUTTON_PRESS, NULL, start, -10, 0, 10);
+  put_event (stage, device, CLUTTER_MOTION, NULL, start, 490, 500, 10);
+  wait_for_events (&data, 1);
+  end = g_get_monotonic_time ();
+  put_event (stage, device, CLUTTER_BUTTON_RELEASE, NULL, start, 490, 500, 10);
+
+  point = &g_array_index (data.points, ClutterPoint, 0);
+  g_assert_cmpfloat (point->x, >=, 10 - 1);
+  /* the presentation time can be up to a few frames after the delivery */
+  g_assert_cmpfloat (point->x, <=, (end - start) / 1000 + 10 + 100);
+  g_assert_cmpfloat (point->y, ==, 10);
+
+  /* both samples are in the past: the position is extrapolated, but
+   * only by half the interval between the two samples
+   */
+  start = g_get_monotonic_time ();
+  put_event (stage, device, CLUTTER_BUTTON_PRESS, NULL, start, -100, 0, 10);
+  put_event (stage, device, CLUTTER_MOTION, NULL, start, -90, 10, 20);
+  wait_for_events (&data, 1);
+  put_event (stage, device, CLUTTER_BUTTON_RELEASE, NULL, start, -90, 10, 20);
+
+  assert_point (&data, 0, 15, 25);
+
+  /* ...and never by more than 8 milliseconds */
+  start = g_get_monotonic_time ();
+  put_event (stage, device, CLUTTER_BUTTON_PRESS, NULL, start, -100, 0, 10);
+  put_event (stage, device, CLUTTER_MOTION, NULL, start, -80, 20, 10);
+  wait_for_events (&data, 1);
+  put_event (stage, device, CLUTTER_BUTTON_RELEASE, NULL, start, -80, 20, 10);
+
+  assert_point (&data, 0, 28, 10);
+
+  /* samples too far apart do not give a meaningful velocity, and the
+   * event is delivered unchanged
+   */
+  start = g_get_monotonic_time ();
+  put_event (stage, device, CLUTTER_BUTTON_PRESS, NULL, start, -100, 0, 10);
+  put_event (stage, device, CLUTTER_MOTION, NULL, start, -50, 50, 10);
+  wait_for_events (&data, 1);
+  put_event (stage, device, CLUTTER_BUTTON_RELEASE, NULL, start, -50, 50, 10);
+
+  assert_point (&data, 0, 50, 10);
+
+  /* the same goes for samples that are too close */
+  start = g_get_monotonic_time ();
+  put_event (stage, device, CLUTTER_BUTTON_PRESS, NULL, start, -100, 0, 10);
+  put_event (stage, device, CLUTTER_MOTION, NULL, start, -99, 50, 10);
+  wait_for_events (&data, 1);
+  put_event (stage, device, CLUTTER_BUTTON_RELEASE, NULL, start, -99, 50, 10);
+
+  assert_point (&data, 0, 50, 10);
+
+  /* devices without resampling deliver the events unchanged */
+  clutter_input_device_set_event_resampling (device, FALSE);
+
+  start = g_get_monotonic_time ();
+  put_event (stage, device, CLUTTER_BUTTON_PRESS, NULL, start, -100, 0, 10);
+  put_event (stage, device, CLUTTER_MOTION, NULL, start, -90, 10, 20);
+  wait_for_events (&data, 1);
+  put_event (stage, device, CLUTTER_BUTTON_RELEASE, NULL, start, -90, 10, 20);
+
+  assert_point (&data, 0, 10, 20);
+
+  g_signal_handler_disconnect (stage, handler_id);
+  g_array_unref (data.points);
+  g_array_unref (data.sequences);
+}
+
+static void
+event_resampling_sequences (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ResampleTest data;
+  ClutterInputDevice *device;
+  gint64 start;
+  gulong handler_id;
+  guint i;
+
+  data.points = g_array_new (FALSE, FALSE, sizeof (ClutterPoint));
+  data.sequences = g_array_new (FALSE, FALSE, sizeof (ClutterEventSequence *));
+
+  handler_id = g_signal_connect (stage, "captured-event",
+                                 G_CALLBACK (on_captured_event),
+                                 &data);
+  clutter_actor_show (stage);
+
+  device = get_resampled_device ();
+
+  /* two touch points moving in different directions, with interleaved
+   * events; each one is extrapolated from its own samples
+   */
+  start = g_get_monotonic_time ();
+  put_event (stage, device, CLUTTER_TOUCH_BEGIN, SEQUENCE_1, start, -100, 100, 100);
+  put_event (stage, device, CLUTTER_TOUCH_BEGIN, SEQUENCE_2, start, -100, 100, 200);
+  put_event (stage, device, CLUTTER_TOUCH_UPDATE, SEQUENCE_1, start, -90, 110, 100);
+  put_event (stage, device, CLUTTER_TOUCH_UPDATE, SEQUENCE_2, start, -90, 100, 180);
+  wait_for_events (&data, 2);
+  put_event (stage, device, CLUTTER_TOUCH_END, SEQUENCE_1, start, -90, 110, 100);
+  put_event (stage, device, CLUTTER_TOUCH_END, SEQUENCE_2, start, -90, 100, 180);
+
+  for (i = 0; i < data.points->len; i++)
+    {
+      ClutterEventSequence *sequence;
+
+      sequence = g_array_index (data.sequences, ClutterEventSequence *, i);
+
+      if (sequence == SEQUENCE_1)
+        assert_point (&data, i, 115, 100);
+      else if (sequence == SEQUENCE_2)
+        assert_point (&data, i, 100, 170);
+      else
+        g_assert_not_reached ();
+    }
+
+  clutter_input_device_set_event_resampling (device, FALSE);
+
+  g_signal_handler_disconnect (stage, handler_id);
+  g_array_unref (data.points);
+  g_array_unref (data.sequences);
+}
+
+CLUTTER_TEST_SUITE (
+  CLUTTER_TEST_UNIT ("/event/resampling", event_resampling)
+  CLUTTER_TEST_UNIT ("/event/resampling/sequences", event_resampling_sequences)
+)
@@ -0,0 +1,283 @@
+#define COGL_ENABLE_EXPERIMENTAL_API
+#define CLUTTER_ENABLE_EXPERIMENTAL_API
+
+#include <string.h>
+
+#include <gio/gio.h>
+#include <glib/gstdio.h>
+#include <clutter/clutter.h>
+
+/* a 2x2 opaque red PNG image */
+static const guint8 red_png[] = {
+  0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d,
+  0x49, 0x48, 0x44, 0x52, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02,
+  0x08, 0x06, 0x00, 0x00, 0x00, 0x72, 0xb6, 0x0d, 0x24, 0x00, 0x00, 0x00,
+  0x11, 0x49, 0x44, 0x41, 0x54, 0x78, 0x9c, 0x63, 0xf8, 0xcf, 0xc0, 0xf0,
+  0x1f, 0x84, 0x19, 0x60, 0x0c, 0x00, 0x47, 0xca, 0x07, 0xf9, 0x67, 0x59,
+  0x6e, 0xb7, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42,
+  0x60, 0x82,
+};
+
+typedef struct {
+  gboolean done;
+  gboolean res;
+  GError *error;
+} LoadResult;
+
+static GFile *
+create_image_file (void)
+{
+  GError *error = NULL;
+  GFile *file;
+  gchar *path;
+  int fd;
+
+  fd = g_file_open_tmp ("clutter-image-XXXXXX.png", &path, &error);
+  g_assert_no_error (error);
+  g_close (fd, NULL);
+
+  g_file_set_contents (path, (const gchar *) red_png, sizeof (red_png), &error);
+  g_assert_no_error (error);
+
+  file = g_file_new_for_path (path);
+  g_free (path);
+
+  return file;
+}
+
+static void
+load_cb (GObject      *source,
+         GAsyncResult *result,
+         gpointer      user_data)
+{
+  LoadResult *load = user_data;
+
+  g_assert (!load->done);
+
+  load->res = clutter_image_load_finish (CLUTTER_IMAGE (source),
+                                         result,
+                                         &load->error);
+  load->done = TRUE;
+}
+
+static void
+wait_for_load (LoadResult *load)
+{
+  while (!load->done)
+    g_main_context_iteration (NULL, TRUE);
+}
+
+static void
+image_load_async (void)
+{
+  ClutterContent *image = clutter_image_new ();
+  LoadResult load = { FALSE, };
+  GFile *file = create_image_file ();
+  CoglTexture *texture;
+
+  /* there is no stage being painted, so the upload happens in an idle */
+  clutter_image_load_async (CLUTTER_IMAGE (image), file,
+                            G_PRIORITY_DEFAULT,
+                            NULL,
+                            load_cb, &load);
+  wait_for_load (&load);
+
+  g_assert_no_error (load.error);
+  g_assert (load.res);
+
+  texture = clutter_image_get_texture (CLUTTER_IMAGE (image));
+  g_assert (texture != NULL);
+  g_assert_cmpint (cogl_texture_get_width (texture), ==, 2);
+  g_assert_cmpint (cogl_texture_get_height (texture), ==, 2);
+
+  g_file_delete (file, NULL, NULL);
+  g_object_unref (file);
+  g_object_unref (image);
+}
+
+static void
+image_load_async_cancel (void)
+{
+  ClutterContent *image = clutter_image_new ();
+  LoadResult load = { FALSE, };
+  GFile *file = create_image_file ();
+  GCancellable *cancellable;
+
+  /* cancelling completes the load right away */
+  cancellable = g_cancellable_new ();
+  clutter_image_load_async (CLUTTER_IMAGE (image), file,
+                            G_PRIORITY_DEFAULT,
+                            cancellable,
+                            load_cb, &load);
+  g_cancellable_cancel (cancellable);
+  wait_for_load (&load);
+
+  g_assert_error (load.error, G_IO_ERROR, G_IO_ERROR_CANCELLED);
+  g_assert (!load.res);
+  g_clear_error (&load.error);
+
+  g_assert (clutter_image_get_texture (CLUTTER_IMAGE (image)) == NULL);
+
+  /* a load started with a cancelled cancellable never starts */
+  load.done = FALSE;
+  clutter_image_load_async (CLUTTER_IMAGE (image), file,
+                            G_PRIORITY_DEFAULT,
+                            cancellable,
+                            load_cb, &load);
+  wait_for_load (&load);
+
+  g_assert_error (load.error, G_IO_ERROR, G_IO_ERROR_CANCELLED);
+  g_clear_error (&load.error);
+
+  g_assert (clutter_image_get_texture (CLUTTER_IMAGE (image)) == NULL);
+
+  g_object_unref (cancellable);
+  g_file_delete (file, NULL, NULL);
+  g_object_unref (file);
+  g_object_unref (image);
+}
+
+static void
+image_load_async_superseded (void)
+{
+  ClutterContent *image = clutter_image_new ();
+  LoadResult first = { FALSE, }, second = { FALSE, };
+  GFile *file = create_image_file ();
+
+  clutter_image_load_async (CLUTTER_IMAGE (image), file,
+                            G_PRIORITY_DEFAULT,
+                            NULL,
+                            load_cb, &first);
+  clutter_image_load_async (CLUTTER_IMAGE (image), file,
+                            G_PRIORITY_DEFAULT,
+                            NULL,
+                            load_cb, &second);
+  wait_for_load (&first);
+  wait_for_load (&second);
+
+  /* only the last load replaces the image data */
+  g_assert_error (first.error, G_IO_ERROR, G_IO_ERROR_CANCELLED);
+  g_assert (!first.res);
+  g_clear_error (&first.error);
+
+  g_assert_no_error (second.error);
+  g_assert (second.res);
+
+  g_assert (clutter_image_get_texture (CLUTTER_IMAGE (image)) != NULL);
+
+  g_file_delete (file, NULL, NULL);
+  g_object_unref (file);
+  g_object_unref (image);
+}
+
+static CoglTexture *
+set_image_data (ClutterContent  *image,
+                CoglPixelFormat  pixel_format,
+                guint            width,
+                guint            height,
+                guint8           value)
+{
+  guint bpp = pixel_format == COGL_PIXEL_FORMAT_RGB_888 ? 3 : 4;
+  GError *error = NULL;
+  guint8 *data;
+
+  data = g_malloc (width * height * bpp);
+  memset (data, value, width * height * bpp);
+
+  clutter_image_set_data (CLUTTER_IMAGE (image),
+                          data,
+                          pixel_format,
+                          width, height,
+                          width * bpp,
+                          &error);
+  g_assert_no_error (error);
+  g_free (data);
+
+  return clutter_image_get_texture (CLUTTER_IMAGE (image));
+}
+
+static void
+image_atlas (void)
+{
+  ClutterContent *image = clutter_image_new ();
+  CoglTexture *texture;
+  gboolean has_atlas;
+
+  texture = set_image_data (image, COGL_PIXEL_FORMAT_RGBA_8888, 16, 16, 0xff);
+
+  /* whether small images end up in the atlas depends on the driver */
+  has_atlas = cogl_is_atlas_texture (texture);
+  if (!has_atlas && g_test_verbose ())
+    g_print ("Texture atlas not available\n");
+
+  /* anything smaller than 512 pixels in both dimensions can be packed */
+  texture = set_image_data (image, COGL_PIXEL_FORMAT_RGBA_8888, 511, 16, 0xff);
+  g_assert (cogl_is_atlas_texture (texture) == has_atlas);
+
+  texture = set_image_data (image, COGL_PIXEL_FORMAT_RGBA_8888, 16, 511, 0xff);
+  g_assert (cogl_is_atlas_texture (texture) == has_atlas);
+
+  /* long strips, and large images, get their own texture */
+  texture = set_image_data (image, COGL_PIXEL_FORMAT_RGBA_8888, 512, 16, 0xff);
+  g_assert (!cogl_is_atlas_texture (texture));
+
+  texture = set_image_data (image, COGL_PIXEL_FORMAT_RGBA_8888, 16, 600, 0xff);
+  g_assert (!cogl_is_atlas_texture (texture));
+
+  texture = set_image_data (image, COGL_PIXEL_FORMAT_RGBA_8888, 512, 512, 0xff);
+  g_assert (!cogl_is_atlas_texture (texture));
+
+  g_object_unref (image);
+}
+
+static void
+image_update_in_place (void)
+{
+  ClutterContent *image = clutter_image_new ();
+  CoglTexture *texture, *updated;
+  guint8 *data;
+
+  if (clutter_test_skip_without_rendering ())
+    return;
+
+  texture = set_image_data (image, COGL_PIXEL_FORMAT_RGBA_8888, 16, 16, 0x00);
+  g_assert (texture != NULL);
+
+  /* the same size and format reuses the texture, and replaces its
+   * contents
+   */
+  updated = set_image_data (image, COGL_PIXEL_FORMAT_RGBA_8888, 16, 16, 0xff);
+  g_assert (updated == texture);
+
+  data = g_malloc (16 * 16 * 4);
+  cogl_texture_get_data (updated, COGL_PIXEL_FORMAT_RGBA_8888, 16 * 4, data);
+  g_assert_cmpint (data[0], ==, 0xff);
+  g_assert_cmpint (data[16 * 16 * 4 - 1], ==, 0xff);
+  g_free (data);
+
+  /* a different size or format creates a new texture, and a texture
+   * held by the caller is left untouched
+   */
+  cogl_object_ref (texture);
+
+  updated = set_image_data (image, COGL_PIXEL_FORMAT_RGBA_8888, 32, 16, 0xff);
+  g_assert (updated != texture);
+  g_assert_cmpint (cogl_texture_get_width (texture), ==, 16);
+
+  cogl_object_unref (texture);
+
+  texture = cogl_object_ref (updated);
+  updated = set_image_data (image, COGL_PIXEL_FORMAT_RGB_888, 32, 16, 0xff);
+  g_assert (updated != texture);
+
+  cogl_object_unref (texture);
+  g_object_unref (image);
+}
+
+CLUTTER_TEST_SUITE (
+  CLUTTER_TEST_UNIT ("/image/atlas", image_atlas)
+  CLUTTER_TEST_UNIT ("/image/update-in-place", image_update_in_place)
+  CLUTTER_TEST_UNIT ("/image/load-async", image_load_async)
+  CLUTTER_TEST_UNIT ("/image/load-async/cancel", image_load_async_cancel)
+  CLUTTER_TEST_UNIT ("/image/load-async/superseded", image_load_async_superseded)
+)
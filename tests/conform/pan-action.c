@@ -0,0 +1,222 @@
+#include <math.h>
+
+#include <clutter/clutter.h>
+
+/* the same rate the velocity decays with, and the same minimum
+ * velocity, of ClutterPanAction
+ */
+#define DECELERATION    (0.5)
+#define MIN_VELOCITY    (0.1f)
+
+typedef struct {
+  ClutterActor *actor;
+  ClutterAction *action;
+  ClutterInputDevice *device;
+  gint64 base_time;
+  guint n_interpolated;
+  gboolean stopped;
+} PanTest;
+
+static gboolean
+on_pan (ClutterPanAction *action,
+        ClutterActor     *actor,
+        gboolean          is_interpolated,
+        PanTest          *data)
+{
+  if (is_interpolated)
+    data->n_interpolated += 1;
+
+  return CLUTTER_EVENT_PROPAGATE;
+}
+
+static void
+on_pan_stopped (ClutterPanAction *action,
+                ClutterActor     *actor,
+                PanTest          *data)
+{
+  data->stopped = TRUE;
+}
+
+static void
+pan_test_init (PanTest *data)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterDeviceManager *manager = clutter_device_manager_get_default ();
+
+  /* every motion event is a sample of the velocity, so none of them
+   * can be dropped
+   */
+  clutter_stage_set_throttle_motion_events (CLUTTER_STAGE (stage), FALSE);
+
+  data->device = clutter_device_manager_get_core_device (manager, CLUTTER_POINTER_DEVICE);
+  g_assert (data->device != NULL);
+
+  data->actor = clutter_actor_new ();
+  clutter_actor_set_size (data->actor, 200, 200);
+  clutter_actor_set_reactive (data->actor, TRUE);
+  clutter_actor_add_child (stage, data->actor);
+
+  data->action = clutter_pan_action_new ();
+  clutter_pan_action_set_interpolate (CLUTTER_PAN_ACTION (data->action), TRUE);
+  clutter_pan_action_set_deceleration (CLUTTER_PAN_ACTION (data->action), DECELERATION);
+  clutter_actor_add_action (data->actor, data->action);
+
+  g_signal_connect (data->action, "pan", G_CALLBACK (on_pan), data);
+  g_signal_connect (data->action, "pan-stopped", G_CALLBACK (on_pan_stopped), data);
+
+  clutter_actor_show (stage);
+
+  data->base_time = g_get_monotonic_time () / 1000;
+  data->n_interpolated = 0;
+  data->stopped = FALSE;
+}
+
+static void
+pan_test_finish (PanTest *data)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+
+  clutter_actor_destroy (data->actor);
+  clutter_stage_set_throttle_motion_events (CLUTTER_STAGE (stage), TRUE);
+}
+
+static void
+put_event (PanTest          *data,
+           ClutterEventType  type,
+           gint              time_ms,
+           gfloat            x,
+           gfloat            y)
+{
+  ClutterEvent *event = clutter_event_new (type);
+
+  clutter_event_set_stage (event, CLUTTER_STAGE (clutter_test_get_stage ()));
+  clutter_event_set_source (event, data->actor);
+  clutter_event_set_device (event, data->device);
+  clutter_event_set_time (event, (guint32) data->base_time + time_ms);
+  clutter_event_set_coords (event, x, y);
+
+  if (type == CLUTTER_BUTTON_PRESS || type == CLUTTER_BUTTON_RELEASE)
+    clutter_event_set_button (event, CLUTTER_BUTTON_PRIMARY);
+  else
+    clutter_event_set_state (event, CLUTTER_BUTTON1_MASK);
+
+  clutter_event_put (event);
+  clutter_event_free (event);
+}
+
+static void
+wait_for_pan_stopped (PanTest *data)
+{
+  while (!data->stopped)
+    g_main_context_iteration (NULL, TRUE);
+}
+
+/* where the fling ends, relative to the release point, for a release
+ * velocity of @velocity_x, @velocity_y
+ */
+static void
+assert_fling (PanTest *data,
+              gfloat   release_x,
+              gfloat   release_y,
+              gfloat   velocity_x,
+              gfloat   velocity_y)
+{
+  gfloat velocity, tau, decay;
+  gfloat x, y;
+  gint duration;
+
+  velocity = sqrtf (velocity_x * velocity_x + velocity_y * velocity_y);
+  tau = 1000.0f / (60.0f * - logf (DECELERATION));
+  duration = - tau * logf (MIN_VELOCITY / velocity);
+  decay = tau * (1.0f - expf (- (gfloat) duration / tau));
+
+  clutter_pan_action_get_interpolated_coords (CLUTTER_PAN_ACTION (data->action), &x, &y);
+
+  if (g_test_verbose ())
+    g_print ("fling: (%.2f, %.2f), expected (%.2f, %.2f)\n",
+             x - release_x, y - release_y,
+             velocity_x * decay, velocity_y * decay);
+
+  g_assert_cmpuint (data->n_interpolated, >, 0);
+  g_assert_cmpfloat (fabsf (x - release_x - velocity_x * decay), <, 0.05f);
+  g_assert_cmpfloat (fabsf (y - release_y - velocity_y * decay), <, 0.05f);
+}
+
+static void
+pan_action_fling_least_squares (void)
+{
+  PanTest data;
+
+  pan_test_init (&data);
+
+  /* the last motion is noisy, and moves at 1.5px/ms along X, but the
+   * fit over all the samples moves at 1.1px/ms; Y moves at half that
+   */
+  put_event (&data, CLUTTER_BUTTON_PRESS, 0, 0, 100);
+  put_event (&data, CLUTTER_MOTION, 10, 10, 105);
+  put_event (&data, CLUTTER_MOTION, 20, 20, 110);
+  put_event (&data, CLUTTER_MOTION, 30, 30, 115);
+  put_event (&data, CLUTTER_MOTION, 40, 45, 122.5f);
+  put_event (&data, CLUTTER_BUTTON_RELEASE, 40, 45, 122.5f);
+  wait_for_pan_stopped (&data);
+
+  assert_fling (&data, 45, 122.5f, 1.1f, 0.55f);
+
+  pan_test_finish (&data);
+}
+
+static void
+pan_action_fling_stop_gap (void)
+{
+  PanTest data;
+
+  pan_test_init (&data);
+
+  /* the pointer pauses for longer than 40ms in the middle of the
+   * gesture, so only the samples after the pause are used
+   */
+  put_event (&data, CLUTTER_BUTTON_PRESS, 0, 0, 100);
+  put_event (&data, CLUTTER_MOTION, 10, 20, 100);
+  put_event (&data, CLUTTER_MOTION, 20, 40, 100);
+  put_event (&data, CLUTTER_MOTION, 70, 45, 100);
+  put_event (&data, CLUTTER_MOTION, 80, 50, 100);
+  put_event (&data, CLUTTER_MOTION, 90, 55, 100);
+  put_event (&data, CLUTTER_BUTTON_RELEASE, 90, 55, 100);
+  wait_for_pan_stopped (&data);
+
+  assert_fling (&data, 55, 100, 0.5f, 0.f);
+
+  pan_test_finish (&data);
+}
+
+static void
+pan_action_fling_stopped (void)
+{
+  PanTest data;
+  gfloat x, y;
+
+  pan_test_init (&data);
+
+  /* the pointer stops for longer than 40ms before being released, so
+   * there is no fling at all
+   */
+  put_event (&data, CLUTTER_BUTTON_PRESS, 0, 0, 100);
+  put_event (&data, CLUTTER_MOTION, 10, 20, 100);
+  put_event (&data, CLUTTER_MOTION, 20, 40, 100);
+  put_event (&data, CLUTTER_BUTTON_RELEASE, 70, 40, 100);
+  wait_for_pan_stopped (&data);
+
+  g_assert_cmpuint (data.n_interpolated, ==, 0);
+
+  clutter_pan_action_get_interpolated_coords (CLUTTER_PAN_ACTION (data.action), &x, &y);
+  g_assert_cmpfloat (x, ==, 40);
+  g_assert_cmpfloat (y, ==, 100);
+
+  pan_test_finish (&data);
+}
+
+CLUTTER_TEST_SUITE (
+  CLUTTER_TEST_UNIT ("/pan-action/fling/least-squares", pan_action_fling_least_squares)
+  CLUTTER_TEST_UNIT ("/pan-action/fling/stop-gap", pan_action_fling_stop_gap)
+  CLUTTER_TEST_UNIT ("/pan-action/fling/stopped", pan_action_fling_stopped)
+)
@@ -1,6 +1,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <glib/gstdio.h>
+
 #define CLUTTER_DISABLE_DEPRECATION_WARNINGS
 #include <clutter/clutter.h>
 
@@ -418,6 +420,456 @@ script_margin (void)
   g_free (test_file);
 }
 
+/* compiles @name, from the scripts directory, with the compiler built
+ * alongside the library, and returns the compiled definitions
+ */
+static gchar *
+compile_definitions (const gchar *name,
+                     gsize       *length)
+{
+  const gchar *compiler = g_getenv ("CLUTTER_SCRIPT_COMPILER");
+  GError *error = NULL;
+  gchar *argv[4] = { NULL, };
+  gchar *test_file, *output_file, *output_arg;
+  gchar *contents;
+  gint status;
+  int fd;
+
+  if (compiler == NULL)
+    {
+      g_test_skip ("clutter-script-compiler is only available in the build directory");
+      return NULL;
+    }
+
+  test_file = g_test_build_filename (G_TEST_DIST, "scripts", name, NULL);
+
+  fd = g_file_open_tmp ("clutter-script-XXXXXX.clsc", &output_file, &error);
+  g_assert_no_error (error);
+  g_close (fd, NULL);
+
+  output_arg = g_strconcat ("--output=", output_file, NULL);
+
+  argv[0] = (gchar *) compiler;
+  argv[1] = output_arg;
+  argv[2] = test_file;
+
+  g_spawn_sync (NULL, argv, NULL,
+                G_SPAWN_STDOUT_TO_DEV_NULL,
+                NULL, NULL,
+                NULL, NULL,
+                &status,
+                &error);
+  g_assert_no_error (error);
+
+  g_spawn_check_exit_status (status, &error);
+  g_assert_no_error (error);
+
+  g_file_get_contents (output_file, &contents, length, &error);
+  g_assert_no_error (error);
+
+  g_unlink (output_file);
+
+  g_free (output_arg);
+  g_free (output_file);
+  g_free (test_file);
+
+  return contents;
+}
+
+static void
+check_compiled_objects (ClutterScript *script)
+{
+  ClutterActor *actor, *text;
+  ClutterColor color;
+  GObject *timeline;
+
+  actor = CLUTTER_ACTOR (clutter_script_get_object (script, "actor"));
+  g_assert (CLUTTER_IS_ACTOR (actor));
+  g_assert_cmpfloat (clutter_actor_get_x (actor), ==, 10.0f);
+  g_assert_cmpfloat (clutter_actor_get_y (actor), ==, 20.0f);
+  g_assert_cmpfloat (clutter_actor_get_width (actor), ==, 100.0f);
+  g_assert_cmpfloat (clutter_actor_get_height (actor), ==, 50.0f);
+  g_assert_cmpint (clutter_actor_get_x_align (actor), ==, CLUTTER_ACTOR_ALIGN_CENTER);
+  g_assert_cmpint (clutter_actor_get_offscreen_redirect (actor), ==,
+                   CLUTTER_OFFSCREEN_REDIRECT_AUTOMATIC_FOR_OPACITY |
+                   CLUTTER_OFFSCREEN_REDIRECT_ALWAYS);
+  g_assert (clutter_actor_get_reactive (actor));
+
+  clutter_actor_get_background_color (actor, &color);
+  g_assert_cmpint (color.red, ==, 255);
+  g_assert_cmpint (color.green, ==, 0);
+  g_assert_cmpint (color.blue, ==, 0);
+  g_assert_cmpint (color.alpha, ==, 255);
+
+  text = CLUTTER_ACTOR (clutter_script_get_object (script, "text"));
+  g_assert (CLUTTER_IS_TEXT (text));
+  g_assert (clutter_actor_get_parent (text) == actor);
+  g_assert_cmpstr (clutter_text_get_text (CLUTTER_TEXT (text)), ==, "Hello, wörld");
+  g_assert_cmpint (clutter_actor_get_opacity (text), ==, 128);
+
+  clutter_text_get_color (CLUTTER_TEXT (text), &color);
+  g_assert_cmpint (color.red, ==, 0);
+  g_assert_cmpint (color.green, ==, 0);
+  g_assert_cmpint (color.blue, ==, 255);
+  g_assert_cmpint (color.alpha, ==, 128);
+
+  timeline = clutter_script_get_object (script, "timeline");
+  g_assert (CLUTTER_IS_TIMELINE (timeline));
+  g_assert_cmpuint (clutter_timeline_get_duration (CLUTTER_TIMELINE (timeline)), ==, 500);
+  g_assert_cmpint (clutter_timeline_get_progress_mode (CLUTTER_TIMELINE (timeline)), ==,
+                   CLUTTER_EASE_IN_OUT_CUBIC);
+}
+
+static void
+script_compiled (void)
+{
+  ClutterScript *script;
+  GError *error = NULL;
+  gchar *test_file;
+  gchar *image;
+  gsize length;
+  guint merge_id;
+
+  /* the JSON definitions and their compiled form create the same
+   * objects
+   */
+  test_file = g_test_build_filename (G_TEST_DIST, "scripts", "test-script-compiled.json", NULL);
+  script = clutter_script_new ();
+  clutter_script_load_from_file (script, test_file, &error);
+  g_assert_no_error (error);
+  check_compiled_objects (script);
+  g_object_unref (script);
+  g_free (test_file);
+
+  image = compile_definitions ("test-script-compiled.json", &length);
+  if (image == NULL)
+    return;
+
+  script = clutter_script_new ();
+  merge_id = clutter_script_load_from_data (script, image, length, &error);
+  g_assert_no_error (error);
+  g_assert_cmpuint (merge_id, >, 0);
+  check_compiled_objects (script);
+  g_object_unref (script);
+
+  g_free (image);
+}
+
+static void
+script_compiled_custom_type (void)
+{
+  ClutterScript *script = clutter_script_new ();
+  GObject *container, *actor;
+  GError *error = NULL;
+  gboolean focus_ret;
+  gchar *image;
+  gsize length;
+
+  g_type_ensure (TEST_TYPE_GROUP);
+  g_type_ensure (TEST_TYPE_GROUP_META);
+
+  /* the compiler does not know the types defined by the application,
+   * and copies their definitions as they are
+   */
+  image = compile_definitions ("test-script-child.json", &length);
+  if (image == NULL)
+    {
+      g_object_unref (script);
+      return;
+    }
+
+  clutter_script_load_from_data (script, image, length, &error);
+  g_assert_no_error (error);
+  g_free (image);
+
+  container = actor = NULL;
+  clutter_script_get_objects (script,
+                              "test-group", &container,
+                              "test-rect-1", &actor,
+                              NULL);
+  g_assert (TEST_IS_GROUP (container));
+  g_assert (CLUTTER_IS_RECTANGLE (actor));
+
+  focus_ret = FALSE;
+  clutter_container_child_get (CLUTTER_CONTAINER (container),
+                               CLUTTER_ACTOR (actor),
+                               "focus", &focus_ret,
+                               NULL);
+  g_assert (focus_ret);
+
+  g_object_unref (script);
+}
+
+/* the layout of the compiled definitions; see
+ * clutter-script-binary-private.h
+ */
+#define MAGIC           "\211CSCR\r\n\032"
+#define MAGIC_LEN       8
+#define HEADER_SIZE     (MAGIC_LEN + 4 * 4)
+#define VERSION_OFFSET  (MAGIC_LEN)
+#define STRINGS_OFFSET  (MAGIC_LEN + 4)
+#define TAG_NULL        (0)
+#define TAG_ARRAY       (6)
+#define MAX_DEPTH       (512)
+
+static void
+set_word (gchar   *image,
+          gsize    offset,
+          guint32  word)
+{
+  word = GUINT32_TO_LE (word);
+  memcpy (image + offset, &word, sizeof (word));
+}
+
+static gchar *
+copy_image (const gchar *image,
+            gsize        length)
+{
+  gchar *copy = g_malloc (length);
+
+  memcpy (copy, image, length);
+
+  return copy;
+}
+
+static void
+assert_invalid (const gchar *image,
+                gsize        length)
+{
+  ClutterScript *script = clutter_script_new ();
+  GError *error = NULL;
+  guint merge_id;
+
+  merge_id = clutter_script_load_from_data (script, image, length, &error);
+
+  if (g_test_verbose () && error != NULL)
+    g_print ("Error: %s\n", error->message);
+
+  g_assert_error (error, CLUTTER_SCRIPT_ERROR, CLUTTER_SCRIPT_ERROR_INVALID_VALUE);
+  g_assert_cmpuint (merge_id, ==, 0);
+  g_clear_error (&error);
+
+  g_object_unref (script);
+}
+
+/* an image with @depth arrays nested inside each other */
+static GByteArray *
+build_nested_image (guint depth)
+{
+  GByteArray *image = g_byte_array_new ();
+  guint8 word[4];
+  guint i;
+
+  g_byte_array_set_size (image, HEADER_SIZE);
+  memcpy (image->data, MAGIC, MAGIC_LEN);
+
+  for (i = 0; i < depth; i++)
+    {
+      set_word ((gchar *) word, 0, TAG_ARRAY | (1 << 8));
+      g_byte_array_append (image, word, sizeof (word));
+    }
+
+  set_word ((gchar *) word, 0, TAG_NULL);
+  g_byte_array_append (image, word, sizeof (word));
+
+  /* a string table with a single empty string */
+  g_byte_array_append (image, (const guint8 *) "", 1);
+
+  set_word ((gchar *) image->data, VERSION_OFFSET, 1);
+  set_word ((gchar *) image->data, STRINGS_OFFSET, image->len - 1);
+  set_word ((gchar *) image->data, STRINGS_OFFSET + 4, 1);
+  set_word ((gchar *) image->data, STRINGS_OFFSET + 8, HEADER_SIZE);
+
+  return image;
+}
+
+static void
+script_compiled_strings (void)
+{
+  ClutterScript *script;
+  GError *error = NULL;
+  const gchar *str, *end;
+  guint32 strings_offset, strings_size;
+  guint n_strings = 0;
+  gchar *image;
+  gsize length;
+
+  image = compile_definitions ("test-script-compiled.json", &length);
+  if (image == NULL)
+    return;
+
+  /* the table holds each distinct string once, one after the other,
+   * including non-ASCII ones
+   */
+  memcpy (&strings_offset, image + STRINGS_OFFSET, sizeof (guint32));
+  memcpy (&strings_size, image + STRINGS_OFFSET + 4, sizeof (guint32));
+  strings_offset = GUINT32_FROM_LE (strings_offset);
+  strings_size = GUINT32_FROM_LE (strings_size);
+  g_assert_cmpuint (strings_offset + strings_size, <=, length);
+
+  str = image + strings_offset;
+  end = str + strings_size;
+  while (str < end)
+    {
+      n_strings += 1;
+      str += strlen (str) + 1;
+    }
+
+  g_assert_cmpuint (n_strings, >, 1);
+
+  script = clutter_script_new ();
+  clutter_script_load_from_data (script, image, length, &error);
+  g_assert_no_error (error);
+
+  g_assert_cmpstr (clutter_text_get_text (CLUTTER_TEXT (clutter_script_get_object (script, "text"))),
+                   ==,
+                   "Hello, wörld");
+
+  g_object_unref (script);
+  g_free (image);
+}
+
+static void
+script_compiled_invalid (void)
+{
+  ClutterScript *script;
+  GError *error = NULL;
+  GByteArray *nested;
+  gchar *image, *copy;
+  gsize length;
+
+  /* nesting is limited, to avoid running out of stack */
+  nested = build_nested_image (MAX_DEPTH);
+  script = clutter_script_new ();
+  clutter_script_load_from_data (script, (const gchar *) nested->data, nested->len, &error);
+  g_assert_no_error (error);
+  g_object_unref (script);
+  g_byte_array_unref (nested);
+
+  nested = build_nested_image (MAX_DEPTH + 1);
+  assert_invalid ((const gchar *) nested->data, nested->len);
+  g_byte_array_unref (nested);
+
+  /* counts larger than what is left of the image */
+  nested = build_nested_image (1);
+  set_word ((gchar *) nested->data, HEADER_SIZE, TAG_ARRAY | (0xffffffu << 8));
+  assert_invalid ((const gchar *) nested->data, nested->len);
+  g_byte_array_unref (nested);
+
+  image = compile_definitions ("test-script-compiled.json", &length);
+  if (image == NULL)
+    return;
+
+  /* truncated header */
+  assert_invalid (image, HEADER_SIZE - 4);
+
+  /* images from another version of the format must be compiled again */
+  copy = copy_image (image, length);
+  set_word (copy, VERSION_OFFSET, 2);
+  assert_invalid (copy, length);
+  g_free (copy);
+
+  /* string table outside of the image */
+  copy = copy_image (image, length);
+  set_word (copy, STRINGS_OFFSET, length + 1);
+  assert_invalid (copy, length);
+  g_free (copy);
+
+  /* string offset outside of the table; the root array is followed by
+   * the first object, and by the name of its first member
+   */
+  copy = copy_image (image, length);
+  set_word (copy, HEADER_SIZE + 8, length);
+  assert_invalid (copy, length);
+  g_free (copy);
+
+  /* unterminated string table */
+  copy = copy_image (image, length);
+  copy[length - 1] = 'x';
+  assert_invalid (copy, length);
+  g_free (copy);
+
+  g_free (image);
+}
+
+static const gchar *lazy_definitions =
+"["
+"  {"
+"    \"id\" : \"screen-1\", \"type\" : \"ClutterActor\","
+"    \"children\" : ["
+"      { \"id\" : \"label-1\", \"type\" : \"ClutterActor\", \"x\" : 10.0 }"
+"    ]"
+"  },"
+"  {"
+"    \"id\" : \"screen-2\", \"type\" : \"ClutterActor\","
+"    \"children\" : ["
+"      { \"id\" : \"label-2\", \"type\" : \"ClutterActor\", \"x\" : 20.0 }"
+"    ]"
+"  },"
+"  { \"id\" : \"timeline\", \"type\" : \"ClutterTimeline\", \"duration\" : 500 }"
+"]";
+
+static void
+script_lazy (void)
+{
+  const gchar *prefetch[] = { "screen-2", NULL };
+  ClutterScript *script = clutter_script_new ();
+  guint n_declared, n_constructed;
+  GError *error = NULL;
+  GObject *object;
+
+  clutter_script_set_lazy_construction (script, TRUE);
+  g_assert (clutter_script_get_lazy_construction (script));
+
+  clutter_script_load_from_data (script, lazy_definitions, -1, &error);
+  g_assert_no_error (error);
+
+  clutter_script_get_object_counts (script, &n_declared, &n_constructed);
+  g_assert_cmpuint (n_declared, ==, 5);
+  g_assert_cmpuint (n_constructed, ==, 0);
+
+  /* retrieving a container constructs its children as well */
+  object = clutter_script_get_object (script, "screen-1");
+  g_assert (CLUTTER_IS_ACTOR (object));
+  g_assert_cmpint (clutter_actor_get_n_children (CLUTTER_ACTOR (object)), ==, 1);
+
+  clutter_script_get_object_counts (script, NULL, &n_constructed);
+  g_assert_cmpuint (n_constructed, ==, 2);
+
+  object = clutter_script_get_object (script, "label-1");
+  g_assert_cmpfloat (clutter_actor_get_x (CLUTTER_ACTOR (object)), ==, 10.0f);
+
+  /* prefetching constructs one object for each iteration */
+  clutter_script_prefetch_objects (script, prefetch);
+  while (n_constructed == 2)
+    {
+      g_main_context_iteration (NULL, TRUE);
+      clutter_script_get_object_counts (script, NULL, &n_constructed);
+    }
+
+  g_assert_cmpuint (n_constructed, ==, 3);
+
+  while (g_main_context_pending (NULL))
+    g_main_context_iteration (NULL, FALSE);
+
+  clutter_script_get_object_counts (script, NULL, &n_constructed);
+  g_assert_cmpuint (n_constructed, ==, 4);
+
+  object = clutter_script_get_object (script, "label-2");
+  g_assert (clutter_actor_get_parent (CLUTTER_ACTOR (object)) ==
+            CLUTTER_ACTOR (clutter_script_get_object (script, "screen-2")));
+  g_assert_cmpfloat (clutter_actor_get_x (CLUTTER_ACTOR (object)), ==, 20.0f);
+
+  clutter_script_ensure_objects (script);
+  clutter_script_get_object_counts (script, NULL, &n_constructed);
+  g_assert_cmpuint (n_constructed, ==, 5);
+
+  object = clutter_script_get_object (script, "timeline");
+  g_assert_cmpuint (clutter_timeline_get_duration (CLUTTER_TIMELINE (object)), ==, 500);
+
+  g_object_unref (script);
+}
+
 CLUTTER_TEST_SUITE (
   CLUTTER_TEST_UNIT ("/script/single-object", script_single)
   CLUTTER_TEST_UNIT ("/script/container-child", script_child)
@@ -427,4 +879,9 @@ CLUTTER_TEST_SUITE (
   CLUTTER_TEST_UNIT ("/script/object-property", script_object_property)
   CLUTTER_TEST_UNIT ("/script/layout-property", script_layout_property)
   CLUTTER_TEST_UNIT ("/script/actor-margin", script_margin)
+  CLUTTER_TEST_UNIT ("/script/compiled", script_compiled)
+  CLUTTER_TEST_UNIT ("/script/compiled/custom-type", script_compiled_custom_type)
+  CLUTTER_TEST_UNIT ("/script/compiled/strings", script_compiled_strings)
+  CLUTTER_TEST_UNIT ("/script/compiled/invalid", script_compiled_invalid)
+  CLUTTER_TEST_UNIT ("/script/lazy", script_lazy)
 )
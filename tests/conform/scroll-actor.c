@@ -0,0 +1,211 @@
+#include <clutter/clutter.h>
+
+typedef struct _CountActor      CountActor;
+typedef struct _CountActorClass CountActorClass;
+
+struct _CountActorClass
+{
+  ClutterActorClass parent_class;
+};
+
+struct _CountActor
+{
+  ClutterActor parent;
+};
+
+GType count_actor_get_type (void) G_GNUC_CONST;
+
+G_DEFINE_TYPE (CountActor, count_actor, CLUTTER_TYPE_ACTOR);
+
+static guint n_paints = 0;
+
+static void
+count_actor_paint (ClutterActor *actor)
+{
+  /* we cannot use the ::paint signal, as connecting a handler to it
+   * makes the paint volume of the actor unknown, and it would then
+   * always be painted
+   */
+  n_paints += 1;
+
+  CLUTTER_ACTOR_CLASS (count_actor_parent_class)->paint (actor);
+}
+
+static void
+count_actor_class_init (CountActorClass *klass)
+{
+  CLUTTER_ACTOR_CLASS (klass)->paint = count_actor_paint;
+}
+
+static void
+count_actor_init (CountActor *self)
+{
+}
+
+typedef struct {
+  guint32 expected_top;
+  guint32 expected_bottom;
+  gboolean was_painted;
+} ScrollTest;
+
+static guint32
+get_pixel (int x, int y)
+{
+  guint8 data[4];
+
+  cogl_read_pixels (x, y, 1, 1,
+                    COGL_READ_PIXELS_COLOR_BUFFER,
+                    COGL_PIXEL_FORMAT_RGBA_8888_PRE,
+                    data);
+
+  return (((guint32) data[0] << 16) |
+          ((guint32) data[1] << 8) |
+          data[2]);
+}
+
+static void
+paint_cb (ClutterStage *stage,
+          ScrollTest   *data)
+{
+  g_assert_cmpint (get_pixel (50, 10), ==, data->expected_top);
+  g_assert_cmpint (get_pixel (50, 90), ==, data->expected_bottom);
+
+  data->was_painted = TRUE;
+}
+
+static void
+wait_for_paint (ScrollTest *data,
+                guint32     expected_top,
+                guint32     expected_bottom)
+{
+  data->expected_top = expected_top;
+  data->expected_bottom = expected_bottom;
+  data->was_painted = FALSE;
+
+  while (!data->was_painted)
+    g_main_context_iteration (NULL, FALSE);
+}
+
+static ClutterActor *
+make_item (const ClutterColor *color,
+           gfloat              y)
+{
+  ClutterActor *item = clutter_actor_new ();
+
+  clutter_actor_set_background_color (item, color);
+  clutter_actor_set_position (item, 0, y);
+  clutter_actor_set_size (item, 100, 100);
+
+  return item;
+}
+
+static void
+scroll_actor_scroll_by_copy (void)
+{
+  ClutterActor *stage, *scroll, *top;
+  ScrollTest data = { 0, };
+  ClutterPoint point;
+  gulong paint_id;
+
+  if (clutter_test_skip_without_rendering ())
+    return;
+
+  stage = clutter_test_get_stage ();
+
+  scroll = clutter_scroll_actor_new ();
+  clutter_scroll_actor_set_scroll_mode (CLUTTER_SCROLL_ACTOR (scroll),
+                                        CLUTTER_SCROLL_VERTICALLY);
+  clutter_scroll_actor_set_scroll_by_copy (CLUTTER_SCROLL_ACTOR (scroll), TRUE);
+  g_assert (clutter_scroll_actor_get_scroll_by_copy (CLUTTER_SCROLL_ACTOR (scroll)));
+  clutter_actor_set_size (scroll, 100, 100);
+  clutter_actor_add_child (stage, scroll);
+
+  top = make_item (CLUTTER_COLOR_Red, 0);
+  clutter_actor_add_child (scroll, top);
+  clutter_actor_add_child (scroll, make_item (CLUTTER_COLOR_Blue, 100));
+
+  clutter_actor_show (stage);
+
+  paint_id = g_signal_connect (stage, "after-paint",
+                               G_CALLBACK (paint_cb),
+                               &data);
+
+  wait_for_paint (&data, 0xff0000, 0xff0000);
+
+  /* half of the contents are copied, and half are painted */
+  clutter_point_init (&point, 0, 50);
+  clutter_scroll_actor_scroll_to_point (CLUTTER_SCROLL_ACTOR (scroll), &point);
+  wait_for_paint (&data, 0xff0000, 0x0000ff);
+
+  /* fractional origins are rounded to whole pixels */
+  clutter_point_init (&point, 0, 99.7f);
+  clutter_scroll_actor_scroll_to_point (CLUTTER_SCROLL_ACTOR (scroll), &point);
+  wait_for_paint (&data, 0x0000ff, 0x0000ff);
+
+  /* changing a child must invalidate the cached contents */
+  clutter_actor_set_background_color (top, CLUTTER_COLOR_Green);
+  clutter_point_init (&point, 0, 50);
+  clutter_scroll_actor_scroll_to_point (CLUTTER_SCROLL_ACTOR (scroll), &point);
+  wait_for_paint (&data, 0x00ff00, 0x0000ff);
+
+  g_signal_handler_disconnect (stage, paint_id);
+}
+
+static void
+scroll_actor_scroll_by_copy_culling (void)
+{
+  ClutterActor *stage, *scroll;
+  ScrollTest data = { 0, };
+  ClutterPoint point;
+  gulong paint_id;
+  guint i;
+
+  if (clutter_test_skip_without_rendering ())
+    return;
+
+  stage = clutter_test_get_stage ();
+
+  scroll = clutter_scroll_actor_new ();
+  clutter_scroll_actor_set_scroll_mode (CLUTTER_SCROLL_ACTOR (scroll),
+                                        CLUTTER_SCROLL_VERTICALLY);
+  clutter_scroll_actor_set_scroll_by_copy (CLUTTER_SCROLL_ACTOR (scroll), TRUE);
+  clutter_actor_set_size (scroll, 100, 100);
+  clutter_actor_add_child (stage, scroll);
+
+  /* enough children for the scroll actor to keep a spatial index */
+  for (i = 0; i < 200; i++)
+    {
+      ClutterActor *item = g_object_new (count_actor_get_type (), NULL);
+
+      clutter_actor_set_background_color (item, i < 10 ? CLUTTER_COLOR_Red : CLUTTER_COLOR_Blue);
+      clutter_actor_set_position (item, 0, i * 10);
+      clutter_actor_set_size (item, 100, 10);
+      clutter_actor_add_child (scroll, item);
+    }
+
+  clutter_actor_show (stage);
+
+  paint_id = g_signal_connect (stage, "after-paint",
+                               G_CALLBACK (paint_cb),
+                               &data);
+
+  /* the whole cache is painted, but only with the visible children */
+  n_paints = 0;
+  wait_for_paint (&data, 0xff0000, 0xff0000);
+  g_assert_cmpuint (n_paints, <=, 12);
+
+  /* scrolling by one item only paints the items in the exposed strip */
+  n_paints = 0;
+  clutter_point_init (&point, 0, 10);
+  clutter_scroll_actor_scroll_to_point (CLUTTER_SCROLL_ACTOR (scroll), &point);
+  wait_for_paint (&data, 0xff0000, 0x0000ff);
+  g_assert_cmpuint (n_paints, <=, 3);
+
+  g_signal_handler_disconnect (stage, paint_id);
+  clutter_actor_destroy (scroll);
+}
+
+CLUTTER_TEST_SUITE (
+  CLUTTER_TEST_UNIT ("/scroll-actor/scroll-by-copy", scroll_actor_scroll_by_copy)
+  CLUTTER_TEST_UNIT ("/scroll-actor/scroll-by-copy/culling", scroll_actor_scroll_by_copy_culling)
+)
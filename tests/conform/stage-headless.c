@@ -0,0 +1,94 @@
+#include <clutter/clutter.h>
+
+typedef struct {
+  guint n_frames;
+  guint n_actor_paints;
+} FrameTest;
+
+static void
+on_after_paint (ClutterStage *stage,
+                FrameTest    *data)
+{
+  data->n_frames += 1;
+}
+
+static void
+on_actor_paint (ClutterActor *actor,
+                FrameTest    *data)
+{
+  data->n_actor_paints += 1;
+}
+
+static void
+wait_for_frames (FrameTest *data,
+                 guint      n_frames)
+{
+  while (data->n_frames < n_frames)
+    g_main_context_iteration (NULL, TRUE);
+}
+
+static void
+stage_headless_frame (void)
+{
+#ifdef CLUTTER_WINDOWING_HEADLESS
+  ClutterActor *stage, *actor;
+  FrameTest data = { 0, };
+  ClutterActorBox box;
+
+  g_assert (clutter_check_windowing_backend (CLUTTER_WINDOWING_HEADLESS));
+
+  stage = clutter_test_get_stage ();
+  clutter_actor_set_size (stage, 320, 240);
+
+  actor = clutter_actor_new ();
+  clutter_actor_set_background_color (actor, CLUTTER_COLOR_Red);
+  clutter_actor_set_position (actor, 10, 20);
+  clutter_actor_set_size (actor, 100, 50);
+  clutter_actor_add_child (stage, actor);
+
+  g_signal_connect (stage, "after-paint", G_CALLBACK (on_after_paint), &data);
+  g_signal_connect (actor, "paint", G_CALLBACK (on_actor_paint), &data);
+
+  clutter_actor_show (stage);
+  g_assert (CLUTTER_ACTOR_IS_REALIZED (stage));
+  g_assert (CLUTTER_ACTOR_IS_MAPPED (actor));
+
+  /* the first frame lays out and paints the scene graph */
+  wait_for_frames (&data, 1);
+  g_assert_cmpuint (data.n_actor_paints, ==, 1);
+
+  clutter_actor_get_allocation_box (actor, &box);
+  g_assert_cmpfloat (box.x1, ==, 10);
+  g_assert_cmpfloat (box.y1, ==, 20);
+  g_assert_cmpfloat (box.x2, ==, 110);
+  g_assert_cmpfloat (box.y2, ==, 70);
+
+  /* the next frame is scheduled once the first one is presented */
+  clutter_actor_set_x (actor, 30);
+  wait_for_frames (&data, 2);
+  g_assert_cmpuint (data.n_actor_paints, ==, 2);
+
+  clutter_actor_get_allocation_box (actor, &box);
+  g_assert_cmpfloat (box.x1, ==, 30);
+#else
+  g_test_skip ("The headless backend is not enabled");
+#endif
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+#ifdef CLUTTER_WINDOWING_HEADLESS
+  /* the test suites run on the windowing system backend of the build
+   * environment, so we override it here
+   */
+  g_setenv ("CLUTTER_BACKEND", CLUTTER_WINDOWING_HEADLESS, TRUE);
+#endif
+
+  clutter_test_init (&argc, &argv);
+
+  clutter_test_add ("/stage/headless/frame", stage_headless_frame);
+
+  return clutter_test_run ();
+}
@@ -0,0 +1,244 @@
+#include <errno.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <glib-unix.h>
+#include <clutter/clutter.h>
+#include <clutter/wayland/clutter-wayland-surface.h>
+
+/* the opcode of the wl_buffer.release event */
+#define WL_BUFFER_RELEASE       0
+
+typedef struct {
+  struct wl_display *display;
+  struct wl_client *client;
+  int client_fd;
+  guint32 next_id;
+} WaylandTest;
+
+static void
+wayland_test_init (WaylandTest *data)
+{
+  int fds[2];
+
+  data->display = wl_display_create ();
+  g_assert (data->display != NULL);
+
+  /* there is no client library involved: the test reads the events
+   * sent to the client directly from its end of the connection
+   */
+  g_assert_cmpint (socketpair (AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds), ==, 0);
+  g_assert (g_unix_set_fd_nonblocking (fds[1], TRUE, NULL));
+
+  data->client = wl_client_create (data->display, fds[0]);
+  g_assert (data->client != NULL);
+
+  data->client_fd = fds[1];
+
+  /* the id 1 is taken by the wl_display object */
+  data->next_id = 2;
+}
+
+static void
+wayland_test_finish (WaylandTest *data)
+{
+  wl_client_destroy (data->client);
+  wl_display_destroy (data->display);
+  close (data->client_fd);
+}
+
+/* creates a SHM buffer owned by the client, filled with @color in the
+ * ARGB8888 format
+ */
+static struct wl_resource *
+create_shm_buffer (WaylandTest *data,
+                   int          width,
+                   int          height,
+                   guint32      color)
+{
+  struct wl_shm_buffer *shm_buffer;
+  guint32 id = data->next_id++;
+  guint32 *pixels;
+  int i;
+
+  /* without a client library there is no pool to create the buffer
+   * from, so the buffer is created directly on the server side
+   */
+  G_GNUC_BEGIN_IGNORE_DEPRECATIONS
+  shm_buffer = wl_shm_buffer_create (data->client, id,
+                                     width, height,
+                                     width * 4,
+                                     WL_SHM_FORMAT_ARGB8888);
+  G_GNUC_END_IGNORE_DEPRECATIONS
+  g_assert (shm_buffer != NULL);
+
+  pixels = wl_shm_buffer_get_data (shm_buffer);
+  for (i = 0; i < width * height; i++)
+    pixels[i] = color;
+
+  return wl_client_get_object (data->client, id);
+}
+
+/* counts the wl_buffer.release events sent for @buffer since the
+ * last call
+ */
+static guint
+count_releases (WaylandTest        *data,
+                struct wl_resource *buffer)
+{
+  guint32 id = wl_resource_get_id (buffer);
+  guint32 words[1024];
+  guint n_releases = 0;
+  gssize len, i;
+
+  wl_client_flush (data->client);
+
+  len = read (data->client_fd, words, sizeof (words));
+  if (len < 0)
+    {
+      g_assert_cmpint (errno, ==, EAGAIN);
+      return 0;
+    }
+
+  /* every message starts with the id of the object, followed by the
+   * size of the message in the upper 16 bits and the opcode in the
+   * lower 16 bits
+   */
+  for (i = 0; i + 2 <= len / 4; )
+    {
+      guint32 size = words[i + 1] >> 16;
+
+      if (words[i] == id && (words[i + 1] & 0xffff) == WL_BUFFER_RELEASE)
+        n_releases += 1;
+
+      g_assert_cmpuint (size, >=, 8);
+      i += size / 4;
+    }
+
+  return n_releases;
+}
+
+static void
+assert_texture_color (CoglTexture *texture,
+                      int          x,
+                      int          y,
+                      guint8       red,
+                      guint8       green,
+                      guint8       blue)
+{
+  int width = cogl_texture_get_width (texture);
+  int height = cogl_texture_get_height (texture);
+  guint8 *pixels, *pixel;
+
+  pixels = g_malloc (width * height * 4);
+  cogl_texture_get_data (texture, COGL_PIXEL_FORMAT_RGBA_8888_PRE, width * 4, pixels);
+
+  pixel = pixels + (y * width + x) * 4;
+  g_assert_cmpint (pixel[0], ==, red);
+  g_assert_cmpint (pixel[1], ==, green);
+  g_assert_cmpint (pixel[2], ==, blue);
+
+  g_free (pixels);
+}
+
+static void
+wayland_surface_shm_reuse (void)
+{
+  WaylandTest data;
+  ClutterActor *surface;
+  ClutterWaylandSurface *wayland_surface;
+  struct wl_resource *red, *blue, *large;
+  CoglTexture *texture;
+
+  if (clutter_test_skip_without_rendering ())
+    return;
+
+  wayland_test_init (&data);
+
+  surface = clutter_wayland_surface_new (NULL);
+  g_object_ref_sink (surface);
+  wayland_surface = CLUTTER_WAYLAND_SURFACE (surface);
+
+  red = create_shm_buffer (&data, 8, 8, 0xffff0000);
+  blue = create_shm_buffer (&data, 8, 8, 0xff0000ff);
+  large = create_shm_buffer (&data, 16, 8, 0xff0000ff);
+
+  g_assert (clutter_wayland_surface_attach_buffer (wayland_surface, red, NULL));
+  texture = clutter_wayland_surface_get_cogl_texture (wayland_surface);
+  g_assert (texture != NULL);
+  assert_texture_color (texture, 0, 0, 0xff, 0, 0);
+
+  /* a buffer with the same size and format keeps the texture, and only
+   * the damaged region is uploaded
+   */
+  g_assert (clutter_wayland_surface_attach_buffer (wayland_surface, blue, NULL));
+  clutter_wayland_surface_damage_buffer (wayland_surface, blue, 2, 2, 4, 4);
+  g_assert (clutter_wayland_surface_get_cogl_texture (wayland_surface) == texture);
+  assert_texture_color (texture, 0, 0, 0xff, 0, 0);
+  assert_texture_color (texture, 3, 3, 0, 0, 0xff);
+
+  /* damage outside of the buffer is clamped */
+  clutter_wayland_surface_damage_buffer (wayland_surface, blue, -4, -4, 6, 6);
+  assert_texture_color (texture, 0, 0, 0, 0, 0xff);
+  assert_texture_color (texture, 7, 7, 0xff, 0, 0);
+
+  /* a buffer with a different size needs a new texture */
+  g_assert (clutter_wayland_surface_attach_buffer (wayland_surface, large, NULL));
+  texture = clutter_wayland_surface_get_cogl_texture (wayland_surface);
+  g_assert_cmpint (cogl_texture_get_width (texture), ==, 16);
+  assert_texture_color (texture, 12, 0, 0, 0, 0xff);
+
+  clutter_actor_destroy (surface);
+  g_object_unref (surface);
+
+  wayland_test_finish (&data);
+}
+
+static void
+wayland_surface_shm_release (void)
+{
+  WaylandTest data;
+  ClutterActor *surface;
+  ClutterWaylandSurface *wayland_surface;
+  struct wl_resource *first, *second;
+
+  wayland_test_init (&data);
+
+  surface = clutter_wayland_surface_new (NULL);
+  g_object_ref_sink (surface);
+  wayland_surface = CLUTTER_WAYLAND_SURFACE (surface);
+
+  first = create_shm_buffer (&data, 8, 8, 0xffff0000);
+  second = create_shm_buffer (&data, 8, 8, 0xff0000ff);
+
+  /* without commits, the compositor is in charge of the releases */
+  g_assert (clutter_wayland_surface_attach_buffer (wayland_surface, first, NULL));
+  g_assert (clutter_wayland_surface_attach_buffer (wayland_surface, second, NULL));
+  g_assert_cmpuint (count_releases (&data, first), ==, 0);
+
+  /* SHM buffers are released as soon as they are committed, as their
+   * contents have been copied into the texture
+   */
+  g_assert (clutter_wayland_surface_attach_buffer (wayland_surface, first, NULL));
+  clutter_wayland_surface_commit (wayland_surface);
+  g_assert_cmpuint (count_releases (&data, first), ==, 1);
+
+  g_assert (clutter_wayland_surface_attach_buffer (wayland_surface, second, NULL));
+  clutter_wayland_surface_damage_buffer (wayland_surface, second, 0, 0, 8, 8);
+  clutter_wayland_surface_commit (wayland_surface);
+  g_assert_cmpuint (count_releases (&data, second), ==, 1);
+
+  /* committing again does not release the buffer twice */
+  clutter_wayland_surface_commit (wayland_surface);
+  g_assert_cmpuint (count_releases (&data, second), ==, 0);
+
+  clutter_actor_destroy (surface);
+  g_object_unref (surface);
+
+  wayland_test_finish (&data);
+}
+
+CLUTTER_TEST_SUITE (
+  CLUTTER_TEST_UNIT ("/wayland-surface/shm/reuse", wayland_surface_shm_reuse)
+  CLUTTER_TEST_UNIT ("/wayland-surface/shm/release", wayland_surface_shm_release)
+)
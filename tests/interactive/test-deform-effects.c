@@ -0,0 +1,239 @@
+#include <stdlib.h>
+#include <math.h>
+
+#include <glib.h>
+#include <gmodule.h>
+
+#define COGL_ENABLE_EXPERIMENTAL_API
+#include <clutter/clutter.h>
+
+/* a simple wave deformation, implemented both on the CPU and on the
+ * GPU; the TestCpuWave sub-class disables the GPU path, so that the
+ * two results can be compared side by side
+ */
+#define TEST_TYPE_WAVE          (test_wave_get_type ())
+#define TEST_WAVE(obj)          (G_TYPE_CHECK_INSTANCE_CAST ((obj), TEST_TYPE_WAVE, TestWave))
+#define TEST_TYPE_CPU_WAVE      (test_cpu_wave_get_type ())
+
+typedef struct _TestWave        TestWave;
+typedef struct _TestWaveClass   TestWaveClass;
+
+struct _TestWave
+{
+  ClutterDeformEffect parent_instance;
+
+  gfloat phase;
+  gfloat amplitude;
+
+  gint phase_uniform;
+  gint amplitude_uniform;
+  gint size_uniform;
+};
+
+struct _TestWaveClass
+{
+  ClutterDeformEffectClass parent_class;
+};
+
+typedef TestWave                TestCpuWave;
+typedef TestWaveClass           TestCpuWaveClass;
+
+static const gchar *wave_glsl_declarations =
+  "uniform float phase;\n"
+  "uniform float amplitude;\n"
+  "uniform vec2 size;\n";
+
+static const gchar *wave_glsl_source =
+  "  vec4 position = cogl_position_in;\n"
+  "  position.y += amplitude * sin (phase + (position.x / size.x) * 6.2831853);\n"
+  "  cogl_position_out = cogl_modelview_projection_matrix * position;\n";
+
+GType test_wave_get_type (void);
+GType test_cpu_wave_get_type (void);
+
+G_DEFINE_TYPE (TestWave, test_wave, CLUTTER_TYPE_DEFORM_EFFECT)
+
+G_DEFINE_TYPE (TestCpuWave, test_cpu_wave, TEST_TYPE_WAVE)
+
+static void
+test_wave_deform_vertex (ClutterDeformEffect *effect,
+                         gfloat               width,
+                         gfloat               height,
+                         CoglTextureVertex   *vertex)
+{
+  TestWave *self = TEST_WAVE (effect);
+
+  vertex->y += self->amplitude
+             * sinf (self->phase + (vertex->x / width) * 2.0f * G_PI);
+}
+
+static CoglHandle
+test_wave_create_vertex_snippet (ClutterDeformEffect *effect)
+{
+  return cogl_snippet_new (COGL_SNIPPET_HOOK_VERTEX,
+                           wave_glsl_declarations,
+                           wave_glsl_source);
+}
+
+static void
+test_wave_update_uniforms (ClutterDeformEffect *effect,
+                           CoglHandle           handle,
+                           gfloat               width,
+                           gfloat               height)
+{
+  TestWave *self = TEST_WAVE (effect);
+  CoglPipeline *pipeline = handle;
+  float size[2] = { width, height };
+
+  if (self->phase_uniform < 0)
+    {
+      self->phase_uniform =
+        cogl_pipeline_get_uniform_location (pipeline, "phase");
+      self->amplitude_uniform =
+        cogl_pipeline_get_uniform_location (pipeline, "amplitude");
+      self->size_uniform =
+        cogl_pipeline_get_uniform_location (pipeline, "size");
+    }
+
+  cogl_pipeline_set_uniform_1f (pipeline, self->phase_uniform, self->phase);
+  cogl_pipeline_set_uniform_1f (pipeline, self->amplitude_uniform,
+                                self->amplitude);
+  cogl_pipeline_set_uniform_float (pipeline, self->size_uniform, 2, 1, size);
+}
+
+static void
+test_wave_class_init (TestWaveClass *klass)
+{
+  ClutterDeformEffectClass *deform_class = CLUTTER_DEFORM_EFFECT_CLASS (klass);
+
+  deform_class->deform_vertex = test_wave_deform_vertex;
+  deform_class->create_vertex_snippet = test_wave_create_vertex_snippet;
+  deform_class->update_uniforms = test_wave_update_uniforms;
+}
+
+static void
+test_wave_init (TestWave *self)
+{
+  self->amplitude = 12.0f;
+
+  self->phase_uniform = -1;
+  self->amplitude_uniform = -1;
+  self->size_uniform = -1;
+}
+
+static void
+test_cpu_wave_class_init (TestCpuWaveClass *klass)
+{
+  ClutterDeformEffectClass *deform_class = CLUTTER_DEFORM_EFFECT_CLASS (klass);
+
+  /* force the fallback path */
+  deform_class->create_vertex_snippet = NULL;
+  deform_class->update_uniforms = NULL;
+}
+
+static void
+test_cpu_wave_init (TestCpuWave *self)
+{
+}
+
+static void
+on_new_frame (ClutterTimeline *timeline,
+              gint             elapsed,
+              ClutterActor    *stage)
+{
+  gdouble progress = clutter_timeline_get_progress (timeline);
+  gint i;
+
+  /* the first two children of the stage are the deformed actors */
+  for (i = 0; i < 2; i++)
+    {
+      ClutterActor *actor = clutter_actor_get_child_at_index (stage, i);
+      ClutterEffect *wave, *curl;
+
+      wave = clutter_actor_get_effect (actor, "wave");
+      TEST_WAVE (wave)->phase = progress * 2.0 * G_PI;
+      clutter_deform_effect_invalidate (CLUTTER_DEFORM_EFFECT (wave));
+
+      curl = clutter_actor_get_effect (actor, "curl");
+      clutter_page_turn_effect_set_period (CLUTTER_PAGE_TURN_EFFECT (curl),
+                                           progress * 0.5);
+    }
+}
+
+static ClutterActor *
+create_hand (const char    *name,
+             ClutterEffect *wave,
+             gfloat         x)
+{
+  ClutterActor *hand, *group;
+  gchar *file;
+
+  file = g_build_filename (TESTS_DATADIR, "redhand.png", NULL);
+  hand = clutter_texture_new_from_file (file, NULL);
+  if (hand == NULL)
+    g_error ("Unable to load '%s'", file);
+
+  g_free (file);
+
+  /* the page turn is applied to a parent so that the two deformations
+   * can be told apart
+   */
+  group = clutter_actor_new ();
+  clutter_actor_set_name (group, name);
+  clutter_actor_add_child (group, hand);
+  clutter_actor_set_position (group, x, 100);
+
+  clutter_actor_add_effect_with_name (hand, "wave", wave);
+  clutter_actor_add_effect_with_name (group, "curl",
+                                      clutter_page_turn_effect_new (0.0, 45.0, 12.0));
+
+  return group;
+}
+
+G_MODULE_EXPORT int
+test_deform_effects_main (int argc, char *argv[])
+{
+  ClutterTimeline *timeline;
+  ClutterActor *stage, *label;
+
+  if (clutter_init (&argc, &argv) != CLUTTER_INIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  stage = clutter_stage_new ();
+  clutter_stage_set_title (CLUTTER_STAGE (stage), "Deform Effects");
+  clutter_actor_set_size (stage, 640, 480);
+  clutter_actor_set_background_color (stage, CLUTTER_COLOR_Aluminium3);
+  g_signal_connect (stage, "destroy", G_CALLBACK (clutter_main_quit), NULL);
+
+  clutter_actor_add_child (stage,
+                           create_hand ("cpu", g_object_new (TEST_TYPE_CPU_WAVE, NULL), 50));
+  clutter_actor_add_child (stage,
+                           create_hand ("gpu", g_object_new (TEST_TYPE_WAVE, NULL), 350));
+
+  label = clutter_text_new_with_text ("Sans 12",
+                                      clutter_feature_available (CLUTTER_FEATURE_SHADERS_GLSL)
+                                        ? "Left: CPU deformation, right: GPU deformation"
+                                        : "No GLSL support: both actors use the CPU");
+  clutter_actor_set_position (label, 12, 12);
+  clutter_actor_add_child (stage, label);
+
+  timeline = clutter_timeline_new (4000);
+  clutter_timeline_set_repeat_count (timeline, -1);
+  clutter_timeline_set_auto_reverse (timeline, TRUE);
+  g_signal_connect (timeline, "new-frame", G_CALLBACK (on_new_frame), stage);
+  clutter_timeline_start (timeline);
+
+  clutter_actor_show (stage);
+
+  clutter_main ();
+
+  g_object_unref (timeline);
+
+  return EXIT_SUCCESS;
+}
+
+G_MODULE_EXPORT const char *
+test_deform_effects_describe (void)
+{
+  return "Compare CPU and GPU vertex deformation in ClutterDeformEffect";
+}
@@ -0,0 +1,117 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <clutter/clutter.h>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#define N_ACTORS 10000
+
+static gint n_actors = N_ACTORS;
+static gboolean with_content = FALSE;
+
+static GOptionEntry entries[] = {
+  {
+    "num-actors", 'a',
+    0,
+    G_OPTION_ARG_INT, &n_actors,
+    "Number of actors", "ACTORS"
+  },
+  {
+    "with-content", 'c',
+    0,
+    G_OPTION_ARG_NONE, &with_content,
+    "Give each actor a content and a content gravity", NULL
+  },
+  { NULL }
+};
+
+/* the number of bytes currently allocated through malloc(); we force
+ * GSlice to use the system allocator in main(), so that this includes
+ * the instance and private data of each actor
+ */
+static gsize
+get_allocated_bytes (void)
+{
+#ifdef __GLIBC__
+# if __GLIBC_PREREQ (2, 33)
+  struct mallinfo2 info = mallinfo2 ();
+
+  return info.uordblks + info.hblkhd;
+# else
+  struct mallinfo info = mallinfo ();
+
+  return (gsize) info.uordblks + (gsize) info.hblkhd;
+# endif
+#else
+  return 0;
+#endif
+}
+
+int
+main (int argc, char **argv)
+{
+  ClutterActor *stage, *container;
+  ClutterContent *content;
+  GError *error = NULL;
+  gsize before, after;
+  gint i;
+
+  g_setenv ("G_SLICE", "always-malloc", TRUE);
+
+  if (clutter_init_with_args (&argc, &argv,
+                              NULL,
+                              entries,
+                              NULL,
+                              &error) != CLUTTER_INIT_SUCCESS)
+    return 1;
+
+  stage = clutter_stage_new ();
+  container = clutter_actor_new ();
+  clutter_actor_add_child (stage, container);
+
+  content = with_content ? clutter_canvas_new () : NULL;
+
+  /* create and destroy one actor, so that the class and all the
+   * lazily initialized global state are not accounted for
+   */
+  clutter_actor_destroy (clutter_actor_new ());
+
+  before = get_allocated_bytes ();
+
+  for (i = 0; i < n_actors; i++)
+    {
+      ClutterActor *actor = clutter_actor_new ();
+
+      clutter_actor_set_size (actor, 10, 10);
+
+      if (content != NULL)
+        {
+          clutter_actor_set_content (actor, content);
+          clutter_actor_set_content_gravity (actor, CLUTTER_CONTENT_GRAVITY_CENTER);
+        }
+
+      clutter_actor_add_child (container, actor);
+    }
+
+  after = get_allocated_bytes ();
+
+  if (after == 0)
+    {
+      printf ("Allocation statistics are not available on this platform\n");
+      return EXIT_SUCCESS;
+    }
+
+  printf ("Actor memory test with %d actors%s\n",
+          n_actors,
+          with_content ? " with content" : "");
+  printf ("  total: %" G_GSIZE_FORMAT " bytes\n", after - before);
+  printf ("  per actor: %.1f bytes\n",
+          (double) (after - before) / (double) MAX (n_actors, 1));
+
+  clutter_actor_destroy (stage);
+  g_clear_object (&content);
+
+  return EXIT_SUCCESS;
+}
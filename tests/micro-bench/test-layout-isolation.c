@@ -0,0 +1,142 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <clutter/clutter.h>
+
+#define N_PANELS        64
+#define N_LABELS        4
+#define N_ITERATIONS    2000
+
+static gint n_panels = N_PANELS;
+static gint n_iterations = N_ITERATIONS;
+
+static GOptionEntry entries[] = {
+  {
+    "num-panels", 'p',
+    0,
+    G_OPTION_ARG_INT, &n_panels,
+    "Number of panels", "PANELS"
+  },
+  {
+    "num-iterations", 'i',
+    0,
+    G_OPTION_ARG_INT, &n_iterations,
+    "Number of label changes", "ITERATIONS"
+  },
+  { NULL }
+};
+
+/* lays out a grid of fixed size panels, each with a vertical box of
+ * labels, and measures how long it takes to change the text of one
+ * label at a time and get the new layout
+ */
+static gdouble
+run_test (gboolean isolate)
+{
+  ClutterLayoutManager *grid;
+  ClutterActor *stage, *container;
+  ClutterActor **labels;
+  ClutterActorBox box;
+  GTimer *timer;
+  gdouble elapsed;
+  gint n_columns, n_labels;
+  gint i, j;
+
+  stage = clutter_stage_new ();
+
+  grid = clutter_grid_layout_new ();
+  clutter_grid_layout_set_row_spacing (CLUTTER_GRID_LAYOUT (grid), 6);
+  clutter_grid_layout_set_column_spacing (CLUTTER_GRID_LAYOUT (grid), 6);
+
+  container = clutter_actor_new ();
+  clutter_actor_set_layout_manager (container, grid);
+  clutter_actor_add_child (stage, container);
+
+  n_columns = MAX ((gint) sqrt (n_panels), 1);
+  n_labels = n_panels * N_LABELS;
+  labels = g_new (ClutterActor *, n_labels);
+
+  for (i = 0; i < n_panels; i++)
+    {
+      ClutterLayoutManager *box_layout;
+      ClutterActor *panel;
+
+      box_layout = clutter_box_layout_new ();
+      clutter_box_layout_set_orientation (CLUTTER_BOX_LAYOUT (box_layout),
+                                          CLUTTER_ORIENTATION_VERTICAL);
+
+      panel = clutter_actor_new ();
+      clutter_actor_set_layout_manager (panel, box_layout);
+      clutter_actor_set_size (panel, 160, 80);
+      clutter_actor_set_isolate_layout (panel, isolate);
+
+      for (j = 0; j < N_LABELS; j++)
+        {
+          ClutterActor *label = clutter_text_new_with_text ("Sans 10px", "0");
+
+          clutter_actor_add_child (panel, label);
+          labels[i * N_LABELS + j] = label;
+        }
+
+      clutter_grid_layout_attach (CLUTTER_GRID_LAYOUT (grid), panel,
+                                  i % n_columns, i / n_columns,
+                                  1, 1);
+    }
+
+  /* the initial layout is not part of the measurement */
+  clutter_actor_get_allocation_box (container, &box);
+
+  timer = g_timer_new ();
+
+  for (i = 0; i < n_iterations; i++)
+    {
+      ClutterActor *label = labels[(i * 7) % n_labels];
+      gchar text[32];
+
+      g_snprintf (text, sizeof (text), "%d", i);
+      clutter_text_set_text (CLUTTER_TEXT (label), text);
+
+      /* this forces the stage to process the queued relayout */
+      clutter_actor_get_allocation_box (label, &box);
+    }
+
+  elapsed = g_timer_elapsed (timer, NULL);
+
+  g_timer_destroy (timer);
+  g_free (labels);
+  clutter_actor_destroy (stage);
+
+  return elapsed;
+}
+
+int
+main (int argc, char **argv)
+{
+  GError *error = NULL;
+  gdouble shared, isolated;
+
+  if (clutter_init_with_args (&argc, &argv,
+                              NULL,
+                              entries,
+                              NULL,
+                              &error) != CLUTTER_INIT_SUCCESS)
+    return 1;
+
+  n_panels = MAX (n_panels, 1);
+  n_iterations = MAX (n_iterations, 1);
+
+  shared = run_test (FALSE);
+  isolated = run_test (TRUE);
+
+  printf ("Layout isolation test with %d panels, %d label changes\n",
+          n_panels,
+          n_iterations);
+  printf ("  shared layout: %.3f ms per change\n",
+          shared * 1000.0 / n_iterations);
+  printf ("  isolated layout: %.3f ms per change\n",
+          isolated * 1000.0 / n_iterations);
+  printf ("  speed-up: %.1fx\n",
+          isolated > 0 ? shared / isolated : 0.0);
+
+  return EXIT_SUCCESS;
+}